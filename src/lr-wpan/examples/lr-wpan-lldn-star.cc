@@ -0,0 +1,177 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Large LLDN scenario built with the LrWpanLldnStarHelper.
+ *
+ * A number of LLDN stars (a PAN-C and its LLDN devices on a ring) are placed
+ * along a line, on the channels of a channel plan. Once the PAN-Cs are Online,
+ * every device periodically sends a LL-DATA frame to its PAN-C in its dedicated
+ * timeslot. The wall clock time spent building the scenario and simulating it
+ * is printed, along with the number of frames received by the PAN-Cs, the
+ * inter-cell collision rate and the timeslots missed by devices with a drifting clock.
+ *
+ * ./ns3 run "lr-wpan-lldn-star --stars=20 --devices=250 --duration=60"
+ * ./ns3 run "lr-wpan-lldn-star --stars=8 --spacing=30 --channels=2"
+ * ./ns3 run "lr-wpan-lldn-star --stars=8 --devices=100 --sleep=1"
+ * ./ns3 run "lr-wpan-lldn-star --stars=1 --devices=100 --drift=40 --guard=2"
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/packet.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+static uint64_t g_received = 0;   //!< The number of frames received by the PAN-Cs
+static uint64_t g_slotMisses = 0; //!< The number of timeslots missed by the devices
+
+/**
+ * Function called when a PAN-C receives a frame.
+ * \param params MCPS data indication parameters
+ * \param p packet
+ */
+static void
+DataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_received++;
+}
+
+/**
+ * Function called when a LLDN device misses a timeslot.
+ * \param type the type of the missed timeslot
+ * \param clockError the timing error of the device
+ */
+static void
+SlotMiss(LLDNTimeslotType type, Time clockError)
+{
+    g_slotMisses++;
+}
+
+/**
+ * Send a LL-DATA frame to the PAN-C and schedule the next one.
+ * \param mac the MAC of the LLDN device
+ * \param period the period of the frames
+ */
+static void
+SendData(Ptr<LrWpanMac> mac, Time period)
+{
+    McpsDataRequestParams params;
+    params.m_srcAddrMode = SIMPLE_ADDR;
+    params.m_dstAddrMode = SIMPLE_ADDR;
+    params.m_dstSimpleAddr = Mac8Address(1);
+    params.m_msduHandle = 0;
+    mac->McpsDataRequest(params, Create<Packet>(10));
+    Simulator::Schedule(period, &SendData, mac, period);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t numStars = 4;
+    uint32_t numDevices = 50;
+    double duration = 10;
+    double period = 1;
+    double spacing = 1000;
+    uint32_t numChannels = 16;
+    bool sleep = false;
+    double drift = 0;
+    double guard = 500;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("stars", "Number of LLDN stars", numStars);
+    cmd.AddValue("devices", "Number of LLDN devices per star (at most 253)", numDevices);
+    cmd.AddValue("duration", "Simulated time in seconds", duration);
+    cmd.AddValue("period", "Period of the LL-DATA frames in seconds", period);
+    cmd.AddValue("spacing", "Distance between the PAN-Cs of the stars in meters", spacing);
+    cmd.AddValue("channels", "Number of channels of the channel plan (1-16)", numChannels);
+    cmd.AddValue("sleep", "Switch off the transceiver of the devices between timeslots", sleep);
+    cmd.AddValue("drift", "Maximum clock frequency offset of the devices in ppm", drift);
+    cmd.AddValue("guard", "Guard time of the timeslots in microseconds", guard);
+    cmd.Parse(argc, argv);
+
+    auto buildStart = std::chrono::steady_clock::now();
+
+    LrWpanLldnStarHelper starHelper;
+    starHelper.SetPlacement(LrWpanLldnStarHelper::RING, 10);
+    starHelper.SetTimeslotSize(10);
+    starHelper.SetPanCDataIndicationCallback(MakeCallback(&DataIndication));
+    starHelper.SetGuardTime(MicroSeconds(guard));
+    if (sleep)
+    {
+        starHelper.EnableDeviceSleep(MicroSeconds(guard));
+    }
+    if (drift > 0)
+    {
+        Ptr<UniformRandomVariable> clockDrift = CreateObject<UniformRandomVariable>();
+        clockDrift->SetAttribute("Min", DoubleValue(-drift));
+        clockDrift->SetAttribute("Max", DoubleValue(drift));
+        clockDrift->SetStream(1000);
+        starHelper.SetClockDrift(clockDrift, 0);
+    }
+
+    std::vector<uint8_t> channels;
+    for (uint32_t i = 0; i < numChannels && i < 16; i++)
+    {
+        channels.push_back(11 + i);
+    }
+    starHelper.SetChannelPlan(channels, 100);
+
+    Ptr<UniformRandomVariable> offset = CreateObject<UniformRandomVariable>();
+    offset->SetStream(0);
+    for (uint32_t i = 0; i < numStars; i++)
+    {
+        starHelper.SetPanId(i + 1);
+        starHelper.SetNetworkId(i % 254 + 1);
+        starHelper.SetCenter(Vector(i * spacing, 0, 0));
+        NetDeviceContainer devices = starHelper.Install(numDevices);
+        for (uint32_t j = 1; j < devices.GetN(); j++)
+        {
+            Ptr<LrWpanNetDevice> dev = DynamicCast<LrWpanNetDevice>(devices.Get(j));
+            dev->GetMac()->TraceConnectWithoutContext("LLDNSlotMiss", MakeCallback(&SlotMiss));
+            Simulator::ScheduleWithContext(dev->GetNode()->GetId(),
+                                           Seconds(1 + offset->GetValue(0, period)),
+                                           &SendData,
+                                           dev->GetMac(),
+                                           Seconds(period));
+        }
+    }
+    starHelper.AssignStreams(1);
+    starHelper.EnableInterCellStats();
+    starHelper.Start(Seconds(0.5));
+
+    auto buildEnd = std::chrono::steady_clock::now();
+
+    Simulator::Stop(Seconds(duration));
+    Simulator::Run();
+
+    auto runEnd = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> buildTime = buildEnd - buildStart;
+    std::chrono::duration<double> runTime = runEnd - buildEnd;
+    std::cout << "Nodes: " << starHelper.GetNodes().GetN() << "\n"
+              << "Build time: " << buildTime.count() << " s\n"
+              << "Run time: " << runTime.count() << " s\n"
+              << "Frames received by the PAN-Cs: " << g_received << "\n"
+              << "Timeslots missed by the devices: " << g_slotMisses << "\n"
+              << "Inter-cell collision rate: " << starHelper.GetInterCellCollisionRate() << "\n";
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,542 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "lr-wpan-lldn-star-helper.h"
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-net-device.h>
+#include <ns3/mac16-address.h>
+#include <ns3/mac8-address.h>
+#include <ns3/node.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LrWpanLldnStarHelper");
+
+LrWpanLldnStarHelper::LrWpanLldnStarHelper()
+    : LrWpanLldnStarHelper(CreateObject<SingleModelSpectrumChannel>())
+{
+    m_channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    m_channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+}
+
+LrWpanLldnStarHelper::LrWpanLldnStarHelper(Ptr<SpectrumChannel> channel)
+    : m_channel(channel),
+      m_panId(5),
+      m_networkId(1),
+      m_channels({11}),
+      m_channelRange(100),
+      m_center(0, 0, 0),
+      m_placement(RING),
+      m_distance(10),
+      m_timeslotSize(40),
+      m_numRetransmitTS(0),
+      m_numSharedGroupTS(0),
+      m_deviceSleep(false),
+      m_guardTime(MicroSeconds(500)),
+      m_clockDriftWalk(0)
+{
+}
+
+LrWpanLldnStarHelper::~LrWpanLldnStarHelper()
+{
+}
+
+Ptr<SpectrumChannel>
+LrWpanLldnStarHelper::GetChannel() const
+{
+    return m_channel;
+}
+
+void
+LrWpanLldnStarHelper::SetPanId(uint16_t panId)
+{
+    m_panId = panId;
+}
+
+void
+LrWpanLldnStarHelper::SetNetworkId(uint8_t networkId)
+{
+    NS_ASSERT_MSG(networkId != 0xff, "0xff is not a valid LLDN identifier");
+    m_networkId = networkId;
+}
+
+void
+LrWpanLldnStarHelper::SetChannelPlan(const std::vector<uint8_t>& channels, double range)
+{
+    NS_ASSERT_MSG(!channels.empty(), "The channel plan has no channel");
+    m_channels = channels;
+    m_channelRange = range;
+}
+
+void
+LrWpanLldnStarHelper::SetCenter(Vector center)
+{
+    m_center = center;
+}
+
+void
+LrWpanLldnStarHelper::SetPlacement(Placement placement, double distance)
+{
+    NS_ASSERT_MSG(distance > 0, "The distance between the nodes must be positive");
+    m_placement = placement;
+    m_distance = distance;
+}
+
+void
+LrWpanLldnStarHelper::SetTimeslotSize(uint8_t size)
+{
+    m_timeslotSize = size;
+}
+
+void
+LrWpanLldnStarHelper::SetNumRetransmitTimeslots(uint8_t numTimeslots)
+{
+    m_numRetransmitTS = numTimeslots;
+}
+
+void
+LrWpanLldnStarHelper::SetNumSharedGroupTimeslots(uint8_t numTimeslots)
+{
+    m_numSharedGroupTS = numTimeslots;
+}
+
+void
+LrWpanLldnStarHelper::EnableDeviceSleep(Time guardTime)
+{
+    m_deviceSleep = true;
+    m_guardTime = guardTime;
+}
+
+void
+LrWpanLldnStarHelper::SetGuardTime(Time guardTime)
+{
+    m_guardTime = guardTime;
+}
+
+void
+LrWpanLldnStarHelper::SetClockDrift(Ptr<RandomVariableStream> drift, double walk)
+{
+    m_clockDrift = drift;
+    m_clockDriftWalk = walk;
+}
+
+void
+LrWpanLldnStarHelper::SetPanCDataIndicationCallback(McpsDataIndicationCallback c)
+{
+    m_panCDataIndication = c;
+}
+
+void
+LrWpanLldnStarHelper::SetDeviceDataConfirmCallback(McpsDataConfirmCallback c)
+{
+    m_deviceDataConfirm = c;
+}
+
+NetDeviceContainer
+LrWpanLldnStarHelper::Install(uint32_t numDevices)
+{
+    NS_LOG_FUNCTION(this << numDevices);
+
+    uint32_t numUplinkTS = m_numRetransmitTS + numDevices + m_numSharedGroupTS;
+    NS_ASSERT_MSG(numDevices <= 253 && numUplinkTS <= 254,
+                  "Too many devices for the base timeslots of a LLDN superframe");
+
+    NodeContainer nodes;
+    nodes.Create(numDevices + 1);
+    m_nodes.Add(nodes);
+
+    Star star;
+    star.center = m_center;
+    star.channel = ChooseChannel(m_center);
+    star.devices.reserve(numDevices);
+
+    LrWpanPhyPibAttributes pibAttr;
+    pibAttr.phyCurrentChannel = star.channel;
+
+    NetDeviceContainer devices;
+
+    // PAN-C
+    Mac8Address panCAddr(m_networkId);
+    star.panC = CreateDevice(nodes.Get(0), m_center);
+    star.panC->SetAddress(panCAddr);
+    star.panC->GetPhy()->PlmeSetAttributeRequest(LrWpanPibAttributeIdentifier::phyCurrentChannel,
+                                                  &pibAttr);
+    Ptr<LrWpanMac> panCMac = star.panC->GetMac();
+    panCMac->SetPanId(m_panId);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetAssociatedCoor(panCAddr);
+    panCMac->SetMacLLDNlowLatencyNWid(m_networkId);
+    panCMac->SetMacLLDNNumTimeSlots(numUplinkTS);
+    panCMac->SetMacLLDNnumUplinkTS(numUplinkTS);
+    panCMac->SetMacLLDNnumReTransmitTS(m_numRetransmitTS);
+    panCMac->SetMacLLDNnumSharedGroupTS(m_numSharedGroupTS);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+    panCMac->SetMlmeLLDNTimeslotSize(m_timeslotSize);
+    if (!m_panCDataIndication.IsNull())
+    {
+        panCMac->SetMcpsDataIndicationCallback(m_panCDataIndication);
+    }
+    devices.Add(star.panC);
+
+    // LLDN devices, each one owning the base timeslot following the previous one
+    for (uint32_t i = 0; i < numDevices; i++)
+    {
+        Ptr<LrWpanNetDevice> dev = CreateDevice(nodes.Get(i + 1), GetDevicePosition(i, numDevices));
+        Mac8Address simpleAddr(i + 1 < m_networkId ? i + 1 : i + 2);
+        uint8_t timeslot = m_numRetransmitTS + i;
+        dev->SetAddress(simpleAddr);
+        dev->GetPhy()->PlmeSetAttributeRequest(LrWpanPibAttributeIdentifier::phyCurrentChannel,
+                                               &pibAttr);
+        panCMac->SetLLDNTimeslotOwner(timeslot, simpleAddr);
+
+        Ptr<LrWpanMac> devMac = dev->GetMac();
+        devMac->SetPanId(m_panId);
+        devMac->SetLLDNModeEnabled();
+        devMac->SetMacLLDNlowLatencyNWid(m_networkId);
+        devMac->SetMacLLDNnumUplinkTS(numUplinkTS);
+        devMac->SetMacLLDNnumReTransmitTS(m_numRetransmitTS);
+        devMac->SetMacLLDNnumSharedGroupTS(m_numSharedGroupTS);
+        devMac->SetMacLLDNassignedTimeSlot(timeslot);
+        devMac->SetLLDNGuardTime(m_guardTime);
+        if (m_deviceSleep)
+        {
+            devMac->SetLLDNSleepEnabled(true);
+        }
+        if (m_clockDrift)
+        {
+            devMac->SetLLDNClockDrift(m_clockDrift->GetValue());
+            devMac->SetLLDNClockDriftWalk(m_clockDriftWalk);
+        }
+        if (!m_deviceDataConfirm.IsNull())
+        {
+            devMac->SetMcpsDataConfirmCallback(m_deviceDataConfirm);
+        }
+        star.devices.push_back(dev);
+        devices.Add(dev);
+    }
+
+    m_stars.push_back(std::move(star));
+    return devices;
+}
+
+NetDeviceContainer
+LrWpanLldnStarHelper::GetPanCs() const
+{
+    NetDeviceContainer panCs;
+    for (const auto& star : m_stars)
+    {
+        panCs.Add(star.panC);
+    }
+    return panCs;
+}
+
+uint8_t
+LrWpanLldnStarHelper::GetChannelNumber(uint32_t star) const
+{
+    NS_ASSERT_MSG(star < m_stars.size(), "No such star");
+    return m_stars[star].channel;
+}
+
+NodeContainer
+LrWpanLldnStarHelper::GetNodes() const
+{
+    return m_nodes;
+}
+
+void
+LrWpanLldnStarHelper::Start(Time startTime)
+{
+    for (const auto& star : m_stars)
+    {
+        MlmeLLDNOnlineRequestParams onlineParams;
+        Simulator::ScheduleWithContext(star.panC->GetNode()->GetId(),
+                                       startTime,
+                                       &LrWpanMac::MlmeLLDNOnlineRequest,
+                                       star.panC->GetMac(),
+                                       onlineParams);
+    }
+}
+
+int64_t
+LrWpanLldnStarHelper::AssignStreams(int64_t stream)
+{
+    int64_t currentStream = stream;
+    for (const auto& star : m_stars)
+    {
+        currentStream += star.panC->AssignStreams(currentStream);
+        for (const auto& device : star.devices)
+        {
+            currentStream += device->AssignStreams(currentStream);
+        }
+    }
+    return (currentStream - stream);
+}
+
+void
+LrWpanLldnStarHelper::EnableInterCellStats()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (uint32_t i = 0; i < m_stars.size(); i++)
+    {
+        Ptr<LrWpanPhy> panCPhy = m_stars[i].panC->GetPhy();
+        panCPhy->TraceConnectWithoutContext(
+            "PhyTxBegin",
+            MakeCallback(&LrWpanLldnStarHelper::TxSink, this).Bind(i, false));
+        panCPhy->TraceConnectWithoutContext(
+            "PhyRxBegin",
+            MakeCallback(&LrWpanLldnStarHelper::PanCRxBeginSink, this).Bind(i));
+        panCPhy->TraceConnectWithoutContext(
+            "PhyRxEnd",
+            MakeCallback(&LrWpanLldnStarHelper::PanCRxEndSink, this).Bind(i));
+        panCPhy->TraceConnectWithoutContext(
+            "PhyRxDrop",
+            MakeCallback(&LrWpanLldnStarHelper::PanCRxDropSink, this).Bind(i));
+        for (const auto& device : m_stars[i].devices)
+        {
+            device->GetPhy()->TraceConnectWithoutContext(
+                "PhyTxBegin",
+                MakeCallback(&LrWpanLldnStarHelper::TxSink, this).Bind(i, true));
+        }
+    }
+}
+
+uint64_t
+LrWpanLldnStarHelper::GetUplinkFrames(uint32_t star) const
+{
+    NS_ASSERT_MSG(star < m_stars.size(), "No such star");
+    return m_stars[star].uplinkFrames;
+}
+
+uint64_t
+LrWpanLldnStarHelper::GetInterCellCollisions(uint32_t star) const
+{
+    NS_ASSERT_MSG(star < m_stars.size(), "No such star");
+    return m_stars[star].interCellCollisions;
+}
+
+double
+LrWpanLldnStarHelper::GetInterCellCollisionRate(uint32_t star) const
+{
+    NS_ASSERT_MSG(star < m_stars.size(), "No such star");
+    if (m_stars[star].uplinkFrames == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(m_stars[star].interCellCollisions) / m_stars[star].uplinkFrames;
+}
+
+double
+LrWpanLldnStarHelper::GetInterCellCollisionRate() const
+{
+    uint64_t uplinkFrames = 0;
+    uint64_t collisions = 0;
+    for (const auto& star : m_stars)
+    {
+        uplinkFrames += star.uplinkFrames;
+        collisions += star.interCellCollisions;
+    }
+    return (uplinkFrames > 0) ? static_cast<double>(collisions) / uplinkFrames : 0;
+}
+
+uint8_t
+LrWpanLldnStarHelper::ChooseChannel(Vector center) const
+{
+    uint8_t bestChannel = m_channels.front();
+    uint32_t bestCount = std::numeric_limits<uint32_t>::max();
+    double bestDistance = 0;
+    for (const auto& channel : m_channels)
+    {
+        uint32_t count = 0;
+        double distance = std::numeric_limits<double>::max();
+        for (const auto& star : m_stars)
+        {
+            if (star.channel == channel)
+            {
+                double d = CalculateDistance(center, star.center);
+                distance = std::min(distance, d);
+                if (d < m_channelRange)
+                {
+                    count++;
+                }
+            }
+        }
+        if (count < bestCount || (count == bestCount && distance > bestDistance))
+        {
+            bestChannel = channel;
+            bestCount = count;
+            bestDistance = distance;
+        }
+    }
+    return bestChannel;
+}
+
+uint32_t
+LrWpanLldnStarHelper::GetOtherStar(uint32_t star, Ptr<const Packet> p) const
+{
+    auto it = m_txStar.find(p->GetUid());
+    if (it == m_txStar.end() || m_stars[it->second].channel != m_stars[star].channel)
+    {
+        return star;
+    }
+    return it->second;
+}
+
+Time
+LrWpanLldnStarHelper::GetFrameDuration(uint32_t star, Ptr<const Packet> p) const
+{
+    // PPDU = SHR + PHR (1 octet) + PSDU
+    Ptr<LrWpanPhy> phy = m_stars[star].panC->GetPhy();
+    double symbols = phy->GetPhySHRDuration() + (1 + p->GetSize()) * phy->GetPhySymbolsPerOctet();
+    return Seconds(symbols / phy->GetDataOrSymbolRate(false));
+}
+
+void
+LrWpanLldnStarHelper::RecordOtherStarFrame(uint32_t star, Ptr<const Packet> p)
+{
+    // The frames are kept as long as they may overlap the frame being received.
+    Time now = Simulator::Now();
+    std::deque<std::pair<Time, Time>>& frames = m_stars[star].otherStarFrames;
+    while (!frames.empty() && frames.front().second < now - GetFrameDuration(star, p))
+    {
+        frames.pop_front();
+    }
+    frames.emplace_back(now, now + GetFrameDuration(star, p));
+}
+
+void
+LrWpanLldnStarHelper::TxSink(uint32_t star, bool isDevice, Ptr<const Packet> p)
+{
+    if (isDevice)
+    {
+        m_stars[star].uplinkFrames++;
+    }
+
+    // The frames are delivered to the receivers within a few milliseconds.
+    Time now = Simulator::Now();
+    while (!m_txTimes.empty() && m_txTimes.front().first < now - Seconds(1))
+    {
+        m_txStar.erase(m_txTimes.front().second);
+        m_txTimes.pop_front();
+    }
+    m_txStar[p->GetUid()] = star;
+    m_txTimes.emplace_back(now, p->GetUid());
+}
+
+void
+LrWpanLldnStarHelper::PanCRxBeginSink(uint32_t star, Ptr<const Packet> p)
+{
+    if (GetOtherStar(star, p) != star)
+    {
+        RecordOtherStarFrame(star, p);
+    }
+}
+
+void
+LrWpanLldnStarHelper::PanCRxEndSink(uint32_t star, Ptr<const Packet> p, double lqi)
+{
+    m_stars[star].lastRxEndUid = p->GetUid();
+    m_stars[star].lastRxEndTime = Simulator::Now();
+}
+
+void
+LrWpanLldnStarHelper::PanCRxDropSink(uint32_t star, Ptr<const Packet> p)
+{
+    Star& s = m_stars[star];
+    // A frame is dropped either when it reaches the PAN-C or at the end of its reception.
+    bool corrupted = (p->GetUid() == s.lastRxEndUid && Simulator::Now() == s.lastRxEndTime);
+    uint32_t otherStar = GetOtherStar(star, p);
+    if (otherStar != star)
+    {
+        if (!corrupted)
+        {
+            RecordOtherStarFrame(star, p);
+        }
+        return;
+    }
+
+    auto it = m_txStar.find(p->GetUid());
+    if (it != m_txStar.end() && it->second == star)
+    {
+        // The frame of a device is lost, check if a frame of another star overlapped it:
+        // during its reception if it was corrupted, when it reached the PAN-C otherwise.
+        Time now = Simulator::Now();
+        Time rxStart = corrupted ? now - GetFrameDuration(star, p) : now;
+        for (const auto& frame : s.otherStarFrames)
+        {
+            if (frame.first <= now && frame.second > rxStart)
+            {
+                s.interCellCollisions++;
+                break;
+            }
+        }
+    }
+}
+
+Vector
+LrWpanLldnStarHelper::GetDevicePosition(uint32_t index, uint32_t numDevices) const
+{
+    if (m_placement == RING)
+    {
+        double angle = 2 * M_PI * index / numDevices;
+        return Vector(m_center.x + m_distance * std::cos(angle),
+                      m_center.y + m_distance * std::sin(angle),
+                      m_center.z);
+    }
+
+    // The grid has room for the PAN-C and the devices, the cell at the center
+    // of the grid (if any) is left to the PAN-C.
+    uint32_t cols = static_cast<uint32_t>(std::ceil(std::sqrt(numDevices + 1)));
+    uint32_t rows = (numDevices + cols) / cols;
+    uint32_t cell = index;
+    if (cols % 2 == 1 && rows % 2 == 1 && cell >= (rows / 2) * cols + cols / 2)
+    {
+        cell++;
+    }
+    double col = cell % cols;
+    double row = cell / cols;
+    return Vector(m_center.x + (col - (cols - 1) / 2.0) * m_distance,
+                  m_center.y + (row - (rows - 1) / 2.0) * m_distance,
+                  m_center.z);
+}
+
+Ptr<LrWpanNetDevice>
+LrWpanLldnStarHelper::CreateDevice(Ptr<Node> node, Vector position)
+{
+    Ptr<LrWpanNetDevice> device = CreateObject<LrWpanNetDevice>();
+    device->SetAddress(Mac16Address::Allocate());
+    device->SetChannel(m_channel);
+    node->AddDevice(device);
+
+    Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(position);
+    node->AggregateObject(mobility);
+    device->GetPhy()->SetMobility(mobility);
+
+    return device;
+}
+
+} // namespace ns3
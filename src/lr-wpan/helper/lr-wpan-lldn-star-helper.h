@@ -0,0 +1,393 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LR_WPAN_LLDN_STAR_HELPER_H
+#define LR_WPAN_LLDN_STAR_HELPER_H
+
+#include <ns3/lr-wpan-mac.h>
+#include <ns3/net-device-container.h>
+#include <ns3/node-container.h>
+#include <ns3/nstime.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/vector.h>
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class LrWpanNetDevice;
+class SpectrumChannel;
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief Builds LLDN star networks: a PAN-C and its LLDN devices.
+ *
+ * Each call to Install creates the nodes of one star, places them around
+ * the PAN-C (on a ring or on a grid) and configures their LLDN MAC with a
+ * preassigned slot plan, so that the network can go straight to the Online
+ * state without the Discovery and Configuration states:
+ *
+ * - the PAN-C simple address is the identifier of the LLDN (1 by default), the
+ *   devices have the other simple addresses, in increasing order.
+ * - the superframe starts with the retransmission timeslots, followed by one
+ *   dedicated uplink base timeslot per device and by the shared group timeslots.
+ *
+ * The devices are configured through the MAC setters, without Config path
+ * lookups, so that large scenarios are built quickly. The PAN-Cs of all the
+ * installed stars switch to the Online state with Start.
+ *
+ * Several stars (cells) may be installed side by side. Each star operates on the
+ * channel of the channel plan with the fewest co-channel stars in range, the
+ * stars sharing a channel must have different LLDN identifiers. The frames of
+ * the stars lost because of the other stars are reported once EnableInterCellStats
+ * is called.
+ */
+class LrWpanLldnStarHelper
+{
+  public:
+    /**
+     * The placement of the devices around the PAN-C.
+     */
+    enum Placement
+    {
+        RING, //!< The devices are evenly spaced on a circle centered on the PAN-C
+        GRID  //!< The devices are on a square grid centered on the PAN-C
+    };
+
+    /**
+     * \brief Create a LLDN star helper with a SingleModelSpectrumChannel, a
+     * LogDistancePropagationLossModel and a ConstantSpeedPropagationDelayModel.
+     */
+    LrWpanLldnStarHelper();
+
+    /**
+     * \brief Create a LLDN star helper attaching the devices to an existing channel.
+     * \param channel the channel
+     */
+    LrWpanLldnStarHelper(Ptr<SpectrumChannel> channel);
+
+    ~LrWpanLldnStarHelper();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LrWpanLldnStarHelper(const LrWpanLldnStarHelper&) = delete;
+    LrWpanLldnStarHelper& operator=(const LrWpanLldnStarHelper&) = delete;
+
+    /**
+     * \brief Get the channel of the installed devices.
+     * \return the channel
+     */
+    Ptr<SpectrumChannel> GetChannel() const;
+
+    /**
+     * \brief Set the PAN ID of the next installed star (5 by default).
+     * \param panId the PAN ID
+     */
+    void SetPanId(uint16_t panId);
+
+    /**
+     * \brief Set the LLDN identifier of the next installed star (1 by default), which
+     * is the simple address of its PAN-C.
+     * \param networkId the LLDN identifier, in the range 0-254
+     */
+    void SetNetworkId(uint8_t networkId);
+
+    /**
+     * \brief Set the channels available to the stars (channel 11 by default).
+     *
+     * Each installed star gets the channel used by the fewest stars whose PAN-C
+     * is within range of its own PAN-C. Ties go to the channel whose nearest
+     * co-channel star is the farthest away, then to the first channel of the plan.
+     *
+     * \param channels the channel numbers
+     * \param range the distance below which two stars interfere, in meters
+     */
+    void SetChannelPlan(const std::vector<uint8_t>& channels, double range);
+
+    /**
+     * \brief Set the position of the PAN-C of the next installed star (the origin by default).
+     * \param center the position of the PAN-C
+     */
+    void SetCenter(Vector center);
+
+    /**
+     * \brief Set the placement of the devices (a ring of 10 m by default).
+     * \param placement the placement
+     * \param distance the radius of the ring or the spacing of the grid, in meters
+     */
+    void SetPlacement(Placement placement, double distance);
+
+    /**
+     * \brief Set the size of the base timeslots (40 octets by default).
+     * \param size the LL frame payload which fits in a base timeslot, in octets
+     */
+    void SetTimeslotSize(uint8_t size);
+
+    /**
+     * \brief Set the number of retransmission timeslots of the superframe (none by default).
+     * \param numTimeslots the number of retransmission timeslots
+     */
+    void SetNumRetransmitTimeslots(uint8_t numTimeslots);
+
+    /**
+     * \brief Set the number of shared group timeslots of the superframe (none by default).
+     * \param numTimeslots the number of shared group timeslots
+     */
+    void SetNumSharedGroupTimeslots(uint8_t numTimeslots);
+
+    /**
+     * \brief Duty-cycle the transceiver of the LLDN devices of the next stars, switched
+     * off outside the LL beacon and their timeslots (disabled by default).
+     * \param guardTime the time the transceiver is switched on ahead of them, which
+     * replaces the guard time set with SetGuardTime
+     * \see LrWpanMac::SetLLDNSleepEnabled
+     */
+    void EnableDeviceSleep(Time guardTime);
+
+    /**
+     * \brief Set the guard time of the timeslots of the LLDN devices of the next stars
+     * (500 us by default).
+     * \param guardTime the guard time
+     * \see LrWpanMac::SetLLDNGuardTime
+     */
+    void SetGuardTime(Time guardTime);
+
+    /**
+     * \brief Set the clock frequency offset of the LLDN devices of the next stars (perfect
+     * clocks by default).
+     * \param drift the random variable drawing the initial frequency offset of each
+     * device, in parts per million
+     * \param walk the standard deviation of the random walk of the frequency offset after
+     * one second, in parts per million
+     * \see LrWpanMac::SetLLDNClockDrift
+     * \see LrWpanMac::SetLLDNClockDriftWalk
+     */
+    void SetClockDrift(Ptr<RandomVariableStream> drift, double walk);
+
+    /**
+     * \brief Set the callback invoked when a PAN-C receives a frame.
+     * \param c the MCPS-DATA.indication callback
+     */
+    void SetPanCDataIndicationCallback(McpsDataIndicationCallback c);
+
+    /**
+     * \brief Set the callback invoked when a device ends the transmission of a MSDU.
+     * \param c the MCPS-DATA.confirm callback
+     */
+    void SetDeviceDataConfirmCallback(McpsDataConfirmCallback c);
+
+    /**
+     * \brief Create and configure a star of a PAN-C and its LLDN devices.
+     *
+     * The simple addresses and the 254 base timeslots of the superframe bound
+     * a star to 253 devices.
+     *
+     * \param numDevices the number of LLDN devices
+     * \return the net devices of the star, the PAN-C first
+     */
+    NetDeviceContainer Install(uint32_t numDevices);
+
+    /**
+     * \brief Get the PAN-Cs of the installed stars.
+     * \return the PAN-C net devices
+     */
+    NetDeviceContainer GetPanCs() const;
+
+    /**
+     * \brief Get the channel assigned to an installed star.
+     * \param star the index of the star, in installation order
+     * \return the channel number
+     */
+    uint8_t GetChannelNumber(uint32_t star) const;
+
+    /**
+     * \brief Get the nodes of all the installed stars.
+     * \return the nodes
+     */
+    NodeContainer GetNodes() const;
+
+    /**
+     * \brief Switch the PAN-Cs of all the installed stars to the Online state.
+     * \param startTime the time of the MLME-LLDN-ONLINE.request
+     */
+    void Start(Time startTime);
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by the installed devices.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this helper
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /**
+     * \brief Record the inter-cell collisions of the installed stars.
+     *
+     * An inter-cell collision is a frame of a device lost by its PAN-C while a
+     * frame of another star on the same channel was on the air at the PAN-C.
+     */
+    void EnableInterCellStats();
+
+    /**
+     * \brief Get the number of frames sent by the devices of a star.
+     * \param star the index of the star, in installation order
+     * \return the number of uplink frames
+     */
+    uint64_t GetUplinkFrames(uint32_t star) const;
+
+    /**
+     * \brief Get the number of inter-cell collisions at the PAN-C of a star.
+     * \param star the index of the star, in installation order
+     * \return the number of inter-cell collisions
+     */
+    uint64_t GetInterCellCollisions(uint32_t star) const;
+
+    /**
+     * \brief Get the inter-cell collisions per uplink frame of a star.
+     * \param star the index of the star, in installation order
+     * \return the inter-cell collision rate
+     */
+    double GetInterCellCollisionRate(uint32_t star) const;
+
+    /**
+     * \brief Get the inter-cell collisions per uplink frame of all the stars.
+     * \return the inter-cell collision rate
+     */
+    double GetInterCellCollisionRate() const;
+
+  private:
+    /**
+     * A star: a PAN-C, its LLDN devices and their inter-cell statistics.
+     */
+    struct Star
+    {
+        Ptr<LrWpanNetDevice> panC;                    //!< The PAN-C
+        std::vector<Ptr<LrWpanNetDevice>> devices;    //!< The LLDN devices
+        Vector center;                                //!< The position of the PAN-C
+        uint8_t channel{0};                           //!< The channel number
+        uint64_t uplinkFrames{0};                     //!< Frames sent by the devices
+        uint64_t interCellCollisions{0};              //!< Inter-cell collisions at the PAN-C
+        uint64_t lastRxEndUid{0};                     //!< Last frame received by the PAN-C
+        Time lastRxEndTime;                           //!< End of the last received frame
+        std::deque<std::pair<Time, Time>> otherStarFrames; //!< Start and end of the frames
+                                                           //!< of other stars at the PAN-C
+    };
+
+    /**
+     * Choose the channel of a new star from the channel plan.
+     * \param center the position of the PAN-C of the new star
+     * \return the channel number
+     */
+    uint8_t ChooseChannel(Vector center) const;
+
+    /**
+     * Get the star which sent a frame on the channel of another star.
+     * \param star the index of the receiving star
+     * \param p the frame
+     * \return the index of the sending star, or the receiving star if the frame
+     * was sent by one of its nodes, on another channel or is unknown
+     */
+    uint32_t GetOtherStar(uint32_t star, Ptr<const Packet> p) const;
+
+    /**
+     * Get the duration of a frame at the PAN-C of a star.
+     * \param star the index of the star
+     * \param p the frame
+     * \return the duration of the PPDU
+     */
+    Time GetFrameDuration(uint32_t star, Ptr<const Packet> p) const;
+
+    /**
+     * Record a frame of another star on the air at the PAN-C of a star.
+     * \param star the index of the star
+     * \param p the frame
+     */
+    void RecordOtherStarFrame(uint32_t star, Ptr<const Packet> p);
+
+    /**
+     * Trace sink of the frames sent by the nodes of a star.
+     * \param star the index of the star
+     * \param isDevice true if the frame is sent by a LLDN device
+     * \param p the frame
+     */
+    void TxSink(uint32_t star, bool isDevice, Ptr<const Packet> p);
+
+    /**
+     * Trace sink of the frames whose reception starts at the PAN-C of a star.
+     * \param star the index of the star
+     * \param p the frame
+     */
+    void PanCRxBeginSink(uint32_t star, Ptr<const Packet> p);
+
+    /**
+     * Trace sink of the frames whose reception ends at the PAN-C of a star.
+     * \param star the index of the star
+     * \param p the frame
+     * \param lqi the LQI of the frame
+     */
+    void PanCRxEndSink(uint32_t star, Ptr<const Packet> p, double lqi);
+
+    /**
+     * Trace sink of the frames dropped by the PAN-C of a star.
+     * \param star the index of the star
+     * \param p the frame
+     */
+    void PanCRxDropSink(uint32_t star, Ptr<const Packet> p);
+
+    /**
+     * Get the position of a device of the star.
+     * \param index the index of the device
+     * \param numDevices the number of devices of the star
+     * \return the position of the device
+     */
+    Vector GetDevicePosition(uint32_t index, uint32_t numDevices) const;
+
+    /**
+     * Install a net device attached to the channel on a node.
+     * \param node the node
+     * \param position the position of the node
+     * \return the net device
+     */
+    Ptr<LrWpanNetDevice> CreateDevice(Ptr<Node> node, Vector position);
+
+    Ptr<SpectrumChannel> m_channel;                  //!< The channel of the devices
+    uint16_t m_panId;                                //!< The PAN ID of the next star
+    uint8_t m_networkId;                             //!< The LLDN identifier of the next star
+    std::vector<uint8_t> m_channels;                 //!< The channel plan
+    double m_channelRange;                           //!< The co-channel interference range
+    Vector m_center;                                 //!< The PAN-C position of the next star
+    Placement m_placement;                           //!< The placement of the devices
+    double m_distance;                               //!< The ring radius or grid spacing
+    uint8_t m_timeslotSize;                          //!< The base timeslot size
+    uint8_t m_numRetransmitTS;                       //!< The retransmission timeslots
+    uint8_t m_numSharedGroupTS;                      //!< The shared group timeslots
+    bool m_deviceSleep;                              //!< Whether the devices are duty-cycled
+    Time m_guardTime;                                //!< The guard time of the timeslots
+    Ptr<RandomVariableStream> m_clockDrift;          //!< The initial clock frequency offset
+    double m_clockDriftWalk;                         //!< The clock frequency offset walk
+    McpsDataIndicationCallback m_panCDataIndication; //!< The PAN-C data indication callback
+    McpsDataConfirmCallback m_deviceDataConfirm;     //!< The device data confirm callback
+    std::vector<Star> m_stars;                       //!< The installed stars
+    NodeContainer m_nodes;                           //!< All the installed nodes
+    std::unordered_map<uint64_t, uint32_t> m_txStar; //!< The star of the recent frames (by UID)
+    std::deque<std::pair<Time, uint64_t>> m_txTimes; //!< The send time of the recent frames
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_LLDN_STAR_HELPER_H */
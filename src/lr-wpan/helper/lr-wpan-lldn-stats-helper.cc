@@ -0,0 +1,350 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "lr-wpan-lldn-stats-helper.h"
+
+#include <ns3/log.h>
+#include <ns3/lr-wpan-net-device.h>
+#include <ns3/node.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LrWpanLldnStatsHelper");
+
+/**
+ * Print the non-empty bins of a histogram of times in seconds.
+ * \param os the output stream
+ * \param histogram the histogram
+ */
+static void
+PrintHistogram(std::ostream& os, Histogram histogram)
+{
+    for (uint32_t i = 0; i < histogram.GetNBins(); i++)
+    {
+        if (histogram.GetBinCount(i) > 0)
+        {
+            os << "    [" << histogram.GetBinStart(i) * 1e3 << " ms, "
+               << histogram.GetBinEnd(i) * 1e3 << " ms): " << histogram.GetBinCount(i)
+               << std::endl;
+        }
+    }
+}
+
+LrWpanLldnStatsHelper::LrWpanLldnStatsHelper()
+    : m_binWidth(MicroSeconds(500))
+{
+}
+
+void
+LrWpanLldnStatsHelper::SetHistogramBinWidth(Time binWidth)
+{
+    NS_ASSERT_MSG(binWidth.IsStrictlyPositive(), "The bin width must be positive");
+    m_binWidth = binWidth;
+}
+
+void
+LrWpanLldnStatsHelper::Install(Ptr<LrWpanNetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+
+    uint32_t nodeId = device->GetNode()->GetId();
+    Ptr<LrWpanMac> mac = device->GetMac();
+    GetNodeStats(nodeId);
+
+    mac->TraceConnectWithoutContext(
+        "LLDNSuperframe",
+        MakeCallback(&LrWpanLldnStatsHelper::SuperframeSink, this).Bind(nodeId));
+    mac->TraceConnectWithoutContext(
+        "LLDNTimeslotOccupancy",
+        MakeCallback(&LrWpanLldnStatsHelper::TimeslotOccupancySink, this).Bind(nodeId));
+    mac->TraceConnectWithoutContext(
+        "LLDNTimeslotTx",
+        MakeCallback(&LrWpanLldnStatsHelper::TimeslotTxSink, this).Bind(nodeId));
+    mac->TraceConnectWithoutContext(
+        "LLDNGroupAckMiss",
+        MakeCallback(&LrWpanLldnStatsHelper::GroupAckMissSink, this).Bind(nodeId));
+    mac->TraceConnectWithoutContext(
+        "LLDNDataLatency",
+        MakeCallback(&LrWpanLldnStatsHelper::DataLatencySink, this).Bind(nodeId));
+    mac->TraceConnectWithoutContext(
+        "LLDNBeaconToData",
+        MakeCallback(&LrWpanLldnStatsHelper::BeaconToDataSink, this).Bind(nodeId));
+}
+
+void
+LrWpanLldnStatsHelper::Install(NetDeviceContainer devices)
+{
+    for (auto i = devices.Begin(); i != devices.End(); i++)
+    {
+        Ptr<LrWpanNetDevice> device = DynamicCast<LrWpanNetDevice>(*i);
+        NS_ASSERT_MSG(device, "Not a LrWpanNetDevice");
+        Install(device);
+    }
+}
+
+Histogram
+LrWpanLldnStatsHelper::GetLatencyHistogram(uint32_t nodeId) const
+{
+    auto it = m_nodeStats.find(nodeId);
+    if (it == m_nodeStats.end())
+    {
+        return Histogram(m_binWidth.GetSeconds());
+    }
+    return it->second.latency;
+}
+
+Histogram
+LrWpanLldnStatsHelper::GetBeaconToDataHistogram(Mac8Address srcAddress) const
+{
+    auto it = m_beaconToData.find(srcAddress);
+    if (it == m_beaconToData.end())
+    {
+        return Histogram(m_binWidth.GetSeconds());
+    }
+    return it->second;
+}
+
+double
+LrWpanLldnStatsHelper::GetTimeslotUtilization() const
+{
+    uint64_t observed = 0;
+    uint64_t occupied = 0;
+    for (uint32_t i = 0; i < m_timeslotObserved.size(); i++)
+    {
+        observed += m_timeslotObserved[i];
+        occupied += m_timeslotOccupied[i];
+    }
+    return (observed > 0) ? static_cast<double>(occupied) / observed : 0;
+}
+
+double
+LrWpanLldnStatsHelper::GetTimeslotUtilization(uint8_t baseTimeslot) const
+{
+    if (baseTimeslot >= m_timeslotObserved.size() || m_timeslotObserved[baseTimeslot] == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(m_timeslotOccupied[baseTimeslot]) /
+           m_timeslotObserved[baseTimeslot];
+}
+
+double
+LrWpanLldnStatsHelper::GetRetransmissionRatio() const
+{
+    uint64_t txFrames = 0;
+    uint64_t retransmissions = 0;
+    for (const auto& stats : m_nodeStats)
+    {
+        txFrames += stats.second.txFrames;
+        retransmissions += stats.second.retransmissions;
+    }
+    return (txFrames > 0) ? static_cast<double>(retransmissions) / txFrames : 0;
+}
+
+double
+LrWpanLldnStatsHelper::GetRetransmissionRatio(uint32_t nodeId) const
+{
+    auto it = m_nodeStats.find(nodeId);
+    if (it == m_nodeStats.end() || it->second.txFrames == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(it->second.retransmissions) / it->second.txFrames;
+}
+
+uint32_t
+LrWpanLldnStatsHelper::GetGroupAckMisses() const
+{
+    uint32_t misses = 0;
+    for (const auto& stats : m_nodeStats)
+    {
+        misses += stats.second.groupAckMisses;
+    }
+    return misses;
+}
+
+uint32_t
+LrWpanLldnStatsHelper::GetSharedTimeslotAttempts(uint8_t baseTimeslot) const
+{
+    auto it = m_sharedTimeslots.find(baseTimeslot);
+    return (it == m_sharedTimeslots.end()) ? 0 : it->second.attempts;
+}
+
+uint32_t
+LrWpanLldnStatsHelper::GetSharedTimeslotCollisions(uint8_t baseTimeslot) const
+{
+    auto it = m_sharedTimeslots.find(baseTimeslot);
+    return (it == m_sharedTimeslots.end()) ? 0 : it->second.collisions;
+}
+
+uint32_t
+LrWpanLldnStatsHelper::GetNumSuperframes(uint32_t nodeId) const
+{
+    auto it = m_nodeStats.find(nodeId);
+    return (it == m_nodeStats.end()) ? 0 : it->second.superframes;
+}
+
+Time
+LrWpanLldnStatsHelper::GetMeanSuperframeDuration(uint32_t nodeId) const
+{
+    auto it = m_nodeStats.find(nodeId);
+    if (it == m_nodeStats.end() || it->second.superframes == 0)
+    {
+        return Time(0);
+    }
+    return it->second.superframeSum / it->second.superframes;
+}
+
+void
+LrWpanLldnStatsHelper::Print(std::ostream& os) const
+{
+    os << "LLDN timeslot utilization: " << GetTimeslotUtilization() * 100 << " %" << std::endl;
+    for (uint32_t i = 0; i < m_timeslotObserved.size(); i++)
+    {
+        if (m_timeslotObserved[i] > 0)
+        {
+            os << "  base timeslot " << i << ": " << GetTimeslotUtilization(i) * 100 << " %"
+               << std::endl;
+        }
+    }
+    os << "LLDN retransmission ratio: " << GetRetransmissionRatio() * 100 << " %" << std::endl;
+    os << "LLDN group acknowledgement misses: " << GetGroupAckMisses() << std::endl;
+    for (const auto& shared : m_sharedTimeslots)
+    {
+        os << "  shared group timeslot " << static_cast<uint32_t>(shared.first) << ": "
+           << shared.second.attempts << " frames sent, " << shared.second.collisions
+           << " collisions" << std::endl;
+    }
+
+    for (const auto& stats : m_nodeStats)
+    {
+        const NodeStats& node = stats.second;
+        os << "Node " << stats.first << ": " << node.superframes << " superframes";
+        if (node.superframes > 0)
+        {
+            os << " (mean " << GetMeanSuperframeDuration(stats.first).As(Time::MS) << ")";
+        }
+        os << ", " << node.txFrames << " frames sent, " << node.retransmissions
+           << " retransmissions, " << node.groupAckMisses << " group ack misses" << std::endl;
+
+        Histogram latency = node.latency;
+        uint32_t delivered = 0;
+        for (uint32_t i = 0; i < latency.GetNBins(); i++)
+        {
+            delivered += latency.GetBinCount(i);
+        }
+        if (delivered > 0)
+        {
+            os << "  latency of the " << delivered << " delivered frames (mean "
+               << (node.latencySum / delivered).As(Time::MS) << "):" << std::endl;
+            PrintHistogram(os, latency);
+        }
+    }
+
+    for (const auto& delays : m_beaconToData)
+    {
+        os << "Beacon to LL-DATA delay from " << delays.first << ":" << std::endl;
+        PrintHistogram(os, delays.second);
+    }
+}
+
+LrWpanLldnStatsHelper::NodeStats&
+LrWpanLldnStatsHelper::GetNodeStats(uint32_t nodeId)
+{
+    auto it = m_nodeStats.find(nodeId);
+    if (it == m_nodeStats.end())
+    {
+        it = m_nodeStats.emplace(nodeId, NodeStats()).first;
+        it->second.latency = Histogram(m_binWidth.GetSeconds());
+    }
+    return it->second;
+}
+
+void
+LrWpanLldnStatsHelper::SuperframeSink(uint32_t nodeId, Time duration)
+{
+    NodeStats& stats = GetNodeStats(nodeId);
+    stats.superframes++;
+    stats.superframeSum += duration;
+}
+
+void
+LrWpanLldnStatsHelper::TimeslotOccupancySink(uint32_t nodeId, uint8_t baseTimeslot, bool occupied)
+{
+    if (baseTimeslot >= m_timeslotObserved.size())
+    {
+        m_timeslotObserved.resize(baseTimeslot + 1, 0);
+        m_timeslotOccupied.resize(baseTimeslot + 1, 0);
+    }
+    m_timeslotObserved[baseTimeslot]++;
+    if (occupied)
+    {
+        m_timeslotOccupied[baseTimeslot]++;
+    }
+}
+
+void
+LrWpanLldnStatsHelper::TimeslotTxSink(uint32_t nodeId,
+                                      uint8_t baseTimeslot,
+                                      LLDNTimeslotType type,
+                                      uint8_t retransmission)
+{
+    NodeStats& stats = GetNodeStats(nodeId);
+    stats.txFrames++;
+    if (type == LLDN_TS_SHARED)
+    {
+        m_sharedTimeslots[baseTimeslot].attempts++;
+    }
+    if (retransmission > 0)
+    {
+        stats.retransmissions++;
+    }
+}
+
+void
+LrWpanLldnStatsHelper::GroupAckMissSink(uint32_t nodeId,
+                                        uint8_t baseTimeslot,
+                                        uint8_t retransmission)
+{
+    GetNodeStats(nodeId).groupAckMisses++;
+
+    // The shared group timeslots are known from the frames sent in them.
+    auto it = m_sharedTimeslots.find(baseTimeslot);
+    if (it != m_sharedTimeslots.end())
+    {
+        it->second.collisions++;
+    }
+}
+
+void
+LrWpanLldnStatsHelper::DataLatencySink(uint32_t nodeId, Ptr<const Packet> packet, Time latency)
+{
+    NodeStats& stats = GetNodeStats(nodeId);
+    stats.latency.AddValue(latency.GetSeconds());
+    stats.latencySum += latency;
+}
+
+void
+LrWpanLldnStatsHelper::BeaconToDataSink(uint32_t nodeId, Mac8Address srcAddress, Time delay)
+{
+    auto it = m_beaconToData.find(srcAddress);
+    if (it == m_beaconToData.end())
+    {
+        it = m_beaconToData.emplace(srcAddress, Histogram(m_binWidth.GetSeconds())).first;
+    }
+    it->second.AddValue(delay.GetSeconds());
+}
+
+} // namespace ns3
@@ -0,0 +1,263 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LR_WPAN_LLDN_STATS_HELPER_H
+#define LR_WPAN_LLDN_STATS_HELPER_H
+
+#include <ns3/histogram.h>
+#include <ns3/lr-wpan-mac.h>
+#include <ns3/mac8-address.h>
+#include <ns3/net-device-container.h>
+#include <ns3/nstime.h>
+
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+
+class LrWpanNetDevice;
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief Collects the LLDN statistics of a set of IEEE 802.15.4 NetDevices.
+ *
+ * The helper connects to the LLDN trace sources of the MAC of each installed
+ * device and aggregates them:
+ *
+ * - the histogram of the latency of the frames delivered by each device, from
+ *   their enqueue to the end of their successful transmission,
+ * - the histogram of the delay between the LL beacon and the LL-DATA frames
+ *   received by the PAN-C, for each sender,
+ * - the utilization of the uplink base timeslots, seen by the PAN-C,
+ * - the ratio of retransmitted frames and the group acknowledgement misses,
+ * - the attempts and the collisions in each shared group timeslot,
+ * - the number and the mean duration of the LLDN superframes.
+ *
+ * The statistics are kept by the helper, which must outlive the simulation;
+ * they can be dumped at the end of a run with Print.
+ */
+class LrWpanLldnStatsHelper
+{
+  public:
+    /**
+     * \brief Create a LLDN statistics helper with 500 us histogram bins.
+     */
+    LrWpanLldnStatsHelper();
+
+    // Delete copy constructor and assignment operator, the trace sinks are bound to the helper
+    LrWpanLldnStatsHelper(const LrWpanLldnStatsHelper&) = delete;
+    LrWpanLldnStatsHelper& operator=(const LrWpanLldnStatsHelper&) = delete;
+
+    /**
+     * \brief Set the width of the bins of the latency histograms.
+     *
+     * Only the histograms created after this call use the new width.
+     *
+     * \param binWidth the bin width
+     */
+    void SetHistogramBinWidth(Time binWidth);
+
+    /**
+     * \brief Collect the LLDN statistics of a device.
+     * \param device the device
+     */
+    void Install(Ptr<LrWpanNetDevice> device);
+
+    /**
+     * \brief Collect the LLDN statistics of a set of devices.
+     * \param devices the devices, all of them must be LrWpanNetDevices
+     */
+    void Install(NetDeviceContainer devices);
+
+    /**
+     * \brief Get the latency histogram of the frames delivered by a node, in seconds.
+     * \param nodeId the node ID
+     * \return the latency histogram
+     */
+    Histogram GetLatencyHistogram(uint32_t nodeId) const;
+
+    /**
+     * \brief Get the histogram of the delay between the LL beacon and the LL-DATA frames
+     * received by the PAN-C from a device, in seconds.
+     * \param srcAddress the simple address of the device
+     * \return the beacon to data delay histogram
+     */
+    Histogram GetBeaconToDataHistogram(Mac8Address srcAddress) const;
+
+    /**
+     * \brief Get the fraction of the observed uplink base timeslots in which
+     * the PAN-C received a frame.
+     * \return the timeslot utilization, between 0 and 1
+     */
+    double GetTimeslotUtilization() const;
+
+    /**
+     * \brief Get the fraction of the LLDN superframes in which the PAN-C received
+     * a frame in a base timeslot.
+     * \param baseTimeslot the base timeslot number
+     * \return the timeslot utilization, between 0 and 1
+     */
+    double GetTimeslotUtilization(uint8_t baseTimeslot) const;
+
+    /**
+     * \brief Get the fraction of the frames sent in a base timeslot which were retransmissions.
+     * \return the retransmission ratio, between 0 and 1
+     */
+    double GetRetransmissionRatio() const;
+
+    /**
+     * \brief Get the fraction of the frames sent in a base timeslot by a node which
+     * were retransmissions.
+     * \param nodeId the node ID
+     * \return the retransmission ratio, between 0 and 1
+     */
+    double GetRetransmissionRatio(uint32_t nodeId) const;
+
+    /**
+     * \brief Get the number of frames not acknowledged in the group acknowledgement.
+     * \return the number of group acknowledgement misses
+     */
+    uint32_t GetGroupAckMisses() const;
+
+    /**
+     * \brief Get the number of frames sent in a shared group timeslot.
+     * \param baseTimeslot the base timeslot number
+     * \return the number of frames sent
+     */
+    uint32_t GetSharedTimeslotAttempts(uint8_t baseTimeslot) const;
+
+    /**
+     * \brief Get the number of frames sent in a shared group timeslot and not acknowledged
+     * in the group acknowledgement, most likely because of a collision.
+     * \param baseTimeslot the base timeslot number
+     * \return the number of collided frames
+     */
+    uint32_t GetSharedTimeslotCollisions(uint8_t baseTimeslot) const;
+
+    /**
+     * \brief Get the number of LLDN superframes started by a node.
+     * \param nodeId the node ID
+     * \return the number of LLDN superframes
+     */
+    uint32_t GetNumSuperframes(uint32_t nodeId) const;
+
+    /**
+     * \brief Get the mean duration of the LLDN superframes started by a node.
+     * \param nodeId the node ID
+     * \return the mean LLDN superframe duration
+     */
+    Time GetMeanSuperframeDuration(uint32_t nodeId) const;
+
+    /**
+     * \brief Print the collected statistics.
+     * \param os the output stream
+     */
+    void Print(std::ostream& os) const;
+
+  private:
+    /**
+     * The LLDN statistics of a node.
+     */
+    struct NodeStats
+    {
+        Histogram latency;           //!< The latency of the delivered frames, in seconds
+        Time latencySum;             //!< The sum of the latencies of the delivered frames
+        uint32_t txFrames{0};        //!< The frames sent in a base timeslot
+        uint32_t retransmissions{0}; //!< The retransmitted frames sent in a base timeslot
+        uint32_t groupAckMisses{0};  //!< The frames not acknowledged in the group ack
+        uint32_t superframes{0};     //!< The LLDN superframes started
+        Time superframeSum;          //!< The sum of the durations of the LLDN superframes
+    };
+
+    /**
+     * The contention statistics of a shared group timeslot.
+     */
+    struct SharedTimeslotStats
+    {
+        uint32_t attempts{0};   //!< The frames sent in the shared group timeslot
+        uint32_t collisions{0}; //!< The frames not acknowledged in the group ack
+    };
+
+    /**
+     * Get the statistics of a node, creating them if needed.
+     * \param nodeId the node ID
+     * \return the statistics of the node
+     */
+    NodeStats& GetNodeStats(uint32_t nodeId);
+
+    /**
+     * Trace sink for the LLDNSuperframe trace source.
+     * \param nodeId the node ID
+     * \param duration the LLDN superframe duration
+     */
+    void SuperframeSink(uint32_t nodeId, Time duration);
+
+    /**
+     * Trace sink for the LLDNTimeslotOccupancy trace source.
+     * \param nodeId the node ID
+     * \param baseTimeslot the base timeslot number
+     * \param occupied true if a frame was received in the base timeslot
+     */
+    void TimeslotOccupancySink(uint32_t nodeId, uint8_t baseTimeslot, bool occupied);
+
+    /**
+     * Trace sink for the LLDNTimeslotTx trace source.
+     * \param nodeId the node ID
+     * \param baseTimeslot the base timeslot number
+     * \param type the type of the base timeslot
+     * \param retransmission the number of previous attempts of the frame
+     */
+    void TimeslotTxSink(uint32_t nodeId,
+                        uint8_t baseTimeslot,
+                        LLDNTimeslotType type,
+                        uint8_t retransmission);
+
+    /**
+     * Trace sink for the LLDNGroupAckMiss trace source.
+     * \param nodeId the node ID
+     * \param baseTimeslot the base timeslot in which the frame was sent
+     * \param retransmission the number of previous attempts of the frame
+     */
+    void GroupAckMissSink(uint32_t nodeId, uint8_t baseTimeslot, uint8_t retransmission);
+
+    /**
+     * Trace sink for the LLDNDataLatency trace source.
+     * \param nodeId the node ID
+     * \param packet the delivered packet
+     * \param latency the latency of the packet
+     */
+    void DataLatencySink(uint32_t nodeId, Ptr<const Packet> packet, Time latency);
+
+    /**
+     * Trace sink for the LLDNBeaconToData trace source.
+     * \param nodeId the node ID
+     * \param srcAddress the simple address of the sender
+     * \param delay the delay between the LL beacon and the frame
+     */
+    void BeaconToDataSink(uint32_t nodeId, Mac8Address srcAddress, Time delay);
+
+    Time m_binWidth;                                 //!< The bin width of the histograms
+    std::map<uint32_t, NodeStats> m_nodeStats;       //!< The statistics of each node
+    std::map<Mac8Address, Histogram> m_beaconToData; //!< The beacon to data delay of each sender
+    std::vector<uint32_t> m_timeslotObserved; //!< The superframes observed in each base timeslot
+    std::vector<uint32_t> m_timeslotOccupied; //!< The superframes with a frame in each timeslot
+    std::map<uint8_t, SharedTimeslotStats> m_sharedTimeslots; //!< The shared group timeslots
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_LLDN_STATS_HELPER_H */
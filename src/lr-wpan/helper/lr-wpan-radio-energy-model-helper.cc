@@ -0,0 +1,86 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "lr-wpan-radio-energy-model-helper.h"
+
+#include <ns3/log.h>
+#include <ns3/lr-wpan-net-device.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LrWpanRadioEnergyModelHelper");
+
+LrWpanRadioEnergyModelHelper::LrWpanRadioEnergyModelHelper()
+{
+    m_radioEnergy.SetTypeId("ns3::LrWpanRadioEnergyModel");
+}
+
+LrWpanRadioEnergyModelHelper::~LrWpanRadioEnergyModelHelper()
+{
+}
+
+void
+LrWpanRadioEnergyModelHelper::Set(std::string name, const AttributeValue& v)
+{
+    m_radioEnergy.Set(name, v);
+}
+
+void
+LrWpanRadioEnergyModelHelper::SetDepletionCallback(
+    LrWpanRadioEnergyModel::LrWpanRadioEnergyDepletionCallback callback)
+{
+    m_depletionCallback = callback;
+}
+
+void
+LrWpanRadioEnergyModelHelper::SetRechargedCallback(
+    LrWpanRadioEnergyModel::LrWpanRadioEnergyRechargedCallback callback)
+{
+    m_rechargedCallback = callback;
+}
+
+void
+LrWpanRadioEnergyModelHelper::SetTxCurrentA(int8_t txPower, double txCurrentA)
+{
+    m_txCurrentsA[txPower] = txCurrentA;
+}
+
+Ptr<DeviceEnergyModel>
+LrWpanRadioEnergyModelHelper::DoInstall(Ptr<NetDevice> device, Ptr<EnergySource> source) const
+{
+    NS_ASSERT(device);
+    NS_ASSERT(source);
+    Ptr<LrWpanNetDevice> lrWpanDevice = DynamicCast<LrWpanNetDevice>(device);
+    if (!lrWpanDevice)
+    {
+        NS_FATAL_ERROR("NetDevice type is not LrWpanNetDevice!");
+    }
+
+    Ptr<LrWpanRadioEnergyModel> model = m_radioEnergy.Create<LrWpanRadioEnergyModel>();
+    NS_ASSERT(model);
+    model->SetEnergyDepletionCallback(m_depletionCallback);
+    model->SetEnergyRechargedCallback(m_rechargedCallback);
+    for (const auto& txCurrent : m_txCurrentsA)
+    {
+        model->SetTxCurrentA(txCurrent.first, txCurrent.second);
+    }
+
+    source->AppendDeviceEnergyModel(model);
+    model->SetEnergySource(source);
+    model->AttachPhy(lrWpanDevice->GetPhy());
+    return model;
+}
+
+} // namespace ns3
@@ -0,0 +1,86 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LR_WPAN_RADIO_ENERGY_MODEL_HELPER_H
+#define LR_WPAN_RADIO_ENERGY_MODEL_HELPER_H
+
+#include <ns3/energy-model-helper.h>
+#include <ns3/lr-wpan-radio-energy-model.h>
+
+#include <map>
+
+namespace ns3
+{
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief Install a LrWpanRadioEnergyModel on LrWpanNetDevice objects.
+ *
+ * The models of a whole network are installed with
+ * DeviceEnergyModelHelper::Install(NetDeviceContainer, EnergySourceContainer).
+ */
+class LrWpanRadioEnergyModelHelper : public DeviceEnergyModelHelper
+{
+  public:
+    LrWpanRadioEnergyModelHelper();
+    ~LrWpanRadioEnergyModelHelper() override;
+
+    /**
+     * Set an attribute of the LrWpanRadioEnergyModel objects.
+     * \param name the name of the attribute to set
+     * \param v the value of the attribute
+     */
+    void Set(std::string name, const AttributeValue& v) override;
+
+    /**
+     * \param callback the callback invoked when the energy source is depleted
+     */
+    void SetDepletionCallback(
+        LrWpanRadioEnergyModel::LrWpanRadioEnergyDepletionCallback callback);
+
+    /**
+     * \param callback the callback invoked when the energy source is recharged
+     */
+    void SetRechargedCallback(
+        LrWpanRadioEnergyModel::LrWpanRadioEnergyRechargedCallback callback);
+
+    /**
+     * Set the transmit current at a transmit power on the installed models.
+     * \param txPower the nominal transmit power, in dBm
+     * \param txCurrentA the transmit current, in A
+     * \see LrWpanRadioEnergyModel::SetTxCurrentA
+     */
+    void SetTxCurrentA(int8_t txPower, double txCurrentA);
+
+  private:
+    /**
+     * \param device the LrWpanNetDevice to install the model on
+     * \param source the energy source of the model
+     * \return the installed LrWpanRadioEnergyModel
+     */
+    Ptr<DeviceEnergyModel> DoInstall(Ptr<NetDevice> device,
+                                     Ptr<EnergySource> source) const override;
+
+    ObjectFactory m_radioEnergy; //!< The LrWpanRadioEnergyModel factory
+    LrWpanRadioEnergyModel::LrWpanRadioEnergyDepletionCallback
+        m_depletionCallback; //!< The energy depletion callback
+    LrWpanRadioEnergyModel::LrWpanRadioEnergyRechargedCallback
+        m_rechargedCallback;                //!< The energy recharged callback
+    std::map<int8_t, double> m_txCurrentsA; //!< The transmit current by transmit power
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_RADIO_ENERGY_MODEL_HELPER_H */
@@ -194,11 +194,9 @@ LrWpanCsmaCa::GetTimeToNextSlot() const
 
     Time elapsedSuperframe; // (i.e  The beacon + the elapsed CAP)
     Time currentTime = Simulator::Now();
-    double symbolsToBoundary;
+    uint64_t symbolsToBoundary;
     Time nextBoundary;
     uint64_t elapsedSuperframeSymbols;
-    uint64_t symbolRate =
-        (uint64_t)m_mac->GetPhy()->GetDataOrSymbolRate(false); // symbols per second
     Time timeAtBoundary;
 
     if (m_coorDest)
@@ -206,10 +204,10 @@ LrWpanCsmaCa::GetTimeToNextSlot() const
         // Take the Incoming Frame Reference
         elapsedSuperframe = currentTime - m_mac->m_macBeaconRxTime;
 
-        Time beaconTime [[maybe_unused]] = Seconds((double)m_mac->m_rxBeaconSymbols / symbolRate);
+        Time beaconTime [[maybe_unused]] = m_mac->GetSymbolsTime(m_mac->m_rxBeaconSymbols);
         Time elapsedCap [[maybe_unused]] = elapsedSuperframe - beaconTime;
-        NS_LOG_DEBUG("Elapsed incoming CAP symbols: " << (elapsedCap.GetSeconds() * symbolRate)
-                                                      << " (" << elapsedCap.As(Time::S) << ")");
+        NS_LOG_DEBUG("Elapsed incoming CAP symbols: " << m_mac->GetTimeSymbols(elapsedCap) << " ("
+                                                      << elapsedCap.As(Time::S) << ")");
     }
     else
     {
@@ -218,11 +216,10 @@ LrWpanCsmaCa::GetTimeToNextSlot() const
     }
 
     // get a close value to the the boundary in symbols
-    elapsedSuperframeSymbols = elapsedSuperframe.GetSeconds() * symbolRate;
-    symbolsToBoundary =
-        m_aUnitBackoffPeriod - std::fmod((double)elapsedSuperframeSymbols, m_aUnitBackoffPeriod);
+    elapsedSuperframeSymbols = m_mac->GetTimeSymbols(elapsedSuperframe);
+    symbolsToBoundary = m_aUnitBackoffPeriod - (elapsedSuperframeSymbols % m_aUnitBackoffPeriod);
 
-    timeAtBoundary = Seconds((double)(elapsedSuperframeSymbols + symbolsToBoundary) / symbolRate);
+    timeAtBoundary = m_mac->GetSymbolsTime(elapsedSuperframeSymbols + symbolsToBoundary);
 
     // get the exact time boundary
     nextBoundary = timeAtBoundary - elapsedSuperframe;
@@ -231,7 +228,7 @@ LrWpanCsmaCa::GetTimeToNextSlot() const
                                                 << elapsedSuperframe.As(Time::S) << ")");
 
     NS_LOG_DEBUG("Next backoff period boundary in approx. "
-                 << nextBoundary.GetSeconds() * symbolRate << " symbols ("
+                 << m_mac->GetTimeSymbols(nextBoundary) << " symbols ("
                  << nextBoundary.As(Time::S) << ")");
 
     return nextBoundary;
@@ -295,11 +292,8 @@ LrWpanCsmaCa::RandomBackoffDelay()
 
     uint64_t upperBound = (uint64_t)pow(2, m_BE) - 1;
     Time randomBackoff;
-    uint64_t symbolRate;
     Time timeLeftInCap;
 
-    symbolRate = (uint64_t)m_mac->GetPhy()->GetDataOrSymbolRate(false); // symbols per second
-
     // We should not recalculate the random backoffPeriods if we are in a slotted CSMA-CA and the
     // transmission was previously deferred (m_randomBackoffPeriods != 0)
     if (m_randomBackoffPeriodsLeft == 0 || IsUnSlottedCsmaCa())
@@ -307,8 +301,7 @@ LrWpanCsmaCa::RandomBackoffDelay()
         m_randomBackoffPeriodsLeft = (uint64_t)m_random->GetValue(0, upperBound + 1);
     }
 
-    randomBackoff =
-        Seconds((double)(m_randomBackoffPeriodsLeft * GetUnitBackoffPeriod()) / symbolRate);
+    randomBackoff = m_mac->GetSymbolsTime(m_randomBackoffPeriodsLeft * GetUnitBackoffPeriod());
 
     if (IsUnSlottedCsmaCa())
     {
@@ -326,18 +319,17 @@ LrWpanCsmaCa::RandomBackoffDelay()
 
         NS_LOG_DEBUG("Slotted CSMA-CA: proceeding after random backoff of "
                      << m_randomBackoffPeriodsLeft << " periods ("
-                     << (randomBackoff.GetSeconds() * symbolRate) << " symbols or "
+                     << m_mac->GetTimeSymbols(randomBackoff) << " symbols or "
                      << randomBackoff.As(Time::S) << ")");
 
         NS_LOG_DEBUG("Backoff periods left in CAP: "
-                     << ((timeLeftInCap.GetSeconds() * symbolRate) / m_aUnitBackoffPeriod) << " ("
-                     << (timeLeftInCap.GetSeconds() * symbolRate) << " symbols or "
+                     << (m_mac->GetTimeSymbols(timeLeftInCap) / m_aUnitBackoffPeriod) << " ("
+                     << m_mac->GetTimeSymbols(timeLeftInCap) << " symbols or "
                      << timeLeftInCap.As(Time::S) << ")");
 
         if (randomBackoff >= timeLeftInCap)
         {
-            uint64_t usedBackoffs =
-                (double)(timeLeftInCap.GetSeconds() * symbolRate) / m_aUnitBackoffPeriod;
+            uint64_t usedBackoffs = m_mac->GetTimeSymbols(timeLeftInCap) / m_aUnitBackoffPeriod;
             m_randomBackoffPeriodsLeft -= usedBackoffs;
             NS_LOG_DEBUG("No time in CAP to complete backoff delay, deferring to the next CAP");
             m_endCapEvent =
@@ -357,24 +349,22 @@ LrWpanCsmaCa::GetTimeLeftInCap()
     uint64_t capSymbols;
     Time endCapTime;
     uint64_t activeSlot;
-    uint64_t symbolRate;
     Time rxBeaconTime;
 
     // At this point, the currentTime should be aligned on a backoff period boundary
     currentTime = Simulator::Now();
-    symbolRate = (uint64_t)m_mac->GetPhy()->GetDataOrSymbolRate(false); // symbols per second
 
     if (m_coorDest)
     { // Take Incoming frame reference
         activeSlot = m_mac->m_incomingSuperframeDuration / 16;
         capSymbols = activeSlot * (m_mac->m_incomingFnlCapSlot + 1);
-        endCapTime = m_mac->m_macBeaconRxTime + Seconds((double)capSymbols / symbolRate);
+        endCapTime = m_mac->m_macBeaconRxTime + m_mac->GetSymbolsTime(capSymbols);
     }
     else
     { // Take Outgoing frame reference
         activeSlot = m_mac->m_superframeDuration / 16;
         capSymbols = activeSlot * (m_mac->m_fnlCapSlot + 1);
-        endCapTime = m_mac->m_macBeaconTxTime + Seconds((double)capSymbols / symbolRate);
+        endCapTime = m_mac->m_macBeaconTxTime + m_mac->GetSymbolsTime(capSymbols);
     }
 
     return (endCapTime - currentTime);
@@ -389,11 +379,9 @@ LrWpanCsmaCa::CanProceed()
     uint16_t ccaSymbols;
     uint32_t transactionSymbols;
     Time transactionTime;
-    uint64_t symbolRate;
 
     ccaSymbols = 0;
     m_randomBackoffPeriodsLeft = 0;
-    symbolRate = (uint64_t)m_mac->GetPhy()->GetDataOrSymbolRate(false);
     timeLeftInCap = GetTimeLeftInCap();
 
     // TODO: On the 950 Mhz Band (Japanese Band)
@@ -434,7 +422,7 @@ LrWpanCsmaCa::CanProceed()
         m_lrWpanMacTransCostCallback(transactionSymbols);
     }
 
-    transactionTime = Seconds((double)transactionSymbols / symbolRate);
+    transactionTime = m_mac->GetSymbolsTime(transactionSymbols);
     NS_LOG_DEBUG("Total required transaction: " << transactionSymbols << " symbols ("
                                                 << transactionTime.As(Time::S) << ")");
 
@@ -444,7 +432,7 @@ LrWpanCsmaCa::CanProceed()
                      << transactionSymbols << " symbols "
                      << "cannot be completed in CAP, deferring transmission to the next CAP");
 
-        NS_LOG_DEBUG("Symbols left in CAP: " << (timeLeftInCap.GetSeconds() * symbolRate) << " ("
+        NS_LOG_DEBUG("Symbols left in CAP: " << m_mac->GetTimeSymbols(timeLeftInCap) << " ("
                                              << timeLeftInCap.As(Time::S) << ")");
 
         m_endCapEvent = Simulator::Schedule(timeLeftInCap, &LrWpanCsmaCa::DeferCsmaTimeout, this);
@@ -18,9 +18,11 @@
  */
 #include "lr-wpan-error-model.h"
 
+#include <ns3/boolean.h>
 #include <ns3/log.h>
 
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -35,11 +37,18 @@ LrWpanErrorModel::GetTypeId()
     static TypeId tid = TypeId("ns3::LrWpanErrorModel")
                             .SetParent<Object>()
                             .SetGroupName("LrWpan")
-                            .AddConstructor<LrWpanErrorModel>();
+                            .AddConstructor<LrWpanErrorModel>()
+                            .AddAttribute("Tabulated",
+                                          "Interpolate the BER from a precalculated table "
+                                          "instead of evaluating the closed form expression.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&LrWpanErrorModel::m_tabulated),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 LrWpanErrorModel::LrWpanErrorModel()
+    : m_tabulated(false)
 {
     m_binomialCoefficients[0] = 1;
     m_binomialCoefficients[1] = -16;
@@ -62,6 +71,15 @@ LrWpanErrorModel::LrWpanErrorModel()
 
 double
 LrWpanErrorModel::GetChunkSuccessRate(double snr, uint32_t nbits) const
+{
+    double ber = m_tabulated ? GetTabulatedBer(snr) : GetBer(snr);
+
+    double retval = pow(1.0 - ber, nbits);
+    return retval;
+}
+
+double
+LrWpanErrorModel::GetBer(double snr) const
 {
     double ber = 0.0;
 
@@ -72,9 +90,54 @@ LrWpanErrorModel::GetChunkSuccessRate(double snr, uint32_t nbits) const
 
     ber = ber * 8.0 / 15.0 / 16.0;
 
-    ber = std::min(ber, 1.0);
-    double retval = pow(1.0 - ber, nbits);
-    return retval;
+    return std::min(ber, 1.0);
+}
+
+double
+LrWpanErrorModel::GetTabulatedBer(double snr) const
+{
+    if (snr <= 0.0)
+    {
+        return GetBer(snr);
+    }
+
+    double snrDb = 10.0 * log10(snr);
+    if (snrDb < TABLE_MIN_SNR_DB)
+    {
+        // The BER is close to its maximum, use the closed form expression.
+        return GetBer(snr);
+    }
+    else if (snrDb >= TABLE_MAX_SNR_DB)
+    {
+        // The BER is below 1e-40.
+        return 0.0;
+    }
+
+    const std::vector<double>& table = GetBerTable();
+    double position = (snrDb - TABLE_MIN_SNR_DB) / TABLE_STEP_DB;
+    uint32_t index = static_cast<uint32_t>(position);
+    double fraction = position - index;
+
+    return exp(table[index] + fraction * (table[index + 1] - table[index]));
+}
+
+const std::vector<double>&
+LrWpanErrorModel::GetBerTable() const
+{
+    static std::vector<double> table;
+
+    if (table.empty())
+    {
+        uint32_t size = std::lround((TABLE_MAX_SNR_DB - TABLE_MIN_SNR_DB) / TABLE_STEP_DB) + 1;
+        table.reserve(size);
+        for (uint32_t i = 0; i < size; i++)
+        {
+            double snr = pow(10.0, (TABLE_MIN_SNR_DB + i * TABLE_STEP_DB) / 10.0);
+            table.push_back(log(std::max(GetBer(snr), std::numeric_limits<double>::min())));
+        }
+    }
+
+    return table;
 }
 
 } // namespace ns3
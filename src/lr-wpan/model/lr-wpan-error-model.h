@@ -21,6 +21,8 @@
 
 #include <ns3/object.h>
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -30,6 +32,11 @@ namespace ns3
  * Model the error rate for IEEE 802.15.4 2.4 GHz AWGN channel for OQPSK
  * the model description can be found in IEEE Std 802.15.4-2006, section
  * E.4.1.7
+ *
+ * If the Tabulated attribute is set, the BER is interpolated from a table
+ * of the closed form expression, precalculated over a grid of SNR values in dB.
+ * The interpolation is done on the logarithm of the BER, the relative error with
+ * respect to the closed form expression is below 1%.
  */
 class LrWpanErrorModel : public Object
 {
@@ -53,6 +60,40 @@ class LrWpanErrorModel : public Object
     double GetChunkSuccessRate(double snr, uint32_t nbits) const;
 
   private:
+    /**
+     * Return the BER for a given SNR (closed form expression).
+     *
+     * \param snr SNR expressed as a power ratio (i.e. not in dB)
+     * \return the bit error rate
+     */
+    double GetBer(double snr) const;
+
+    /**
+     * Return the BER for a given SNR, interpolated from the BER table.
+     *
+     * \param snr SNR expressed as a power ratio (i.e. not in dB)
+     * \return the bit error rate
+     */
+    double GetTabulatedBer(double snr) const;
+
+    /**
+     * Get the table of the logarithm of the BER, from TABLE_MIN_SNR_DB to
+     * TABLE_MAX_SNR_DB in steps of TABLE_STEP_DB. The table is shared by all
+     * the error model instances.
+     *
+     * \return the BER table
+     */
+    const std::vector<double>& GetBerTable() const;
+
+    static constexpr double TABLE_MIN_SNR_DB = -10.0; //!< Lowest SNR (dB) of the BER table
+    static constexpr double TABLE_MAX_SNR_DB = 10.0;  //!< Highest SNR (dB) of the BER table
+    static constexpr double TABLE_STEP_DB = 0.1;      //!< SNR step (dB) of the BER table
+
+    /**
+     * Use the BER table instead of the closed form expression.
+     */
+    bool m_tabulated;
+
     /**
      * Array of precalculated binomial coefficients.
      */
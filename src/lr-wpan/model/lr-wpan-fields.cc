@@ -246,6 +246,71 @@ GtsFields::GetGtsPermit() const
     return m_gtsSpecPermit;
 }
 
+void
+GtsFields::SetGtsPermit(bool permit)
+{
+    m_gtsSpecPermit = permit;
+}
+
+void
+GtsFields::AddGtsDescriptor(Mac16Address shortAddr,
+                            uint8_t startSlot,
+                            uint8_t length,
+                            bool direction)
+{
+    if (m_gtsSpecDescCount == 7)
+    {
+        return;
+    }
+
+    m_gtsList[m_gtsSpecDescCount].m_gtsDescDevShortAddr = shortAddr;
+    m_gtsList[m_gtsSpecDescCount].m_gtsDescStartSlot = startSlot & 0x0F;
+    m_gtsList[m_gtsSpecDescCount].m_gtsDescLength = length & 0x0F;
+    if (direction)
+    {
+        m_gtsDirMask |= (0x01 << m_gtsSpecDescCount);
+    }
+    else
+    {
+        m_gtsDirMask &= ~(0x01 << m_gtsSpecDescCount);
+    }
+    m_gtsSpecDescCount++;
+}
+
+uint8_t
+GtsFields::GetNumGtsDescriptors() const
+{
+    return m_gtsSpecDescCount;
+}
+
+Mac16Address
+GtsFields::GetGtsDescShortAddr(uint8_t i) const
+{
+    NS_ASSERT(i < m_gtsSpecDescCount);
+    return m_gtsList[i].m_gtsDescDevShortAddr;
+}
+
+uint8_t
+GtsFields::GetGtsDescStartSlot(uint8_t i) const
+{
+    NS_ASSERT(i < m_gtsSpecDescCount);
+    return m_gtsList[i].m_gtsDescStartSlot;
+}
+
+uint8_t
+GtsFields::GetGtsDescLength(uint8_t i) const
+{
+    NS_ASSERT(i < m_gtsSpecDescCount);
+    return m_gtsList[i].m_gtsDescLength;
+}
+
+bool
+GtsFields::GetGtsDescDirection(uint8_t i) const
+{
+    NS_ASSERT(i < m_gtsSpecDescCount);
+    return (m_gtsDirMask >> i) & 0x01;
+}
+
 uint32_t
 GtsFields::GetSerializedSize() const
 {
@@ -276,8 +341,8 @@ GtsFields::Serialize(Buffer::Iterator i) const
             WriteTo(i, m_gtsList[j].m_gtsDescDevShortAddr);
 
             gtsDescStartAndLenght =
-                (m_gtsList[j].m_gtsDescStartSlot & 0x0F) | // GTS descriptor bits 16-19
-                (m_gtsList[j].m_gtsDescLength & 0xF0);     // GTS descriptor bits 20-23
+                (m_gtsList[j].m_gtsDescStartSlot & 0x0F) |    // GTS descriptor bits 16-19
+                ((m_gtsList[j].m_gtsDescLength << 4) & 0xF0); // GTS descriptor bits 20-23
 
             i.WriteU8(gtsDescStartAndLenght);
         }
@@ -387,7 +452,7 @@ PendingAddrFields::AddAddress(Mac64Address extAddr)
 bool
 PendingAddrFields::SearchAddress(Mac16Address shortAddr)
 {
-    for (int j = 0; j <= m_pndAddrSpecNumShortAddr; j++)
+    for (int j = 0; j < m_pndAddrSpecNumShortAddr; j++)
     {
         if (shortAddr == m_shortAddrList[j])
         {
@@ -401,7 +466,7 @@ PendingAddrFields::SearchAddress(Mac16Address shortAddr)
 bool
 PendingAddrFields::SearchAddress(Mac64Address extAddr)
 {
-    for (int j = 0; j <= m_pndAddrSpecNumExtAddr; j++)
+    for (int j = 0; j < m_pndAddrSpecNumExtAddr; j++)
     {
         if (extAddr == m_extAddrList[j])
         {
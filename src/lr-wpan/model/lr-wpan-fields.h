@@ -201,6 +201,54 @@ class GtsFields
      * \return True if the coordinator is accepting GTS request.
      */
     bool GetGtsPermit() const;
+    /**
+     * Set the GTS Specification Permit.
+     * \param permit True if the coordinator is accepting GTS requests.
+     */
+    void SetGtsPermit(bool permit);
+    /**
+     * Add a GTS descriptor to the GTS List. The descriptor is ignored if the list
+     * already holds 7 descriptors.
+     * \param shortAddr The short address of the device owning the GTS.
+     * \param startSlot The superframe slot at which the GTS begins, 0 if the GTS request
+     *                  of the device was denied.
+     * \param length The number of superframe slots of the GTS.
+     * \param direction False for a transmit-only GTS (device to coordinator), true for
+     *                  a receive-only GTS (coordinator to device).
+     */
+    void AddGtsDescriptor(Mac16Address shortAddr,
+                          uint8_t startSlot,
+                          uint8_t length,
+                          bool direction);
+    /**
+     * Get the number of GTS descriptors in the GTS List.
+     * \return The GTS Specification Field Descriptor Count.
+     */
+    uint8_t GetNumGtsDescriptors() const;
+    /**
+     * Get the device short address of a GTS descriptor.
+     * \param i The position of the descriptor in the GTS List.
+     * \return The short address of the device owning the GTS.
+     */
+    Mac16Address GetGtsDescShortAddr(uint8_t i) const;
+    /**
+     * Get the starting slot of a GTS descriptor.
+     * \param i The position of the descriptor in the GTS List.
+     * \return The superframe slot at which the GTS begins.
+     */
+    uint8_t GetGtsDescStartSlot(uint8_t i) const;
+    /**
+     * Get the length of a GTS descriptor.
+     * \param i The position of the descriptor in the GTS List.
+     * \return The number of superframe slots of the GTS.
+     */
+    uint8_t GetGtsDescLength(uint8_t i) const;
+    /**
+     * Get the direction of a GTS descriptor from the GTS Directions Mask.
+     * \param i The position of the descriptor in the GTS List.
+     * \return False for a transmit-only GTS, true for a receive-only GTS.
+     */
+    bool GetGtsDescDirection(uint8_t i) const;
     /**
      * Get the size of the serialized GTS fields.
      * \return the size of the serialized fields.
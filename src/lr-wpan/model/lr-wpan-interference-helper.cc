@@ -19,6 +19,8 @@
  */
 #include "lr-wpan-interference-helper.h"
 
+#include "lr-wpan-spectrum-value-helper.h"
+
 #include <ns3/log.h>
 #include <ns3/spectrum-model.h>
 #include <ns3/spectrum-value.h>
@@ -28,8 +30,11 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("LrWpanInterferenceHelper");
 
-LrWpanInterferenceHelper::LrWpanInterferenceHelper(Ptr<const SpectrumModel> spectrumModel)
+LrWpanInterferenceHelper::LrWpanInterferenceHelper(Ptr<const SpectrumModel> spectrumModel,
+                                                   uint32_t channel)
     : m_spectrumModel(spectrumModel),
+      m_channel(channel),
+      m_power(0.0),
       m_dirty(false)
 {
     m_signal = Create<SpectrumValue>(m_spectrumModel);
@@ -51,10 +56,12 @@ LrWpanInterferenceHelper::AddSignal(Ptr<const SpectrumValue> signal)
 
     if (signal->GetSpectrumModel() == m_spectrumModel)
     {
-        result = m_signals.insert(signal).second;
-        if (result && !m_dirty)
+        double power = LrWpanSpectrumValueHelper::TotalAvgPower(signal, m_channel);
+        result = m_signals.emplace(signal, power).second;
+        if (result)
         {
-            *m_signal += *signal;
+            m_power += power;
+            m_dirty = true;
         }
     }
     return result;
@@ -69,11 +76,24 @@ LrWpanInterferenceHelper::RemoveSignal(Ptr<const SpectrumValue> signal)
 
     if (signal->GetSpectrumModel() == m_spectrumModel)
     {
-        result = (m_signals.erase(signal) == 1);
+        auto it = m_signals.find(signal);
+        result = (it != m_signals.end());
         if (result)
         {
+            m_power -= it->second;
+            m_signals.erase(it);
             m_dirty = true;
         }
+
+        // Avoid the accumulation of rounding errors.
+        if (m_signals.empty() || m_power < 0.0)
+        {
+            m_power = 0.0;
+            for (const auto& signalPower : m_signals)
+            {
+                m_power += signalPower.second;
+            }
+        }
     }
     return result;
 }
@@ -84,6 +104,7 @@ LrWpanInterferenceHelper::ClearSignals()
     NS_LOG_FUNCTION(this);
 
     m_signals.clear();
+    m_power = 0.0;
     m_dirty = true;
 }
 
@@ -95,11 +116,10 @@ LrWpanInterferenceHelper::GetSignalPsd() const
     if (m_dirty)
     {
         // Sum up the current interference PSD.
-        std::set<Ptr<const SpectrumValue>>::const_iterator it;
         m_signal = Create<SpectrumValue>(m_spectrumModel);
-        for (it = m_signals.begin(); it != m_signals.end(); ++it)
+        for (const auto& signalPower : m_signals)
         {
-            *m_signal += *(*it);
+            *m_signal += *(signalPower.first);
         }
         m_dirty = false;
     }
@@ -107,4 +127,10 @@ LrWpanInterferenceHelper::GetSignalPsd() const
     return m_signal->Copy();
 }
 
+double
+LrWpanInterferenceHelper::GetSignalPower() const
+{
+    return m_power;
+}
+
 } // namespace ns3
@@ -23,7 +23,7 @@
 #include <ns3/ptr.h>
 #include <ns3/simple-ref-count.h>
 
-#include <set>
+#include <map>
 
 namespace ns3
 {
@@ -43,8 +43,9 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
      * Create a new interference helper for the given SpectrumModel.
      *
      * \param spectrumModel the SpectrumModel to be used
+     * \param channel the channel used to compute the in-band power of the signals
      */
-    LrWpanInterferenceHelper(Ptr<const SpectrumModel> spectrumModel);
+    LrWpanInterferenceHelper(Ptr<const SpectrumModel> spectrumModel, uint32_t channel);
 
     ~LrWpanInterferenceHelper();
 
@@ -80,6 +81,15 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
      */
     Ptr<SpectrumValue> GetSignalPsd() const;
 
+    /**
+     * Get the total in-band power of all accumulated signals. The power is
+     * updated incrementally when signals are added or removed, this does
+     * not involve any SpectrumValue operation.
+     *
+     * \return the total in-band power in W
+     */
+    double GetSignalPower() const;
+
     /**
      * Get the SpectrumModel used by the helper.
      *
@@ -104,9 +114,19 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
     Ptr<const SpectrumModel> m_spectrumModel;
 
     /**
-     * The set of accumulated signals.
+     * The channel used to compute the in-band power of the signals.
+     */
+    uint32_t m_channel;
+
+    /**
+     * The accumulated signals and their in-band power (W).
+     */
+    std::map<Ptr<const SpectrumValue>, double> m_signals;
+
+    /**
+     * The total in-band power of the accumulated signals (W).
      */
-    std::set<Ptr<const SpectrumValue>> m_signals;
+    double m_power;
 
     /**
      * The precomputed sum of all accumulated signals.
@@ -164,20 +164,19 @@ LLBeaconPayloadHeader::GetSerializedSize() const
         Configuation Sequence Number             1 byte
         TimeSlot size                            1 byte  
         Number of Base Timeslots in superframe 0/1 byte //! Note : This field present only in Online mode
-        Group Ack Bitmap                       0/2 byte //! Note : This field present only in Online mode
+        Group Ack Bitmap                       0/n byte //! Note : Only present in Online mode
         ------------------------------------------------
-        Total :                                4/7 bytes
+        Total :                              4/5+n bytes
+
+        The Group Ack Bitmap has one bit per base timeslot, n = ceil(numOfBaseTS / 8).
     */
     uint32_t size = 0;
     size += m_flagsFields.GetSerializedSize();
-    
+    size += 3;
+
     if(m_flagsFields.GetTransmissionState() == FlagsField::ONLINE_STATE)
     {
-        size += 7;
-    }
-    else
-    {
-        size += 4;
+        size += 1 + (m_numOfBaseTSinSuperframe + 7) / 8;
     }
 
     return size;
@@ -195,7 +194,19 @@ LLBeaconPayloadHeader::Serialize(Buffer::Iterator start) const
     if(m_flagsFields.GetTransmissionState() == FlagsField::ONLINE_STATE)
     {
         i.WriteU8(m_numOfBaseTSinSuperframe);
-        i.WriteU16(m_groupAckBmp); // TODO : Need to check sanity
+        for (uint32_t octet = 0; octet < (m_numOfBaseTSinSuperframe + 7) / 8u; octet++)
+        {
+            uint8_t bmp = 0;
+            for (uint32_t bit = 0; bit < 8; bit++)
+            {
+                uint32_t timeslot = octet * 8 + bit;
+                if (timeslot < m_groupAckBmp.size() && m_groupAckBmp[timeslot])
+                {
+                    bmp |= (1 << bit);
+                }
+            }
+            i.WriteU8(bmp);
+        }
     }
 }
 
@@ -211,7 +222,15 @@ LLBeaconPayloadHeader::Deserialize(Buffer::Iterator start)
     if(m_flagsFields.GetTransmissionState() == FlagsField::ONLINE_STATE)
     {
         m_numOfBaseTSinSuperframe = i.ReadU8();
-        m_groupAckBmp = i.ReadU16(); // TODO : Need to check sanity
+        m_groupAckBmp.assign(m_numOfBaseTSinSuperframe, false);
+        for (uint32_t octet = 0; octet < (m_numOfBaseTSinSuperframe + 7) / 8u; octet++)
+        {
+            uint8_t bmp = i.ReadU8();
+            for (uint32_t bit = 0; bit < 8 && octet * 8 + bit < m_numOfBaseTSinSuperframe; bit++)
+            {
+                m_groupAckBmp[octet * 8 + bit] = (bmp >> bit) & 0x01;
+            }
+        }
     }
     return i.GetDistanceFrom(start);
 }
@@ -225,9 +244,9 @@ LLBeaconPayloadHeader::Print(std::ostream& os) const
     Configuation Sequence Number             1 byte
     TimeSlot size                            1 byte  
     Number of Base Timeslots in superframe 0/1 byte //! Note : This field present only in Online mode
-    Group Ack Bitmap                       0/2 byte //! Note : This field present only in Online mode
+    Group Ack Bitmap                       0/n byte //! Note : Only present in Online mode
     ------------------------------------------------
-    Total :                                4/7 bytes
+    Total :                              4/5+n bytes
     */
     if(m_flagsFields.GetTransmissionState() == FlagsField::ONLINE_STATE)
     {
@@ -236,7 +255,12 @@ LLBeaconPayloadHeader::Print(std::ostream& os) const
             << "| Configuation Sequence Number | =" << m_configurationSeqNum  << "\n"
             << "| TimeSlot size | =" << m_timeslotSize << "\n"
             << "| Number of Base Timeslots in superframe | =" << m_numOfBaseTSinSuperframe << "\n"
-            << "| Group Ack Bitmap | =" << m_groupAckBmp << "\n";
+            << "| Group Ack Bitmap | =";
+        for (bool acked : m_groupAckBmp)
+        {
+            os << acked;
+        }
+        os << "\n";
     }
     else
     {
@@ -279,7 +303,7 @@ LLBeaconPayloadHeader::SetNumOfBaseTsInSuperframe(uint8_t numOfBaseTSinSuperfram
 }
 
 void 
-LLBeaconPayloadHeader::SetgroupAckBmp(uint16_t groupAckBmp)
+LLBeaconPayloadHeader::SetgroupAckBmp(const std::vector<bool>& groupAckBmp)
 {
     m_groupAckBmp = groupAckBmp;
 }
@@ -312,7 +336,7 @@ LLBeaconPayloadHeader::GetNumOfBaseTsInSuperframe() const
     return m_numOfBaseTSinSuperframe;
 }
 
-uint16_t 
+std::vector<bool>
 LLBeaconPayloadHeader::GetgroupAckBmp() const
 {
     return m_groupAckBmp;
@@ -377,53 +401,52 @@ CommandPayloadHeader::GetSerializedSize() const
     case COOR_REALIGN:
         break;
     case GTS_REQ:
+        size += 1; // GTS Characteristics
         break;
     case CMD_RESERVED:
         break;
-    // TODO : Add LLDN and DSME amendment
     case LL_DISCOVER_RESP:
-        // TODO : need to pass Discovery parameters to get length
-        NS_LOG_UNCOND("GetSerializedSize() case LL_CONFIGURATON_REQ");
-        // TODO - need to calculate timeslot length
         /**
          * Discover response command
-         * See 802.15.4e-2011 Section 5.3.10.1.4
-         *      MHR         - Command Frame Identifier - //?Discovery parameters
-         * Variable Octets  -            1             -   Variable Octets        
+         * See 802.15.4e-2012 Section 5.3.10.1
          *? Discovery parameters
          *  Full MAC address - Required timeslot duration - Uplink/bidirectional type indicator
-         *          1        -              1             -                 1
+         *          8        -              1             -                 1
          */
-        size += 1 + 1 + 1;
+        size += 8 + 1 + 1;
         break;
     case LL_CONFIGURATION_STATUS:
-        NS_LOG_UNCOND("GetSerializedSize() case LL_CONFIGURATION_STATUS");
         /**
          * Configuration status command
-         * See 802.15.4e-2011 Section 5.3.10.2.5
-         *      MHR         - Command Frame Identifier - //?Configuration Parameters 
-         * Variable Octets  -            1             -   Variable Octets  
-         * //! 可以考慮把Short Macaddress field 拿掉?
-         *? Configuration Parameters
-         *  Full MAC address - Short MAC address - Required timeslot duration - Uplink/bidirectional type indicator - Assigned timeslots
-         *          1        -          2        -             1              -                  1                  -         1 
+         * See 802.15.4e-2012 Section 5.3.10.2
+         *? Configuration Parameters                          Octets
+         *  Full MAC address                                     8
+         *  Short MAC address                                    1
+         *  Required timeslot duration                           1
+         *  Uplink/bidirectional type indicator                  1
+         *  Assigned timeslots                                   1
+         *  Requested period (*)                                 2
+         *  (*) Not part of the standard, used to plan the Online superframe.
          */
-        size += 1 + 2 + 1 + 1 + 1;
+        size += 8 + 1 + 1 + 1 + 1 + 2;
+        break;
     case LL_CONFIGURATON_REQ:
-        NS_LOG_UNCOND("GetSerializedSize() case LL_CONFIGURATON_REQ");
         /**
          * Configuration request command
-         * See 802.15.4e-2011 Section 5.3.10.3.4
-         *      MHR         - Command Frame Identifier - //?Configuration Parameters 
-         * Variable Octets  -            1             -   Variable Octets        
-         *? Configuration Parameters
-         *  Full MAC address - Short MAC address - Transmission channel - Existence of management frames - Timeslot duration - Assigned timeslots
-         *          1        -          2        -          1           -               1                -         1         -         1
+         * See 802.15.4e-2012 Section 5.3.10.3
+         *? Configuration Parameters                          Octets
+         *  Full MAC address                                     8
+         *  Short MAC address                                    1
+         *  Transmission channel                                 1
+         *  Existence of management frames                       1
+         *  Timeslot duration                                    1
+         *  Assigned timeslots                                   1
+         *  Number of timeslots (*)                              1
+         *  (*) Not part of the standard, consecutive base timeslots of the device.
          */
-        size += 1 + 2 + 1 + 1 + 1 + 1;
+        size += 8 + 1 + 1 + 1 + 1 + 1 + 1;
         break;
     case LL_CTS_SHARED_GROUP:
-        NS_LOG_UNCOND("GetSerializedSize() case LL_CTS_SHARED_GROUP");
         /**
          * Clear to send shared group command
          * See 802.15.4e-2011 Section 5.3.10.4.1
@@ -434,7 +457,6 @@ CommandPayloadHeader::GetSerializedSize() const
         break;
 
     case LL_RTS:
-        NS_LOG_UNCOND("GetSerializedSize() case LL_RTS");
         /**
          * Ready to send command
          * See 802.15.4e-2011 Section 5.3.10.5.1
@@ -446,7 +468,6 @@ CommandPayloadHeader::GetSerializedSize() const
         size += 1 + 1;
         break;
     case LL_CTS:
-        NS_LOG_UNCOND("GetSerializedSize() case LL_CTS");
         /**
          * Clear to send command
          * See 802.15.4e-2011 Section 5.3.10.6.1
@@ -491,63 +512,35 @@ CommandPayloadHeader::Serialize(Buffer::Iterator start) const
     case COOR_REALIGN:
         break;
     case GTS_REQ:
+        i.WriteU8(m_gtsCharacteristics);
         break;
     case CMD_RESERVED:
         break;
 
     //!< LLDN MAC command frame serializer
     case LL_DISCOVER_RESP:
-
-        NS_LOG_UNCOND("Serialize() case LL_CONFIGURATON_REQ");
-        /**
-         * Discover response command
-         * See 802.15.4e-2011 Section 5.3.10.1.4
-         *      MHR         - Command Frame Identifier - //?Discovery parameters
-         * Variable Octets  -            1             -   Variable Octets        
-         *? Discovery parameters
-         *  Full MAC address - Required timeslot duration - Uplink/bidirectional type indicator
-         *          1        -              1             -                 1
-         */
+        WriteTo(i, m_fullAddr);
         i.WriteU8(m_timeslotDuration);
         i.WriteU8(m_typeIndicator);
         break;
     case LL_CONFIGURATION_STATUS:
-        NS_LOG_UNCOND("Serialize() case LL_CONFIGURATION_STATUS");
-        /**
-         * Configuration status command
-         * See 802.15.4e-2011 Section 5.3.10.2.5
-         *      MHR         - Command Frame Identifier - //?Configuration Parameters 
-         * Variable Octets  -            1             -   Variable Octets  
-         *? Configuration Parameters
-         *  Full MAC address - Short MAC address - Required timeslot duration - Uplink/bidirectional type indicator - Assigned timeslots
-         *          1        -          2        -             1              -                  1                  -         1 
-         */
-        WriteTo(i,m_simpleAddr);
-        WriteTo(i,m_shortAddr);
+        WriteTo(i, m_fullAddr);
+        WriteTo(i, m_simpleAddr);
         i.WriteU8(m_timeslotDuration);
         i.WriteU8(m_typeIndicator);
         i.WriteU8(m_assignedTimeSlot);
+        i.WriteHtolsbU16(m_requestedPeriod);
         break;
     case LL_CONFIGURATON_REQ:
-        NS_LOG_UNCOND("Serialize() case LL_CONFIGURATON_REQ");
-        /**
-         * Configuration request command
-         * See 802.15.4e-2011 Section 5.3.10.3.4
-         *      MHR         - Command Frame Identifier - //?Configuration Parameters 
-         * Variable Octets  -            1             -   Variable Octets        
-         *? Configuration Parameters
-         *  Full MAC address - Short MAC address - Transmission channel - Existence of management frames - Timeslot duration - Assigned timeslots
-         *          1        -          2        -          1           -               1                -         1         -         1
-         */
-        WriteTo(i,m_simpleAddr);
-        WriteTo(i,m_shortAddr);
+        WriteTo(i, m_fullAddr);
+        WriteTo(i, m_simpleAddr);
         i.WriteU8(m_txChannel);
         i.WriteU8(m_enMgntFrame);
         i.WriteU8(m_timeslotDuration);
         i.WriteU8(m_assignedTimeSlot);
+        i.WriteU8(m_numTimeslots);
         break;
     case LL_CTS_SHARED_GROUP:
-        NS_LOG_UNCOND("Serialize() case LL_CTS_SHARED_GROUP");
         /**
          * Clear to send shared group command
          * See 802.15.4e-2011 Section 5.3.10.4.1
@@ -558,7 +551,6 @@ CommandPayloadHeader::Serialize(Buffer::Iterator start) const
         break;
 
     case LL_RTS:
-        NS_LOG_UNCOND("Serialize() case LL_RTS");
         /**
          * Ready to send command
          * See 802.15.4e-2011 Section 5.3.10.5.1
@@ -571,7 +563,6 @@ CommandPayloadHeader::Serialize(Buffer::Iterator start) const
         i.WriteU8(m_networkID);
         break;
     case LL_CTS:
-        NS_LOG_UNCOND("Serialize() case LL_CTS");
         /**
          * Clear to send command
          * See 802.15.4e-2011 Section 5.3.10.6.1
@@ -616,65 +607,35 @@ CommandPayloadHeader::Deserialize(Buffer::Iterator start)
     case COOR_REALIGN:
         break;
     case GTS_REQ:
+        m_gtsCharacteristics = i.ReadU8();
         break;
     case CMD_RESERVED:
         break;
 
     //!< LLDN MAC command frame deserializer
     case LL_DISCOVER_RESP:
-
-        NS_LOG_UNCOND("Deserialize() case LL_CONFIGURATON_REQ");
-        /**
-         * Discover response command
-         * See 802.15.4e-2011 Section 5.3.10.1.4
-         *      MHR         - Command Frame Identifier - //?Discovery parameters
-         * Variable Octets  -            1             -   Variable Octets        
-         *? Discovery parameters
-         *  Full MAC address - Required timeslot duration - Uplink/bidirectional type indicator
-         *          1        -              1             -                 1
-         */
-
+        ReadFrom(i, m_fullAddr);
         m_timeslotDuration = i.ReadU8();
         m_typeIndicator = i.ReadU8();
-
         break;
     case LL_CONFIGURATION_STATUS:
-        NS_LOG_UNCOND("Deserialize() case LL_CONFIGURATION_STATUS");
-        /**
-         * Configuration status command
-         * See 802.15.4e-2011 Section 5.3.10.2.5
-         *      MHR         - Command Frame Identifier - //?Configuration Parameters 
-         * Variable Octets  -            1             -   Variable Octets  
-         *? Configuration Parameters
-         *  Full MAC address - Short MAC address - Required timeslot duration - Uplink/bidirectional type indicator - Assigned timeslots
-         *          1        -          2        -             1              -                  1                  -         1 
-         */
-        ReadFrom(i,m_simpleAddr);
-        ReadFrom(i,m_shortAddr);
+        ReadFrom(i, m_fullAddr);
+        ReadFrom(i, m_simpleAddr);
         m_timeslotDuration = i.ReadU8();
         m_typeIndicator = i.ReadU8();
         m_assignedTimeSlot = i.ReadU8();
+        m_requestedPeriod = i.ReadLsbtohU16();
         break;
     case LL_CONFIGURATON_REQ:
-        NS_LOG_UNCOND("Deserialize() case LL_CONFIGURATON_REQ");
-        /**
-         * Configuration request command
-         * See 802.15.4e-2011 Section 5.3.10.3.4
-         *      MHR         - Command Frame Identifier - //?Configuration Parameters 
-         * Variable Octets  -            1             -   Variable Octets        
-         *? Configuration Parameters
-         *  Full MAC address - Short MAC address - Transmission channel - Existence of management frames - Timeslot duration - Assigned timeslots
-         *          1        -          2        -          1           -               1                -         1         -         1
-         */
-        ReadFrom(i,m_simpleAddr);
-        ReadFrom(i,m_shortAddr);
+        ReadFrom(i, m_fullAddr);
+        ReadFrom(i, m_simpleAddr);
         m_txChannel = i.ReadU8();
         m_enMgntFrame = i.ReadU8();
         m_timeslotDuration = i.ReadU8();
         m_assignedTimeSlot = i.ReadU8();
+        m_numTimeslots = i.ReadU8();
         break;
     case LL_CTS_SHARED_GROUP:
-        NS_LOG_UNCOND("Deserialize() case LL_CTS_SHARED_GROUP");
         /**
          * Clear to send shared group command
          * See 802.15.4e-2011 Section 5.3.10.4.1
@@ -685,7 +646,6 @@ CommandPayloadHeader::Deserialize(Buffer::Iterator start)
         break;
 
     case LL_RTS:
-        NS_LOG_UNCOND("Deserialize() case LL_RTS");
         /**
          * Ready to send command
          * See 802.15.4e-2011 Section 5.3.10.5.1
@@ -699,7 +659,6 @@ CommandPayloadHeader::Deserialize(Buffer::Iterator start)
         m_networkID = i.ReadU8();
         break;
     case LL_CTS:
-        NS_LOG_UNCOND("Deserialize() case LL_CTS");
         /**
          * Clear to send command
          * See 802.15.4e-2011 Section 5.3.10.6.1
@@ -748,10 +707,30 @@ CommandPayloadHeader::Print(std::ostream& os) const
     case COOR_REALIGN:
         break;
     case GTS_REQ:
+        os << "| GTS Characteristics | = " << static_cast<uint32_t>(m_gtsCharacteristics);
         break;
     case CMD_RESERVED:
         break;
-    // TODO Add LLDN payload infos
+    case LL_DISCOVER_RESP:
+        os << "| Full Address | = " << m_fullAddr
+           << "| Timeslot Duration | = " << static_cast<uint32_t>(m_timeslotDuration)
+           << "| Type Indicator | = " << static_cast<uint32_t>(m_typeIndicator);
+        break;
+    case LL_CONFIGURATION_STATUS:
+        os << "| Full Address | = " << m_fullAddr << "| Simple Address | = " << m_simpleAddr
+           << "| Timeslot Duration | = " << static_cast<uint32_t>(m_timeslotDuration)
+           << "| Type Indicator | = " << static_cast<uint32_t>(m_typeIndicator)
+           << "| Assigned Timeslot | = " << static_cast<uint32_t>(m_assignedTimeSlot)
+           << "| Requested Period | = " << m_requestedPeriod;
+        break;
+    case LL_CONFIGURATON_REQ:
+        os << "| Full Address | = " << m_fullAddr << "| Simple Address | = " << m_simpleAddr
+           << "| Tx Channel | = " << static_cast<uint32_t>(m_txChannel)
+           << "| Management Frames | = " << static_cast<uint32_t>(m_enMgntFrame)
+           << "| Timeslot Duration | = " << static_cast<uint32_t>(m_timeslotDuration)
+           << "| Assigned Timeslot | = " << static_cast<uint32_t>(m_assignedTimeSlot)
+           << "| Number of Timeslots | = " << static_cast<uint32_t>(m_numTimeslots);
+        break;
     default:
         break;
     }
@@ -902,4 +881,148 @@ CommandPayloadHeader::GetCapabilityField() const
     return m_capabilityInfo;
 }
 
+void
+CommandPayloadHeader::SetFullAddr(Mac64Address fullAddr)
+{
+    NS_ASSERT(m_cmdFrameId == LL_DISCOVER_RESP || m_cmdFrameId == LL_CONFIGURATION_STATUS ||
+              m_cmdFrameId == LL_CONFIGURATON_REQ);
+    m_fullAddr = fullAddr;
+}
+
+void
+CommandPayloadHeader::SetSimpleAddr(Mac8Address simpleAddr)
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATION_STATUS || m_cmdFrameId == LL_CONFIGURATON_REQ);
+    m_simpleAddr = simpleAddr;
+}
+
+void
+CommandPayloadHeader::SetTimeslotDuration(uint8_t timeslotDuration)
+{
+    NS_ASSERT(m_cmdFrameId == LL_DISCOVER_RESP || m_cmdFrameId == LL_CONFIGURATION_STATUS ||
+              m_cmdFrameId == LL_CONFIGURATON_REQ);
+    m_timeslotDuration = timeslotDuration;
+}
+
+void
+CommandPayloadHeader::SetTypeIndicator(uint8_t typeIndicator)
+{
+    NS_ASSERT(m_cmdFrameId == LL_DISCOVER_RESP || m_cmdFrameId == LL_CONFIGURATION_STATUS);
+    m_typeIndicator = typeIndicator;
+}
+
+void
+CommandPayloadHeader::SetAssignedTimeslot(uint8_t assignedTimeslot)
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATION_STATUS || m_cmdFrameId == LL_CONFIGURATON_REQ);
+    m_assignedTimeSlot = assignedTimeslot;
+}
+
+void
+CommandPayloadHeader::SetTxChannel(uint8_t txChannel)
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATON_REQ);
+    m_txChannel = txChannel;
+}
+
+void
+CommandPayloadHeader::SetMgmtFrames(bool mgmtFrames)
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATON_REQ);
+    m_enMgntFrame = mgmtFrames ? 1 : 0;
+}
+
+Mac64Address
+CommandPayloadHeader::GetFullAddr() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_DISCOVER_RESP || m_cmdFrameId == LL_CONFIGURATION_STATUS ||
+              m_cmdFrameId == LL_CONFIGURATON_REQ);
+    return m_fullAddr;
+}
+
+Mac8Address
+CommandPayloadHeader::GetSimpleAddr() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATION_STATUS || m_cmdFrameId == LL_CONFIGURATON_REQ);
+    return m_simpleAddr;
+}
+
+uint8_t
+CommandPayloadHeader::GetTimeslotDuration() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_DISCOVER_RESP || m_cmdFrameId == LL_CONFIGURATION_STATUS ||
+              m_cmdFrameId == LL_CONFIGURATON_REQ);
+    return m_timeslotDuration;
+}
+
+uint8_t
+CommandPayloadHeader::GetTypeIndicator() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_DISCOVER_RESP || m_cmdFrameId == LL_CONFIGURATION_STATUS);
+    return m_typeIndicator;
+}
+
+uint8_t
+CommandPayloadHeader::GetAssignedTimeslot() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATION_STATUS || m_cmdFrameId == LL_CONFIGURATON_REQ);
+    return m_assignedTimeSlot;
+}
+
+uint8_t
+CommandPayloadHeader::GetTxChannel() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATON_REQ);
+    return m_txChannel;
+}
+
+bool
+CommandPayloadHeader::GetMgmtFrames() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATON_REQ);
+    return (m_enMgntFrame != 0);
+}
+
+void
+CommandPayloadHeader::SetRequestedPeriod(uint16_t period)
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATION_STATUS);
+    m_requestedPeriod = period;
+}
+
+void
+CommandPayloadHeader::SetNumTimeslots(uint8_t numTimeslots)
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATON_REQ);
+    m_numTimeslots = numTimeslots;
+}
+
+uint16_t
+CommandPayloadHeader::GetRequestedPeriod() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATION_STATUS);
+    return m_requestedPeriod;
+}
+
+uint8_t
+CommandPayloadHeader::GetNumTimeslots() const
+{
+    NS_ASSERT(m_cmdFrameId == LL_CONFIGURATON_REQ);
+    return m_numTimeslots;
+}
+
+void
+CommandPayloadHeader::SetGtsCharacteristics(uint8_t gtsCharacteristics)
+{
+    NS_ASSERT(m_cmdFrameId == GTS_REQ);
+    m_gtsCharacteristics = gtsCharacteristics;
+}
+
+uint8_t
+CommandPayloadHeader::GetGtsCharacteristics() const
+{
+    NS_ASSERT(m_cmdFrameId == GTS_REQ);
+    return m_gtsCharacteristics;
+}
+
 } // namespace ns3
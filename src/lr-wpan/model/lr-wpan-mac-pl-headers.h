@@ -26,6 +26,8 @@
 #include <ns3/mac16-address.h>
 #include <ns3/mac64-address.h>
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -120,14 +122,14 @@ class LLBeaconPayloadHeader : public Header
     void SetConfigurationSeqNum(uint8_t configurationSeqNum);
     void SetBaseTimeSlotSize(uint8_t baseTimeSlotSize);
     void SetNumOfBaseTsInSuperframe(uint8_t numOfBaseTSinSuperframe);
-    void SetgroupAckBmp(uint16_t groupAckBmp);
+    void SetgroupAckBmp(const std::vector<bool>& groupAckBmp);
 
     FlagsField GetFlagsFields() const;
     Mac8Address GetLLPanCoordAddr() const;
     uint8_t GetConfigurationSeqNum() const;
     uint8_t GetBaseTimeSlotSize() const;
     uint8_t GetNumOfBaseTsInSuperframe() const;
-    uint16_t GetgroupAckBmp() const;
+    std::vector<bool> GetgroupAckBmp() const;
 
 
 
@@ -139,7 +141,7 @@ class LLBeaconPayloadHeader : public Header
     uint8_t m_timeslotSize;            // Length of a base timeslot
     uint8_t m_numOfBaseTSinSuperframe; // corresponds to macLLDNnumTimeSlot (Uplink + Bidirectional TS time length) 
                                        //! Note : This field present only in Online mode
-    uint16_t m_groupAckBmp;            // Only present in online mode 
+    std::vector<bool> m_groupAckBmp;   // One bit per base timeslot of the superframe
                                        //! Note : This field present only in Online mode
     
 };
@@ -243,12 +245,73 @@ class CommandPayloadHeader : public Header
      * \param status The status resulting from the association attempt
      */
     void SetAssociationStatus(AssocStatus status);
+    /**
+     * Set the full MAC address of the LLDN device (Discover Response, Configuration Status
+     * and Configuration Request Commands).
+     * \param fullAddr The extended address of the LLDN device
+     */
+    void SetFullAddr(Mac64Address fullAddr);
+    /**
+     * Set the simple address of the LLDN device (Configuration Status and Configuration
+     * Request Commands).
+     * \param simpleAddr The simple address of the LLDN device
+     */
+    void SetSimpleAddr(Mac8Address simpleAddr);
+    /**
+     * Set the required or assigned timeslot duration, expressed as the number of octets
+     * of the LL frame payload (Discover Response, Configuration Status and Configuration
+     * Request Commands).
+     * \param timeslotDuration The timeslot duration
+     */
+    void SetTimeslotDuration(uint8_t timeslotDuration);
+    /**
+     * Set the uplink/bidirectional type indicator (Discover Response and Configuration Status
+     * Commands).
+     * \param typeIndicator 0 for an uplink only device, 1 for a bidirectional device
+     */
+    void SetTypeIndicator(uint8_t typeIndicator);
+    /**
+     * Set the base timeslot assigned to the LLDN device (Configuration Status and
+     * Configuration Request Commands).
+     * \param assignedTimeslot The assigned base timeslot
+     */
+    void SetAssignedTimeslot(uint8_t assignedTimeslot);
+    /**
+     * Set the transmission channel used in the Online state (Configuration Request Command).
+     * \param txChannel The transmission channel
+     */
+    void SetTxChannel(uint8_t txChannel);
+    /**
+     * Set the existence of management timeslots in the Online state (Configuration Request
+     * Command).
+     * \param mgmtFrames True if the Online superframe contains management timeslots
+     */
+    void SetMgmtFrames(bool mgmtFrames);
+    /**
+     * Set the longest period between two data frames accepted by the LLDN device
+     * (Configuration Status Command). This field is not part of the standard, it lets
+     * the PAN-C size the Online superframe.
+     * \param period The requested period in milliseconds, 0 if the device has no requirement
+     */
+    void SetRequestedPeriod(uint16_t period);
+    /**
+     * Set the number of consecutive base timeslots assigned to the LLDN device, starting
+     * at the assigned timeslot (Configuration Request Command). This field is not part
+     * of the standard.
+     * \param numTimeslots The number of assigned base timeslots
+     */
+    void SetNumTimeslots(uint8_t numTimeslots);
+    /**
+     * Set the GTS Characteristics field (GTS Request Command).
+     * See IEEE 802.15.4-2011 Section 5.3.9.2, the bits 0-3 hold the GTS length, the bit 4
+     * the GTS direction and the bit 5 the characteristics type (1 for an allocation).
+     * \param gtsCharacteristics The GTS Characteristics field
+     */
+    void SetGtsCharacteristics(uint8_t gtsCharacteristics);
     /**
      * Get the Short address assigned by the coordinator (Association Response Command).
      * \return The Mac16Address assigned by the coordinator
      */
-
-    // TODO : add LLDN GET & SET FUNCTIONS
     Mac16Address GetShortAddr() const;
     /**
      * Get the status resulting from an association request (Association Response Command).
@@ -266,6 +329,56 @@ class CommandPayloadHeader : public Header
      * \return The Capability Information Field
      */
     CapabilityField GetCapabilityField() const;
+    /**
+     * Get the full MAC address of the LLDN device.
+     * \return The extended address of the LLDN device
+     */
+    Mac64Address GetFullAddr() const;
+    /**
+     * Get the simple address of the LLDN device.
+     * \return The simple address of the LLDN device
+     */
+    Mac8Address GetSimpleAddr() const;
+    /**
+     * Get the required or assigned timeslot duration.
+     * \return The timeslot duration in octets of LL frame payload
+     */
+    uint8_t GetTimeslotDuration() const;
+    /**
+     * Get the uplink/bidirectional type indicator.
+     * \return The type indicator
+     */
+    uint8_t GetTypeIndicator() const;
+    /**
+     * Get the base timeslot assigned to the LLDN device.
+     * \return The assigned base timeslot
+     */
+    uint8_t GetAssignedTimeslot() const;
+    /**
+     * Get the transmission channel used in the Online state.
+     * \return The transmission channel
+     */
+    uint8_t GetTxChannel() const;
+    /**
+     * Get the existence of management timeslots in the Online state.
+     * \return True if the Online superframe contains management timeslots
+     */
+    bool GetMgmtFrames() const;
+    /**
+     * Get the longest period between two data frames accepted by the LLDN device.
+     * \return The requested period in milliseconds, 0 if the device has no requirement
+     */
+    uint16_t GetRequestedPeriod() const;
+    /**
+     * Get the number of consecutive base timeslots assigned to the LLDN device.
+     * \return The number of assigned base timeslots
+     */
+    uint8_t GetNumTimeslots() const;
+    /**
+     * Get the GTS Characteristics field (GTS Request Command).
+     * \return The GTS Characteristics field
+     */
+    uint8_t GetGtsCharacteristics() const;
 
   private:
     MacCommand m_cmdFrameId; //!< The command Frame Identifier
@@ -278,15 +391,21 @@ class CommandPayloadHeader : public Header
     // For LLDN MAC Command frame payload variable
 
     // LLDN Discover response command 
-    Mac8Address m_simpleAddr;
-    uint16_t m_timeslotDuration; //!< Timeslot length , received by beacon
+    Mac64Address m_fullAddr;     //!< Full MAC address of the LLDN device
+    Mac8Address m_simpleAddr;    //!< Simple address of the LLDN device
+    uint8_t m_timeslotDuration;  //!< Timeslot length , received by beacon
     uint8_t m_typeIndicator;     //!< Uplink/bidirectional type indicator
 
     // Configuration status command
     uint8_t m_assignedTimeSlot;     //!< Timeslot assigned for transmission
+    uint16_t m_requestedPeriod{0};  //!< Requested period between data frames (ms)
     // Configuration request command
     uint8_t m_txChannel;            //!< Transmission channel
     uint8_t m_enMgntFrame;          //!< Enable MgmtTS or not
+    uint8_t m_numTimeslots{1};      //!< Number of consecutive base timeslots assigned
+
+    // GTS request command
+    uint8_t m_gtsCharacteristics{0}; //!< GTS Characteristics field
 
     // Clear to send shared group command
     uint8_t m_networkID;
@@ -23,9 +23,45 @@
 
 #include <ns3/packet.h>
 
+#include <array>
+#include <vector>
+
 namespace ns3
 {
 
+namespace
+{
+
+/**
+ * Build the lookup table of the CRC-16 used by the FCS (ITU-T polynomial
+ * x^16 + x^12 + x^5 + 1, processed LSB first). See IEEE 802.15.4-2011 Section 5.2.1.9.
+ *
+ * \return the CRC-16 value of each possible octet
+ */
+constexpr std::array<uint16_t, 256>
+MakeCrc16Table()
+{
+    std::array<uint16_t, 256> table{};
+    for (uint16_t i = 0; i < 256; i++)
+    {
+        uint16_t crc = i;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x0001) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+/// CRC-16 lookup table, computed at compile time.
+constexpr std::array<uint16_t, 256> g_crc16Table = MakeCrc16Table();
+
+/// The maximum PSDU size (aMaxPhyPacketSize), frames up to this size do not use the heap.
+constexpr uint32_t g_maxPsduSize = 127;
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(LrWpanMacTrailer);
 
 const uint16_t LrWpanMacTrailer::LR_WPAN_MAC_FCS_LENGTH = 2;
@@ -91,13 +127,7 @@ LrWpanMacTrailer::SetFcs(Ptr<const Packet> p)
 {
     if (m_calcFcs)
     {
-        uint16_t size = p->GetSize();
-        uint8_t* serial_packet = new uint8_t[size];
-
-        p->CopyData(serial_packet, size);
-
-        m_fcs = GenerateCrc16(serial_packet, size);
-        delete[] serial_packet;
+        m_fcs = GenerateCrc16(p);
     }
 }
 
@@ -112,15 +142,7 @@ LrWpanMacTrailer::CheckFcs(Ptr<const Packet> p)
     }
     else
     {
-        uint16_t checkFcs;
-        uint16_t size = p->GetSize();
-        uint8_t* serial_packet = new uint8_t[size];
-
-        p->CopyData(serial_packet, size);
-
-        checkFcs = GenerateCrc16(serial_packet, size);
-        delete[] serial_packet;
-        return (checkFcs == GetFcs());
+        return (GenerateCrc16(p) == GetFcs());
     }
 }
 
@@ -141,19 +163,33 @@ LrWpanMacTrailer::IsFcsEnabled()
 }
 
 uint16_t
-LrWpanMacTrailer::GenerateCrc16(uint8_t* data, int length)
+LrWpanMacTrailer::GenerateCrc16(Ptr<const Packet> p)
+{
+    uint32_t size = p->GetSize();
+
+    // Valid frames fit in a stack buffer, only oversized frames (which will be
+    // rejected by the PHY) need a temporary heap buffer.
+    std::array<uint8_t, g_maxPsduSize> frame;
+    std::vector<uint8_t> largeFrame;
+    uint8_t* data = frame.data();
+    if (size > g_maxPsduSize)
+    {
+        largeFrame.resize(size);
+        data = largeFrame.data();
+    }
+
+    p->CopyData(data, size);
+    return GenerateCrc16(data, size);
+}
+
+uint16_t
+LrWpanMacTrailer::GenerateCrc16(const uint8_t* data, uint32_t length)
 {
-    int i;
     uint16_t accumulator = 0;
 
-    for (i = 0; i < length; ++i)
+    for (uint32_t i = 0; i < length; ++i)
     {
-        accumulator ^= *data;
-        accumulator = (accumulator >> 8) | (accumulator << 8);
-        accumulator ^= (accumulator & 0xff00) << 4;
-        accumulator ^= (accumulator >> 8) >> 4;
-        accumulator ^= (accumulator & 0xff00) >> 5;
-        ++data;
+        accumulator = (accumulator >> 8) ^ g_crc16Table[(accumulator ^ data[i]) & 0xff];
     }
     return accumulator;
 }
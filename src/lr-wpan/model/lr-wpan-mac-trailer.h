@@ -102,16 +102,24 @@ class LrWpanMacTrailer : public Trailer
     bool IsFcsEnabled();
 
   private:
+    /**
+     * Calculate the 16-bit FCS value over the content of a packet.
+     *
+     * \param p the packet, without the MAC trailer
+     * \return the checksum
+     */
+    uint16_t GenerateCrc16(Ptr<const Packet> p);
+
     /**
      * Calculate the 16-bit FCS value.
      * CRC16-CCITT with a generator polynomial = ^16 + ^12 + ^5 + 1, LSB first and
-     * initial value = 0x0000.
+     * initial value = 0x0000. The CRC is computed one octet at a time with a lookup table.
      *
      * \param data the checksum will be calculated over this data
      * \param length the length of the data
      * \return the checksum
      */
-    uint16_t GenerateCrc16(uint8_t* data, int length);
+    uint16_t GenerateCrc16(const uint8_t* data, uint32_t length);
 
     /**
      * The FCS value stored in this trailer.
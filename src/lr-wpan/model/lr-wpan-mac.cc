@@ -37,6 +37,11 @@
 #include <ns3/simulator.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT std::clog << "[address " << m_shortAddress << "] ";
 
@@ -46,6 +51,65 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("LrWpanMac");
 NS_OBJECT_ENSURE_REGISTERED(LrWpanMac);
 
+/**
+ * Get the key of an extended address in the index of the pending transaction list.
+ * \param address the extended address
+ * \return the address as an integer
+ */
+static uint64_t
+GetIndTxQueueKey(Mac64Address address)
+{
+    uint8_t buffer[8];
+    address.CopyTo(buffer);
+    uint64_t key = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        key = (key << 8) | buffer[i];
+    }
+    return key;
+}
+
+/**
+ * Get the key of a short address in the index of the pending transaction list.
+ * \param address the short address
+ * \return the address as an integer
+ */
+static uint16_t
+GetIndTxQueueKey(Mac16Address address)
+{
+    uint8_t buffer[2];
+    address.CopyTo(buffer);
+    return (static_cast<uint16_t>(buffer[0]) << 8) | buffer[1];
+}
+
+/**
+ * Build the GTS Characteristics field of a GTS request command.
+ * \param gtsCharacteristics the GTS characteristics
+ * \return the GTS Characteristics field (See IEEE 802.15.4-2011 Section 5.3.9.2)
+ */
+static uint8_t
+GetGtsCharacteristicsField(GtsCharacteristics gtsCharacteristics)
+{
+    return (gtsCharacteristics.m_gtsLength & 0x0F) |              // Bits 0-3
+           (static_cast<uint8_t>(gtsCharacteristics.m_gtsDirection) << 4) | // Bit 4
+           (static_cast<uint8_t>(gtsCharacteristics.m_allocation) << 5);    // Bit 5
+}
+
+/**
+ * Read the GTS characteristics from the GTS Characteristics field of a GTS request command.
+ * \param gtsCharacteristicsField the GTS Characteristics field
+ * \return the GTS characteristics
+ */
+static GtsCharacteristics
+GetGtsCharacteristics(uint8_t gtsCharacteristicsField)
+{
+    GtsCharacteristics gtsCharacteristics;
+    gtsCharacteristics.m_gtsLength = gtsCharacteristicsField & 0x0F;
+    gtsCharacteristics.m_gtsDirection = (gtsCharacteristicsField >> 4) & 0x01;
+    gtsCharacteristics.m_allocation = (gtsCharacteristicsField >> 5) & 0x01;
+    return gtsCharacteristics;
+}
+
 TypeId
 LrWpanMac::GetTypeId()
 {
@@ -59,6 +123,13 @@ LrWpanMac::GetTypeId()
                           UintegerValue(),
                           MakeUintegerAccessor(&LrWpanMac::m_macPanId),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("TxQueueMaxSize",
+                          "The maximum number of MSDUs in the transmit queue and in each "
+                          "GTS transmit queue, 0 for no limit",
+                          UintegerValue(32),
+                          MakeUintegerAccessor(&LrWpanMac::SetTxQMaxSize,
+                                               &LrWpanMac::GetTxQMaxSize),
+                          MakeUintegerChecker<uint32_t>())
             .AddTraceSource("MacTxEnqueue",
                             "Trace source indicating a packet has been "
                             "enqueued in the transaction queue",
@@ -154,7 +225,51 @@ LrWpanMac::GetTypeId()
                             "Trace source reporting the end of an "
                             "Interframe space (IFS)",
                             MakeTraceSourceAccessor(&LrWpanMac::m_macIfsEndTrace),
-                            "ns3::Packet::TracedCallback");
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("LLDNTimeToOnline",
+                            "Trace source reporting the time needed by a LLDN "
+                            "device to go through the Discovery and Configuration "
+                            "states and enter the Online state",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llTimeToOnlineTrace),
+                            "ns3::LrWpanMac::LLDNTimeToOnlineTracedCallback")
+            .AddTraceSource("LLDNSuperframe",
+                            "Trace source reporting the start and the duration "
+                            "of each LLDN superframe",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llSuperframeTrace),
+                            "ns3::LrWpanMac::LLDNSuperframeTracedCallback")
+            .AddTraceSource("LLDNTimeslotOccupancy",
+                            "Trace source reporting, at the end of each LLDN "
+                            "superframe, whether the PAN-C received a frame in "
+                            "each uplink base timeslot",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llTimeslotOccupancyTrace),
+                            "ns3::LrWpanMac::LLDNTimeslotOccupancyTracedCallback")
+            .AddTraceSource("LLDNTimeslotTx",
+                            "Trace source reporting the frames sent by a LLDN "
+                            "device in a base timeslot",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llTimeslotTxTrace),
+                            "ns3::LrWpanMac::LLDNTimeslotTxTracedCallback")
+            .AddTraceSource("LLDNGroupAckMiss",
+                            "Trace source reporting the frames of a LLDN device "
+                            "not acknowledged in the group acknowledgement",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llGroupAckMissTrace),
+                            "ns3::LrWpanMac::LLDNGroupAckMissTracedCallback")
+            .AddTraceSource("LLDNDataLatency",
+                            "Trace source reporting the latency of the frames "
+                            "delivered in a LLDN timeslot, from their enqueue to "
+                            "the end of their successful transmission",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llDataLatencyTrace),
+                            "ns3::LrWpanMac::LLDNDataLatencyTracedCallback")
+            .AddTraceSource("LLDNBeaconToData",
+                            "Trace source reporting the delay between the LL "
+                            "beacon and the LL-DATA frames received by the PAN-C",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llBeaconToDataTrace),
+                            "ns3::LrWpanMac::LLDNBeaconToDataTracedCallback")
+            .AddTraceSource("LLDNSlotMiss",
+                            "Trace source reporting the timeslots and the LL "
+                            "beacons missed by a LLDN device because its clock "
+                            "error exceeds the guard time",
+                            MakeTraceSourceAccessor(&LrWpanMac::m_llSlotMissTrace),
+                            "ns3::LrWpanMac::LLDNSlotMissTracedCallback");
     return tid;
 }
 
@@ -192,6 +307,7 @@ LrWpanMac::LrWpanMac()
     m_macSuperframeOrder = 15;
     m_macTransactionPersistenceTime = 500; // 0x01F5
     m_macAssociationPermit = true;
+    m_macGtsPermit = true;
     m_macAutoRequest = true;
 
     m_incomingBeaconOrder = 15;
@@ -206,8 +322,15 @@ LrWpanMac::LrWpanMac()
     m_macResponseWaitTime = aBaseSuperframeDuration * 32;
     m_assocRespCmdWaitTime = 960;
 
-    m_maxTxQueueSize = m_txQueue.max_size();
-    m_maxIndTxQueueSize = m_indTxQueue.max_size();
+    m_txQueueDropPolicy = TX_QUEUE_TAIL_DROP;
+    m_txQueueStaleTime = Seconds(1);
+    m_maxIndTxQueueSize = std::numeric_limits<uint32_t>::max();
+    m_indTxQueueNextId = 0;
+    m_pollPending = false;
+    m_gtsRequestPending = false;
+    m_gtsTxQueue = nullptr;
+    m_gtsTx = false;
+    m_gtsRxOn = false;
 
     Ptr<UniformRandomVariable> uniformVar = CreateObject<UniformRandomVariable>();
     uniformVar->SetAttribute("Min", DoubleValue(0.0));
@@ -224,11 +347,46 @@ LrWpanMac::LrWpanMac()
     m_macLLDNnumUplinkTS = 20;
     m_macLLDNnumRetransmitTS = 0;
     m_macLLDNnumBidirectionalTS = 0;
+    m_macLLDNnumSharedGroupTS = 0;
     m_macLLDNmgmtTS = false;
     m_macLLDNlowLatencyNWid = 0xff;
     m_macLLDNdiscoveryModeTimeout = 256;
     m_macLLDNcoordinator = false;
+    m_macLLDNassignedTimeSlot = 0xff;
+    m_mlmeLLTransmissionState = FlagsField::DISCOVERY_STATE;
+    m_mlmeLLTransmissionDirection = FlagsField::UPLINK;
+    m_mlmeLLTimeSlotPerMgmtTS = 0;
     m_mlmeLLTimeslotSize = 40; // Maximum LL frame data payload size in octect
+
+    m_llCurrentTimeslot = 0;
+    m_llCurrentTimeslotType = LLDN_TS_UNUSED;
+    m_llTimeslotTx = false;
+    m_llGroupAckPending = false;
+    m_llGroupAckTimeslot = 0;
+    m_llMgmtTx = false;
+    m_llMgmtCmd = CommandPayloadHeader::CMD_RESERVED;
+    m_llMgmtBE = 0;
+    m_llMgmtBackoff = 0;
+    m_llSharedBE = 0;
+    m_llSharedBackoff = 0;
+    m_llDiscovered = false;
+    m_llConfigStatusAcked = false;
+    m_llConfigured = false;
+    m_llBringUpStart = Seconds(-1);
+    m_llNextSimpleAddress = 0;
+    m_llSlotPlanner = false;
+    m_llReqPayloadSize = 0;
+    m_llReqPeriod = Seconds(0);
+    m_llNumAssignedTimeslots = 1;
+    m_llSleepEnabled = false;
+    m_llGuardTime = MicroSeconds(500);
+    m_llClockDrift = 0;
+    m_llClockDriftWalk = 0;
+    m_llSyncTime = Seconds(-1);
+    m_llDriftStream = -1;
+    m_llWakeTime = Seconds(0);
+    m_llWakeForUplink = false;
+    m_llRandom = CreateObject<UniformRandomVariable>();
 }
 
 LrWpanMac::~LrWpanMac()
@@ -260,21 +418,19 @@ LrWpanMac::DoDispose()
     }
     m_txPkt = nullptr;
 
-    for (uint32_t i = 0; i < m_txQueue.size(); i++)
-    {
-        m_txQueue[i]->txQPkt = nullptr;
-        m_txQueue[i]->txQMsduHandle = 0;
-    }
-    m_txQueue.clear();
+    m_txQueue.Clear();
 
-    for (uint32_t i = 0; i < m_indTxQueue.size(); i++)
-    {
-        m_indTxQueue[i]->txQPkt = nullptr;
-        m_indTxQueue[i]->seqNum = 0;
-        m_indTxQueue[i]->dstExtAddress = nullptr;
-        m_indTxQueue[i]->dstShortAddress = nullptr;
-    }
     m_indTxQueue.clear();
+    m_indTxQueueExtIndex.clear();
+    m_indTxQueueShortIndex.clear();
+    m_indTxQueueExpiry = decltype(m_indTxQueueExpiry)();
+
+    m_gtsTxQueue = nullptr;
+    m_gtsTxQueues.clear();
+    m_gtsList.clear();
+    m_outGtsList.clear();
+    m_gtsDenied.clear();
+    m_incGtsList.clear();
 
     m_phy = nullptr;
     m_mcpsDataConfirmCallback = MakeNullCallback<void, McpsDataConfirmParams>();
@@ -284,16 +440,46 @@ LrWpanMac::DoDispose()
         MakeNullCallback<void, MlmeBeaconNotifyIndicationParams, Ptr<Packet>>();
     m_mlmeSyncLossIndicationCallback = MakeNullCallback<void, MlmeSyncLossIndicationParams>();
     m_mlmePollConfirmCallback = MakeNullCallback<void, MlmePollConfirmParams>();
+    m_mlmeGtsConfirmCallback = MakeNullCallback<void, MlmeGtsConfirmParams>();
+    m_mlmeGtsIndicationCallback = MakeNullCallback<void, MlmeGtsIndicationParams>();
     m_mlmeScanConfirmCallback = MakeNullCallback<void, MlmeScanConfirmParams>();
     m_mlmeAssociateConfirmCallback = MakeNullCallback<void, MlmeAssociateConfirmParams>();
     m_mlmeAssociateIndicationCallback = MakeNullCallback<void, MlmeAssociateIndicationParams>();
     m_mlmeCommStatusIndicationCallback = MakeNullCallback<void, MlmeCommStatusIndicationParams>();
 
     m_beaconEvent.Cancel();
+    m_llTimeslotEvent.Cancel();
+    m_llSleepEvent.Cancel();
+    m_llWakeEvent.Cancel();
+    m_llDiscoveryTimeoutEvent.Cancel();
+    m_llConfigurationTimeoutEvent.Cancel();
+    m_llMgmtSubslotEvent.Cancel();
+    m_llMgmtAckEvent.Cancel();
+    m_llPlanEvent.Cancel();
+    m_pollWaitTimeout.Cancel();
+    m_gtsRequestTimeout.Cancel();
+    m_gtsEvent.Cancel();
+    m_gtsEndEvent.Cancel();
+    m_llMgmtPkt = nullptr;
+    m_llDevices.clear();
+    m_llConfigRequestQueue.clear();
 
     Object::DoDispose();
 }
 
+int64_t
+LrWpanMac::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_llRandom->SetStream(stream);
+    m_llDriftStream = stream + 1;
+    if (m_llDriftRandom)
+    {
+        m_llDriftRandom->SetStream(m_llDriftStream);
+    }
+    return 2;
+}
+
 bool
 LrWpanMac::GetRxOnWhenIdle()
 {
@@ -347,6 +533,13 @@ LrWpanMac::GetShortAddress() const
     return m_shortAddress;
 }
 
+Mac8Address
+LrWpanMac::GetSimpleAddress() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_simpleAddress;
+}
+
 Mac64Address
 LrWpanMac::GetExtendedAddress() const
 {
@@ -367,6 +560,12 @@ LrWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
     //       The current tx drop trace is not suitable, because packets dropped using this trace
     //       carry the mac header and footer, while packets being dropped here do not have them.
 
+    if (params.m_srcAddrMode == SIMPLE_ADDR || params.m_dstAddrMode == SIMPLE_ADDR)
+    {
+        LLDataRequest(params, p);
+        return;
+    }
+
     LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_DATA, m_macDsn.GetValue());
     m_macDsn++;
 
@@ -400,10 +599,6 @@ LrWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
         macHdr.SetSrcAddrMode(params.m_srcAddrMode);
         macHdr.SetNoPanIdComp();
         break;
-    case SIMPLE_ADDR:
-        // TODO : LLDN mode
-        NS_ABORT_MSG("Can not set source address type to ADDR_MODE_RESERVED. Aborting.");
-        break;
     case SHORT_ADDR:
         macHdr.SetSrcAddrMode(params.m_srcAddrMode);
         macHdr.SetSrcAddrFields(GetPanId(), GetShortAddress());
@@ -428,10 +623,6 @@ LrWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
         macHdr.SetDstAddrMode(params.m_dstAddrMode);
         macHdr.SetNoPanIdComp();
         break;
-    case SIMPLE_ADDR:
-        // TODO : LLDN mode
-        NS_ABORT_MSG("Can not set destination address type to ADDR_MODE_RESERVED. Aborting.");
-        break;
     case SHORT_ADDR:
         macHdr.SetDstAddrMode(params.m_dstAddrMode);
         macHdr.SetDstAddrFields(params.m_dstPanId, params.m_dstAddr);
@@ -502,7 +693,67 @@ LrWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
     // process b1 in TX_OPTION for GTS action / CAP action
     if (b1 == TX_OPTION_GTS)
     {
-        // TODO:GTS Transmission
+        // GTS Tx
+        // The frame waits in the queue of the GTS and is sent without CSMA-CA in the CFP.
+        // A device transmits in its transmit-only GTS, a coordinator transmits in the
+        // receive-only GTS of the destination device.
+        auto gtsTxQueue = m_gtsTxQueues.end();
+        if (params.m_dstAddrMode == SHORT_ADDR)
+        {
+            gtsTxQueue = m_gtsTxQueues.find(std::make_pair(params.m_dstAddr, true));
+        }
+        if (gtsTxQueue == m_gtsTxQueues.end())
+        {
+            gtsTxQueue = m_gtsTxQueues.find(std::make_pair(m_shortAddress, false));
+        }
+
+        if (gtsTxQueue == m_gtsTxQueues.end())
+        {
+            NS_LOG_ERROR(this << " No valid GTS to send the packet");
+            confirmParams.m_status = IEEE_802_15_4_INVALID_GTS;
+            if (!m_mcpsDataConfirmCallback.IsNull())
+            {
+                m_mcpsDataConfirmCallback(confirmParams);
+            }
+            return;
+        }
+
+        p->AddHeader(macHdr);
+
+        LrWpanMacTrailer macTrailer;
+        // Calculate FCS if the global attribute ChecksumEnable is set.
+        if (Node::ChecksumEnabled())
+        {
+            macTrailer.EnableFcs(true);
+            macTrailer.SetFcs(p);
+        }
+        p->AddTrailer(macTrailer);
+
+        if (gtsTxQueue->second.IsFull())
+        {
+            NS_LOG_DEBUG("GTS Queue with size " << gtsTxQueue->second.GetSize()
+                                                << " is full, dropping packet");
+            m_macTxDropTrace(p);
+            confirmParams.m_status = IEEE_802_15_4_TRANSACTION_OVERFLOW;
+            if (!m_mcpsDataConfirmCallback.IsNull())
+            {
+                m_mcpsDataConfirmCallback(confirmParams);
+            }
+            return;
+        }
+
+        TxQueueElement txQElement;
+        txQElement.txQMsduHandle = params.m_msduHandle;
+        txQElement.txQPkt = p;
+        txQElement.txQEnqueueTime = Simulator::Now();
+        gtsTxQueue->second.PushBack(std::move(txQElement));
+        m_macTxEnqueueTrace(p);
+
+        if (m_gtsTxQueue == &gtsTxQueue->second)
+        {
+            // The frame was requested during its GTS.
+            GtsTransmit();
+        }
     }
     else if (b2 == TX_OPTION_INDIRECT)
     {
@@ -527,11 +778,7 @@ LrWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
         }
         p->AddTrailer(macTrailer);
 
-        NS_LOG_ERROR(this << " Indirect transmissions not currently supported");
-        // Note: The current Pending transaction list should work for indirect transmissions.
-        // However, this is not tested yet. For now, we block the use of indirect transmissions.
-        // TODO: Save packet in the Pending Transaction list.
-        // EnqueueInd (p);
+        EnqueueInd(p, params.m_msduHandle);
     }
     else
     {
@@ -552,9 +799,9 @@ LrWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
         }
         p->AddTrailer(macTrailer);
 
-        Ptr<TxQueueElement> txQElement = Create<TxQueueElement>();
-        txQElement->txQMsduHandle = params.m_msduHandle;
-        txQElement->txQPkt = p;
+        TxQueueElement txQElement;
+        txQElement.txQMsduHandle = params.m_msduHandle;
+        txQElement.txQPkt = p;
         EnqueueTxQElement(txQElement);
         CheckQueue();
     }
@@ -792,7 +1039,7 @@ LrWpanMac::MlmeAssociateResponse(MlmeAssociateResponseParams params)
     commandPacket->AddTrailer(macTrailer);
 
     // Save packet in the Pending Transaction list.
-    EnqueueInd(commandPacket);
+    EnqueueInd(commandPacket, 0);
 }
 
 void
@@ -801,7 +1048,6 @@ LrWpanMac::MlmeSyncRequest(MlmeSyncRequestParams params)
     NS_LOG_FUNCTION(this);
     NS_ASSERT(params.m_logCh <= 26 && m_macPanId != 0xffff);
 
-    uint64_t symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false); // symbols per second
     // change phy current logical channel
     LrWpanPhyPibAttributes pibAttr;
     pibAttr.phyCurrentChannel = params.m_logCh;
@@ -822,8 +1068,8 @@ LrWpanMac::MlmeSyncRequest(MlmeSyncRequestParams params)
     {
         m_numLostBeacons = 0;
         // search for a beacon for a time = incomingSuperframe symbols + 960 symbols
-        searchSymbols = ((uint64_t)1 << m_incomingBeaconOrder) + 1 * aBaseSuperframeDuration;
-        searchBeaconTime = Seconds((double)searchSymbols / symbolRate);
+        searchSymbols = (((uint64_t)1 << m_incomingBeaconOrder) + 1) * aBaseSuperframeDuration;
+        searchBeaconTime = GetSymbolsTime(searchSymbols);
         m_beaconTrackingOn = true;
         m_trackingEvent =
             Simulator::Schedule(searchBeaconTime, &LrWpanMac::BeaconSearchTimeout, this);
@@ -839,21 +1085,254 @@ LrWpanMac::MlmePollRequest(MlmePollRequestParams params)
 {
     NS_LOG_FUNCTION(this);
 
-    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, m_macBsn.GetValue());
-    m_macBsn++;
+    if ((params.m_coorAddrMode != SHORT_ADDR && params.m_coorAddrMode != EXT_ADDR) ||
+        m_pollPending)
+    {
+        if (!m_mlmePollConfirmCallback.IsNull())
+        {
+            MlmePollConfirmParams pollConfirmParams;
+            pollConfirmParams.m_status = MLMEPOLL_INVALID_PARAMETER;
+            m_mlmePollConfirmCallback(pollConfirmParams);
+        }
+        return;
+    }
+
+    // Data request command, see IEEE 802.15.4-2011 Section 5.3.4
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, m_macDsn.GetValue());
+    m_macDsn++;
+    LrWpanMacTrailer macTrailer;
+    Ptr<Packet> commandPacket = Create<Packet>();
+
+    // The short address is used once allocated by the coordinator
+    if (m_shortAddress == Mac16Address("ff:fe") || m_shortAddress == Mac16Address("ff:ff"))
+    {
+        macHdr.SetSrcAddrMode(LrWpanMacHeader::EXTADDR);
+        macHdr.SetSrcAddrFields(params.m_coorPanId, m_selfExt);
+    }
+    else
+    {
+        macHdr.SetSrcAddrMode(LrWpanMacHeader::SHORTADDR);
+        macHdr.SetSrcAddrFields(params.m_coorPanId, m_shortAddress);
+    }
+
+    if (params.m_coorAddrMode == SHORT_ADDR)
+    {
+        macHdr.SetDstAddrMode(LrWpanMacHeader::SHORTADDR);
+        macHdr.SetDstAddrFields(params.m_coorPanId, params.m_coorShortAddr);
+    }
+    else
+    {
+        macHdr.SetDstAddrMode(LrWpanMacHeader::EXTADDR);
+        macHdr.SetDstAddrFields(params.m_coorPanId, params.m_coorExtAddr);
+    }
+
+    macHdr.SetPanIdComp();
+    macHdr.SetSecDisable();
+    macHdr.SetAckReq();
 
     CommandPayloadHeader macPayload(CommandPayloadHeader::DATA_REQ);
 
-    Ptr<Packet> beaconPacket = Create<Packet>();
-    // TODO: complete poll request (part of indirect transmissions)
-    NS_FATAL_ERROR(this << " Poll request currently not supported");
+    commandPacket->AddHeader(macPayload);
+    commandPacket->AddHeader(macHdr);
+
+    // Calculate FCS if the global attribute ChecksumEnable is set.
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(commandPacket);
+    }
+
+    commandPacket->AddTrailer(macTrailer);
+
+    m_pollPending = true;
+    m_pollParams = params;
+
+    TxQueueElement txQElement;
+    txQElement.txQPkt = commandPacket;
+    EnqueueTxQElement(txQElement);
+    CheckQueue();
+}
+
+void
+LrWpanMac::MlmeGtsRequest(MlmeGtsRequestParams params)
+{
+    NS_LOG_FUNCTION(this);
+
+    MlmeGtsConfirmParams confirmParams;
+    confirmParams.m_gtsCharacteristics = params.m_gtsCharacteristics;
+
+    // See IEEE 802.15.4-2011 Section 5.1.7.2
+    if (m_shortAddress == Mac16Address("ff:fe") || m_shortAddress == Mac16Address("ff:ff"))
+    {
+        confirmParams.m_status = MLMEGTS_NO_SHORT_ADDRESS;
+        if (!m_mlmeGtsConfirmCallback.IsNull())
+        {
+            m_mlmeGtsConfirmCallback(confirmParams);
+        }
+        return;
+    }
+
+    const GtsCharacteristics& gts = params.m_gtsCharacteristics;
+    bool allocated = false;
+    for (const auto& incGts : m_incGtsList)
+    {
+        if (incGts.direction == gts.m_gtsDirection)
+        {
+            allocated = true;
+        }
+    }
+
+    if (gts.m_gtsLength == 0 || gts.m_gtsLength > 15 || m_incomingBeaconOrder == 15 ||
+        m_gtsRequestPending || (gts.m_allocation == allocated))
+    {
+        confirmParams.m_status = MLMEGTS_INVALID_PARAMETER;
+        if (!m_mlmeGtsConfirmCallback.IsNull())
+        {
+            m_mlmeGtsConfirmCallback(confirmParams);
+        }
+        return;
+    }
+
+    // GTS request command, see IEEE 802.15.4-2011 Section 5.3.9
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, m_macDsn.GetValue());
+    m_macDsn++;
+    LrWpanMacTrailer macTrailer;
+    Ptr<Packet> commandPacket = Create<Packet>();
+
+    macHdr.SetSrcAddrMode(LrWpanMacHeader::SHORTADDR);
+    macHdr.SetSrcAddrFields(m_macPanId, m_shortAddress);
+
+    if (m_macCoordShortAddress == Mac16Address("ff:fe"))
+    {
+        macHdr.SetDstAddrMode(LrWpanMacHeader::EXTADDR);
+        macHdr.SetDstAddrFields(m_macPanId, m_macCoordExtendedAddress);
+    }
+    else
+    {
+        macHdr.SetDstAddrMode(LrWpanMacHeader::SHORTADDR);
+        macHdr.SetDstAddrFields(m_macPanId, m_macCoordShortAddress);
+    }
+
+    macHdr.SetPanIdComp();
+    macHdr.SetSecDisable();
+    macHdr.SetAckReq();
+
+    CommandPayloadHeader macPayload(CommandPayloadHeader::GTS_REQ);
+    macPayload.SetGtsCharacteristics(GetGtsCharacteristicsField(gts));
+
+    commandPacket->AddHeader(macPayload);
+    commandPacket->AddHeader(macHdr);
+
+    // Calculate FCS if the global attribute ChecksumEnable is set.
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(commandPacket);
+    }
+
+    commandPacket->AddTrailer(macTrailer);
+
+    m_gtsRequestPending = true;
+    m_gtsRequest = gts;
+
+    TxQueueElement txQElement;
+    txQElement.txQPkt = commandPacket;
+    EnqueueTxQElement(txQElement);
+    CheckQueue();
 }
 
 
 void
 LrWpanMac::MlmeLLDiscoveryStart()
 {
-    SendOneLLBeacon();
+    MlmeLLDNDiscoveryRequest(MlmeLLDNDiscoveryRequstParams());
+}
+
+void
+LrWpanMac::MlmeLLDNDiscoveryRequest(MlmeLLDNDiscoveryRequstParams params)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_macLLenabled && m_macLLDNcoordinator,
+                  "MLME-LLDN-DISCOVERY.request is only valid in a LLDN PAN coordinator");
+
+    // A new discovery forgets the previous configuration of the network.
+    m_mlmeLLTransmissionState = FlagsField::DISCOVERY_STATE;
+    m_llDevices.clear();
+    m_llConfigRequestQueue.clear();
+    m_llTimeslotOwners.clear();
+    m_llNextSimpleAddress = 0;
+    m_llPlan = LrWpanMlmeLLNetworkConfiguration();
+    m_llPlanEvent.Cancel();
+    m_llConfigurationTimeoutEvent.Cancel();
+
+    m_llDiscoveryTimeoutEvent.Cancel();
+    m_llDiscoveryTimeoutEvent = Simulator::Schedule(Seconds(m_macLLDNdiscoveryModeTimeout),
+                                                    &LrWpanMac::LLDiscoveryTimeout,
+                                                    this);
+
+    if (!m_llTimeslotEvent.IsRunning() && m_lrWpanMacState == MAC_IDLE)
+    {
+        SendOneLLBeacon();
+    }
+}
+
+void
+LrWpanMac::MlmeLLDNConfigurationRequest(MlmeLLDNConfigurationRequestParams params)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_macLLenabled && m_macLLDNcoordinator,
+                  "MLME-LLDN-CONFIGURATION.request is only valid in a LLDN PAN coordinator");
+
+    if (m_llDiscoveryTimeoutEvent.IsRunning())
+    {
+        m_llDiscoveryTimeoutEvent.Cancel();
+        LLDiscoveryTimeout();
+    }
+
+    m_mlmeLLTransmissionState = FlagsField::CONFIGURATION_STATE;
+
+    m_llConfigurationTimeoutEvent.Cancel();
+    m_llConfigurationTimeoutEvent = Simulator::Schedule(Seconds(m_macLLDNdiscoveryModeTimeout),
+                                                        &LrWpanMac::LLConfigurationEnd,
+                                                        this);
+
+    if (!m_llTimeslotEvent.IsRunning() && m_lrWpanMacState == MAC_IDLE)
+    {
+        SendOneLLBeacon();
+    }
+}
+
+void
+LrWpanMac::MlmeLLDNOnlineRequest(MlmeLLDNOnlineRequestParams params)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_macLLenabled && m_macLLDNcoordinator,
+                  "MLME-LLDN-ONLINE.request is only valid in a LLDN PAN coordinator");
+
+    m_mlmeLLTransmissionState = FlagsField::ONLINE_STATE;
+    m_llDiscoveryTimeoutEvent.Cancel();
+    m_llConfigurationTimeoutEvent.Cancel();
+
+    if (m_llPlanEvent.IsRunning())
+    {
+        LLPlanSuperframe();
+    }
+
+    // The superframe computed by the slot planner replaces the configured one.
+    if (m_llSlotPlanner && m_llPlan.m_timeslotSize > 0)
+    {
+        m_mlmeLLTimeslotSize = m_llPlan.m_timeslotSize;
+        m_macLLDNnumTimeSlots = m_llPlan.m_numTimeSlots;
+        m_macLLDNnumUplinkTS = m_llPlan.m_numUplinkTS;
+        m_macLLDNnumBidirectionalTS = m_llPlan.m_numBidirectionalTS;
+    }
+
+    // If the PAN-C is already sending LL beacons, the Online state
+    // takes effect from the next LL beacon onwards.
+    if (!m_llTimeslotEvent.IsRunning() && m_lrWpanMacState == MAC_IDLE)
+    {
+        SendOneLLBeacon();
+    }
 }
 
 void
@@ -886,9 +1365,19 @@ LrWpanMac::SendOneBeacon()
     macHdr.SetSecDisable();
     macHdr.SetNoAckReq();
 
+    // The GTSs allocated so far are used in the CFP of this superframe,
+    // the CAP ends before the first of them.
+    m_outGtsList = m_gtsList;
+    m_fnlCapSlot = 15;
+    for (const auto& gts : m_outGtsList)
+    {
+        m_fnlCapSlot = std::min<uint8_t>(m_fnlCapSlot, gts.startSlot - 1);
+    }
+
     macPayload.SetSuperframeSpecField(GetSuperframeField());
     macPayload.SetGtsFields(GetGtsFields());
     macPayload.SetPndAddrFields(GetPendingAddrFields());
+    m_gtsDenied.clear();
 
     beaconPacket->AddHeader(macPayload);
     beaconPacket->AddHeader(macHdr);
@@ -931,14 +1420,6 @@ LrWpanMac::SendOneLLBeacon()
     Ptr<Packet> beaconPacket = Create<Packet>();
     LrWpanMacTrailer macTrailer;
 
-    // void SetFlagsFields(FlagsField flagsFields);
-    // void SetLLPanCoordAddr(Mac8Address panCAddr);
-    // void SetConfigurationSeqNum(uint8_t configurationSeqNum);
-    // void SetBaseTimeSlotSize(uint8_t baseTimeSlotSize);
-    // TODO
-    // void SetNumOfBaseTsInSuperframe(uint8_t numOfBaseTSinSuperframe);
-    // void SetgroupAckBmp(uint16_t groupAckBmp);
-
     // Implements the header for the MAC payload command frame according to
     // the IEEE 802.15.4e-2011 section 5.2.2.5.2 LL Beacon frame format
 
@@ -959,11 +1440,15 @@ LrWpanMac::SendOneLLBeacon()
     if(m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE)
     {
         // NumOfBaseTsInSuperframe
+        llMacPayload.SetNumOfBaseTsInSuperframe(m_macLLDNnumTimeSlots);
 
-        // GroupAck Bitmap
-
+        // GroupAck Bitmap: frames received in the previous superframe
+        llMacPayload.SetgroupAckBmp(m_llGroupAckBmp);
     }
 
+    m_llLastGroupAckBmp = m_llGroupAckBmp;
+    m_llGroupAckBmp.assign(m_macLLDNnumTimeSlots, false);
+
     beaconPacket->AddHeader(llMacPayload);
     beaconPacket->AddHeader(llMacHeader);
 
@@ -1026,8 +1511,8 @@ LrWpanMac::SendBeaconRequestCommand()
 
     commandPacket->AddTrailer(macTrailer);
 
-    Ptr<TxQueueElement> txQElement = Create<TxQueueElement>();
-    txQElement->txQPkt = commandPacket;
+    TxQueueElement txQElement;
+    txQElement.txQPkt = commandPacket;
     EnqueueTxQElement(txQElement);
     CheckQueue();
 }
@@ -1075,8 +1560,8 @@ LrWpanMac::SendAssocRequestCommand()
 
     commandPacket->AddTrailer(macTrailer);
 
-    Ptr<TxQueueElement> txQElement = Create<TxQueueElement>();
-    txQElement->txQPkt = commandPacket;
+    TxQueueElement txQElement;
+    txQElement.txQPkt = commandPacket;
     EnqueueTxQElement(txQElement);
     CheckQueue();
 }
@@ -1134,14 +1619,14 @@ LrWpanMac::SendDataRequestCommand()
     commandPacket->AddTrailer(macTrailer);
 
     // Set the Command packet to be transmitted
-    Ptr<TxQueueElement> txQElement = Create<TxQueueElement>();
-    txQElement->txQPkt = commandPacket;
+    TxQueueElement txQElement;
+    txQElement.txQPkt = commandPacket;
     EnqueueTxQElement(txQElement);
     CheckQueue();
 }
 
 void
-LrWpanMac::SendAssocResponseCommand(Ptr<Packet> rxDataReqPkt)
+LrWpanMac::SendPendingTransaction(Ptr<Packet> rxDataReqPkt)
 {
     LrWpanMacHeader receivedMacHdr;
     rxDataReqPkt->RemoveHeader(receivedMacHdr);
@@ -1150,14 +1635,23 @@ LrWpanMac::SendAssocResponseCommand(Ptr<Packet> rxDataReqPkt)
 
     NS_ASSERT(receivedMacPayload.GetCommandFrameType() == CommandPayloadHeader::DATA_REQ);
 
-    Ptr<IndTxQueueElement> indTxQElement = Create<IndTxQueueElement>();
+    IndTxQueueElement indTxQElement;
     bool elementFound;
-    elementFound = DequeueInd(receivedMacHdr.GetExtSrcAddr(), indTxQElement);
+    if (receivedMacHdr.GetSrcAddrMode() == SHORT_ADDR)
+    {
+        elementFound = DequeueInd(receivedMacHdr.GetShortSrcAddr(), indTxQElement);
+    }
+    else
+    {
+        elementFound = DequeueInd(receivedMacHdr.GetExtSrcAddr(), indTxQElement);
+    }
+
     if (elementFound)
     {
-        Ptr<TxQueueElement> txQElement = Create<TxQueueElement>();
-        txQElement->txQPkt = indTxQElement->txQPkt;
-        m_txQueue.emplace_back(txQElement);
+        TxQueueElement txQElement;
+        txQElement.txQMsduHandle = indTxQElement.txQMsduHandle;
+        txQElement.txQPkt = indTxQElement.txQPkt;
+        EnqueueTxQElement(txQElement);
     }
     else
     {
@@ -1165,37 +1659,124 @@ LrWpanMac::SendAssocResponseCommand(Ptr<Packet> rxDataReqPkt)
     }
 }
 
-void
-LrWpanMac::LostAssocRespCommand()
+bool
+LrWpanMac::IsIndTxPending(const LrWpanMacHeader& rxMacHdr)
 {
-    // Association response command was not received, return to default values.
-    m_macPanId = 0xffff;
-    m_macCoordShortAddress = Mac16Address("FF:FF");
-    m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
+    PurgeInd();
 
-    if (!m_mlmeAssociateConfirmCallback.IsNull())
+    if (rxMacHdr.GetSrcAddrMode() == SHORT_ADDR)
     {
-        MlmeAssociateConfirmParams confirmParams;
-        confirmParams.m_assocShortAddr = Mac16Address("FF:FF");
-        confirmParams.m_status = MLMEASSOC_NO_DATA;
-        m_mlmeAssociateConfirmCallback(confirmParams);
+        return m_indTxQueueShortIndex.find(GetIndTxQueueKey(rxMacHdr.GetShortSrcAddr())) !=
+               m_indTxQueueShortIndex.end();
+    }
+    else if (rxMacHdr.GetSrcAddrMode() == EXT_ADDR)
+    {
+        return m_indTxQueueExtIndex.find(GetIndTxQueueKey(rxMacHdr.GetExtSrcAddr())) !=
+               m_indTxQueueExtIndex.end();
     }
+    return false;
 }
 
 void
-LrWpanMac::EndStartRequest()
+LrWpanMac::PollWaitTimeout()
 {
     NS_LOG_FUNCTION(this);
-    // The primitive is no longer pending (Channel & Page have been set)
-    m_pendPrimitive = MLME_NONE;
 
-    if (m_startParams.m_coorRealgn) // Coordinator Realignment
+    m_pollPending = false;
+    if (!m_mlmePollConfirmCallback.IsNull())
     {
-        // TODO: Send realignment request command frame in CSMA/CA
-        NS_LOG_ERROR(this << " Coordinator realignment request not supported");
-        return;
+        MlmePollConfirmParams pollConfirmParams;
+        pollConfirmParams.m_status = MLMEPOLL_NO_DATA;
+        m_mlmePollConfirmCallback(pollConfirmParams);
     }
-    else
+
+    if (m_lrWpanMacState == MAC_IDLE && !m_macRxOnWhenIdle)
+    {
+        m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+    }
+}
+
+bool
+LrWpanMac::IsPollResponse(const McpsDataIndicationParams& params) const
+{
+    bool toThisDevice =
+        (params.m_dstAddrMode == SHORT_ADDR && params.m_dstAddr == m_shortAddress) ||
+        (params.m_dstAddrMode == EXT_ADDR && params.m_dstExtAddr == m_selfExt);
+    if (!toThisDevice)
+    {
+        return false;
+    }
+
+    // The coordinator may answer with the other form of its address.
+    if (params.m_srcAddrMode == SHORT_ADDR)
+    {
+        return params.m_srcAddr == ((m_pollParams.m_coorAddrMode == SHORT_ADDR)
+                                        ? m_pollParams.m_coorShortAddr
+                                        : m_macCoordShortAddress);
+    }
+    else if (params.m_srcAddrMode == EXT_ADDR)
+    {
+        return params.m_srcExtAddr == ((m_pollParams.m_coorAddrMode == EXT_ADDR)
+                                           ? m_pollParams.m_coorExtAddr
+                                           : m_macCoordExtendedAddress);
+    }
+    return false;
+}
+
+uint64_t
+LrWpanMac::GetMacMaxFrameTotalWaitTime() const
+{
+    // See IEEE 802.15.4-2011, Section 6.4.3, Equation 14
+    uint8_t minBE = m_csmaCa->GetMacMinBE();
+    uint8_t maxBE = m_csmaCa->GetMacMaxBE();
+    uint8_t maxBackoffs = m_csmaCa->GetMacMaxCSMABackoffs();
+    uint8_t m = std::min(static_cast<uint8_t>(maxBE - minBE), maxBackoffs);
+
+    uint64_t backoffPeriods = 0;
+    for (uint8_t k = 0; k < m; k++)
+    {
+        backoffPeriods += static_cast<uint64_t>(1) << (minBE + k);
+    }
+    backoffPeriods += ((static_cast<uint64_t>(1) << maxBE) - 1) * (maxBackoffs - m);
+
+    uint64_t phyMaxFrameDuration =
+        m_phy->GetPhySHRDuration() +
+        ceil((LrWpanPhy::aMaxPhyPacketSize + 1) * m_phy->GetPhySymbolsPerOctet());
+
+    return backoffPeriods * m_csmaCa->GetUnitBackoffPeriod() + phyMaxFrameDuration;
+}
+
+void
+LrWpanMac::LostAssocRespCommand()
+{
+    // Association response command was not received, return to default values.
+    m_macPanId = 0xffff;
+    m_macCoordShortAddress = Mac16Address("FF:FF");
+    m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
+
+    if (!m_mlmeAssociateConfirmCallback.IsNull())
+    {
+        MlmeAssociateConfirmParams confirmParams;
+        confirmParams.m_assocShortAddr = Mac16Address("FF:FF");
+        confirmParams.m_status = MLMEASSOC_NO_DATA;
+        m_mlmeAssociateConfirmCallback(confirmParams);
+    }
+}
+
+void
+LrWpanMac::EndStartRequest()
+{
+    NS_LOG_FUNCTION(this);
+    // The primitive is no longer pending (Channel & Page have been set)
+    m_pendPrimitive = MLME_NONE;
+
+    if (m_startParams.m_coorRealgn) // Coordinator Realignment
+    {
+        // TODO: Send realignment request command frame in CSMA/CA
+        NS_LOG_ERROR(this << " Coordinator realignment request not supported");
+        return;
+    }
+    else
     {
         if (m_startParams.m_panCoor)
         {
@@ -1241,10 +1822,7 @@ LrWpanMac::EndStartRequest()
 
             m_csmaCa->SetSlottedCsmaCa();
 
-            // TODO: Calculate the real Final CAP slot (requires GTS implementation)
-            //  FinalCapSlot = Superframe duration slots - CFP slots.
-            //  In the current implementation the value of the final cap slot is equal to
-            //  the total number of possible slots in the superframe (15).
+            // The final CAP slot is updated with the allocated GTSs before each beacon.
             m_fnlCapSlot = 15;
 
             m_beaconInterval =
@@ -1375,20 +1953,17 @@ LrWpanMac::StartCAP(SuperframeType superframeType)
     uint32_t activeSlot;
     uint64_t capDuration;
     Time endCapTime;
-    uint64_t symbolRate;
-
-    symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false); // symbols per second
 
     if (superframeType == OUTGOING)
     {
         m_outSuperframeStatus = CAP;
         activeSlot = m_superframeDuration / 16;
         capDuration = activeSlot * (m_fnlCapSlot + 1);
-        endCapTime = Seconds((double)capDuration / symbolRate);
+        endCapTime = GetSymbolsTime(capDuration);
         // Obtain the end of the CAP by adjust the time it took to send the beacon
         endCapTime -= (Simulator::Now() - m_macBeaconTxTime);
 
-        NS_LOG_DEBUG("Outgoing superframe CAP duration " << (endCapTime.GetSeconds() * symbolRate)
+        NS_LOG_DEBUG("Outgoing superframe CAP duration " << GetTimeSymbols(endCapTime)
                                                          << " symbols (" << endCapTime.As(Time::S)
                                                          << ")");
         NS_LOG_DEBUG("Active Slots duration " << activeSlot << " symbols");
@@ -1401,11 +1976,11 @@ LrWpanMac::StartCAP(SuperframeType superframeType)
         m_incSuperframeStatus = CAP;
         activeSlot = m_incomingSuperframeDuration / 16;
         capDuration = activeSlot * (m_incomingFnlCapSlot + 1);
-        endCapTime = Seconds((double)capDuration / symbolRate);
+        endCapTime = GetSymbolsTime(capDuration);
         // Obtain the end of the CAP by adjust the time it took to receive the beacon
         endCapTime -= (Simulator::Now() - m_macBeaconRxTime);
 
-        NS_LOG_DEBUG("Incoming superframe CAP duration " << (endCapTime.GetSeconds() * symbolRate)
+        NS_LOG_DEBUG("Incoming superframe CAP duration " << GetTimeSymbols(endCapTime)
                                                          << " symbols (" << endCapTime.As(Time::S)
                                                          << ")");
         NS_LOG_DEBUG("Active Slots duration " << activeSlot << " symbols");
@@ -1423,15 +1998,12 @@ LrWpanMac::StartCFP(SuperframeType superframeType)
     uint32_t activeSlot;
     uint64_t cfpDuration;
     Time endCfpTime;
-    uint64_t symbolRate;
-
-    symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false); // symbols per second
 
     if (superframeType == INCOMING)
     {
         activeSlot = m_incomingSuperframeDuration / 16;
         cfpDuration = activeSlot * (15 - m_incomingFnlCapSlot);
-        endCfpTime = Seconds((double)cfpDuration / symbolRate);
+        endCfpTime = GetSymbolsTime(cfpDuration);
         if (cfpDuration > 0)
         {
             m_incSuperframeStatus = CFP;
@@ -1449,7 +2021,7 @@ LrWpanMac::StartCFP(SuperframeType superframeType)
     {
         activeSlot = m_superframeDuration / 16;
         cfpDuration = activeSlot * (15 - m_fnlCapSlot);
-        endCfpTime = Seconds((double)cfpDuration / symbolRate);
+        endCfpTime = GetSymbolsTime(cfpDuration);
 
         if (cfpDuration > 0)
         {
@@ -1464,7 +2036,393 @@ LrWpanMac::StartCFP(SuperframeType superframeType)
                                          this,
                                          SuperframeType::OUTGOING);
     }
-    // TODO: Start transmit or receive  GTS here.
+
+    ScheduleNextGts(superframeType,
+                    ((superframeType == INCOMING) ? m_incomingFnlCapSlot : m_fnlCapSlot) + 1);
+}
+
+void
+LrWpanMac::ScheduleNextGts(SuperframeType superframeType, uint8_t slot)
+{
+    const std::vector<GtsDescriptor>& gtsList =
+        (superframeType == INCOMING) ? m_incGtsList : m_outGtsList;
+
+    auto nextGts = gtsList.end();
+    for (auto it = gtsList.begin(); it != gtsList.end(); it++)
+    {
+        if (it->startSlot >= slot &&
+            (nextGts == gtsList.end() || it->startSlot < nextGts->startSlot))
+        {
+            nextGts = it;
+        }
+    }
+
+    if (nextGts == gtsList.end())
+    {
+        return;
+    }
+
+    uint64_t slotSymbols;
+    Time superframeStart;
+    if (superframeType == INCOMING)
+    {
+        slotSymbols = m_incomingSuperframeDuration / 16;
+        superframeStart = m_macBeaconRxTime;
+    }
+    else
+    {
+        slotSymbols = m_superframeDuration / 16;
+        superframeStart = m_macBeaconTxTime;
+    }
+
+    Time gtsStart = superframeStart + GetSymbolsTime(nextGts->startSlot * slotSymbols);
+    Time delay = std::max(gtsStart - Simulator::Now(), Time(0));
+
+    NS_LOG_DEBUG("GTS of " << nextGts->devAddress << " starts at slot "
+                           << static_cast<uint32_t>(nextGts->startSlot) << " ("
+                           << gtsStart.As(Time::S) << ")");
+
+    m_gtsEvent = Simulator::Schedule(delay, &LrWpanMac::StartGts, this, superframeType, *nextGts);
+}
+
+void
+LrWpanMac::StartGts(SuperframeType superframeType, GtsDescriptor gts)
+{
+    NS_LOG_FUNCTION(this << gts.devAddress << static_cast<uint32_t>(gts.startSlot)
+                         << static_cast<uint32_t>(gts.length) << gts.direction);
+
+    uint64_t slotSymbols = ((superframeType == INCOMING) ? m_incomingSuperframeDuration
+                                                          : m_superframeDuration) /
+                           16;
+    Time gtsDuration = GetSymbolsTime(gts.length * slotSymbols);
+
+    m_gtsStartTime = Simulator::Now();
+    m_gtsEndTime = m_gtsStartTime + gtsDuration;
+    m_gtsEndEvent = Simulator::Schedule(gtsDuration, &LrWpanMac::EndGts, this);
+
+    // The coordinator transmits in the receive-only GTSs of its devices,
+    // a device transmits in its transmit-only GTS.
+    if ((superframeType == OUTGOING) == gts.direction)
+    {
+        auto it = m_gtsTxQueues.find(std::make_pair(gts.devAddress, gts.direction));
+        if (it != m_gtsTxQueues.end())
+        {
+            m_gtsTxQueue = &it->second;
+            GtsTransmit();
+        }
+    }
+    else
+    {
+        m_gtsRxOn = true;
+        if (m_lrWpanMacState == MAC_IDLE)
+        {
+            m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
+        }
+    }
+
+    ScheduleNextGts(superframeType, gts.startSlot + gts.length);
+}
+
+void
+LrWpanMac::EndGts()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_gtsRxOn = false;
+    if (m_lrWpanMacState == MAC_IDLE && !m_macRxOnWhenIdle && !m_pollWaitTimeout.IsRunning())
+    {
+        m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+    }
+}
+
+void
+LrWpanMac::GtsTransmit()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_lrWpanMacState != MAC_IDLE || m_ifsEvent.IsRunning() || m_setMacState.IsRunning() ||
+        !m_gtsTxQueue || m_gtsTxQueue->IsEmpty() || Simulator::Now() >= m_gtsEndTime)
+    {
+        return;
+    }
+
+    m_txPkt = m_gtsTxQueue->Front().txQPkt;
+    m_gtsTx = true;
+
+    // The whole transaction (frame, ACK and IFS) must fit in the GTS
+    // (See IEEE 802.15.4-2011 Section 5.1.7.4).
+    uint64_t transactionSymbols = GetTxPacketSymbols() + GetIfsSize();
+    if (isTxAckReq())
+    {
+        transactionSymbols += GetMacAckWaitDuration();
+    }
+    Time transactionTime = GetSymbolsTime(transactionSymbols);
+
+    if (transactionTime > m_gtsEndTime - m_gtsStartTime)
+    {
+        NS_LOG_DEBUG("The frame does not fit in the GTS, dropping it");
+        TxQueueElement& txQElement = m_gtsTxQueue->Front();
+        m_macTxDropTrace(txQElement.txQPkt);
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            McpsDataConfirmParams confirmParams;
+            confirmParams.m_msduHandle = txQElement.txQMsduHandle;
+            confirmParams.m_status = IEEE_802_15_4_FRAME_TOO_LONG;
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+        RemoveFirstTxQElement();
+        GtsTransmit();
+        return;
+    }
+
+    if (transactionTime > m_gtsEndTime - Simulator::Now())
+    {
+        NS_LOG_DEBUG("Not enough time left in the GTS, the frame is deferred to the next GTS");
+        m_txPkt = nullptr;
+        m_gtsTx = false;
+        m_retransmission = 0;
+        return;
+    }
+
+    ChangeMacState(MAC_SENDING);
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+}
+
+LrWpanRingBuffer<LrWpanMac::TxQueueElement>&
+LrWpanMac::GetCurrentTxQueue()
+{
+    if (m_gtsTx)
+    {
+        NS_ASSERT(m_gtsTxQueue);
+        return *m_gtsTxQueue;
+    }
+    return m_txQueue;
+}
+
+void
+LrWpanMac::ProcessGtsRequest(Mac16Address devAddress, GtsCharacteristics gtsCharacteristics)
+{
+    NS_LOG_FUNCTION(this << devAddress << static_cast<uint32_t>(gtsCharacteristics.m_gtsLength)
+                         << gtsCharacteristics.m_gtsDirection
+                         << gtsCharacteristics.m_allocation);
+
+    auto gts = std::find_if(m_gtsList.begin(),
+                            m_gtsList.end(),
+                            [&](const GtsDescriptor& allocated) {
+                                return allocated.devAddress == devAddress &&
+                                       allocated.direction == gtsCharacteristics.m_gtsDirection;
+                            });
+
+    GtsDescriptor descriptor;
+    descriptor.devAddress = devAddress;
+    descriptor.length = gtsCharacteristics.m_gtsLength;
+    descriptor.direction = gtsCharacteristics.m_gtsDirection;
+
+    if (gtsCharacteristics.m_allocation)
+    {
+        if (gts != m_gtsList.end())
+        {
+            NS_LOG_DEBUG("GTS already allocated to " << devAddress << ", request ignored");
+            return;
+        }
+
+        // The GTSs are allocated from the end of the superframe (See IEEE 802.15.4-2011
+        // Section 5.1.7.3), the CAP must last at least aMinCAPLength symbols.
+        uint8_t cfpStart = 16;
+        for (const auto& allocated : m_gtsList)
+        {
+            cfpStart = std::min(cfpStart, allocated.startSlot);
+        }
+        uint64_t slotSymbols = m_superframeDuration / 16;
+
+        if (m_macGtsPermit && m_gtsList.size() < 7 && m_macBeaconOrder < 15 &&
+            cfpStart > descriptor.length &&
+            (cfpStart - descriptor.length) * slotSymbols >= aMinCAPLength)
+        {
+            descriptor.startSlot = cfpStart - descriptor.length;
+            m_gtsList.push_back(descriptor);
+            if (descriptor.direction)
+            {
+                m_gtsTxQueues[std::make_pair(devAddress, true)].SetMaxSize(m_txQueue.GetMaxSize());
+            }
+            NS_LOG_DEBUG("GTS allocated to " << devAddress << " at slot "
+                                             << static_cast<uint32_t>(descriptor.startSlot));
+        }
+        else
+        {
+            NS_LOG_DEBUG("GTS request of " << devAddress << " denied");
+            m_gtsDenied.push_back(descriptor);
+            return;
+        }
+    }
+    else
+    {
+        if (gts == m_gtsList.end())
+        {
+            NS_LOG_DEBUG("No GTS allocated to " << devAddress << ", request ignored");
+            return;
+        }
+
+        m_gtsList.erase(gts);
+        if (descriptor.direction)
+        {
+            RemoveGtsTxQueue(devAddress, true);
+        }
+
+        // The CFP is kept contiguous, the remaining GTSs move towards the end
+        // of the superframe (See IEEE 802.15.4-2011 Section 5.1.7.5).
+        std::sort(m_gtsList.begin(),
+                  m_gtsList.end(),
+                  [](const GtsDescriptor& a, const GtsDescriptor& b) {
+                      return a.startSlot > b.startSlot;
+                  });
+        uint8_t next = 16;
+        for (auto& allocated : m_gtsList)
+        {
+            allocated.startSlot = next - allocated.length;
+            next = allocated.startSlot;
+        }
+        NS_LOG_DEBUG("GTS of " << devAddress << " deallocated");
+    }
+
+    if (!m_mlmeGtsIndicationCallback.IsNull())
+    {
+        MlmeGtsIndicationParams indicationParams;
+        indicationParams.m_devAddress = devAddress;
+        indicationParams.m_gtsCharacteristics = gtsCharacteristics;
+        m_mlmeGtsIndicationCallback(indicationParams);
+    }
+}
+
+void
+LrWpanMac::UpdateIncomingGts(const GtsFields& gtsFields)
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<GtsDescriptor> incGtsList;
+    bool requestDescribed = false;
+    bool requestDenied = false;
+
+    for (uint8_t i = 0; i < gtsFields.GetNumGtsDescriptors(); i++)
+    {
+        if (gtsFields.GetGtsDescShortAddr(i) != m_shortAddress)
+        {
+            continue;
+        }
+
+        GtsDescriptor gts;
+        gts.devAddress = m_shortAddress;
+        gts.startSlot = gtsFields.GetGtsDescStartSlot(i);
+        gts.length = gtsFields.GetGtsDescLength(i);
+        gts.direction = gtsFields.GetGtsDescDirection(i);
+
+        if (m_gtsRequestPending && m_gtsRequest.m_allocation &&
+            m_gtsRequestTimeout.IsRunning() && gts.direction == m_gtsRequest.m_gtsDirection)
+        {
+            requestDescribed = true;
+            requestDenied = (gts.startSlot == 0);
+        }
+
+        if (gts.startSlot != 0)
+        {
+            incGtsList.push_back(gts);
+        }
+    }
+
+    // Drop the queue of a transmit GTS which is no longer described,
+    // create the queue of a new transmit GTS.
+    bool txGts = false;
+    for (const auto& gts : incGtsList)
+    {
+        txGts |= !gts.direction;
+    }
+    auto txQueue = m_gtsTxQueues.find(std::make_pair(m_shortAddress, false));
+    if (!txGts && txQueue != m_gtsTxQueues.end() && !m_gtsTx)
+    {
+        RemoveGtsTxQueue(m_shortAddress, false);
+    }
+    else if (txGts && txQueue == m_gtsTxQueues.end())
+    {
+        m_gtsTxQueues[std::make_pair(m_shortAddress, false)].SetMaxSize(m_txQueue.GetMaxSize());
+    }
+
+    m_incGtsList = incGtsList;
+
+    if (requestDescribed)
+    {
+        m_gtsRequestTimeout.Cancel();
+        m_gtsRequestPending = false;
+        if (!m_mlmeGtsConfirmCallback.IsNull())
+        {
+            MlmeGtsConfirmParams confirmParams;
+            confirmParams.m_gtsCharacteristics = m_gtsRequest;
+            confirmParams.m_status = requestDenied ? MLMEGTS_DENIED : MLMEGTS_SUCCESS;
+            m_mlmeGtsConfirmCallback(confirmParams);
+        }
+    }
+}
+
+void
+LrWpanMac::GtsRequestTimeout()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_gtsRequestPending = false;
+    if (!m_mlmeGtsConfirmCallback.IsNull())
+    {
+        MlmeGtsConfirmParams confirmParams;
+        confirmParams.m_gtsCharacteristics = m_gtsRequest;
+        confirmParams.m_status = MLMEGTS_NO_DATA;
+        m_mlmeGtsConfirmCallback(confirmParams);
+    }
+}
+
+void
+LrWpanMac::RemoveGtsTxQueue(Mac16Address devAddress, bool direction)
+{
+    NS_LOG_FUNCTION(this << devAddress << direction);
+
+    auto it = m_gtsTxQueues.find(std::make_pair(devAddress, direction));
+    if (it == m_gtsTxQueues.end())
+    {
+        return;
+    }
+
+    if (m_gtsTxQueue == &it->second)
+    {
+        NS_ASSERT_MSG(!m_gtsTx, "Removing the queue of the GTS frame being sent");
+        m_gtsTxQueue = nullptr;
+    }
+
+    LrWpanRingBuffer<TxQueueElement>& txQueue = it->second;
+    while (!txQueue.IsEmpty())
+    {
+        m_macTxDropTrace(txQueue.Front().txQPkt);
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            McpsDataConfirmParams confirmParams;
+            confirmParams.m_msduHandle = txQueue.Front().txQMsduHandle;
+            confirmParams.m_status = IEEE_802_15_4_INVALID_GTS;
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+        txQueue.PopFront();
+    }
+    m_gtsTxQueues.erase(it);
+}
+
+void
+LrWpanMac::ClearIncomingGts()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_incGtsList.clear();
+    if (!m_gtsTx)
+    {
+        RemoveGtsTxQueue(m_shortAddress, false);
+    }
+    m_gtsEvent.Cancel();
+    m_gtsEndEvent.Cancel();
+    m_gtsRxOn = false;
 }
 
 void
@@ -1472,14 +2430,11 @@ LrWpanMac::StartInactivePeriod(SuperframeType superframeType)
 {
     uint64_t inactiveDuration;
     Time endInactiveTime;
-    uint64_t symbolRate;
-
-    symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false); // symbols per second
 
     if (superframeType == INCOMING)
     {
         inactiveDuration = m_incomingBeaconInterval - m_incomingSuperframeDuration;
-        endInactiveTime = Seconds((double)inactiveDuration / symbolRate);
+        endInactiveTime = GetSymbolsTime(inactiveDuration);
 
         if (inactiveDuration > 0)
         {
@@ -1493,7 +2448,7 @@ LrWpanMac::StartInactivePeriod(SuperframeType superframeType)
     else
     {
         inactiveDuration = m_beaconInterval - m_superframeDuration;
-        endInactiveTime = Seconds((double)inactiveDuration / symbolRate);
+        endInactiveTime = GetSymbolsTime(inactiveDuration);
 
         if (inactiveDuration > 0)
         {
@@ -1507,53 +2462,1617 @@ LrWpanMac::StartInactivePeriod(SuperframeType superframeType)
 }
 
 void
-LrWpanMac::AwaitBeacon()
+LrWpanMac::AwaitBeacon()
+{
+    m_incSuperframeStatus = BEACON;
+
+    // TODO: If the device waits more than the expected time to receive the beacon (wait = 46
+    // symbols for default beacon size)
+    //       it should continue with the start of the incoming CAP even if it did not receive the
+    //       beacon. At the moment, the start of the incoming CAP is only triggered if the beacon is
+    //       received. See MLME-SyncLoss for details.
+}
+
+void
+LrWpanMac::BeaconSearchTimeout()
+{
+    if (m_numLostBeacons > aMaxLostBeacons)
+    {
+        MlmeSyncLossIndicationParams syncLossParams;
+        // syncLossParams.m_logCh =
+        syncLossParams.m_lossReason = MLMESYNCLOSS_BEACON_LOST;
+        syncLossParams.m_panId = m_macPanId;
+        if (!m_mlmeSyncLossIndicationCallback.IsNull())
+        {
+            m_mlmeSyncLossIndicationCallback(syncLossParams);
+        }
+
+        // The GTSs are lost with the synchronization (See IEEE 802.15.4-2011 Section 5.1.7.6).
+        ClearIncomingGts();
+
+        m_beaconTrackingOn = false;
+        m_numLostBeacons = 0;
+    }
+    else
+    {
+        m_numLostBeacons++;
+
+        // Search for one more beacon
+        uint64_t searchSymbols;
+        Time searchBeaconTime;
+        searchSymbols = (((uint64_t)1 << m_incomingBeaconOrder) + 1) * aBaseSuperframeDuration;
+        searchBeaconTime = GetSymbolsTime(searchSymbols);
+        m_trackingEvent =
+            Simulator::Schedule(searchBeaconTime, &LrWpanMac::BeaconSearchTimeout, this);
+    }
+}
+
+void
+LrWpanMac::StartLLSuperframe(SuperframeType superframeType)
+{
+    NS_LOG_FUNCTION(this << superframeType);
+
+    // The superframe starts with the beacon timeslot, all the following
+    // timeslots are referenced to the start of the LL beacon.
+    if (superframeType == OUTGOING)
+    {
+        m_llSuperframeStart = m_macBeaconTxTime;
+    }
+    else
+    {
+        m_llSuperframeStart = m_macBeaconRxTime;
+
+        // The clock of the device is synchronized on the LL beacon, its frequency
+        // offset drifts in the meantime.
+        if (m_llClockDriftWalk > 0 && !m_llSyncTime.IsStrictlyNegative())
+        {
+            double elapsed = (m_llSuperframeStart - m_llSyncTime).GetSeconds();
+            m_llClockDrift +=
+                m_llDriftRandom->GetValue() * m_llClockDriftWalk * std::sqrt(elapsed);
+        }
+        m_llSyncTime = m_llSuperframeStart;
+    }
+
+    m_llCurrentTimeslot = 0;
+    m_llCurrentTimeslotType = LLDN_TS_BEACON;
+
+    NS_LOG_DEBUG("LLDN superframe started (" << GetLLDNNumTimeslots()
+                                             << " timeslots after the beacon, "
+                                             << GetLLDNSuperframeSymbols() << " symbols)");
+
+    if (m_macLLDNcoordinator)
+    {
+        m_llTimeslotOccupied.assign(
+            (m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE) ? m_macLLDNnumTimeSlots : 0,
+            false);
+    }
+
+    if (!m_llSuperframeTrace.IsEmpty())
+    {
+        m_llSuperframeTrace(GetSymbolsTime(GetLLDNSuperframeSymbols()));
+    }
+
+    ArmNextLLTimeslot(0);
+}
+
+void
+LrWpanMac::StartLLTimeslot(uint16_t timeslot)
+{
+    NS_LOG_FUNCTION(this << timeslot);
+
+    m_llCurrentTimeslot = timeslot;
+    m_llCurrentTimeslotType = GetLLDNTimeslotType(timeslot);
+
+    // A device whose clock error exceeds the guard time would send or listen
+    // outside of the timeslot, the timeslot is lost until the next LL beacon.
+    if (!m_macLLDNcoordinator)
+    {
+        Time clockError = Simulator::Now() - m_llSuperframeStart -
+                          GetSymbolsTime(GetLLDNTimeslotOffset(timeslot));
+        if (Abs(clockError) > m_llGuardTime)
+        {
+            NS_LOG_DEBUG("LLDN timeslot " << timeslot << " missed, clock error "
+                                          << clockError.As(Time::US));
+            m_llSlotMissTrace(m_llCurrentTimeslotType, clockError);
+            ArmNextLLTimeslot(timeslot + 1);
+            return;
+        }
+    }
+
+    // The management timeslots of the Discovery and Configuration states carry the
+    // management commands, not the data frames of the transmit queue.
+    if (m_mlmeLLTransmissionState != FlagsField::ONLINE_STATE &&
+        (m_llCurrentTimeslotType == LLDN_TS_MGMT_DOWNLINK ||
+         m_llCurrentTimeslotType == LLDN_TS_MGMT_UPLINK))
+    {
+        LLMgmtTimeslotStart();
+        ArmNextLLTimeslot(timeslot + 1);
+        return;
+    }
+
+    switch (m_llCurrentTimeslotType)
+    {
+    case LLDN_TS_MGMT_DOWNLINK:
+        if (m_macLLDNcoordinator)
+        {
+            LLTimeslotTransmit();
+        }
+        break;
+    case LLDN_TS_RETRANSMIT:
+        // Only devices with an unacknowledged frame use their retransmission timeslot.
+        if (!m_macLLDNcoordinator && m_retransmission > 0)
+        {
+            LLTimeslotTransmit();
+        }
+        break;
+    case LLDN_TS_UPLINK:
+    case LLDN_TS_SHARED:
+        if (!m_macLLDNcoordinator)
+        {
+            LLTimeslotTransmit();
+        }
+        break;
+    case LLDN_TS_BIDIRECTIONAL:
+        // The direction of all bidirectional timeslots is announced in the LL beacon.
+        if (m_macLLDNcoordinator == (m_mlmeLLTransmissionDirection == FlagsField::DOWNLINK))
+        {
+            LLTimeslotTransmit();
+        }
+        break;
+    default:
+        // Uplink management timeslots: the PAN-C listens.
+        break;
+    }
+
+    ArmNextLLTimeslot(timeslot + 1);
+}
+
+void
+LrWpanMac::ArmNextLLTimeslot(uint16_t timeslot)
+{
+    uint16_t numTimeslots = GetLLDNNumTimeslots();
+
+    while (timeslot < numTimeslots && !IsLLTimeslotOfInterest(timeslot))
+    {
+        timeslot++;
+    }
+
+    Time eventTime =
+        m_llSuperframeStart + GetLLDeviceTime(GetSymbolsTime(GetLLDNTimeslotOffset(timeslot)));
+    Time delay = eventTime - Simulator::Now();
+    if (delay.IsStrictlyNegative())
+    {
+        delay = Time(0);
+    }
+
+    if (timeslot < numTimeslots)
+    {
+        m_llTimeslotEvent =
+            Simulator::Schedule(delay, &LrWpanMac::StartLLTimeslot, this, timeslot);
+    }
+    else
+    {
+        m_llTimeslotEvent = Simulator::Schedule(delay, &LrWpanMac::EndLLSuperframe, this);
+    }
+
+    if (m_llSleepEnabled && !m_macLLDNcoordinator &&
+        m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE)
+    {
+        // Sleep until the next timeslot of interest, or the next LL beacon. The device
+        // listens to the PAN-C during its bidirectional timeslots in the downlink direction.
+        bool downlink = (m_mlmeLLTransmissionDirection == FlagsField::DOWNLINK);
+        m_llWakeTime = eventTime - m_llGuardTime;
+        m_llWakeForUplink = (timeslot < numTimeslots &&
+                             !(downlink && GetLLDNTimeslotType(timeslot) == LLDN_TS_BIDIRECTIONAL));
+
+        Time sleepDelay(0);
+        if (downlink && m_llCurrentTimeslotType == LLDN_TS_BIDIRECTIONAL)
+        {
+            uint64_t endSymbols = GetLLDNTimeslotOffset(m_llCurrentTimeslot + 1);
+            sleepDelay = m_llSuperframeStart + GetLLDeviceTime(GetSymbolsTime(endSymbols)) -
+                         Simulator::Now();
+        }
+        m_llSleepEvent.Cancel();
+        m_llSleepEvent = Simulator::Schedule(Max(sleepDelay, Time(0)), &LrWpanMac::LLSleep, this);
+    }
+}
+
+Time
+LrWpanMac::GetLLDeviceTime(Time offset) const
+{
+    if (m_macLLDNcoordinator || m_llClockDrift == 0)
+    {
+        return offset;
+    }
+    return offset / (1 + m_llClockDrift * 1e-6);
+}
+
+bool
+LrWpanMac::IsLLSleepAllowed() const
+{
+    if (!m_llSleepEnabled || m_macLLDNcoordinator ||
+        m_mlmeLLTransmissionState != FlagsField::ONLINE_STATE || m_lrWpanMacState != MAC_IDLE ||
+        m_llSleepEvent.IsRunning())
+    {
+        return false;
+    }
+
+    // Switching the transceiver off is not worth it for less than a turnaround time.
+    return (m_llWakeTime - Simulator::Now() > GetSymbolsTime(m_phy->aTurnaroundTime));
+}
+
+void
+LrWpanMac::LLSleep()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!IsLLSleepAllowed())
+    {
+        return;
+    }
+
+    NS_LOG_DEBUG("LLDN device sleeps until " << m_llWakeTime.As(Time::S));
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+    m_llWakeEvent.Cancel();
+    m_llWakeEvent =
+        Simulator::Schedule(m_llWakeTime - Simulator::Now(), &LrWpanMac::LLWakeUp, this);
+}
+
+void
+LrWpanMac::LLWakeUp()
+{
+    NS_LOG_FUNCTION(this);
+
+    // With nothing to send, the device sleeps through its uplink timeslot. A frame
+    // queued meanwhile is still sent in it, the transceiver goes from TRX_OFF to TX_ON.
+    if (m_lrWpanMacState != MAC_IDLE ||
+        (m_llWakeForUplink && (m_txQueue.IsEmpty() || m_llGroupAckPending)))
+    {
+        return;
+    }
+
+    NS_LOG_DEBUG("LLDN device wakes up");
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
+}
+
+void
+LrWpanMac::EndLLSuperframe()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_llCurrentTimeslotType = LLDN_TS_BEACON;
+
+    // A duty-cycled device woke up after the start of the LL beacon.
+    if (!m_macLLDNcoordinator && m_llSleepEnabled)
+    {
+        Time clockError =
+            Simulator::Now() - m_llSuperframeStart - GetSymbolsTime(GetLLDNSuperframeSymbols());
+        if (clockError > m_llGuardTime)
+        {
+            NS_LOG_DEBUG("LL beacon missed, clock error " << clockError.As(Time::US));
+            m_llSlotMissTrace(LLDN_TS_BEACON, clockError);
+        }
+    }
+
+    if (m_macLLDNcoordinator)
+    {
+        if (!m_llTimeslotOccupancyTrace.IsEmpty())
+        {
+            uint16_t mgmtTimeslots = GetLLDNNumMgmtTimeslots();
+            for (uint16_t i = 0; i < m_llTimeslotOccupied.size(); i++)
+            {
+                if (IsLLUplinkTimeslot(GetLLDNTimeslotType(mgmtTimeslots + i)))
+                {
+                    m_llTimeslotOccupancyTrace(i, m_llTimeslotOccupied[i]);
+                }
+            }
+        }
+        SendOneLLBeacon();
+    }
+}
+
+void
+LrWpanMac::LLTimeslotTransmit()
+{
+    NS_LOG_FUNCTION(this);
+
+    // A frame waiting for its group acknowledgement is not sent again in the same superframe.
+    if (m_lrWpanMacState != MAC_IDLE || m_txQueue.IsEmpty() || m_llGroupAckPending)
+    {
+        return;
+    }
+
+    // Slotted ALOHA in the shared group timeslots: after a collision, the device
+    // skips a random number of occurrences of its shared group timeslot.
+    if (m_llCurrentTimeslotType == LLDN_TS_SHARED && m_llSharedBackoff > 0)
+    {
+        m_llSharedBackoff--;
+        return;
+    }
+
+    // LL-DATA frames carry no address, the PAN-C sends a downlink frame in the
+    // bidirectional timeslot of its destination, and the broadcast frames and the
+    // frames with addresses in the downlink management timeslot.
+    if (m_macLLDNcoordinator)
+    {
+        Mac8Address dst = Mac8Address::GetBroadcast();
+        if (m_llCurrentTimeslotType == LLDN_TS_BIDIRECTIONAL)
+        {
+            dst = GetLLDNTimeslotOwner(m_llCurrentTimeslot - GetLLDNNumMgmtTimeslots());
+            if (dst == Mac8Address::GetBroadcast())
+            {
+                return;
+            }
+        }
+        uint32_t i = 0;
+        while (i < m_txQueue.GetSize() && m_txQueue[i].txQDstSimpleAddr != dst)
+        {
+            i++;
+        }
+        if (i == m_txQueue.GetSize())
+        {
+            NS_LOG_DEBUG("No frame for " << dst << " in LLDN timeslot " << m_llCurrentTimeslot);
+            return;
+        }
+        m_txQueue.MoveToFront(i);
+    }
+
+    TxQueueElement& txQElement = m_txQueue.Front();
+    m_txPkt = txQElement.txQPkt;
+
+    // The frame must fit in the timeslot, excluding the IFS at the end of it.
+    // The timeslot of a device can span several consecutive base timeslots.
+    uint32_t numTimeslots = 1;
+    if (!m_macLLDNcoordinator && m_llCurrentTimeslotType != LLDN_TS_RETRANSMIT)
+    {
+        numTimeslots = m_llNumAssignedTimeslots;
+    }
+    uint32_t ifsSymbols = (aLLMacOverhead + m_mlmeLLTimeslotSize <= aMaxSIFSFrameSize &&
+                           m_txPkt->GetSize() <= aMaxSIFSFrameSize)
+                              ? m_macSIFSPeriod
+                              : m_macLIFSPeriod;
+    uint64_t maxFrameSymbols = numTimeslots * GetLLDNBaseTimeslotSymbols() - ifsSymbols;
+    if (GetTxPacketSymbols() > maxFrameSymbols)
+    {
+        if (m_llCurrentTimeslotType == LLDN_TS_RETRANSMIT && m_llNumAssignedTimeslots > 1)
+        {
+            // Retransmitted in the timeslot of the device instead.
+            m_txPkt = nullptr;
+            return;
+        }
+        NS_LOG_DEBUG("Frame too long for the LLDN timeslot (" << GetTxPacketSymbols() << " > "
+                                                              << maxFrameSymbols
+                                                              << " symbols), dropping packet");
+        m_macTxDropTrace(m_txPkt);
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            McpsDataConfirmParams confirmParams;
+            confirmParams.m_msduHandle = txQElement.txQMsduHandle;
+            confirmParams.m_status = IEEE_802_15_4_FRAME_TOO_LONG;
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+        RemoveFirstTxQElement();
+        return;
+    }
+
+    NS_LOG_DEBUG("Transmitting in LLDN timeslot " << m_llCurrentTimeslot);
+    if (!m_macLLDNcoordinator)
+    {
+        m_llTimeslotTxTrace(m_llCurrentTimeslot - GetLLDNNumMgmtTimeslots(),
+                            m_llCurrentTimeslotType,
+                            m_retransmission);
+    }
+    m_llTimeslotTx = true;
+    ChangeMacState(MAC_SENDING);
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+}
+
+bool
+LrWpanMac::IsLLTimeslotOfInterest(uint16_t timeslot) const
+{
+    if (m_macLLDNcoordinator)
+    {
+        // The PAN-C keeps track of every timeslot of the superframe.
+        return true;
+    }
+
+    // LLDN devices only arm their own timeslot and their retransmission timeslot,
+    // and the uplink management timeslot when they have a management command to send.
+    uint16_t mgmtTimeslots = GetLLDNNumMgmtTimeslots();
+    LLDNTimeslotType type = GetLLDNTimeslotType(timeslot);
+
+    if (type == LLDN_TS_MGMT_UPLINK)
+    {
+        return (m_mlmeLLTransmissionState != FlagsField::ONLINE_STATE && m_llMgmtPkt &&
+                m_llMgmtBackoff == 0 && !m_llMgmtAckEvent.IsRunning());
+    }
+
+    // The devices of a shared group timeslot retransmit in it, the retransmission
+    // timeslots are dedicated to a single device.
+    if (type == LLDN_TS_RETRANSMIT)
+    {
+        return (timeslot == mgmtTimeslots + GetLLDNRetransmitTimeslot(m_macLLDNassignedTimeSlot) &&
+                GetLLDNTimeslotType(mgmtTimeslots + m_macLLDNassignedTimeSlot) != LLDN_TS_SHARED);
+    }
+
+    return (m_macLLDNassignedTimeSlot != 0xff &&
+            timeslot == mgmtTimeslots + m_macLLDNassignedTimeSlot &&
+            (type == LLDN_TS_UPLINK || type == LLDN_TS_BIDIRECTIONAL || type == LLDN_TS_SHARED));
+}
+
+uint64_t
+LrWpanMac::GetLLDNBaseTimeslotSymbols() const
+{
+    return GetLLDNTimeslotSymbols(m_mlmeLLTimeslotSize);
+}
+
+uint64_t
+LrWpanMac::GetLLDNTimeslotSymbols(uint32_t payloadSize) const
+{
+    // See IEEE 802.15.4e-2012 Section 5.1.1.6.3
+    // tTS = (p * sp + (m + n) * sm) / v + IFS
+    uint32_t mpduOctets = aLLMacOverhead + payloadSize;
+
+    // (p * sp): Sync Header (SHR) + PHY header (PHR)
+    uint64_t symbols = m_phy->GetPhySHRDuration() + 1 * m_phy->GetPhySymbolsPerOctet();
+    // (m + n) * sm: LL MHR + payload + MFR
+    symbols += ceil(mpduOctets * m_phy->GetPhySymbolsPerOctet());
+
+    if (mpduOctets <= aMaxSIFSFrameSize)
+    {
+        symbols += m_macSIFSPeriod;
+    }
+    else
+    {
+        symbols += m_macLIFSPeriod;
+    }
+
+    return symbols;
+}
+
+uint64_t
+LrWpanMac::GetLLDNBeaconTimeslotSymbols(uint64_t baseTimeslotSymbols,
+                                        bool online,
+                                        uint16_t numBaseTimeslots) const
+{
+    // LL beacon payload: Flags, PAN-C ID, Configuration Sequence Number and Timeslot Size,
+    // followed in the Online state by the Number of Base Timeslots and the Group Ack Bitmap.
+    uint32_t payloadSize = 4;
+    if (online)
+    {
+        payloadSize += 1 + (numBaseTimeslots + 7) / 8;
+    }
+
+    return std::max(baseTimeslotSymbols, GetLLDNTimeslotSymbols(payloadSize));
+}
+
+uint64_t
+LrWpanMac::GetLLDNSuperframeSymbols() const
+{
+    return GetLLDNTimeslotOffset(GetLLDNNumTimeslots());
+}
+
+LLDNTimeslotType
+LrWpanMac::GetLLDNTimeslotType(uint16_t timeslot) const
+{
+    uint16_t mgmtTimeslots = GetLLDNNumMgmtTimeslots();
+
+    if (timeslot < mgmtTimeslots)
+    {
+        return (timeslot == 0) ? LLDN_TS_MGMT_DOWNLINK : LLDN_TS_MGMT_UPLINK;
+    }
+
+    // Base timeslots: retransmission timeslots are the first uplink timeslots,
+    // followed by the uplink and bidirectional timeslots.
+    uint16_t baseTimeslot = timeslot - mgmtTimeslots;
+
+    if (baseTimeslot < m_macLLDNnumRetransmitTS)
+    {
+        return LLDN_TS_RETRANSMIT;
+    }
+    else if (baseTimeslot < m_macLLDNnumUplinkTS)
+    {
+        // The shared group timeslots are the last uplink timeslots.
+        return (baseTimeslot + m_macLLDNnumSharedGroupTS >= m_macLLDNnumUplinkTS) ? LLDN_TS_SHARED
+                                                                                  : LLDN_TS_UPLINK;
+    }
+    else if (baseTimeslot < m_macLLDNnumUplinkTS + m_macLLDNnumBidirectionalTS)
+    {
+        return LLDN_TS_BIDIRECTIONAL;
+    }
+
+    return LLDN_TS_UNUSED;
+}
+
+uint16_t
+LrWpanMac::GetLLDNNumTimeslots() const
+{
+    uint16_t numTimeslots = GetLLDNNumMgmtTimeslots();
+
+    // Base timeslots are only present in the Online state.
+    if (m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE)
+    {
+        numTimeslots += m_macLLDNnumTimeSlots;
+    }
+
+    return numTimeslots;
+}
+
+uint64_t
+LrWpanMac::GetLLDNTimeslotOffset(uint16_t timeslot) const
+{
+    uint64_t baseTimeslotSymbols = GetLLDNBaseTimeslotSymbols();
+    uint8_t mgmtLength = GetLLDNMgmtTimeslotLength();
+
+    uint64_t offset =
+        GetLLDNBeaconTimeslotSymbols(baseTimeslotSymbols,
+                                     m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE,
+                                     m_macLLDNnumTimeSlots);
+
+    if (mgmtLength > 0)
+    {
+        uint16_t mgmtTimeslots = std::min<uint16_t>(timeslot, 2);
+        offset += mgmtTimeslots * mgmtLength * baseTimeslotSymbols;
+        timeslot -= mgmtTimeslots;
+    }
+
+    return offset + timeslot * baseTimeslotSymbols;
+}
+
+bool
+LrWpanMac::IsLLGroupAckReq()
+{
+    // Only uplink frames sent by LLDN devices are acknowledged by the PAN-C.
+    if (m_macLLDNcoordinator || m_llCurrentTimeslotType == LLDN_TS_MGMT_UPLINK)
+    {
+        return false;
+    }
+
+    if (IsLLFrame(m_txPkt))
+    {
+        LrWpanLLMacHeader llMacHdr;
+        m_txPkt->PeekHeader(llMacHdr);
+        return llMacHdr.GetAckReq();
+    }
+
+    return isTxAckReq();
+}
+
+uint16_t
+LrWpanMac::GetLLDNNumMgmtTimeslots() const
+{
+    return (GetLLDNMgmtTimeslotLength() > 0) ? 2 : 0;
+}
+
+uint8_t
+LrWpanMac::GetLLDNRetransmitTimeslot(uint8_t baseTimeslot) const
+{
+    uint8_t numRetransmitTS = m_macLLDNnumRetransmitTS;
+
+    if (numRetransmitTS == 0 || baseTimeslot == 0xff || baseTimeslot < numRetransmitTS)
+    {
+        return 0xff;
+    }
+
+    return (baseTimeslot - numRetransmitTS) % numRetransmitTS;
+}
+
+uint8_t
+LrWpanMac::GetLLDNMgmtTimeslotLength() const
+{
+    if (m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE && !m_macLLDNmgmtTS)
+    {
+        return 0;
+    }
+
+    // The Discovery and Configuration states always use management timeslots.
+    return std::max<uint8_t>(m_mlmeLLTimeSlotPerMgmtTS, 1);
+}
+
+bool
+LrWpanMac::IsLLUplinkTimeslot(LLDNTimeslotType type) const
+{
+    return (type == LLDN_TS_RETRANSMIT || type == LLDN_TS_UPLINK || type == LLDN_TS_SHARED ||
+            (type == LLDN_TS_BIDIRECTIONAL &&
+             m_mlmeLLTransmissionDirection == FlagsField::UPLINK));
+}
+
+uint16_t
+LrWpanMac::GetLLDNTimeslotAt(Time time) const
+{
+    uint64_t offset = GetTimeSymbols(std::max(time - m_llSuperframeStart, Seconds(0)));
+    uint64_t baseTimeslotSymbols = GetLLDNBaseTimeslotSymbols();
+    uint64_t beaconTimeslotSymbols =
+        GetLLDNBeaconTimeslotSymbols(baseTimeslotSymbols,
+                                     m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE,
+                                     m_macLLDNnumTimeSlots);
+
+    if (offset < beaconTimeslotSymbols)
+    {
+        return 0xffff;
+    }
+    offset -= beaconTimeslotSymbols;
+
+    uint16_t timeslot = 0;
+    uint64_t mgmtSymbols = GetLLDNMgmtTimeslotLength() * baseTimeslotSymbols;
+    if (mgmtSymbols > 0)
+    {
+        if (offset < 2 * mgmtSymbols)
+        {
+            return offset / mgmtSymbols;
+        }
+        offset -= 2 * mgmtSymbols;
+        timeslot = 2;
+    }
+
+    return timeslot + offset / baseTimeslotSymbols;
+}
+
+bool
+LrWpanMac::IsInLLTimeslot(uint16_t timeslot) const
+{
+    Time start = m_llSuperframeStart + GetSymbolsTime(GetLLDNTimeslotOffset(timeslot));
+    Time end = m_llSuperframeStart + GetSymbolsTime(GetLLDNTimeslotOffset(timeslot + 1));
+
+    return (Simulator::Now() >= start && Simulator::Now() <= end);
+}
+
+Mac8Address
+LrWpanMac::GetLLDNTimeslotOwner(uint8_t baseTimeslot) const
+{
+    // The frames received in a shared group timeslot can come from any of its devices.
+    if (GetLLDNTimeslotType(GetLLDNNumMgmtTimeslots() + baseTimeslot) == LLDN_TS_SHARED)
+    {
+        return Mac8Address::GetBroadcast();
+    }
+
+    if (baseTimeslot >= m_macLLDNnumRetransmitTS)
+    {
+        auto it = m_llTimeslotOwners.find(baseTimeslot);
+        if (it != m_llTimeslotOwners.end())
+        {
+            return it->second;
+        }
+        return Mac8Address::GetBroadcast();
+    }
+
+    // Retransmission timeslot: look for the devices whose frame was not acknowledged.
+    // The devices spanning several base timeslots are not retransmitting here.
+    Mac8Address owner = Mac8Address::GetBroadcast();
+    uint32_t candidates = 0;
+    auto prev = m_llTimeslotOwners.end();
+    for (auto it = m_llTimeslotOwners.begin(); it != m_llTimeslotOwners.end(); prev = it++)
+    {
+        bool multiTimeslot =
+            (prev != m_llTimeslotOwners.end() && prev->first + 1 == it->first &&
+             prev->second == it->second);
+        auto next = std::next(it);
+        multiTimeslot = multiTimeslot ||
+                        (next != m_llTimeslotOwners.end() && next->first == it->first + 1 &&
+                         next->second == it->second);
+        if (!multiTimeslot && GetLLDNRetransmitTimeslot(it->first) == baseTimeslot &&
+            it->first < m_llLastGroupAckBmp.size() && !m_llLastGroupAckBmp[it->first])
+        {
+            owner = it->second;
+            candidates++;
+        }
+    }
+
+    return (candidates == 1) ? owner : Mac8Address::GetBroadcast();
+}
+
+void
+LrWpanMac::LLRecordGroupAck(uint16_t timeslot, LLDNTimeslotType type)
+{
+    NS_LOG_FUNCTION(this << timeslot);
+
+    if (!m_macLLDNcoordinator || m_mlmeLLTransmissionState != FlagsField::ONLINE_STATE)
+    {
+        return;
+    }
+
+    uint16_t baseTimeslot = timeslot - GetLLDNNumMgmtTimeslots();
+
+    // A frame spanning several base timeslots occupies all of them, up to the one
+    // in which its reception ended.
+    uint16_t lastTimeslot = GetLLDNTimeslotAt(Simulator::Now() - TimeStep(1));
+    uint16_t lastBaseTimeslot =
+        (lastTimeslot == 0xffff) ? baseTimeslot
+                                 : std::max<uint16_t>(baseTimeslot,
+                                                      lastTimeslot - GetLLDNNumMgmtTimeslots());
+    for (uint16_t i = baseTimeslot; i <= lastBaseTimeslot && i < m_llTimeslotOccupied.size(); i++)
+    {
+        m_llTimeslotOccupied[i] = true;
+    }
+
+    if (IsLLUplinkTimeslot(type) && baseTimeslot < m_llGroupAckBmp.size())
+    {
+        NS_LOG_DEBUG("Frame received in base timeslot " << baseTimeslot
+                                                        << ", set in the group acknowledgement");
+        m_llGroupAckBmp[baseTimeslot] = true;
+    }
+}
+
+void
+LrWpanMac::LLProcessGroupAck(const std::vector<bool>& groupAckBmp)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_llGroupAckPending)
+    {
+        return;
+    }
+
+    m_llGroupAckPending = false;
+    NS_ASSERT_MSG(m_txQueue.GetSize() > 0, "TxQsize = 0");
+    TxQueueElement& txQElement = m_txQueue.Front();
+    bool sharedTimeslot = (GetLLDNTimeslotType(GetLLDNNumMgmtTimeslots() + m_llGroupAckTimeslot) ==
+                           LLDN_TS_SHARED);
+
+    if (m_llGroupAckTimeslot < groupAckBmp.size() && groupAckBmp[m_llGroupAckTimeslot])
+    {
+        NS_LOG_DEBUG("Frame acknowledged in the group acknowledgement");
+        m_macTxOkTrace(txQElement.txQPkt);
+        m_llDataLatencyTrace(txQElement.txQPkt, m_llTxEndTime - txQElement.txQEnqueueTime);
+        m_llSharedBE = 0;
+        m_llSharedBackoff = 0;
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            McpsDataConfirmParams confirmParams;
+            confirmParams.m_msduHandle = txQElement.txQMsduHandle;
+            confirmParams.m_status = IEEE_802_15_4_SUCCESS;
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+        RemoveFirstTxQElement();
+    }
+    else if (m_retransmission >= m_macMaxFrameRetries)
+    {
+        NS_LOG_DEBUG("Frame not acknowledged, max retransmissions reached");
+        m_llGroupAckMissTrace(m_llGroupAckTimeslot, m_retransmission);
+        m_llSharedBE = 0;
+        m_llSharedBackoff = 0;
+        m_macTxDropTrace(txQElement.txQPkt);
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            McpsDataConfirmParams confirmParams;
+            confirmParams.m_msduHandle = txQElement.txQMsduHandle;
+            confirmParams.m_status = IEEE_802_15_4_NO_ACK;
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+        RemoveFirstTxQElement();
+    }
+    else
+    {
+        // The frame is sent again in the retransmission timeslot of the device
+        // (or in its own timeslot if there are no retransmission timeslots).
+        m_llGroupAckMissTrace(m_llGroupAckTimeslot, m_retransmission);
+        m_retransmission++;
+        NS_LOG_DEBUG("Frame not acknowledged, retransmission "
+                     << static_cast<uint32_t>(m_retransmission));
+        if (sharedTimeslot)
+        {
+            // Probably a collision with another device of the shared group timeslot.
+            m_llSharedBE = std::min(std::max<uint8_t>(m_llSharedBE + 1, m_csmaCa->GetMacMinBE()),
+                                    m_csmaCa->GetMacMaxBE());
+            m_llSharedBackoff = m_llRandom->GetInteger(0, (1 << m_llSharedBE) - 1);
+            NS_LOG_DEBUG("Shared group timeslot backoff " << m_llSharedBackoff);
+        }
+    }
+}
+
+void
+LrWpanMac::LLMgmtTimeslotStart()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_macLLDNcoordinator)
+    {
+        // The PAN-C sends the Configuration Requests in the downlink management
+        // timeslot and listens during the uplink management timeslot.
+        if (m_llCurrentTimeslotType == LLDN_TS_MGMT_DOWNLINK)
+        {
+            LLMgmtTransmit(0);
+        }
+    }
+    else if (m_llCurrentTimeslotType == LLDN_TS_MGMT_UPLINK && m_llMgmtPkt &&
+             m_llMgmtBackoff == 0 && !m_llMgmtAckEvent.IsRunning())
+    {
+        // The uplink management timeslot is shared by all the devices, use a random subslot.
+        uint8_t subslot = m_llRandom->GetInteger(0, GetLLDNNumMgmtSubslots() - 1);
+        Time delay = GetSymbolsTime(subslot * GetLLMgmtExchangeSymbols());
+        m_llMgmtSubslotEvent =
+            Simulator::Schedule(delay, &LrWpanMac::LLMgmtTransmit, this, subslot);
+    }
+}
+
+void
+LrWpanMac::LLMgmtTransmit(uint8_t subslot)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(subslot));
+
+    if (m_macLLDNcoordinator && subslot + 1 < GetLLDNNumMgmtSubslots())
+    {
+        Time delay = GetSymbolsTime(GetLLMgmtExchangeSymbols());
+        m_llMgmtSubslotEvent =
+            Simulator::Schedule(delay, &LrWpanMac::LLMgmtTransmit, this, subslot + 1);
+    }
+
+    if (m_lrWpanMacState != MAC_IDLE || m_llMgmtAckEvent.IsRunning())
+    {
+        return;
+    }
+
+    if (m_macLLDNcoordinator)
+    {
+        // Skip the devices configured meanwhile (e.g. a duplicated Configuration Status).
+        while (!m_llConfigRequestQueue.empty() &&
+               m_llDevices[m_llConfigRequestQueue.front()].configured)
+        {
+            m_llConfigRequestQueue.pop_front();
+        }
+        if (m_llConfigRequestQueue.empty())
+        {
+            return;
+        }
+
+        const LLDNDeviceDescriptor& device = m_llDevices[m_llConfigRequestQueue.front()];
+        m_llConfigRequestQueue.pop_front();
+
+        CommandPayloadHeader cmdPayload(CommandPayloadHeader::LL_CONFIGURATON_REQ);
+        cmdPayload.SetFullAddr(device.fullAddr);
+        cmdPayload.SetSimpleAddr(device.simpleAddr);
+        cmdPayload.SetTxChannel(m_phy->GetCurrentChannelNum());
+        cmdPayload.SetMgmtFrames(m_macLLDNmgmtTS);
+        cmdPayload.SetTimeslotDuration((m_llSlotPlanner && m_llPlan.m_timeslotSize > 0)
+                                           ? m_llPlan.m_timeslotSize
+                                           : m_mlmeLLTimeslotSize);
+        cmdPayload.SetAssignedTimeslot(device.assignedTimeslot);
+        cmdPayload.SetNumTimeslots(device.numTimeslots);
+
+        NS_LOG_DEBUG("Sending Configuration Request to " << device.fullAddr << " (subslot "
+                                                         << static_cast<uint32_t>(subslot)
+                                                         << ")");
+        m_llMgmtAckAddr = device.fullAddr;
+        m_txPkt = BuildLLCommand(cmdPayload);
+    }
+    else
+    {
+        NS_LOG_DEBUG("Sending management command " << m_llMgmtCmd << " (subslot "
+                                                   << static_cast<uint32_t>(subslot) << ")");
+        m_llMgmtAckAddr = m_selfExt;
+        m_txPkt = m_llMgmtPkt->Copy();
+    }
+
+    m_llMgmtTx = true;
+    ChangeMacState(MAC_SENDING);
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+}
+
+void
+LrWpanMac::LLCommandIndication(Ptr<Packet> p, bool ackReq)
+{
+    NS_LOG_FUNCTION(this << p << ackReq);
+
+    CommandPayloadHeader cmdPayload;
+    p->RemoveHeader(cmdPayload);
+
+    switch (cmdPayload.GetCommandFrameType())
+    {
+    case CommandPayloadHeader::LL_DISCOVER_RESP:
+    case CommandPayloadHeader::LL_CONFIGURATION_STATUS: {
+        bool discovery =
+            (cmdPayload.GetCommandFrameType() == CommandPayloadHeader::LL_DISCOVER_RESP);
+        if (!m_macLLDNcoordinator ||
+            m_mlmeLLTransmissionState !=
+                (discovery ? FlagsField::DISCOVERY_STATE : FlagsField::CONFIGURATION_STATE))
+        {
+            return;
+        }
+
+        // Devices missed in the Discovery state are accepted in the Configuration state.
+        Mac64Address fullAddr = cmdPayload.GetFullAddr();
+        auto it = m_llDevices.find(fullAddr);
+        if (it == m_llDevices.end())
+        {
+            LLDNDeviceDescriptor device;
+            device.fullAddr = fullAddr;
+            device.numTimeslots = 1;
+            device.statusReceived = false;
+            device.configured = false;
+            if (m_llSlotPlanner)
+            {
+                // The timeslots are assigned once the requirements of all the devices are known.
+                device.assignedTimeslot = 0xff;
+                LLAssignSimpleAddress(device);
+            }
+            else
+            {
+                LLAssignTimeslot(device);
+            }
+            it = m_llDevices.emplace(fullAddr, device).first;
+        }
+        it->second.timeslotDuration = cmdPayload.GetTimeslotDuration();
+        it->second.typeIndicator = cmdPayload.GetTypeIndicator();
+
+        if (discovery)
+        {
+            NS_LOG_DEBUG("Discover Response received from " << fullAddr);
+            if (m_llDiscoveryTimeoutEvent.IsRunning())
+            {
+                m_llDiscoveryTimeoutEvent.Cancel();
+                m_llDiscoveryTimeoutEvent =
+                    Simulator::Schedule(Seconds(m_macLLDNdiscoveryModeTimeout),
+                                        &LrWpanMac::LLDiscoveryTimeout,
+                                        this);
+            }
+        }
+        else
+        {
+            NS_LOG_DEBUG("Configuration Status received from " << fullAddr);
+            it->second.configured = false;
+            it->second.statusReceived = true;
+            it->second.requestedPeriod = MilliSeconds(cmdPayload.GetRequestedPeriod());
+
+            if (m_llSlotPlanner)
+            {
+                bool allReceived = std::all_of(m_llDevices.begin(),
+                                               m_llDevices.end(),
+                                               [](const auto& device) {
+                                                   return device.second.statusReceived;
+                                               });
+                if (allReceived || m_llPlan.m_timeslotSize > 0)
+                {
+                    LLPlanSuperframe();
+                }
+                else
+                {
+                    // Wait for the devices still contending for the uplink management
+                    // timeslot, at most 2^macMaxBE superframes.
+                    uint64_t waitSymbols =
+                        (1 << m_csmaCa->GetMacMaxBE()) * GetLLDNSuperframeSymbols();
+                    m_llPlanEvent.Cancel();
+                    m_llPlanEvent = Simulator::Schedule(GetSymbolsTime(waitSymbols),
+                                                        &LrWpanMac::LLPlanSuperframe,
+                                                        this);
+                }
+            }
+            if (it->second.assignedTimeslot != 0xff &&
+                std::find(m_llConfigRequestQueue.begin(),
+                          m_llConfigRequestQueue.end(),
+                          fullAddr) == m_llConfigRequestQueue.end())
+            {
+                m_llConfigRequestQueue.push_back(fullAddr);
+            }
+            if (m_llConfigurationTimeoutEvent.IsRunning())
+            {
+                m_llConfigurationTimeoutEvent.Cancel();
+                m_llConfigurationTimeoutEvent =
+                    Simulator::Schedule(Seconds(m_macLLDNdiscoveryModeTimeout),
+                                        &LrWpanMac::LLConfigurationEnd,
+                                        this);
+            }
+        }
+
+        if (ackReq)
+        {
+            m_setMacState = Simulator::ScheduleNow(&LrWpanMac::SendLLAck, this, fullAddr);
+        }
+        break;
+    }
+    case CommandPayloadHeader::LL_CONFIGURATON_REQ: {
+        if (m_macLLDNcoordinator || !(cmdPayload.GetFullAddr() == m_selfExt))
+        {
+            return;
+        }
+
+        NS_LOG_DEBUG("Configuration Request received, simple address "
+                     << cmdPayload.GetSimpleAddr() << ", base timeslot "
+                     << static_cast<uint32_t>(cmdPayload.GetAssignedTimeslot()));
+        m_simpleAddress = cmdPayload.GetSimpleAddr();
+        m_macLLDNassignedTimeSlot = cmdPayload.GetAssignedTimeslot();
+        m_llNumAssignedTimeslots = std::max<uint8_t>(cmdPayload.GetNumTimeslots(), 1);
+        // The uplink timeslots of the device must be inside the uplink part of the superframe.
+        if (m_macLLDNassignedTimeSlot != 0xff)
+        {
+            m_macLLDNnumUplinkTS =
+                std::max<uint16_t>(m_macLLDNnumUplinkTS,
+                                   m_macLLDNassignedTimeSlot + m_llNumAssignedTimeslots);
+        }
+        m_macLLDNmgmtTS = cmdPayload.GetMgmtFrames();
+        m_mlmeLLTimeslotSize = cmdPayload.GetTimeslotDuration();
+        m_llConfigured = true;
+        m_llMgmtPkt = nullptr;
+        m_llMgmtAckEvent.Cancel();
+        m_llMgmtSubslotEvent.Cancel();
+
+        if (cmdPayload.GetTxChannel() != m_phy->GetCurrentChannelNum())
+        {
+            LrWpanPhyPibAttributes pibAttr;
+            pibAttr.phyCurrentChannel = cmdPayload.GetTxChannel();
+            m_phy->PlmeSetAttributeRequest(LrWpanPibAttributeIdentifier::phyCurrentChannel,
+                                           &pibAttr);
+        }
+
+        if (ackReq)
+        {
+            m_setMacState = Simulator::ScheduleNow(&LrWpanMac::SendLLAck, this, m_selfExt);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void
+LrWpanMac::LLMgmtAckIndication(Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+
+    if (p->GetSize() < 8)
+    {
+        return;
+    }
+
+    uint8_t buffer[8];
+    p->CopyData(buffer, 8);
+    Mac64Address fullAddr;
+    fullAddr.CopyFrom(buffer);
+
+    // The acknowledgement of another device sent in the same subslot.
+    if (!(fullAddr == m_llMgmtAckAddr))
+    {
+        return;
+    }
+
+    m_llMgmtAckEvent.Cancel();
+
+    if (m_macLLDNcoordinator)
+    {
+        auto it = m_llDevices.find(fullAddr);
+        if (it == m_llDevices.end() || it->second.configured)
+        {
+            return;
+        }
+
+        NS_LOG_DEBUG("Configuration Request acknowledged by " << fullAddr);
+        it->second.configured = true;
+
+        if (m_mlmeLLTransmissionState == FlagsField::CONFIGURATION_STATE &&
+            m_llConfigurationTimeoutEvent.IsRunning())
+        {
+            for (const auto& device : m_llDevices)
+            {
+                if (device.second.assignedTimeslot != 0xff && !device.second.configured)
+                {
+                    return;
+                }
+            }
+            LLConfigurationEnd();
+        }
+    }
+    else
+    {
+        NS_LOG_DEBUG("Management command " << m_llMgmtCmd << " acknowledged");
+        if (m_llMgmtCmd == CommandPayloadHeader::LL_DISCOVER_RESP)
+        {
+            m_llDiscovered = true;
+        }
+        else
+        {
+            m_llConfigStatusAcked = true;
+        }
+        m_llMgmtPkt = nullptr;
+        m_llMgmtBE = 0;
+        m_llMgmtBackoff = 0;
+    }
+}
+
+void
+LrWpanMac::LLMgmtAckTimeout()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_macLLDNcoordinator)
+    {
+        // Try again in one of the next subslots.
+        auto it = m_llDevices.find(m_llMgmtAckAddr);
+        if (it != m_llDevices.end() && !it->second.configured)
+        {
+            m_llConfigRequestQueue.push_back(m_llMgmtAckAddr);
+        }
+    }
+    else if (m_llMgmtPkt)
+    {
+        // Probably a collision in the uplink management timeslot, backoff before trying again.
+        m_llMgmtBE = std::min(static_cast<uint8_t>(m_llMgmtBE + 1), m_csmaCa->GetMacMaxBE());
+        m_llMgmtBackoff = m_llRandom->GetInteger(0, (1 << m_llMgmtBE) - 1);
+        NS_LOG_DEBUG("Management command not acknowledged, backoff " << m_llMgmtBackoff
+                                                                     << " superframes");
+    }
+}
+
+void
+LrWpanMac::SendLLAck(Mac64Address fullAddr)
+{
+    NS_LOG_FUNCTION(this << fullAddr);
+
+    if (m_lrWpanMacState != MAC_IDLE)
+    {
+        NS_LOG_DEBUG("Cannot send the acknowledgement, the MAC is busy");
+        return;
+    }
+
+    LrWpanLLMacHeader llMacHdr(LrWpanLLMacHeader::LRWPAN_LLDN, LrWpanLLMacHeader::LL_ACK);
+    llMacHdr.SetSecDisable();
+    llMacHdr.SetNoAckReq();
+
+    uint8_t buffer[8];
+    fullAddr.CopyTo(buffer);
+    Ptr<Packet> ackPacket = Create<Packet>(buffer, 8);
+    ackPacket->AddHeader(llMacHdr);
+
+    LrWpanMacTrailer macTrailer;
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(ackPacket);
+    }
+    ackPacket->AddTrailer(macTrailer);
+
+    m_txPkt = ackPacket;
+    m_llMgmtTx = true;
+    ChangeMacState(MAC_SENDING);
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+}
+
+Ptr<Packet>
+LrWpanMac::BuildLLCommand(const CommandPayloadHeader& cmdPayload) const
+{
+    LrWpanLLMacHeader llMacHdr(LrWpanLLMacHeader::LRWPAN_LLDN,
+                               LrWpanLLMacHeader::LL_MAC_COMMAND);
+    llMacHdr.SetSecDisable();
+    llMacHdr.SetAckReq();
+
+    Ptr<Packet> commandPacket = Create<Packet>();
+    commandPacket->AddHeader(cmdPayload);
+    commandPacket->AddHeader(llMacHdr);
+
+    LrWpanMacTrailer macTrailer;
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(commandPacket);
+    }
+    commandPacket->AddTrailer(macTrailer);
+
+    return commandPacket;
+}
+
+void
+LrWpanMac::LLPrepareMgmtCommand(CommandPayloadHeader::MacCommand cmd)
+{
+    NS_LOG_FUNCTION(this << cmd);
+
+    CommandPayloadHeader cmdPayload(cmd);
+    cmdPayload.SetFullAddr(m_selfExt);
+    cmdPayload.SetTimeslotDuration((m_llReqPayloadSize > 0) ? m_llReqPayloadSize
+                                                            : m_mlmeLLTimeslotSize);
+    cmdPayload.SetTypeIndicator(0); // uplink device
+    if (cmd == CommandPayloadHeader::LL_CONFIGURATION_STATUS)
+    {
+        cmdPayload.SetSimpleAddr(m_simpleAddress);
+        cmdPayload.SetAssignedTimeslot(m_macLLDNassignedTimeSlot);
+        cmdPayload.SetRequestedPeriod(
+            static_cast<uint16_t>(std::min<int64_t>(m_llReqPeriod.GetMilliSeconds(), 0xffff)));
+    }
+
+    m_llMgmtPkt = BuildLLCommand(cmdPayload);
+    m_llMgmtCmd = cmd;
+    m_llMgmtBE = m_csmaCa->GetMacMinBE();
+    m_llMgmtBackoff = m_llRandom->GetInteger(0, (1 << m_llMgmtBE) - 1);
+}
+
+void
+LrWpanMac::LLProcessBringUpBeacon(FlagsField::TransmissionState oldState)
+{
+    NS_LOG_FUNCTION(this << oldState);
+
+    if (m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE)
+    {
+        m_llMgmtPkt = nullptr;
+        if (oldState != FlagsField::ONLINE_STATE && m_llConfigured &&
+            !m_llBringUpStart.IsNegative())
+        {
+            Time timeToOnline = m_macBeaconRxTime - m_llBringUpStart;
+            NS_LOG_DEBUG("Online after " << timeToOnline.As(Time::S));
+            m_llTimeToOnlineTrace(m_simpleAddress, timeToOnline);
+            m_llBringUpStart = Seconds(-1);
+        }
+        return;
+    }
+
+    if (m_mlmeLLTransmissionState == FlagsField::DISCOVERY_STATE &&
+        oldState != FlagsField::DISCOVERY_STATE)
+    {
+        // The PAN-C started a new discovery of the network.
+        m_llDiscovered = false;
+        m_llConfigStatusAcked = false;
+        m_llConfigured = false;
+        m_llMgmtPkt = nullptr;
+        m_llMgmtAckEvent.Cancel();
+        m_llBringUpStart = Seconds(-1);
+    }
+
+    if (m_llBringUpStart.IsNegative())
+    {
+        m_llBringUpStart = m_macBeaconRxTime;
+    }
+
+    if (m_llMgmtPkt && m_llMgmtBackoff > 0)
+    {
+        m_llMgmtBackoff--;
+    }
+
+    if (m_mlmeLLTransmissionState == FlagsField::DISCOVERY_STATE)
+    {
+        if (!m_llDiscovered && !m_llMgmtPkt)
+        {
+            LLPrepareMgmtCommand(CommandPayloadHeader::LL_DISCOVER_RESP);
+        }
+    }
+    else if (m_mlmeLLTransmissionState == FlagsField::CONFIGURATION_STATE)
+    {
+        if (!m_llConfigured && !m_llConfigStatusAcked &&
+            (!m_llMgmtPkt || m_llMgmtCmd != CommandPayloadHeader::LL_CONFIGURATION_STATUS))
+        {
+            LLPrepareMgmtCommand(CommandPayloadHeader::LL_CONFIGURATION_STATUS);
+        }
+    }
+}
+
+bool
+LrWpanMac::LLAssignTimeslot(LLDNDeviceDescriptor& device)
+{
+    NS_LOG_FUNCTION(this << device.fullAddr);
+
+    device.assignedTimeslot = 0xff;
+
+    // Dedicated timeslots first, then the least used shared group timeslot.
+    uint8_t numTimeslots = std::min<uint16_t>(m_macLLDNnumTimeSlots,
+                                              m_macLLDNnumUplinkTS + m_macLLDNnumBidirectionalTS);
+    uint8_t sharedTimeslot = 0xff;
+    uint32_t sharedDevices = std::numeric_limits<uint32_t>::max();
+    for (uint8_t ts = m_macLLDNnumRetransmitTS; ts < numTimeslots; ts++)
+    {
+        if (GetLLDNTimeslotType(GetLLDNNumMgmtTimeslots() + ts) == LLDN_TS_SHARED)
+        {
+            uint32_t devices = 0;
+            for (const auto& it : m_llDevices)
+            {
+                devices += (it.second.assignedTimeslot == ts) ? 1 : 0;
+            }
+            if (devices < sharedDevices)
+            {
+                sharedTimeslot = ts;
+                sharedDevices = devices;
+            }
+        }
+        else if (m_llTimeslotOwners.find(ts) == m_llTimeslotOwners.end())
+        {
+            device.assignedTimeslot = ts;
+            break;
+        }
+    }
+
+    bool shared = (device.assignedTimeslot == 0xff && sharedTimeslot != 0xff);
+    if (shared)
+    {
+        device.assignedTimeslot = sharedTimeslot;
+    }
+
+    if (device.assignedTimeslot == 0xff)
+    {
+        NS_LOG_DEBUG("No base timeslot available for " << device.fullAddr);
+        return false;
+    }
+
+    device.numTimeslots = 1;
+    LLAssignSimpleAddress(device);
+
+    if (!shared)
+    {
+        SetLLDNTimeslotOwner(device.assignedTimeslot, device.simpleAddr);
+    }
+    NS_LOG_DEBUG("Device " << device.fullAddr << " assigned simple address " << device.simpleAddr
+                           << " and base timeslot "
+                           << static_cast<uint32_t>(device.assignedTimeslot));
+    return true;
+}
+
+void
+LrWpanMac::LLAssignSimpleAddress(LLDNDeviceDescriptor& device)
+{
+    // The simple addresses of the PAN-C and the broadcast simple address are not assigned.
+    uint8_t panCAddr;
+    m_simpleAddress.CopyTo(&panCAddr);
+    while (m_llNextSimpleAddress == panCAddr || m_llNextSimpleAddress == 0xff)
+    {
+        m_llNextSimpleAddress++;
+    }
+    device.simpleAddr = Mac8Address(m_llNextSimpleAddress++);
+}
+
+void
+LrWpanMac::LLPlanSuperframe()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_llPlanEvent.Cancel();
+
+    // Uplink devices first, then bidirectional devices, each group in increasing
+    // number of base timeslots so that most devices get a group acknowledgement.
+    std::vector<LLDNDeviceDescriptor*> devices;
+    uint32_t maxPayloadSize = 1;
+    Time minPeriod = Seconds(0);
+    for (auto& it : m_llDevices)
+    {
+        LLDNDeviceDescriptor& device = it.second;
+        if (!device.statusReceived)
+        {
+            continue;
+        }
+        devices.push_back(&device);
+        maxPayloadSize = std::max<uint32_t>(maxPayloadSize, device.timeslotDuration);
+        if (device.requestedPeriod.IsStrictlyPositive() &&
+            (minPeriod.IsZero() || device.requestedPeriod < minPeriod))
+        {
+            minPeriod = device.requestedPeriod;
+        }
+    }
+
+    if (devices.empty())
+    {
+        return;
+    }
+
+    // Management timeslots, in base timeslots.
+    uint32_t fixedTimeslots = 0;
+    if (m_macLLDNmgmtTS)
+    {
+        fixedTimeslots += 2 * std::max<uint8_t>(m_mlmeLLTimeSlotPerMgmtTS, 1);
+    }
+
+    // Every timeslot size up to the largest payload is a candidate, the shortest
+    // superframe wins (the largest timeslot size on a tie).
+    uint32_t bestSize = 0;
+    uint64_t bestSymbols = std::numeric_limits<uint64_t>::max();
+    for (uint32_t size = 1; size <= maxPayloadSize; size++)
+    {
+        uint64_t timeslotSymbols = GetLLDNTimeslotSymbols(size);
+        uint32_t numTimeslots = m_macLLDNnumRetransmitTS + m_macLLDNnumSharedGroupTS;
+        for (const auto device : devices)
+        {
+            uint64_t frameSymbols = GetLLDNTimeslotSymbols(device->timeslotDuration);
+            numTimeslots += (frameSymbols + timeslotSymbols - 1) / timeslotSymbols;
+        }
+
+        uint64_t symbols = GetLLDNBeaconTimeslotSymbols(timeslotSymbols, true, numTimeslots) +
+                           (fixedTimeslots + numTimeslots) * timeslotSymbols;
+        if (numTimeslots <= 0xff && symbols <= bestSymbols)
+        {
+            bestSize = size;
+            bestSymbols = symbols;
+        }
+    }
+
+    if (bestSize == 0)
+    {
+        NS_LOG_ERROR(this << " Too many devices for a LLDN superframe");
+        return;
+    }
+
+    uint64_t timeslotSymbols = GetLLDNTimeslotSymbols(bestSize);
+    auto numTimeslotsOf = [this, timeslotSymbols](const LLDNDeviceDescriptor* device) {
+        uint64_t frameSymbols = GetLLDNTimeslotSymbols(device->timeslotDuration);
+        return static_cast<uint8_t>((frameSymbols + timeslotSymbols - 1) / timeslotSymbols);
+    };
+    std::stable_sort(devices.begin(),
+                     devices.end(),
+                     [&numTimeslotsOf](const LLDNDeviceDescriptor* a,
+                                       const LLDNDeviceDescriptor* b) {
+                         if (a->typeIndicator != b->typeIndicator)
+                         {
+                             return a->typeIndicator < b->typeIndicator;
+                         }
+                         return numTimeslotsOf(a) < numTimeslotsOf(b);
+                     });
+
+    bool sizeChanged = (m_llPlan.m_timeslotSize != bestSize);
+    m_llTimeslotOwners.clear();
+    m_llPlan.m_timeslotSize = bestSize;
+    m_llPlan.m_numRetransmitTS = m_macLLDNnumRetransmitTS;
+    m_llPlan.m_numUplinkTS = m_macLLDNnumRetransmitTS;
+    m_llPlan.m_numBidirectionalTS = 0;
+
+    // The shared group timeslots follow the timeslots of the uplink devices.
+    uint8_t timeslot = m_macLLDNnumRetransmitTS;
+    bool sharedPlanned = false;
+    auto planShared = [this, &timeslot, &sharedPlanned]() {
+        timeslot += m_macLLDNnumSharedGroupTS;
+        m_llPlan.m_numUplinkTS += m_macLLDNnumSharedGroupTS;
+        sharedPlanned = true;
+    };
+    for (auto device : devices)
+    {
+        if (device->typeIndicator != 0 && !sharedPlanned)
+        {
+            planShared();
+        }
+        uint8_t numTimeslots = numTimeslotsOf(device);
+        bool changed = sizeChanged || device->assignedTimeslot != timeslot ||
+                       device->numTimeslots != numTimeslots;
+        device->assignedTimeslot = timeslot;
+        device->numTimeslots = numTimeslots;
+        for (uint8_t i = 0; i < numTimeslots; i++)
+        {
+            SetLLDNTimeslotOwner(timeslot + i, device->simpleAddr);
+        }
+        timeslot += numTimeslots;
+
+        if (device->typeIndicator == 0)
+        {
+            m_llPlan.m_numUplinkTS += numTimeslots;
+        }
+        else
+        {
+            m_llPlan.m_numBidirectionalTS += numTimeslots;
+        }
+
+        // Devices whose assignment changed get a new Configuration Request.
+        if (changed)
+        {
+            device->configured = false;
+        }
+        if (!device->configured && std::find(m_llConfigRequestQueue.begin(),
+                                             m_llConfigRequestQueue.end(),
+                                             device->fullAddr) == m_llConfigRequestQueue.end())
+        {
+            m_llConfigRequestQueue.push_back(device->fullAddr);
+        }
+    }
+    if (!sharedPlanned)
+    {
+        planShared();
+    }
+    m_llPlan.m_numTimeSlots = timeslot;
+
+    m_llPlan.m_superframeDuration = GetSymbolsTime(bestSymbols);
+    m_llPlan.m_periodsMet = (minPeriod.IsZero() || m_llPlan.m_superframeDuration <= minPeriod);
+
+    NS_LOG_DEBUG("LLDN superframe planned for "
+                 << devices.size() << " devices: timeslot size "
+                 << static_cast<uint32_t>(m_llPlan.m_timeslotSize) << ", "
+                 << static_cast<uint32_t>(m_llPlan.m_numTimeSlots) << " base timeslots, "
+                 << m_llPlan.m_superframeDuration.As(Time::MS)
+                 << (m_llPlan.m_periodsMet ? "" : " (longer than the requested periods)"));
+}
+
+void
+LrWpanMac::LLDiscoveryTimeout()
 {
-    m_incSuperframeStatus = BEACON;
+    NS_LOG_FUNCTION(this);
 
-    // TODO: If the device waits more than the expected time to receive the beacon (wait = 46
-    // symbols for default beacon size)
-    //       it should continue with the start of the incoming CAP even if it did not receive the
-    //       beacon. At the moment, the start of the incoming CAP is only triggered if the beacon is
-    //       received. See MLME-SyncLoss for details.
+    MlmeLLDNDiscoveryConfirmsParams confirmParams;
+    confirmParams.m_discoveredDevices = std::min<size_t>(m_llDevices.size(), 255);
+    confirmParams.m_status =
+        m_llDevices.empty() ? MLME_LLDN_DISCOVERY_NO_DEVICES : MLME_LLDN_DISCOVERY_SUCCESS;
+    NS_LOG_DEBUG("Discovery state ended, " << m_llDevices.size() << " devices discovered");
+
+    if (!m_mlmeLLDNDiscoveryConfirmCallback.IsNull())
+    {
+        m_mlmeLLDNDiscoveryConfirmCallback(confirmParams);
+    }
 }
 
 void
-LrWpanMac::BeaconSearchTimeout()
+LrWpanMac::LLConfigurationEnd()
 {
-    uint64_t symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false); // symbols per second
+    NS_LOG_FUNCTION(this);
 
-    if (m_numLostBeacons > aMaxLostBeacons)
+    m_llConfigurationTimeoutEvent.Cancel();
+
+    uint32_t configuredDevices = 0;
+    for (const auto& device : m_llDevices)
     {
-        MlmeSyncLossIndicationParams syncLossParams;
-        // syncLossParams.m_logCh =
-        syncLossParams.m_lossReason = MLMESYNCLOSS_BEACON_LOST;
-        syncLossParams.m_panId = m_macPanId;
-        m_mlmeSyncLossIndicationCallback(syncLossParams);
+        if (device.second.configured)
+        {
+            configuredDevices++;
+        }
+    }
 
-        m_beaconTrackingOn = false;
-        m_numLostBeacons = 0;
+    MlmeLLDNConfigurationConfirmParams confirmParams;
+    confirmParams.m_configuredDevices = std::min<uint32_t>(configuredDevices, 255);
+    confirmParams.m_status = (configuredDevices == 0) ? MLME_LLDN_CONFIGURATION_NO_DEVICES
+                                                      : MLME_LLDN_CONFIGURATION_SUCCESS;
+    if (m_llSlotPlanner)
+    {
+        confirmParams.m_LLNetworkConfiguration = m_llPlan;
     }
-    else
+    NS_LOG_DEBUG("Configuration state ended, " << configuredDevices << " devices configured");
+
+    if (!m_mlmeLLDNConfigurationConfirmCallback.IsNull())
     {
-        m_numLostBeacons++;
+        m_mlmeLLDNConfigurationConfirmCallback(confirmParams);
+    }
+}
 
-        // Search for one more beacon
-        uint64_t searchSymbols;
-        Time searchBeaconTime;
-        searchSymbols = ((uint64_t)1 << m_incomingBeaconOrder) + 1 * aBaseSuperframeDuration;
-        searchBeaconTime = Seconds((double)searchSymbols / symbolRate);
-        m_trackingEvent =
-            Simulator::Schedule(searchBeaconTime, &LrWpanMac::BeaconSearchTimeout, this);
+uint8_t
+LrWpanMac::GetLLDNNumMgmtSubslots() const
+{
+    uint64_t mgmtSymbols = GetLLDNMgmtTimeslotLength() * GetLLDNBaseTimeslotSymbols();
+    return std::max<uint64_t>(1, std::min<uint64_t>(255, mgmtSymbols / GetLLMgmtExchangeSymbols()));
+}
+
+uint64_t
+LrWpanMac::GetLLMgmtExchangeSymbols() const
+{
+    // The Configuration Request is the longest management command.
+    uint32_t cmdOctets =
+        aLLMacOverhead +
+        CommandPayloadHeader(CommandPayloadHeader::LL_CONFIGURATON_REQ).GetSerializedSize();
+
+    // Turnaround to TX, command frame, acknowledgement wait and SIFS.
+    uint64_t symbols = m_phy->aTurnaroundTime + m_phy->GetPhySHRDuration() +
+                       1 * m_phy->GetPhySymbolsPerOctet() +
+                       ceil(cmdOctets * m_phy->GetPhySymbolsPerOctet());
+    return symbols + GetLLMgmtAckWaitSymbols() + m_macSIFSPeriod;
+}
+
+uint64_t
+LrWpanMac::GetLLMgmtAckWaitSymbols() const
+{
+    // LL MAC header, acknowledged full MAC address and MAC trailer.
+    uint32_t ackOctets = aLLMacOverhead + 8;
+
+    return m_csmaCa->GetUnitBackoffPeriod() + m_phy->aTurnaroundTime +
+           m_phy->GetPhySHRDuration() + ceil((1 + ackOctets) * m_phy->GetPhySymbolsPerOctet());
+}
+
+bool
+LrWpanMac::IsLLFrame(Ptr<const Packet> p) const
+{
+    if (p->GetSize() == 0)
+    {
+        return false;
     }
+
+    // Only the frame type (bits 0-2 of the first frame control octet) is needed.
+    uint8_t frameControl;
+    p->CopyData(&frameControl, 1);
+    return ((frameControl & 0x07) == LrWpanLLMacHeader::LRWPAN_LLDN);
 }
 
 void
 LrWpanMac::CheckQueue()
 {
     NS_LOG_FUNCTION(this);
+
+    // In LLDN mode, the queue is only served in the LLDN timeslots (no CSMA-CA).
+    if (m_macLLenabled)
+    {
+        return;
+    }
+
+    // In a GTS, only the queue of the GTS is served (no CSMA-CA).
+    if (m_gtsTxQueue && Simulator::Now() < m_gtsEndTime)
+    {
+        GtsTransmit();
+        return;
+    }
+
     // Pull a packet from the queue and start sending if we are not already sending.
-    if (m_lrWpanMacState == MAC_IDLE && !m_txQueue.empty() && !m_setMacState.IsRunning())
+    if (m_lrWpanMacState == MAC_IDLE && !m_txQueue.IsEmpty() && !m_setMacState.IsRunning())
     {
         // TODO: this should check if the node is a coordinator and using the outcoming superframe
         // not just the PAN coordinator
@@ -1563,8 +4082,8 @@ LrWpanMac::CheckQueue()
             // check MAC is not in a IFS
             if (!m_ifsEvent.IsRunning())
             {
-                Ptr<TxQueueElement> txQElement = m_txQueue.front();
-                m_txPkt = txQElement->txQPkt;
+                TxQueueElement& txQElement = m_txQueue.Front();
+                m_txPkt = txQElement.txQPkt;
 
                 m_setMacState =
                     Simulator::ScheduleNow(&LrWpanMac::SetLrWpanMacState, this, MAC_CSMA);
@@ -1606,7 +4125,17 @@ LrWpanMac::GetGtsFields()
 {
     GtsFields gtsFields;
 
-    // TODO: Logic to populate the GTS Fields from local information here
+    // All the GTSs of the CFP are described in every beacon. A denied request is
+    // described with a starting slot of 0 (See IEEE 802.15.4-2011 Section 5.1.7.3).
+    gtsFields.SetGtsPermit(m_macGtsPermit);
+    for (const auto& gts : m_outGtsList)
+    {
+        gtsFields.AddGtsDescriptor(gts.devAddress, gts.startSlot, gts.length, gts.direction);
+    }
+    for (const auto& gts : m_gtsDenied)
+    {
+        gtsFields.AddGtsDescriptor(gts.devAddress, 0, gts.length, gts.direction);
+    }
 
     return gtsFields;
 }
@@ -1616,7 +4145,35 @@ LrWpanMac::GetPendingAddrFields()
 {
     PendingAddrFields pndAddrFields;
 
-    // TODO: Logic to populate the Pending Address Fields from local information here
+    // At most 7 addresses fit in a beacon (See IEEE 802.15.4-2011, Section 5.2.2.1.6).
+    // The destinations of the oldest pending transactions are listed, so that every
+    // destination is advertised in turn when there are more of them.
+    PurgeInd();
+    std::vector<uint64_t> oldestIds;
+    oldestIds.reserve(m_indTxQueueShortIndex.size() + m_indTxQueueExtIndex.size());
+    for (const auto& index : m_indTxQueueShortIndex)
+    {
+        oldestIds.push_back(index.second.front());
+    }
+    for (const auto& index : m_indTxQueueExtIndex)
+    {
+        oldestIds.push_back(index.second.front());
+    }
+    auto last = oldestIds.begin() + std::min<std::size_t>(oldestIds.size(), 7);
+    std::partial_sort(oldestIds.begin(), last, oldestIds.end());
+
+    for (auto it = oldestIds.begin(); it != last; it++)
+    {
+        const IndTxQueueElement& entry = m_indTxQueue.at(*it);
+        if (entry.dstAddrMode == SHORT_ADDR)
+        {
+            pndAddrFields.AddAddress(entry.dstShortAddress);
+        }
+        else
+        {
+            pndAddrFields.AddAddress(entry.dstExtAddress);
+        }
+    }
     return pndAddrFields;
 }
 
@@ -1627,7 +4184,7 @@ LrWpanMac::GetFlagsField()
     flagsField.SetTransmissionState(m_mlmeLLTransmissionState);
     flagsField.SetTransmissionDirection(m_mlmeLLTransmissionDirection);
     // reserved (bit-3) we dont set here
-    flagsField.SetTimeSlotPerMgmtTS(m_mlmeLLTimeSlotPerMgmtTS);
+    flagsField.SetTimeSlotPerMgmtTS(GetLLDNMgmtTimeslotLength());
 
     return flagsField;
 }
@@ -1641,6 +4198,7 @@ void
 LrWpanMac::SetPhy(Ptr<LrWpanPhy> phy)
 {
     m_phy = phy;
+    UpdateSymbolDuration();
 }
 
 Ptr<LrWpanPhy>
@@ -1709,6 +4267,18 @@ LrWpanMac::SetMlmePollConfirmCallback(MlmePollConfirmCallback c)
     m_mlmePollConfirmCallback = c;
 }
 
+void
+LrWpanMac::SetMlmeGtsConfirmCallback(MlmeGtsConfirmCallback c)
+{
+    m_mlmeGtsConfirmCallback = c;
+}
+
+void
+LrWpanMac::SetMlmeGtsIndicationCallback(MlmeGtsIndicationCallback c)
+{
+    m_mlmeGtsIndicationCallback = c;
+}
+
 void
 LrWpanMac::SetMlmeLLDNDiscoveryConfirmCallback(MlmeLLDNDiscoveryConfirmCallback c)
 {
@@ -1736,6 +4306,14 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
               m_lrWpanMacState == MAC_CSMA);
     NS_LOG_FUNCTION(this << psduLength << p << (uint16_t)lqi);
 
+    // LLDN frames (frame type 4) only carry a 1 octet MAC header, dispatch them
+    // to the LL receive handler before the general MAC frame processing.
+    if (m_macLLenabled && IsLLFrame(p))
+    {
+        LLDataIndication(psduLength, p, lqi);
+        return;
+    }
+
     bool acceptFrame;
 
     // from sec 7.5.6.2 Reception and rejection, Std802.15.4-2006
@@ -1748,7 +4326,6 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
     // srcPanId=m_macPanId
 
     Ptr<Packet> originalPkt = p->Copy(); // because we will strip headers
-    uint64_t symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false); // symbols per second
     m_promiscSnifferTrace(originalPkt);
 
     m_macPromiscRxTrace(originalPkt);
@@ -1926,7 +4503,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                     Time timeLeftInCap = Simulator::GetDelayLeft(m_capEvent);
                     uint64_t ackSymbols = m_phy->aTurnaroundTime + m_phy->GetPhySHRDuration() +
                                           ceil(6 * m_phy->GetPhySymbolsPerOctet());
-                    Time ackTime = Seconds((double)ackSymbols / symbolRate);
+                    Time ackTime = GetSymbolsTime(ackSymbols);
 
                     if (ackTime >= timeLeftInCap)
                     {
@@ -1947,7 +4524,9 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                 // If the received frame is a frame with the ACK request bit set, we immediately
                 // send back an ACK. If we are currently waiting for a pending ACK, we assume the
                 // ACK was lost and trigger a retransmission after sending the ACK.
-                if ((receivedMacHdr.IsData() || receivedMacHdr.IsCommand()) &&
+                // In LLDN mode, frames are acknowledged with the group acknowledgement of the
+                // next LL beacon instead.
+                if (!m_macLLenabled && (receivedMacHdr.IsData() || receivedMacHdr.IsCommand()) &&
                     receivedMacHdr.IsAckReq() &&
                     !(receivedMacHdr.GetDstAddrMode() == SHORT_ADDR &&
                       (receivedMacHdr.GetShortDstAddr().IsBroadcast() ||
@@ -1981,12 +4560,15 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                     m_rxPkt = originalPkt->Copy();
 
                     // LOG Commands with ACK required.
+                    // The ACK of a data request tells if a transaction is pending for the device.
+                    bool framePending = false;
                     CommandPayloadHeader receivedMacPayload;
                     p->PeekHeader(receivedMacPayload);
                     switch (receivedMacPayload.GetCommandFrameType())
                     {
                     case CommandPayloadHeader::DATA_REQ:
                         NS_LOG_DEBUG("Data Request Command Received; processing ACK");
+                        framePending = receivedMacHdr.IsCommand() && IsIndTxPending(receivedMacHdr);
                         break;
                     case CommandPayloadHeader::ASSOCIATION_REQ:
                         NS_LOG_DEBUG("Association Request Command Received; processing ACK");
@@ -2001,7 +4583,8 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
 
                     m_setMacState = Simulator::ScheduleNow(&LrWpanMac::SendAck,
                                                            this,
-                                                           receivedMacHdr.GetSeqNum());
+                                                           receivedMacHdr.GetSeqNum(),
+                                                           framePending);
                 }
 
                 if (receivedMacHdr.GetDstAddrMode() == SHORT_ADDR)
@@ -2026,8 +4609,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
 
                     // The start of Rx beacon time and start of the Incoming superframe Active
                     // Period
-                    m_macBeaconRxTime =
-                        Simulator::Now() - Seconds(double(m_rxBeaconSymbols) / symbolRate);
+                    m_macBeaconRxTime = Simulator::Now() - GetSymbolsTime(m_rxBeaconSymbols);
 
                     NS_LOG_DEBUG("Beacon Received; forwarding up (m_macBeaconRxTime: "
                                  << m_macBeaconRxTime.As(Time::S) << ")");
@@ -2093,7 +4675,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                             m_csmaCa->SetSlottedCsmaCa();
                         }
 
-                        // TODO: get Incoming frame GTS Fields here
+                        UpdateIncomingGts(receivedMacPayload.GetGtsFields());
 
                         // Begin CAP on the current device using info from the Incoming superframe
                         NS_LOG_DEBUG("Incoming superframe Active Portion (Beacon + CAP + CFP): "
@@ -2177,10 +4759,9 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                                 Time searchBeaconTime;
 
                                 searchSymbols =
-                                    (static_cast<uint64_t>(1 << m_incomingBeaconOrder)) +
-                                    1 * aBaseSuperframeDuration;
-                                searchBeaconTime =
-                                    Seconds(static_cast<double>(searchSymbols / symbolRate));
+                                    (static_cast<uint64_t>(1 << m_incomingBeaconOrder) + 1) *
+                                    aBaseSuperframeDuration;
+                                searchBeaconTime = GetSymbolsTime(searchSymbols);
                                 m_trackingEvent =
                                     Simulator::Schedule(searchBeaconTime,
                                                         &LrWpanMac::BeaconSearchTimeout,
@@ -2192,9 +4773,20 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
 
                             // TODO: Ignore pending data, and do not send data command request if
                             // the address is in the GTS list.
-                            //       If the address is not in the GTS list, then  check if the
-                            //       address is in the short address pending list or in the extended
-                            //       address pending list and send a data command request.
+                            // If the address is in the short address pending list or in the
+                            // extended address pending list, extract the data with a data
+                            // request command (See IEEE 802.15.4-2011 Section 5.1.6.3).
+                            if (!m_pollPending && (pndAddrFields.SearchAddress(m_shortAddress) ||
+                                                   pndAddrFields.SearchAddress(m_selfExt)))
+                            {
+                                NS_LOG_DEBUG("Data pending in the coordinator, polling");
+                                MlmePollRequestParams pollParams;
+                                pollParams.m_coorAddrMode = panDescriptor.m_coorAddrMode;
+                                pollParams.m_coorPanId = panDescriptor.m_coorPanId;
+                                pollParams.m_coorShortAddr = panDescriptor.m_coorShortAddr;
+                                pollParams.m_coorExtAddr = panDescriptor.m_coorExtAddr;
+                                MlmePollRequest(pollParams);
+                            }
                         }
                     }
                     else
@@ -2207,6 +4799,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                             MlmeBeaconNotifyIndicationParams beaconParams;
                             beaconParams.m_bsn = receivedMacHdr.GetSeqNum();
                             beaconParams.m_panDescriptor = panDescriptor;
+                            beaconParams.m_pendAddrSpec = receivedMacPayload.GetPndAddrFields();
                             m_mlmeBeaconNotifyIndicationCallback(beaconParams, originalPkt);
                         }
                     }
@@ -2235,6 +4828,22 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                 {
                     // If it is a data frame, push it up the stack.
                     NS_LOG_DEBUG("Data Packet is for me; forwarding up");
+                    if (m_macLLenabled)
+                    {
+                        LLRecordGroupAck(m_llCurrentTimeslot, m_llCurrentTimeslotType);
+                    }
+                    if (m_pollWaitTimeout.IsRunning() && IsPollResponse(params))
+                    {
+                        // The frame announced in response to a poll was received.
+                        m_pollWaitTimeout.Cancel();
+                        m_pollPending = false;
+                        if (!m_mlmePollConfirmCallback.IsNull())
+                        {
+                            MlmePollConfirmParams pollConfirmParams;
+                            pollConfirmParams.m_status = MLMEPOLL_SUCCESS;
+                            m_mlmePollConfirmCallback(pollConfirmParams);
+                        }
+                    }
                     m_mcpsDataIndicationCallback(params, p);
                 }
                 else if (receivedMacHdr.IsAcknowledgment() && m_txPkt &&
@@ -2249,7 +4858,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                         m_macTxOkTrace(m_txPkt);
 
                         // TODO: check  if the IFS is the correct size after ACK.
-                        Time ifsWaitTime = Seconds((double)GetIfsSize() / symbolRate);
+                        Time ifsWaitTime = GetSymbolsTime(GetIfsSize());
 
                         // We received an ACK to a command
                         if (peekedMacHdr.IsCommand())
@@ -2265,9 +4874,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                             switch (cmdPayload.GetCommandFrameType())
                             {
                             case CommandPayloadHeader::ASSOCIATION_REQ: {
-                                double symbolRate = m_phy->GetDataOrSymbolRate(false);
-                                Time waitTime = Seconds(static_cast<double>(m_macResponseWaitTime) /
-                                                        symbolRate);
+                                Time waitTime = GetSymbolsTime(m_macResponseWaitTime);
                                 if (!m_beaconTrackingOn)
                                 {
                                     m_respWaitTimeout =
@@ -2308,22 +4915,79 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                             }
 
                             case CommandPayloadHeader::DATA_REQ: {
-                                // Schedule an event in case the Association Response Command never
-                                // reached this device during an association process.
-                                double symbolRate = m_phy->GetDataOrSymbolRate(false);
-                                Time waitTime = Seconds(
-                                    static_cast<double>(m_assocRespCmdWaitTime) / symbolRate);
-                                m_assocResCmdWaitTimeout =
-                                    Simulator::Schedule(waitTime,
-                                                        &LrWpanMac::LostAssocRespCommand,
-                                                        this);
+                                if (!m_pollPending)
+                                {
+                                    // Schedule an event in case the Association Response Command
+                                    // never reached this device during an association process.
+                                    Time waitTime = GetSymbolsTime(m_assocRespCmdWaitTime);
+                                    m_assocResCmdWaitTimeout =
+                                        Simulator::Schedule(waitTime,
+                                                            &LrWpanMac::LostAssocRespCommand,
+                                                            this);
+                                }
+                                else if (receivedMacHdr.IsFrmPend())
+                                {
+                                    // Keep the receiver on until the pending frame arrives.
+                                    Time waitTime = GetSymbolsTime(GetMacMaxFrameTotalWaitTime());
+                                    m_pollWaitTimeout =
+                                        Simulator::Schedule(waitTime,
+                                                            &LrWpanMac::PollWaitTimeout,
+                                                            this);
+                                }
+                                else
+                                {
+                                    m_pollPending = false;
+                                    if (!m_mlmePollConfirmCallback.IsNull())
+                                    {
+                                        MlmePollConfirmParams pollConfirmParams;
+                                        pollConfirmParams.m_status =
+                                            LrWpanMlmePollConfirmStatus::MLMEPOLL_NO_DATA;
+                                        m_mlmePollConfirmCallback(pollConfirmParams);
+                                    }
+                                }
+                                break;
+                            }
 
-                                if (!m_mlmePollConfirmCallback.IsNull())
+                            case CommandPayloadHeader::GTS_REQ: {
+                                GtsCharacteristics gts =
+                                    GetGtsCharacteristics(cmdPayload.GetGtsCharacteristics());
+                                if (gts.m_allocation)
+                                {
+                                    // The allocation is described in one of the next beacons
+                                    // (See IEEE 802.15.4-2011 Section 5.1.7.2).
+                                    Time waitTime = GetSymbolsTime(aGTSDescPersistenceTime *
+                                                                   m_incomingBeaconInterval);
+                                    m_gtsRequestTimeout =
+                                        Simulator::Schedule(waitTime,
+                                                            &LrWpanMac::GtsRequestTimeout,
+                                                            this);
+                                }
+                                else
                                 {
-                                    MlmePollConfirmParams pollConfirmParams;
-                                    pollConfirmParams.m_status =
-                                        LrWpanMlmePollConfirmStatus::MLMEPOLL_SUCCESS;
-                                    m_mlmePollConfirmCallback(pollConfirmParams);
+                                    // The deallocation is effective as soon as it is acknowledged
+                                    // (See IEEE 802.15.4-2011 Section 5.1.7.4).
+                                    auto it = std::find_if(m_incGtsList.begin(),
+                                                           m_incGtsList.end(),
+                                                           [&gts](const GtsDescriptor& incGts) {
+                                                               return incGts.direction ==
+                                                                      gts.m_gtsDirection;
+                                                           });
+                                    if (it != m_incGtsList.end())
+                                    {
+                                        m_incGtsList.erase(it);
+                                    }
+                                    if (!gts.m_gtsDirection)
+                                    {
+                                        RemoveGtsTxQueue(m_shortAddress, false);
+                                    }
+                                    m_gtsRequestPending = false;
+                                    if (!m_mlmeGtsConfirmCallback.IsNull())
+                                    {
+                                        MlmeGtsConfirmParams gtsConfirmParams;
+                                        gtsConfirmParams.m_gtsCharacteristics = gts;
+                                        gtsConfirmParams.m_status = MLMEGTS_SUCCESS;
+                                        m_mlmeGtsConfirmCallback(gtsConfirmParams);
+                                    }
                                 }
                                 break;
                             }
@@ -2338,9 +5002,9 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                         {
                             if (!m_mcpsDataConfirmCallback.IsNull())
                             {
-                                Ptr<TxQueueElement> txQElement = m_txQueue.front();
+                                TxQueueElement& txQElement = GetCurrentTxQueue().Front();
                                 McpsDataConfirmParams confirmParams;
-                                confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+                                confirmParams.m_msduHandle = txQElement.txQMsduHandle;
                                 confirmParams.m_status = IEEE_802_15_4_SUCCESS;
                                 m_mcpsDataConfirmCallback(confirmParams);
                             }
@@ -2381,21 +5045,360 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
             }
             else
             {
-                m_macRxDropTrace(originalPkt);
+                m_macRxDropTrace(originalPkt);
+            }
+        }
+    }
+}
+
+void
+LrWpanMac::LLDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+
+    McpsDataConfirmParams confirmParams;
+    confirmParams.m_msduHandle = params.m_msduHandle;
+
+    // LL-DATA frames are only used in LLDN mode and carry no address fields,
+    // both the source and the destination must use the simple address mode.
+    if (!m_macLLenabled || params.m_srcAddrMode != SIMPLE_ADDR ||
+        params.m_dstAddrMode != SIMPLE_ADDR)
+    {
+        NS_LOG_ERROR(this << " Simple addresses can only be used between LLDN devices");
+        confirmParams.m_status = IEEE_802_15_4_INVALID_ADDRESS;
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+        return;
+    }
+
+    // Devices assigned several base timeslots send frames longer than the timeslot size.
+    bool tooLong = (p->GetSize() > m_mlmeLLTimeslotSize);
+    if (m_llNumAssignedTimeslots > 1)
+    {
+        tooLong = (aLLMacOverhead + p->GetSize() > LrWpanPhy::aMaxPhyPacketSize ||
+                   GetLLDNTimeslotSymbols(p->GetSize()) >
+                       m_llNumAssignedTimeslots * GetLLDNBaseTimeslotSymbols());
+    }
+    if (tooLong)
+    {
+        NS_LOG_ERROR(this << " packet too big for the LLDN timeslot: " << p->GetSize());
+        confirmParams.m_status = IEEE_802_15_4_FRAME_TOO_LONG;
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+        return;
+    }
+
+    // IEEE 802.15.4e-2012 Section 5.2.2.5.3 LL-Data frame format
+    LrWpanLLMacHeader llMacHdr(LrWpanLLMacHeader::LRWPAN_LLDN, LrWpanLLMacHeader::LL_DATA);
+    llMacHdr.SetSecDisable();
+
+    if ((params.m_txOptions & TX_OPTION_ACK) &&
+        params.m_dstSimpleAddr != Mac8Address::GetBroadcast())
+    {
+        llMacHdr.SetAckReq();
+    }
+    else
+    {
+        llMacHdr.SetNoAckReq();
+    }
+
+    p->AddHeader(llMacHdr);
+
+    LrWpanMacTrailer macTrailer;
+    // Calculate FCS if the global attribute ChecksumEnable is set.
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(p);
+    }
+    p->AddTrailer(macTrailer);
+
+    TxQueueElement txQElement;
+    txQElement.txQMsduHandle = params.m_msduHandle;
+    txQElement.txQPkt = p;
+    txQElement.txQDstSimpleAddr = params.m_dstSimpleAddr;
+    EnqueueTxQElement(txQElement);
+    CheckQueue();
+}
+
+void
+LrWpanMac::LLDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
+{
+    NS_LOG_FUNCTION(this << psduLength << p << static_cast<uint32_t>(lqi));
+
+    // The received frame is only kept for the traces if someone is listening.
+    Ptr<Packet> originalPkt;
+    if (!m_promiscSnifferTrace.IsEmpty() || !m_macPromiscRxTrace.IsEmpty() ||
+        !m_macRxTrace.IsEmpty() || !m_macRxDropTrace.IsEmpty())
+    {
+        originalPkt = p->Copy();
+    }
+    m_promiscSnifferTrace(originalPkt);
+    m_macPromiscRxTrace(originalPkt);
+
+    LrWpanMacTrailer receivedMacTrailer;
+    p->RemoveTrailer(receivedMacTrailer);
+    if (Node::ChecksumEnabled())
+    {
+        receivedMacTrailer.EnableFcs(true);
+    }
+
+    if (!receivedMacTrailer.CheckFcs(p))
+    {
+        m_macRxDropTrace(originalPkt);
+        return;
+    }
+
+    LrWpanLLMacHeader receivedLLMacHdr;
+    p->RemoveHeader(receivedLLMacHdr);
+
+    if (receivedLLMacHdr.GetSubFrameType() == LrWpanLLMacHeader::LL_BEACON &&
+        !m_macLLDNcoordinator)
+    {
+        LLBeaconPayloadHeader receivedLLBeaconPayload;
+        p->RemoveHeader(receivedLLBeaconPayload);
+
+        // Several LLDNs may share the channel, only follow the superframe of our own PAN-C.
+        uint8_t lowLatencyNWid;
+        receivedLLBeaconPayload.GetLLPanCoordAddr().CopyTo(&lowLatencyNWid);
+        if (m_macLLDNlowLatencyNWid == 0xff)
+        {
+            m_macLLDNlowLatencyNWid = lowLatencyNWid;
+        }
+        else if (m_macLLDNlowLatencyNWid != lowLatencyNWid)
+        {
+            NS_LOG_DEBUG("LL Beacon from another LLDN (" << static_cast<uint32_t>(lowLatencyNWid)
+                                                         << "), ignored");
+            m_macRxDropTrace(originalPkt);
+            return;
+        }
+
+        m_macRxTrace(originalPkt);
+
+        // The received LL beacon size in symbols
+        // Beacon = 5 bytes Sync Header (SHR) +  1 byte PHY header (PHR) + PSDU
+        m_rxBeaconSymbols = m_phy->GetPhySHRDuration() + 1 * m_phy->GetPhySymbolsPerOctet() +
+                            (psduLength * m_phy->GetPhySymbolsPerOctet());
+
+        // The start of Rx beacon time and start of the LLDN superframe
+        m_macBeaconRxTime = Simulator::Now() - GetSymbolsTime(m_rxBeaconSymbols);
+
+        NS_LOG_DEBUG("LL Beacon Received (m_macBeaconRxTime: " << m_macBeaconRxTime.As(Time::S)
+                                                                << ")");
+
+        // The LL beacon describes the superframe, keep it in sync with the PAN-C.
+        FlagsField flagsField = receivedLLBeaconPayload.GetFlagsFields();
+        FlagsField::TransmissionState oldState = m_mlmeLLTransmissionState;
+        bool wasOnline = (oldState == FlagsField::ONLINE_STATE);
+
+        m_macCoordSimpleAddress = receivedLLBeaconPayload.GetLLPanCoordAddr();
+        m_mlmeLLTransmissionState =
+            static_cast<FlagsField::TransmissionState>(flagsField.GetTransmissionState());
+        m_mlmeLLTransmissionDirection =
+            flagsField.GetTransmissionDirection() ? FlagsField::DOWNLINK : FlagsField::UPLINK;
+        m_mlmeLLTimeSlotPerMgmtTS = flagsField.GetTimeSlotPerMgmtTS();
+        m_macLLDNmgmtTS = (m_mlmeLLTimeSlotPerMgmtTS > 0);
+        m_mlmeLLConfigurationSeq = receivedLLBeaconPayload.GetConfigurationSeqNum();
+        m_mlmeLLTimeslotSize = receivedLLBeaconPayload.GetBaseTimeSlotSize();
+
+        if (m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE)
+        {
+            m_macLLDNnumTimeSlots = receivedLLBeaconPayload.GetNumOfBaseTsInSuperframe();
+            LLProcessGroupAck(receivedLLBeaconPayload.GetgroupAckBmp());
+
+            if (!wasOnline && !m_mlmeLLDNOnlineIndicationCallback.IsNull())
+            {
+                MlmeLLDNOnlineIndicationParams onlineParams;
+                onlineParams.m_status = MLME_LLDN_ONLINE_NONE;
+                m_mlmeLLDNOnlineIndicationCallback(onlineParams);
+            }
+        }
+
+        LLProcessBringUpBeacon(oldState);
+
+        m_llTimeslotEvent.Cancel();
+        m_llMgmtSubslotEvent.Cancel();
+        StartLLSuperframe(SuperframeType::INCOMING);
+    }
+    else if (receivedLLMacHdr.GetSubFrameType() == LrWpanLLMacHeader::LL_DATA &&
+             m_mlmeLLTransmissionState == FlagsField::ONLINE_STATE)
+    {
+        // LL-DATA frames carry no address fields, the source and the destination
+        // are given by the timeslot in which the frame is received.
+        McpsDataIndicationParams params;
+        params.m_mpduLinkQuality = lqi;
+        params.m_srcAddrMode = SIMPLE_ADDR;
+        params.m_dstAddrMode = SIMPLE_ADDR;
+        params.m_srcPanId = m_macPanId;
+        params.m_dstPanId = m_macPanId;
+        params.m_dstSimpleAddr = m_simpleAddress;
+
+        bool acceptFrame;
+        uint16_t rxTimeslot = m_llCurrentTimeslot;
+        LLDNTimeslotType rxTimeslotType = m_llCurrentTimeslotType;
+        if (m_macLLDNcoordinator)
+        {
+            // Uplink frame from the device that owns the timeslot in which the reception
+            // started: a frame filling its timeslot ends at the start of the next one,
+            // a frame spanning several base timeslots ends in its last one.
+            uint64_t rxSymbols = m_phy->GetPhySHRDuration() + 1 * m_phy->GetPhySymbolsPerOctet() +
+                                 psduLength * m_phy->GetPhySymbolsPerOctet();
+            rxTimeslot = GetLLDNTimeslotAt(Simulator::Now() - GetSymbolsTime(rxSymbols));
+            rxTimeslotType =
+                (rxTimeslot == 0xffff) ? LLDN_TS_BEACON : GetLLDNTimeslotType(rxTimeslot);
+            acceptFrame = IsLLUplinkTimeslot(rxTimeslotType);
+            params.m_srcSimpleAddr =
+                GetLLDNTimeslotOwner(rxTimeslot - GetLLDNNumMgmtTimeslots());
+        }
+        else
+        {
+            // Downlink frame from the PAN-C in the bidirectional timeslot of the device.
+            uint16_t timeslot = GetLLDNNumMgmtTimeslots() + m_macLLDNassignedTimeSlot;
+            acceptFrame = (m_macLLDNassignedTimeSlot != 0xff &&
+                           m_mlmeLLTransmissionDirection == FlagsField::DOWNLINK &&
+                           GetLLDNTimeslotType(timeslot) == LLDN_TS_BIDIRECTIONAL &&
+                           IsInLLTimeslot(timeslot));
+            params.m_srcSimpleAddr = m_macCoordSimpleAddress;
+        }
+
+        if (acceptFrame)
+        {
+            m_macRxTrace(originalPkt);
+            LLRecordGroupAck(rxTimeslot, rxTimeslotType);
+            if (m_macLLDNcoordinator)
+            {
+                m_llBeaconToDataTrace(params.m_srcSimpleAddr,
+                                      Simulator::Now() - m_llSuperframeStart);
+            }
+            if (!m_mcpsDataIndicationCallback.IsNull())
+            {
+                NS_LOG_DEBUG("LL-DATA frame from " << params.m_srcSimpleAddr
+                                                   << "; forwarding up");
+                m_mcpsDataIndicationCallback(params, p);
+            }
+        }
+        else
+        {
+            m_macRxDropTrace(originalPkt);
+        }
+    }
+    else if (receivedLLMacHdr.GetSubFrameType() == LrWpanLLMacHeader::LL_MAC_COMMAND &&
+             m_mlmeLLTransmissionState != FlagsField::ONLINE_STATE)
+    {
+        m_macRxTrace(originalPkt);
+        LLCommandIndication(p, receivedLLMacHdr.GetAckReq());
+    }
+    else if (receivedLLMacHdr.GetSubFrameType() == LrWpanLLMacHeader::LL_ACK &&
+             m_llMgmtAckEvent.IsRunning())
+    {
+        m_macRxTrace(originalPkt);
+        LLMgmtAckIndication(p);
+    }
+    else
+    {
+        m_macRxDropTrace(originalPkt);
+    }
+}
+
+void
+LrWpanMac::LLDataConfirm(LrWpanPhyEnumeration status)
+{
+    NS_LOG_FUNCTION(this << status);
+
+    if (status == IEEE_802_15_4_PHY_SUCCESS)
+    {
+        if (m_llMgmtTx)
+        {
+            LrWpanLLMacHeader llMacHdr;
+            m_txPkt->PeekHeader(llMacHdr);
+            if (llMacHdr.GetSubFrameType() == LrWpanLLMacHeader::LL_MAC_COMMAND)
+            {
+                // Wait for the acknowledgement of the management command.
+                Time waitTime = GetSymbolsTime(GetLLMgmtAckWaitSymbols());
+                m_llMgmtAckEvent =
+                    Simulator::Schedule(waitTime, &LrWpanMac::LLMgmtAckTimeout, this);
+            }
+            m_txPkt = nullptr;
+        }
+        else if (!m_llTimeslotTx)
+        {
+            // A LL beacon was sent, it marks the start of a new LLDN superframe.
+            m_macBeaconTxTime = Simulator::Now() - GetSymbolsTime(GetTxPacketSymbols());
+            NS_LOG_DEBUG("LL Beacon Sent (m_macBeaconTxTime: " << m_macBeaconTxTime.As(Time::S)
+                                                               << ")");
+            m_txPkt = nullptr;
+            StartLLSuperframe(SuperframeType::OUTGOING);
+        }
+        else if (IsLLGroupAckReq())
+        {
+            // Frames sent in a LLDN timeslot are not individually acknowledged,
+            // wait for the group acknowledgement in the next LL beacon.
+            m_llTxEndTime = Simulator::Now();
+            m_llGroupAckPending = true;
+            m_llGroupAckTimeslot = m_llCurrentTimeslot - GetLLDNNumMgmtTimeslots();
+            NS_LOG_DEBUG("Waiting for the group acknowledgement of base timeslot "
+                         << static_cast<uint32_t>(m_llGroupAckTimeslot));
+        }
+        else
+        {
+            NS_ASSERT_MSG(m_txQueue.GetSize() > 0, "TxQsize = 0");
+            m_macTxOkTrace(m_txPkt);
+            m_llDataLatencyTrace(m_txPkt, Simulator::Now() - m_txQueue.Front().txQEnqueueTime);
+            if (!m_mcpsDataConfirmCallback.IsNull())
+            {
+                McpsDataConfirmParams confirmParams;
+                confirmParams.m_msduHandle = m_txQueue.Front().txQMsduHandle;
+                confirmParams.m_status = IEEE_802_15_4_SUCCESS;
+                m_mcpsDataConfirmCallback(confirmParams);
             }
+            RemoveFirstTxQElement();
+        }
+    }
+    else if (status == IEEE_802_15_4_PHY_UNSPECIFIED && m_llTimeslotTx)
+    {
+        NS_ASSERT_MSG(m_txQueue.GetSize() > 0, "TxQsize = 0");
+        TxQueueElement& txQElement = m_txQueue.Front();
+        m_macTxDropTrace(txQElement.txQPkt);
+        if (!m_mcpsDataConfirmCallback.IsNull())
+        {
+            McpsDataConfirmParams confirmParams;
+            confirmParams.m_msduHandle = txQElement.txQMsduHandle;
+            confirmParams.m_status = IEEE_802_15_4_FRAME_TOO_LONG;
+            m_mcpsDataConfirmCallback(confirmParams);
         }
+        RemoveFirstTxQElement();
+    }
+    else
+    {
+        // Something went really wrong. The PHY is not in the correct state for
+        // data transmission.
+        NS_FATAL_ERROR("Transmission attempt failed with PHY status " << status);
     }
+
+    // The IFS is already part of the LLDN timeslot.
+    m_llTimeslotTx = false;
+    m_llMgmtTx = false;
+    m_setMacState.Cancel();
+    m_setMacState = Simulator::ScheduleNow(&LrWpanMac::SetLrWpanMacState, this, MAC_IDLE);
 }
 
 void
-LrWpanMac::SendAck(uint8_t seqno)
+LrWpanMac::SendAck(uint8_t seqno, bool framePending)
 {
-    NS_LOG_FUNCTION(this << static_cast<uint32_t>(seqno));
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(seqno) << framePending);
 
     NS_ASSERT(m_lrWpanMacState == MAC_IDLE);
 
     // Generate a corresponding ACK Frame.
     LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_ACKNOWLEDGMENT, seqno);
+    if (framePending)
+    {
+        macHdr.SetFrmPend();
+    }
     LrWpanMacTrailer macTrailer;
     Ptr<Packet> ackPacket = Create<Packet>(0);
     ackPacket->AddHeader(macHdr);
@@ -2417,45 +5420,94 @@ LrWpanMac::SendAck(uint8_t seqno)
 }
 
 void
-LrWpanMac::EnqueueTxQElement(Ptr<TxQueueElement> txQElement)
+LrWpanMac::EnqueueTxQElement(TxQueueElement txQElement)
 {
-    if (m_txQueue.size() < m_maxTxQueueSize)
+    if (m_txQueue.IsFull() && m_txQueueDropPolicy != TX_QUEUE_TAIL_DROP)
+    {
+        // The MSDU at the head of the queue cannot be dropped while it is being sent.
+        uint32_t first = 0;
+        if (!m_txQueue.IsEmpty() && (m_txPkt == m_txQueue.Front().txQPkt ||
+                                     m_llGroupAckPending || m_retransmission > 0))
+        {
+            first = 1;
+        }
+
+        if (first < m_txQueue.GetSize())
+        {
+            if (m_txQueueDropPolicy == TX_QUEUE_HEAD_DROP)
+            {
+                NS_LOG_DEBUG("TX Queue is full, dropping the oldest packet");
+                DropTxQElement(first, IEEE_802_15_4_TRANSACTION_OVERFLOW);
+            }
+            else if (Simulator::Now() - m_txQueue[first].txQEnqueueTime > m_txQueueStaleTime)
+            {
+                NS_LOG_DEBUG("TX Queue is full, dropping the oldest stale packet");
+                DropTxQElement(first, IEEE_802_15_4_TRANSACTION_EXPIRED);
+            }
+        }
+    }
+
+    if (!m_txQueue.IsFull())
     {
-        m_txQueue.emplace_back(txQElement);
-        m_macTxEnqueueTrace(txQElement->txQPkt);
+        txQElement.txQEnqueueTime = Simulator::Now();
+        Ptr<const Packet> p = txQElement.txQPkt;
+        m_txQueue.PushBack(std::move(txQElement));
+        m_macTxEnqueueTrace(p);
     }
     else
     {
         if (!m_mcpsDataConfirmCallback.IsNull())
         {
             McpsDataConfirmParams confirmParams;
-            confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+            confirmParams.m_msduHandle = txQElement.txQMsduHandle;
             confirmParams.m_status = IEEE_802_15_4_TRANSACTION_OVERFLOW;
             m_mcpsDataConfirmCallback(confirmParams);
         }
-        NS_LOG_DEBUG("TX Queue with size " << m_txQueue.size() << " is full, dropping packet");
-        m_macTxDropTrace(txQElement->txQPkt);
+        NS_LOG_DEBUG("TX Queue with size " << m_txQueue.GetSize() << " is full, dropping packet");
+        m_macTxDropTrace(txQElement.txQPkt);
+    }
+}
+
+void
+LrWpanMac::DropTxQElement(uint32_t i, LrWpanMcpsDataConfirmStatus status)
+{
+    TxQueueElement txQElement = std::move(m_txQueue[i]);
+    m_txQueue.Erase(i);
+    m_macTxDropTrace(txQElement.txQPkt);
+    if (!m_mcpsDataConfirmCallback.IsNull())
+    {
+        McpsDataConfirmParams confirmParams;
+        confirmParams.m_msduHandle = txQElement.txQMsduHandle;
+        confirmParams.m_status = status;
+        m_mcpsDataConfirmCallback(confirmParams);
     }
 }
 
 void
 LrWpanMac::RemoveFirstTxQElement()
 {
-    Ptr<TxQueueElement> txQElement = m_txQueue.front();
-    Ptr<const Packet> p = txQElement->txQPkt;
+    LrWpanRingBuffer<TxQueueElement>& txQueue = GetCurrentTxQueue();
+    Ptr<const Packet> p = txQueue.Front().txQPkt;
     m_numCsmacaRetry += m_csmaCa->GetNB() + 1;
 
-    Ptr<Packet> pkt = p->Copy();
-    LrWpanMacHeader hdr;
-    pkt->RemoveHeader(hdr);
-    if (!hdr.GetShortDstAddr().IsBroadcast() && !hdr.GetShortDstAddr().IsMulticast())
+    if (IsLLFrame(p))
     {
+        // LL frames do not carry address fields.
         m_sentPktTrace(p, m_retransmission + 1, m_numCsmacaRetry);
     }
+    else
+    {
+        Ptr<Packet> pkt = p->Copy();
+        LrWpanMacHeader hdr;
+        pkt->RemoveHeader(hdr);
+        if (!hdr.GetShortDstAddr().IsBroadcast() && !hdr.GetShortDstAddr().IsMulticast())
+        {
+            m_sentPktTrace(p, m_retransmission + 1, m_numCsmacaRetry);
+        }
+    }
 
-    txQElement->txQPkt = nullptr;
-    txQElement = nullptr;
-    m_txQueue.pop_front();
+    txQueue.PopFront();
+    m_gtsTx = false;
     m_txPkt = nullptr;
     m_retransmission = 0;
     m_numCsmacaRetry = 0;
@@ -2483,9 +5535,8 @@ LrWpanMac::AckWaitTimeout()
 void
 LrWpanMac::IfsWaitTimeout(Time ifsTime)
 {
-    uint64_t symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false);
-    Time lifsTime = Seconds((double)m_macLIFSPeriod / symbolRate);
-    Time sifsTime = Seconds((double)m_macSIFSPeriod / symbolRate);
+    Time lifsTime = GetSymbolsTime(m_macLIFSPeriod);
+    Time sifsTime = GetSymbolsTime(m_macSIFSPeriod);
 
     if (ifsTime == lifsTime)
     {
@@ -2567,6 +5618,18 @@ LrWpanMac::PrepareRetransmission()
                 break;
             }
             case CommandPayloadHeader::DATA_REQ: {
+                if (m_pollPending)
+                {
+                    // A poll failure does not affect the association.
+                    m_pollPending = false;
+                    if (!m_mlmePollConfirmCallback.IsNull())
+                    {
+                        MlmePollConfirmParams pollConfirmParams;
+                        pollConfirmParams.m_status = MLMEPOLL_NO_ACK;
+                        m_mlmePollConfirmCallback(pollConfirmParams);
+                    }
+                    break;
+                }
                 // IEEE 802.15.4-2006 (Section 7.1.16.1.3)
                 m_macPanId = 0xffff;
                 m_macCoordShortAddress = Mac16Address("FF:FF");
@@ -2585,6 +5648,18 @@ LrWpanMac::PrepareRetransmission()
                 }
                 break;
             }
+            case CommandPayloadHeader::GTS_REQ: {
+                m_gtsRequestPending = false;
+                if (!m_mlmeGtsConfirmCallback.IsNull())
+                {
+                    MlmeGtsConfirmParams gtsConfirmParams;
+                    gtsConfirmParams.m_gtsCharacteristics =
+                        GetGtsCharacteristics(cmdPayload.GetGtsCharacteristics());
+                    gtsConfirmParams.m_status = MLMEGTS_NO_ACK;
+                    m_mlmeGtsConfirmCallback(gtsConfirmParams);
+                }
+                break;
+            }
             default: {
                 // TODO: Specify other indications according to other commands
                 break;
@@ -2595,12 +5670,12 @@ LrWpanMac::PrepareRetransmission()
         {
             // Maximum number of retransmissions has been reached.
             // remove the copy of the DATA packet that was just sent
-            Ptr<TxQueueElement> txQElement = m_txQueue.front();
-            m_macTxDropTrace(txQElement->txQPkt);
+            TxQueueElement& txQElement = GetCurrentTxQueue().Front();
+            m_macTxDropTrace(txQElement.txQPkt);
             if (!m_mcpsDataConfirmCallback.IsNull())
             {
                 McpsDataConfirmParams confirmParams;
-                confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+                confirmParams.m_msduHandle = txQElement.txQMsduHandle;
                 confirmParams.m_status = IEEE_802_15_4_NO_ACK;
                 m_mcpsDataConfirmCallback(confirmParams);
             }
@@ -2619,9 +5694,9 @@ LrWpanMac::PrepareRetransmission()
 }
 
 void
-LrWpanMac::EnqueueInd(Ptr<Packet> p)
+LrWpanMac::EnqueueInd(Ptr<Packet> p, uint8_t msduHandle)
 {
-    Ptr<IndTxQueueElement> indTxQElement = Create<IndTxQueueElement>();
+    IndTxQueueElement indTxQElement;
     LrWpanMacHeader peekedMacHdr;
     p->PeekHeader(peekedMacHdr);
 
@@ -2632,14 +5707,16 @@ LrWpanMac::EnqueueInd(Ptr<Packet> p)
 
     if (peekedMacHdr.GetDstAddrMode() == SHORT_ADDR)
     {
-        indTxQElement->dstShortAddress = peekedMacHdr.GetShortDstAddr();
+        indTxQElement.dstShortAddress = peekedMacHdr.GetShortDstAddr();
     }
     else
     {
-        indTxQElement->dstExtAddress = peekedMacHdr.GetExtDstAddr();
+        indTxQElement.dstAddrMode = EXT_ADDR;
+        indTxQElement.dstExtAddress = peekedMacHdr.GetExtDstAddr();
     }
 
-    indTxQElement->seqNum = peekedMacHdr.GetSeqNum();
+    indTxQElement.seqNum = peekedMacHdr.GetSeqNum();
+    indTxQElement.txQMsduHandle = msduHandle;
 
     // See IEEE 802.15.4-2006, Table 86
     uint32_t unit = 0; // The persistence time in symbols
@@ -2657,20 +5734,28 @@ LrWpanMac::EnqueueInd(Ptr<Packet> p)
 
     if (m_indTxQueue.size() < m_maxIndTxQueueSize)
     {
-        double symbolRate = m_phy->GetDataOrSymbolRate(false);
-        Time expireTime = Seconds(unit / symbolRate);
+        Time expireTime = GetSymbolsTime(unit);
         expireTime += Simulator::Now();
-        indTxQElement->expireTime = expireTime;
-        indTxQElement->txQPkt = p;
-        m_indTxQueue.emplace_back(indTxQElement);
+        indTxQElement.expireTime = expireTime;
+        indTxQElement.txQPkt = p;
+
+        uint64_t id = m_indTxQueueNextId++;
+        if (indTxQElement.dstAddrMode == SHORT_ADDR)
+        {
+            m_indTxQueueShortIndex[GetIndTxQueueKey(indTxQElement.dstShortAddress)].push_back(id);
+        }
+        else
+        {
+            m_indTxQueueExtIndex[GetIndTxQueueKey(indTxQElement.dstExtAddress)].push_back(id);
+        }
+        m_indTxQueueExpiry.emplace(expireTime, id);
+        m_indTxQueue.emplace(id, std::move(indTxQElement));
         m_macIndTxEnqueueTrace(p);
     }
     else
     {
         if (!m_mlmeCommStatusIndicationCallback.IsNull())
         {
-            LrWpanMacHeader peekedMacHdr;
-            indTxQElement->txQPkt->PeekHeader(peekedMacHdr);
             MlmeCommStatusIndicationParams commStatusParams;
             commStatusParams.m_panId = m_macPanId;
             commStatusParams.m_srcAddrMode = LrWpanMacHeader::EXTADDR;
@@ -2685,68 +5770,118 @@ LrWpanMac::EnqueueInd(Ptr<Packet> p)
 }
 
 bool
-LrWpanMac::DequeueInd(Mac64Address dst, Ptr<IndTxQueueElement> entry)
+LrWpanMac::DequeueInd(Mac64Address dst, IndTxQueueElement& entry)
 {
     PurgeInd();
 
-    for (auto iter = m_indTxQueue.begin(); iter != m_indTxQueue.end(); iter++)
+    auto it = m_indTxQueueExtIndex.find(GetIndTxQueueKey(dst));
+    if (it == m_indTxQueueExtIndex.end())
     {
-        if ((*iter)->dstExtAddress == dst)
-        {
-            *entry = **iter;
-            m_macIndTxDequeueTrace((*iter)->txQPkt->Copy());
-            m_indTxQueue.erase(iter);
-            return true;
-        }
+        return false;
     }
-    return false;
+    uint64_t id = it->second.front();
+    entry = m_indTxQueue.at(id);
+    EraseIndTxQElement(id);
+    m_macIndTxDequeueTrace(entry.txQPkt->Copy());
+    return true;
+}
+
+bool
+LrWpanMac::DequeueInd(Mac16Address dst, IndTxQueueElement& entry)
+{
+    PurgeInd();
+
+    auto it = m_indTxQueueShortIndex.find(GetIndTxQueueKey(dst));
+    if (it == m_indTxQueueShortIndex.end())
+    {
+        return false;
+    }
+    uint64_t id = it->second.front();
+    entry = m_indTxQueue.at(id);
+    EraseIndTxQElement(id);
+    m_macIndTxDequeueTrace(entry.txQPkt->Copy());
+    return true;
 }
 
 void
 LrWpanMac::PurgeInd()
 {
-    for (uint32_t i = 0; i < m_indTxQueue.size();)
+    while (!m_indTxQueueExpiry.empty() && Simulator::Now() > m_indTxQueueExpiry.top().first)
     {
-        if (Simulator::Now() > m_indTxQueue[i]->expireTime)
+        uint64_t id = m_indTxQueueExpiry.top().second;
+        m_indTxQueueExpiry.pop();
+
+        auto it = m_indTxQueue.find(id);
+        if (it == m_indTxQueue.end())
         {
-            // Transaction expired, remove and send proper confirmation/indication to a higher layer
-            LrWpanMacHeader peekedMacHdr;
-            m_indTxQueue[i]->txQPkt->PeekHeader(peekedMacHdr);
+            // Already dequeued
+            continue;
+        }
 
-            if (peekedMacHdr.IsCommand())
+        // Transaction expired, remove and send proper confirmation/indication to a higher layer
+        Ptr<Packet> p = it->second.txQPkt;
+        uint8_t msduHandle = it->second.txQMsduHandle;
+        EraseIndTxQElement(id);
+
+        LrWpanMacHeader peekedMacHdr;
+        p->PeekHeader(peekedMacHdr);
+
+        if (peekedMacHdr.IsCommand())
+        {
+            // IEEE 802.15.4-2006 (Section 7.1.3.3.3)
+            if (!m_mlmeCommStatusIndicationCallback.IsNull())
             {
-                // IEEE 802.15.4-2006 (Section 7.1.3.3.3)
-                if (!m_mlmeCommStatusIndicationCallback.IsNull())
-                {
-                    MlmeCommStatusIndicationParams commStatusParams;
-                    commStatusParams.m_panId = m_macPanId;
-                    commStatusParams.m_srcAddrMode = LrWpanMacHeader::EXTADDR;
-                    commStatusParams.m_srcExtAddr = peekedMacHdr.GetExtSrcAddr();
-                    commStatusParams.m_dstAddrMode = LrWpanMacHeader::EXTADDR;
-                    commStatusParams.m_dstExtAddr = peekedMacHdr.GetExtDstAddr();
-                    commStatusParams.m_status =
-                        LrWpanMlmeCommStatus::MLMECOMMSTATUS_TRANSACTION_EXPIRED;
-                    m_mlmeCommStatusIndicationCallback(commStatusParams);
-                }
+                MlmeCommStatusIndicationParams commStatusParams;
+                commStatusParams.m_panId = m_macPanId;
+                commStatusParams.m_srcAddrMode = LrWpanMacHeader::EXTADDR;
+                commStatusParams.m_srcExtAddr = peekedMacHdr.GetExtSrcAddr();
+                commStatusParams.m_dstAddrMode = LrWpanMacHeader::EXTADDR;
+                commStatusParams.m_dstExtAddr = peekedMacHdr.GetExtDstAddr();
+                commStatusParams.m_status =
+                    LrWpanMlmeCommStatus::MLMECOMMSTATUS_TRANSACTION_EXPIRED;
+                m_mlmeCommStatusIndicationCallback(commStatusParams);
             }
-            else if (peekedMacHdr.IsData())
+        }
+        else if (peekedMacHdr.IsData())
+        {
+            // IEEE 802.15.4-2006 (Section 7.1.1.1.3)
+            if (!m_mcpsDataConfirmCallback.IsNull())
             {
-                // IEEE 802.15.4-2006 (Section 7.1.1.1.3)
-                if (!m_mcpsDataConfirmCallback.IsNull())
-                {
-                    McpsDataConfirmParams confParams;
-                    confParams.m_status = IEEE_802_15_4_TRANSACTION_EXPIRED;
-                    m_mcpsDataConfirmCallback(confParams);
-                }
+                McpsDataConfirmParams confParams;
+                confParams.m_msduHandle = msduHandle;
+                confParams.m_status = IEEE_802_15_4_TRANSACTION_EXPIRED;
+                m_mcpsDataConfirmCallback(confParams);
             }
-            m_macIndTxDropTrace(m_indTxQueue[i]->txQPkt->Copy());
-            m_indTxQueue.erase(m_indTxQueue.begin() + i);
         }
-        else
+        m_macIndTxDropTrace(p->Copy());
+    }
+}
+
+void
+LrWpanMac::EraseIndTxQElement(uint64_t id)
+{
+    auto it = m_indTxQueue.find(id);
+    NS_ASSERT_MSG(it != m_indTxQueue.end(), "Unknown pending transaction");
+
+    if (it->second.dstAddrMode == EXT_ADDR)
+    {
+        auto index = m_indTxQueueExtIndex.find(GetIndTxQueueKey(it->second.dstExtAddress));
+        index->second.erase(std::find(index->second.begin(), index->second.end(), id));
+        if (index->second.empty())
         {
-            i++;
+            m_indTxQueueExtIndex.erase(index);
+        }
+    }
+    else
+    {
+        auto index = m_indTxQueueShortIndex.find(GetIndTxQueueKey(it->second.dstShortAddress));
+        index->second.erase(std::find(index->second.begin(), index->second.end(), id));
+        if (index->second.empty())
+        {
+            m_indTxQueueShortIndex.erase(index);
         }
     }
+    m_indTxQueue.erase(it);
 }
 
 void
@@ -2758,11 +5893,21 @@ LrWpanMac::PrintPendTxQ(std::ostream& os) const
        << "] | CurrentTime: " << Simulator::Now().As(Time::S) << "\n"
        << "       Destination        | Sequence Number |   Frame type    | Expire time\n";
 
-    for (uint32_t i = 0; i < m_indTxQueue.size(); i++)
+    // Print the transactions in the order they were added
+    std::vector<uint64_t> ids;
+    ids.reserve(m_indTxQueue.size());
+    for (const auto& element : m_indTxQueue)
+    {
+        ids.push_back(element.first);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    for (uint64_t id : ids)
     {
-        m_indTxQueue[i]->txQPkt->PeekHeader(peekedMacHdr);
-        os << m_indTxQueue[i]->dstExtAddress << "           "
-           << static_cast<uint32_t>(m_indTxQueue[i]->seqNum) << "          ";
+        const IndTxQueueElement& indTxQElement = m_indTxQueue.at(id);
+        indTxQElement.txQPkt->PeekHeader(peekedMacHdr);
+        os << indTxQElement.dstExtAddress << "           "
+           << static_cast<uint32_t>(indTxQElement.seqNum) << "          ";
 
         if (peekedMacHdr.IsCommand())
         {
@@ -2777,7 +5922,7 @@ LrWpanMac::PrintPendTxQ(std::ostream& os) const
             os << "Unk Frame    ";
         }
 
-        os << m_indTxQueue[i]->expireTime.As(Time::S) << "\n";
+        os << indTxQElement.expireTime.As(Time::S) << "\n";
     }
 }
 
@@ -2790,9 +5935,9 @@ LrWpanMac::PrintTxQueue(std::ostream& os) const
        << "] | CurrentTime: " << Simulator::Now().As(Time::S) << "\n"
        << "       Destination                 | Sequence Number |  Dst PAN id | Frame type    |\n";
 
-    for (uint32_t i = 0; i < m_indTxQueue.size(); i++)
+    for (uint32_t i = 0; i < m_txQueue.GetSize(); i++)
     {
-        m_txQueue[i]->txQPkt->PeekHeader(peekedMacHdr);
+        m_txQueue[i].txQPkt->PeekHeader(peekedMacHdr);
 
         os << "[" << peekedMacHdr.GetShortDstAddr() << "]"
            << ", [" << peekedMacHdr.GetExtDstAddr() << "]        "
@@ -2823,25 +5968,32 @@ LrWpanMac::RemovePendTxQElement(Ptr<Packet> p)
     LrWpanMacHeader peekedMacHdr;
     p->PeekHeader(peekedMacHdr);
 
-    for (auto it = m_indTxQueue.begin(); it != m_indTxQueue.end(); it++)
+    const std::deque<uint64_t>* ids = nullptr;
+    if (peekedMacHdr.GetDstAddrMode() == EXT_ADDR)
     {
-        if (peekedMacHdr.GetDstAddrMode() == EXT_ADDR)
+        auto it = m_indTxQueueExtIndex.find(GetIndTxQueueKey(peekedMacHdr.GetExtDstAddr()));
+        if (it != m_indTxQueueExtIndex.end())
         {
-            if (((*it)->dstExtAddress == peekedMacHdr.GetExtDstAddr()) &&
-                ((*it)->seqNum == peekedMacHdr.GetSeqNum()))
-            {
-                m_macIndTxDequeueTrace(p);
-                m_indTxQueue.erase(it);
-                break;
-            }
+            ids = &it->second;
+        }
+    }
+    else if (peekedMacHdr.GetDstAddrMode() == SHORT_ADDR)
+    {
+        auto it = m_indTxQueueShortIndex.find(GetIndTxQueueKey(peekedMacHdr.GetShortDstAddr()));
+        if (it != m_indTxQueueShortIndex.end())
+        {
+            ids = &it->second;
         }
-        else if (peekedMacHdr.GetDstAddrMode() == SHORT_ADDR)
+    }
+
+    if (ids)
+    {
+        for (uint64_t id : *ids)
         {
-            if (((*it)->dstShortAddress == peekedMacHdr.GetShortDstAddr()) &&
-                ((*it)->seqNum == peekedMacHdr.GetSeqNum()))
+            if (m_indTxQueue.at(id).seqNum == peekedMacHdr.GetSeqNum())
             {
                 m_macIndTxDequeueTrace(p);
-                m_indTxQueue.erase(it);
+                EraseIndTxQElement(id);
                 break;
             }
         }
@@ -2854,13 +6006,16 @@ void
 LrWpanMac::PdDataConfirm(LrWpanPhyEnumeration status)
 {
     NS_ASSERT(m_lrWpanMacState == MAC_SENDING);
-    NS_LOG_FUNCTION(this << status << m_txQueue.size());
+    NS_LOG_FUNCTION(this << status << m_txQueue.GetSize());
+
+    if (m_llTimeslotTx || IsLLFrame(m_txPkt))
+    {
+        LLDataConfirm(status);
+        return;
+    }
 
     LrWpanMacHeader macHdr;
     Time ifsWaitTime;
-    double symbolRate;
-
-    symbolRate = m_phy->GetDataOrSymbolRate(false); // symbols per second
 
     m_txPkt->PeekHeader(macHdr);
 
@@ -2881,8 +6036,7 @@ LrWpanMac::PdDataConfirm(LrWpanPhyEnumeration status)
                                              (m_txPkt->GetSize() * m_phy->GetPhySymbolsPerOctet());
 
                     // The beacon Tx time and start of the Outgoing superframe Active Period
-                    m_macBeaconTxTime =
-                        Simulator::Now() - Seconds(static_cast<double>(beaconSymbols) / symbolRate);
+                    m_macBeaconTxTime = Simulator::Now() - GetSymbolsTime(beaconSymbols);
 
                     m_capEvent = Simulator::ScheduleNow(&LrWpanMac::StartCAP,
                                                         this,
@@ -2898,7 +6052,7 @@ LrWpanMac::PdDataConfirm(LrWpanPhyEnumeration status)
                     }
                 }
 
-                ifsWaitTime = Seconds(static_cast<double>(GetIfsSize()) / symbolRate);
+                ifsWaitTime = GetSymbolsTime(GetIfsSize());
                 m_txPkt = nullptr;
             }
             else if (macHdr.IsAckReq()) // We have sent a regular data packet, check if we have to
@@ -2907,7 +6061,7 @@ LrWpanMac::PdDataConfirm(LrWpanPhyEnumeration status)
                 // we sent a regular data frame or command frame (e.g. AssocReq command) that
                 // require ACK wait for the ack or the next retransmission timeout start
                 // retransmission timer
-                Time waitTime = Seconds(static_cast<double>(GetMacAckWaitDuration()) / symbolRate);
+                Time waitTime = GetSymbolsTime(GetMacAckWaitDuration());
                 NS_ASSERT(m_ackWaitTimeout.IsExpired());
                 m_ackWaitTimeout = Simulator::Schedule(waitTime, &LrWpanMac::AckWaitTimeout, this);
                 m_setMacState.Cancel();
@@ -2928,13 +6082,13 @@ LrWpanMac::PdDataConfirm(LrWpanPhyEnumeration status)
                 if (!m_mcpsDataConfirmCallback.IsNull())
                 {
                     McpsDataConfirmParams confirmParams;
-                    NS_ASSERT_MSG(m_txQueue.size() > 0, "TxQsize = 0");
-                    Ptr<TxQueueElement> txQElement = m_txQueue.front();
-                    confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+                    NS_ASSERT_MSG(GetCurrentTxQueue().GetSize() > 0, "TxQsize = 0");
+                    TxQueueElement& txQElement = GetCurrentTxQueue().Front();
+                    confirmParams.m_msduHandle = txQElement.txQMsduHandle;
                     confirmParams.m_status = IEEE_802_15_4_SUCCESS;
                     m_mcpsDataConfirmCallback(confirmParams);
                 }
-                ifsWaitTime = Seconds(static_cast<double>(GetIfsSize()) / symbolRate);
+                ifsWaitTime = GetSymbolsTime(GetIfsSize());
                 RemoveFirstTxQElement();
             }
         }
@@ -3021,7 +6175,15 @@ LrWpanMac::PdDataConfirm(LrWpanPhyEnumeration status)
                     // We enqueue the the Assoc Response command frame in the Tx queue
                     // and the packet is transmitted as soon as the PHY is free and the IFS have
                     // taken place.
-                    SendAssocResponseCommand(m_rxPkt->Copy());
+                    SendPendingTransaction(m_rxPkt->Copy());
+                }
+                else if (receivedMacPayload.GetCommandFrameType() ==
+                             CommandPayloadHeader::GTS_REQ &&
+                         receivedMacHdr.GetSrcAddrMode() == SHORT_ADDR)
+                {
+                    ProcessGtsRequest(
+                        receivedMacHdr.GetShortSrcAddr(),
+                        GetGtsCharacteristics(receivedMacPayload.GetGtsCharacteristics()));
                 }
             }
 
@@ -3033,13 +6195,13 @@ LrWpanMac::PdDataConfirm(LrWpanPhyEnumeration status)
     {
         if (!macHdr.IsAcknowledgment())
         {
-            NS_ASSERT_MSG(m_txQueue.size() > 0, "TxQsize = 0");
-            Ptr<TxQueueElement> txQElement = m_txQueue.front();
-            m_macTxDropTrace(txQElement->txQPkt);
+            NS_ASSERT_MSG(GetCurrentTxQueue().GetSize() > 0, "TxQsize = 0");
+            TxQueueElement& txQElement = GetCurrentTxQueue().Front();
+            m_macTxDropTrace(txQElement.txQPkt);
             if (!m_mcpsDataConfirmCallback.IsNull())
             {
                 McpsDataConfirmParams confirmParams;
-                confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+                confirmParams.m_msduHandle = txQElement.txQMsduHandle;
                 confirmParams.m_status = IEEE_802_15_4_FRAME_TOO_LONG;
                 m_mcpsDataConfirmCallback(confirmParams);
             }
@@ -3085,8 +6247,7 @@ LrWpanMac::PlmeEdConfirm(LrWpanPhyEnumeration status, uint8_t energyLevel)
         m_maxEnergyLevel = energyLevel;
     }
 
-    if (Simulator::GetDelayLeft(m_scanEnergyEvent) >
-        Seconds(8.0 / m_phy->GetDataOrSymbolRate(false)))
+    if (Simulator::GetDelayLeft(m_scanEnergyEvent) > GetSymbolsTime(8))
     {
         m_phy->PlmeEdRequest();
     }
@@ -3155,6 +6316,12 @@ void
 LrWpanMac::PlmeSetAttributeConfirm(LrWpanPhyEnumeration status, LrWpanPibAttributeIdentifier id)
 {
     NS_LOG_FUNCTION(this << status << id);
+    if (id == LrWpanPibAttributeIdentifier::phyCurrentPage)
+    {
+        // The page selects the PHY option, and so the symbol duration.
+        UpdateSymbolDuration();
+    }
+
     if (id == LrWpanPibAttributeIdentifier::phyCurrentPage && m_pendPrimitive == MLME_SCAN_REQ)
     {
         if (status == LrWpanPhyEnumeration::IEEE_802_15_4_PHY_SUCCESS)
@@ -3197,10 +6364,9 @@ LrWpanMac::PlmeSetAttributeConfirm(LrWpanPhyEnumeration status, LrWpanPibAttribu
     {
         if (status == LrWpanPhyEnumeration::IEEE_802_15_4_PHY_SUCCESS)
         {
-            uint64_t symbolRate = static_cast<uint64_t>(m_phy->GetDataOrSymbolRate(false));
             uint64_t scanDuration = aBaseSuperframeDuration *
                                     ((static_cast<uint32_t>(1 << m_scanParams.m_scanDuration)) + 1);
-            Time nextScanTime = Seconds(static_cast<double>(scanDuration / symbolRate));
+            Time nextScanTime = GetSymbolsTime(scanDuration);
 
             switch (m_scanParams.m_scanType)
             {
@@ -3408,7 +6574,11 @@ LrWpanMac::SetLrWpanMacState(LrWpanMacState macState)
     if (macState == MAC_IDLE)
     {
         ChangeMacState(MAC_IDLE);
-        if (m_macRxOnWhenIdle)
+        if (IsLLSleepAllowed())
+        {
+            LLSleep();
+        }
+        else if (m_macRxOnWhenIdle || m_pollWaitTimeout.IsRunning() || m_gtsRxOn)
         {
             m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
         }
@@ -3425,6 +6595,13 @@ LrWpanMac::SetLrWpanMacState(LrWpanMacState macState)
     else if (macState == MAC_CSMA)
     {
         NS_ASSERT(m_lrWpanMacState == MAC_IDLE || m_lrWpanMacState == MAC_ACK_PENDING);
+        if (m_gtsTx)
+        {
+            // Retransmissions in a GTS do not use CSMA-CA.
+            ChangeMacState(MAC_IDLE);
+            GtsTransmit();
+            return;
+        }
         ChangeMacState(MAC_CSMA);
         m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
     }
@@ -3491,6 +6668,18 @@ LrWpanMac::SetLrWpanMacState(LrWpanMacState macState)
                 break;
             }
             case CommandPayloadHeader::DATA_REQ: {
+                if (m_pollPending)
+                {
+                    // A poll failure does not affect the association.
+                    m_pollPending = false;
+                    if (!m_mlmePollConfirmCallback.IsNull())
+                    {
+                        MlmePollConfirmParams pollConfirmParams;
+                        pollConfirmParams.m_status = MLMEPOLL_CHANNEL_ACCESS_FAILURE;
+                        m_mlmePollConfirmCallback(pollConfirmParams);
+                    }
+                    break;
+                }
                 m_macPanId = 0xffff;
                 m_macCoordShortAddress = Mac16Address("FF:FF");
                 m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
@@ -3509,6 +6698,18 @@ LrWpanMac::SetLrWpanMacState(LrWpanMacState macState)
                 }
                 break;
             }
+            case CommandPayloadHeader::GTS_REQ: {
+                m_gtsRequestPending = false;
+                if (!m_mlmeGtsConfirmCallback.IsNull())
+                {
+                    MlmeGtsConfirmParams gtsConfirmParams;
+                    gtsConfirmParams.m_gtsCharacteristics =
+                        GetGtsCharacteristics(cmdPayload.GetGtsCharacteristics());
+                    gtsConfirmParams.m_status = MLMEGTS_CHANNEL_ACCESS_FAILURE;
+                    m_mlmeGtsConfirmCallback(gtsConfirmParams);
+                }
+                break;
+            }
             default: {
                 // TODO: Other commands(e.g. Orphan Request)
                 break;
@@ -3521,7 +6722,7 @@ LrWpanMac::SetLrWpanMacState(LrWpanMacState macState)
             if (!m_mcpsDataConfirmCallback.IsNull())
             {
                 McpsDataConfirmParams confirmParams;
-                confirmParams.m_msduHandle = m_txQueue.front()->txQMsduHandle;
+                confirmParams.m_msduHandle = m_txQueue.Front().txQMsduHandle;
                 confirmParams.m_status = IEEE_802_15_4_CHANNEL_ACCESS_FAILURE;
                 m_mcpsDataConfirmCallback(confirmParams);
             }
@@ -3574,7 +6775,31 @@ LrWpanMac::SetAssociationStatus(LrWpanAssociationStatus status)
 void
 LrWpanMac::SetTxQMaxSize(uint32_t queueSize)
 {
-    m_maxTxQueueSize = queueSize;
+    uint32_t maxSize = (queueSize == 0) ? std::numeric_limits<uint32_t>::max() : queueSize;
+    m_txQueue.SetMaxSize(maxSize);
+    for (auto& gtsTxQueue : m_gtsTxQueues)
+    {
+        gtsTxQueue.second.SetMaxSize(maxSize);
+    }
+}
+
+uint32_t
+LrWpanMac::GetTxQMaxSize() const
+{
+    uint32_t maxSize = m_txQueue.GetMaxSize();
+    return (maxSize == std::numeric_limits<uint32_t>::max()) ? 0 : maxSize;
+}
+
+void
+LrWpanMac::SetTxQDropPolicy(LrWpanTxQueueDropPolicy policy)
+{
+    m_txQueueDropPolicy = policy;
+}
+
+void
+LrWpanMac::SetTxQStaleTime(Time staleTime)
+{
+    m_txQueueStaleTime = staleTime;
 }
 
 void
@@ -3583,6 +6808,12 @@ LrWpanMac::SetIndTxQMaxSize(uint32_t queueSize)
     m_maxIndTxQueueSize = queueSize;
 }
 
+void
+LrWpanMac::SetGtsPermit(bool permit)
+{
+    m_macGtsPermit = permit;
+}
+
 uint16_t
 LrWpanMac::GetPanId() const
 {
@@ -3665,6 +6896,103 @@ LrWpanMac::SetMacLLDNnumReTransmitTS(uint8_t numRetransmitTS)
     m_macLLDNnumRetransmitTS = numRetransmitTS;
 }
 
+void
+LrWpanMac::SetMacLLDNnumSharedGroupTS(uint8_t numSharedGroupTS)
+{
+    m_macLLDNnumSharedGroupTS = numSharedGroupTS;
+}
+
+void
+LrWpanMac::SetMacLLDNassignedTimeSlot(uint8_t timeSlot)
+{
+    m_macLLDNassignedTimeSlot = timeSlot;
+}
+
+void
+LrWpanMac::SetMacLLDNlowLatencyNWid(uint8_t lowLatencyNWid)
+{
+    m_macLLDNlowLatencyNWid = lowLatencyNWid;
+}
+
+void
+LrWpanMac::SetLLDNTrafficRequirements(uint8_t payloadSize, Time period)
+{
+    NS_ASSERT_MSG(aLLMacOverhead + payloadSize <= LrWpanPhy::aMaxPhyPacketSize,
+                  "LL frame payload too large");
+    m_llReqPayloadSize = payloadSize;
+    m_llReqPeriod = period;
+}
+
+void
+LrWpanMac::SetLLDNSlotPlannerEnabled(bool enabled)
+{
+    m_llSlotPlanner = enabled;
+}
+
+void
+LrWpanMac::SetLLDNSleepEnabled(bool enabled)
+{
+    NS_LOG_FUNCTION(this << enabled);
+    m_llSleepEnabled = enabled;
+
+    if (!m_llSleepEnabled)
+    {
+        m_llSleepEvent.Cancel();
+        if (m_llWakeEvent.IsRunning())
+        {
+            m_llWakeEvent.Cancel();
+            SetRxOnWhenIdle(m_macRxOnWhenIdle);
+        }
+    }
+}
+
+void
+LrWpanMac::SetLLDNGuardTime(Time guardTime)
+{
+    NS_LOG_FUNCTION(this << guardTime);
+    m_llGuardTime = guardTime;
+}
+
+Time
+LrWpanMac::GetLLDNGuardTime() const
+{
+    return m_llGuardTime;
+}
+
+void
+LrWpanMac::SetLLDNClockDrift(double ppm)
+{
+    NS_LOG_FUNCTION(this << ppm);
+    m_llClockDrift = ppm;
+}
+
+double
+LrWpanMac::GetLLDNClockDrift() const
+{
+    return m_llClockDrift;
+}
+
+void
+LrWpanMac::SetLLDNClockDriftWalk(double ppm)
+{
+    NS_LOG_FUNCTION(this << ppm);
+    m_llClockDriftWalk = ppm;
+
+    // Only created when needed, not to shift the automatic streams of the other models.
+    if (m_llClockDriftWalk > 0 && !m_llDriftRandom)
+    {
+        m_llDriftRandom = CreateObject<NormalRandomVariable>();
+        m_llDriftRandom->SetStream(m_llDriftStream);
+    }
+}
+
+void
+LrWpanMac::SetLLDNTimeslotOwner(uint8_t timeSlot, Mac8Address address)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(timeSlot) << address);
+    m_llTimeslotOwners[timeSlot] = address;
+}
+
 uint8_t 
 LrWpanMac::GetMacLLDNnumUplinkTS() const
 {
@@ -3683,6 +7011,12 @@ LrWpanMac::GetMacLLDNnumReTransmitTS() const
     return m_macLLDNnumRetransmitTS;
 }
 
+uint8_t
+LrWpanMac::GetMacLLDNnumSharedGroupTS() const
+{
+    return m_macLLDNnumSharedGroupTS;
+}
+
 uint8_t 
 LrWpanMac::GetMacLLDNnumBidirectionalTS() const
 {
@@ -3707,9 +7041,21 @@ LrWpanMac::GetMacLLDNcoordinator() const
     return m_macLLDNcoordinator;
 }
 
-void 
+uint8_t
+LrWpanMac::GetMacLLDNassignedTimeSlot() const
+{
+    return m_macLLDNassignedTimeSlot;
+}
+
+uint8_t
+LrWpanMac::GetMacLLDNlowLatencyNWid() const
+{
+    return m_macLLDNlowLatencyNWid;
+}
+
+void
 LrWpanMac::SetLLDNModeEnabled() {
-    NS_ASSERT(m_macDSMEcapable);
+    NS_ASSERT(m_macLLcapable);
 
     m_macLLenabled = true;
 }
@@ -3736,7 +7082,7 @@ LrWpanMac::GetMacMaxFrameRetries() const
 void
 LrWpanMac::PrintTransmitQueueSize()
 {
-    NS_LOG_DEBUG("Transmit Queue Size: " << m_txQueue.size());
+    NS_LOG_DEBUG("Transmit Queue Size: " << m_txQueue.GetSize());
 }
 
 void
@@ -3819,6 +7165,31 @@ LrWpanMac::GetTxPacketSymbols()
             (m_txPkt->GetSize() * m_phy->GetPhySymbolsPerOctet()));
 }
 
+void
+LrWpanMac::UpdateSymbolDuration()
+{
+    NS_LOG_FUNCTION(this);
+    // The symbol rates of all the PHY options (IEEE 802.15.4-2006 Table 1) divide
+    // one second into an integer number of nanoseconds.
+    auto symbolRate = static_cast<int64_t>(m_phy->GetDataOrSymbolRate(false));
+    NS_ASSERT_MSG(symbolRate > 0 && 1000000000 % symbolRate == 0,
+                  "The symbol duration is not an integer number of nanoseconds");
+    m_symbolDuration = NanoSeconds(1000000000 / symbolRate);
+}
+
+Time
+LrWpanMac::GetSymbolsTime(uint64_t symbols) const
+{
+    return m_symbolDuration * static_cast<int64_t>(symbols);
+}
+
+uint64_t
+LrWpanMac::GetTimeSymbols(Time duration) const
+{
+    NS_ASSERT(!duration.IsStrictlyNegative());
+    return static_cast<uint64_t>(Div(duration, m_symbolDuration));
+}
+
 bool
 LrWpanMac::isTxAckReq()
 {
@@ -27,7 +27,10 @@
 
 #include <ns3/event-id.h>
 #include <ns3/lr-wpan-fields.h>
+#include <ns3/lr-wpan-mac-pl-headers.h>
 #include <ns3/lr-wpan-phy.h>
+#include <ns3/lr-wpan-ring-buffer.h>
+#include <ns3/mac8-address.h>
 #include <ns3/mac16-address.h>
 #include <ns3/mac64-address.h>
 #include <ns3/object.h>
@@ -36,13 +39,22 @@
 #include <ns3/traced-value.h>
 
 #include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
 
 class Packet;
 class LrWpanCsmaCa;
+class LrWpanMacHeader;
+class UniformRandomVariable;
+class NormalRandomVariable;
 
 /**
  * \defgroup lr-wpan LR-WPAN models
@@ -108,6 +120,23 @@ typedef enum
     INCOMING = 1  //!< Incoming Superframe
 } SuperframeType;
 
+/**
+ * \ingroup lr-wpan
+ *
+ * LLDN superframe timeslot types. See IEEE 802.15.4e-2012, Section 5.1.1.6
+ */
+typedef enum
+{
+    LLDN_TS_BEACON = 0,        //!< Beacon timeslot
+    LLDN_TS_MGMT_DOWNLINK = 1, //!< Downlink management timeslot
+    LLDN_TS_MGMT_UPLINK = 2,   //!< Uplink management timeslot
+    LLDN_TS_RETRANSMIT = 3,    //!< Uplink timeslot reserved for retransmissions
+    LLDN_TS_UPLINK = 4,        //!< Uplink timeslot
+    LLDN_TS_BIDIRECTIONAL = 5, //!< Bidirectional timeslot
+    LLDN_TS_UNUSED = 6,        //!< Timeslot not used for any transmission
+    LLDN_TS_SHARED = 7         //!< Uplink shared group timeslot, contended by several devices
+} LLDNTimeslotType;
+
 /**
  * \ingroup lr-wpan
  *
@@ -122,6 +151,19 @@ typedef enum
     MLME_SYNC_REQ = 4   //!< Pending MLME-SYNC.request primitive
 } PendingPrimitiveStatus;
 
+/**
+ * \ingroup lr-wpan
+ *
+ * The element dropped when a MSDU is enqueued in a full transmit queue.
+ */
+typedef enum
+{
+    TX_QUEUE_TAIL_DROP = 0,  //!< Drop the new MSDU
+    TX_QUEUE_HEAD_DROP = 1,  //!< Drop the oldest MSDU not being sent
+    TX_QUEUE_STALE_FIRST = 2 //!< Drop the oldest MSDU queued for longer than the stale
+                             //!< time (not being sent), the new MSDU if there is none
+} LrWpanTxQueueDropPolicy;
+
 typedef enum {
         EBAutoSA_NONE = 0,
         EBAutoSA_SHORT = 1,
@@ -332,10 +374,32 @@ typedef enum
     MLMEPOLL_INVALID_PARAMETER = 9
 } LrWpanMlmePollConfirmStatus;
 
+/**
+ * \ingroup lr-wpan
+ *
+ * MLME-GTS.confirm status, see IEEE 802.15.4-2011 Section 6.2.6.2
+ */
+typedef enum
+{
+    MLMEGTS_SUCCESS = 0,
+    MLMEGTS_DENIED = 1,
+    MLMEGTS_NO_SHORT_ADDRESS = 2,
+    MLMEGTS_CHANNEL_ACCESS_FAILURE = 3,
+    MLMEGTS_NO_ACK = 4,
+    MLMEGTS_NO_DATA = 5,
+    MLMEGTS_INVALID_PARAMETER = 6
+} LrWpanMlmeGtsConfirmStatus;
+
 //!< LLDN primitives parameters
 struct LrWpanMlmeLLNetworkConfiguration
 {
-    // TODO add NetworkConfigurations
+    uint8_t m_timeslotSize{0};       //!< Payload size of the base timeslots in octets
+    uint8_t m_numTimeSlots{0};       //!< Number of base timeslots in the Online superframe
+    uint8_t m_numUplinkTS{0};        //!< Number of uplink timeslots (retransmission included)
+    uint8_t m_numBidirectionalTS{0}; //!< Number of bidirectional timeslots
+    uint8_t m_numRetransmitTS{0};    //!< Number of retransmission timeslots
+    Time m_superframeDuration;       //!< Duration of the Online superframe
+    bool m_periodsMet{true};         //!< The superframe meets the periods requested by the devices
 };
 
 /**
@@ -419,6 +483,7 @@ struct McpsDataRequestParams
     uint16_t m_dstPanId{0};                      //!< Destination PAN identifier
     Mac16Address m_dstAddr;                      //!< Destination address
     Mac64Address m_dstExtAddr;                   //!< Destination extended address
+    Mac8Address m_dstSimpleAddr;                 //!< Destination simple address (LLDN mode)
     uint8_t m_msduHandle{0};                     //!< MSDU handle
     uint8_t m_txOptions{0};                      //!< Tx Options (bitfield)
 };
@@ -575,6 +640,55 @@ struct MlmePollRequestParams
     Mac64Address m_coorExtAddr;   //!< Coordinator extended address.
 };
 
+// 6.2.6 Primitives for requesting and managing guaranteed time slots
+
+/**
+ * \ingroup lr-wpan
+ *
+ * The characteristics of a guaranteed time slot (GTS). See IEEE 802.15.4-2011 Section 5.3.9.2
+ */
+struct GtsCharacteristics
+{
+    uint8_t m_gtsLength{1};     //!< The number of superframe slots of the GTS (1 to 15).
+    bool m_gtsDirection{false}; //!< False for a transmit-only GTS (device to coordinator),
+                                //!< true for a receive-only GTS (coordinator to device).
+    bool m_allocation{true};    //!< True for a GTS allocation, false for a GTS deallocation.
+};
+
+/**
+ * \ingroup lr-wpan
+ *
+ * MLME-GTS.request params. See 802.15.4-2011 Section 6.2.6.1
+ */
+struct MlmeGtsRequestParams
+{
+    GtsCharacteristics m_gtsCharacteristics; //!< The characteristics of the requested GTS.
+};
+
+/**
+ * \ingroup lr-wpan
+ *
+ * MLME-GTS.confirm params. See 802.15.4-2011 Section 6.2.6.2
+ */
+struct MlmeGtsConfirmParams
+{
+    GtsCharacteristics m_gtsCharacteristics; //!< The characteristics of the requested GTS.
+    LrWpanMlmeGtsConfirmStatus m_status{
+        MLMEGTS_INVALID_PARAMETER}; //!< The status resulting from a MLME-GTS.request.
+};
+
+/**
+ * \ingroup lr-wpan
+ *
+ * MLME-GTS.indication params. See 802.15.4-2011 Section 6.2.6.3
+ */
+struct MlmeGtsIndicationParams
+{
+    Mac16Address m_devAddress; //!< The short address of the device which has been allocated
+                               //!< or deallocated a GTS.
+    GtsCharacteristics m_gtsCharacteristics; //!< The characteristics of the GTS.
+};
+
 /**
  * \ingroup lr-wpan
  *
@@ -816,8 +930,8 @@ struct MlmeLLDNOnlineRequestParams
  */
 struct MlmeLLDNOnlineIndicationParams
 {
-    LrWpanMlmeLLDNOnlineIndicationStatus m_status;
-    LrWpanMlmeLLDNAdditionalInfo m_additionalIndo;
+    LrWpanMlmeLLDNOnlineIndicationStatus m_status{MLME_LLDN_ONLINE_NONE}; //!< The indication status
+    LrWpanMlmeLLDNAdditionalInfo m_additionalIndo{}; //!< Additional supporting information
 };
 
 /**
@@ -881,6 +995,22 @@ typedef Callback<void, MlmeSyncLossIndicationParams> MlmeSyncLossIndicationCallb
  */
 typedef Callback<void, MlmePollConfirmParams> MlmePollConfirmCallback;
 
+/**
+ * \ingroup lr-wpan
+ *
+ * This callback is called after a MLME-GTS.request has been called from
+ * the higher layer. It returns the status of the GTS allocation or deallocation.
+ */
+typedef Callback<void, MlmeGtsConfirmParams> MlmeGtsConfirmCallback;
+
+/**
+ * \ingroup lr-wpan
+ *
+ * This callback is called by the MLME of a coordinator when a GTS has been
+ * allocated or deallocated following the GTS request command of a device.
+ */
+typedef Callback<void, MlmeGtsIndicationParams> MlmeGtsIndicationCallback;
+
 /**
  * \ingroup lr-wpan
  *
@@ -980,6 +1110,28 @@ class LrWpanMac : public Object
      * See IEEE 802.15.4-2011, section 6.4.1, Table 51.
      */
     static constexpr uint32_t aMaxSIFSFrameSize = 18;
+
+    /**
+     * The minimum number of symbols forming the CAP. This ensures that MAC commands
+     * can still be transferred to devices when GTSs are being used.
+     * See IEEE 802.15.4-2011, section 6.4.1, Table 51.
+     */
+    static constexpr uint32_t aMinCAPLength = 440;
+
+    /**
+     * The number of superframes in which a GTS descriptor exists in the beacon frame
+     * of the coordinator.
+     * See IEEE 802.15.4-2011, section 6.4.1, Table 51.
+     */
+    static constexpr uint32_t aGTSDescPersistenceTime = 4;
+
+    /**
+     * The number of octets of MAC overhead (MHR + MFR) of a LL-DATA frame, (m) in the
+     * base timeslot duration formula.
+     * See IEEE 802.15.4e-2012, section 5.1.1.6.3.
+     */
+    static constexpr uint32_t aLLMacOverhead = 3;
+
     /**
      * Default constructor.
      */
@@ -1094,11 +1246,50 @@ class LrWpanMac : public Object
 
     /**
      * There is no DiscoveryStart primitives in spec.
-     * This is a self design flow for starting LLDN PAN-C Discovery flow.
+     * This is a self design flow for starting LLDN PAN-C Discovery flow,
+     * equivalent to a MLME-LLDN-DISCOVERY.request with default parameters.
      * See IEEE-802.15.4e section 5.1.9.2
      */
     void MlmeLLDiscoveryStart();
 
+    /**
+     * IEEE 802.15.4e-2012, section 6.2.20.2
+     * MLME-LLDN-DISCOVERY.request
+     * Request the LLDN PAN coordinator to switch to the Discovery state. LL beacons are sent
+     * with management timeslots, the devices answer with a Discover Response command in the
+     * uplink management timeslot. The MLME-LLDN-DISCOVERY.confirm is issued when no Discover
+     * Response was received during macLLDNdiscoveryModeTimeout seconds.
+     *
+     * \param params the request parameters
+     */
+    void MlmeLLDNDiscoveryRequest(MlmeLLDNDiscoveryRequstParams params);
+
+    /**
+     * IEEE 802.15.4e-2012, section 6.2.20.4
+     * MLME-LLDN-CONFIGURATION.request
+     * Request the LLDN PAN coordinator to switch to the Configuration state. The devices send
+     * a Configuration Status command in the uplink management timeslot, the PAN-C answers with
+     * a Configuration Request command assigning a simple address and a base timeslot. The
+     * MLME-LLDN-CONFIGURATION.confirm is issued as soon as every known device acknowledged its
+     * Configuration Request, or when no Configuration Status was received during
+     * macLLDNdiscoveryModeTimeout seconds. If the Discovery state is still running, it ends
+     * immediately with its MLME-LLDN-DISCOVERY.confirm.
+     *
+     * \param params the request parameters
+     */
+    void MlmeLLDNConfigurationRequest(MlmeLLDNConfigurationRequestParams params);
+
+    /**
+     * IEEE 802.15.4e-2012, section 6.2.20.6
+     * MLME-LLDN-ONLINE.request
+     * Request the LLDN PAN coordinator to switch to the Online state. From this moment,
+     * every LL beacon starts a superframe composed of the timeslots described by the
+     * LLDN MAC PIB attributes.
+     *
+     * \param params the request parameters
+     */
+    void MlmeLLDNOnlineRequest(MlmeLLDNOnlineRequestParams params);
+
     /**
      * IEEE 802.15.4-2011, section 6.2.10.1
      * MLME-SCAN.request
@@ -1142,11 +1333,24 @@ class LrWpanMac : public Object
      * IEEE 802.15.4-2011, section 6.2.14.2
      * MLME-POLL.request
      * Prompts the device to request data from the coordinator.
+     * The MLME-POLL.confirm reports SUCCESS when a frame is received from the
+     * coordinator, NO_DATA if the coordinator has no pending transaction for the device.
      *
      * \param params the request parameters
      */
     void MlmePollRequest(MlmePollRequestParams params);
 
+    /**
+     * IEEE 802.15.4-2011, section 6.2.6.1
+     * MLME-GTS.request
+     * Request the allocation of a new GTS or the deallocation of an existing GTS
+     * from the coordinator the device is tracking beacons from. An allocation is
+     * confirmed once the device finds its GTS descriptor in a beacon.
+     *
+     * \param params the request parameters
+     */
+    void MlmeGtsRequest(MlmeGtsRequestParams params);
+
     /**
      * Set the CSMA/CA implementation to be used by the MAC.
      *
@@ -1258,6 +1462,24 @@ class LrWpanMac : public Object
      */
     void SetMlmePollConfirmCallback(MlmePollConfirmCallback c);
 
+    /**
+     * Set the callback for the confirmation of a GTS request.
+     * The callback implements MLME-GTS.confirm SAP of IEEE 802.15.4-2011,
+     * section 6.2.6.2
+     *
+     * \param c the callback
+     */
+    void SetMlmeGtsConfirmCallback(MlmeGtsConfirmCallback c);
+
+    /**
+     * Set the callback for the indication of a GTS allocation or deallocation.
+     * The callback implements MLME-GTS.indication SAP of IEEE 802.15.4-2011,
+     * section 6.2.6.3
+     *
+     * \param c the callback
+     */
+    void SetMlmeGtsIndicationCallback(MlmeGtsIndicationCallback c);
+
     //!< LLDN callback amendment
     void SetMlmeLLDNDiscoveryConfirmCallback(MlmeLLDNDiscoveryConfirmCallback c);
     void SetMlmeLLDNConfigurationConfirmCallback(MlmeLLDNConfigurationConfirmCallback c);
@@ -1361,12 +1583,37 @@ class LrWpanMac : public Object
     void SetAssociateNotPermit();
 
     /**
-     * Set the max size of the transmit queue.
+     * Set the max size of the transmit queue and of the GTS transmit queues (32 MSDUs
+     * by default, see the TxQueueMaxSize attribute). The queued MSDUs are kept, even if
+     * they exceed the new size.
      *
-     * \param queueSize The transmit queue size.
+     * \param queueSize The transmit queue size, 0 to let the queues grow without limit.
      */
     void SetTxQMaxSize(uint32_t queueSize);
 
+    /**
+     * Get the max size of the transmit queue and of the GTS transmit queues.
+     *
+     * \return The transmit queue size, 0 if the queues are not limited.
+     */
+    uint32_t GetTxQMaxSize() const;
+
+    /**
+     * Set the element dropped when a MSDU is enqueued in a full transmit queue.
+     *
+     * \param policy The transmit queue drop policy.
+     */
+    void SetTxQDropPolicy(LrWpanTxQueueDropPolicy policy);
+
+    /**
+     * Set the time after which a queued MSDU is stale and can be dropped in favor
+     * of a new MSDU (see TX_QUEUE_STALE_FIRST). Typically the period of the
+     * sensor data sent by the device.
+     *
+     * \param staleTime The stale time.
+     */
+    void SetTxQStaleTime(Time staleTime);
+
     /**
      * Set the max size of the indirect transmit queue (Pending Transaction list)
      *
@@ -1374,6 +1621,13 @@ class LrWpanMac : public Object
      */
     void SetIndTxQMaxSize(uint32_t queueSize);
 
+    /**
+     * Set if the coordinator accepts GTS requests (macGTSPermit, true by default).
+     *
+     * \param permit true to accept the GTS requests
+     */
+    void SetGtsPermit(bool permit);
+
     //!< MAC PIB attributes
 
     /**
@@ -1614,6 +1868,12 @@ class LrWpanMac : public Object
      */
     bool m_macAssociationPermit;
 
+    /**
+     * Indication of whether a coordinator accepts GTS requests.
+     * See IEEE 802.15.4-2011, section 6.4.2, Table 52.
+     */
+    bool m_macGtsPermit;
+
     /**
      * Indication of whether a device automatically sends data request command
      * if its address is listed in the beacon frame.
@@ -1825,6 +2085,15 @@ class LrWpanMac : public Object
      */
     uint8_t m_macLLDNnumRetransmitTS;
 
+    /**
+     * Number of shared group timeslots, the last uplink timeslots of the superframe.
+     * Several LLDN devices can be assigned to the same shared group timeslot, they
+     * contend for it with a slotted ALOHA and a binary exponential backoff.
+     *? Implementation specific.
+     *? Default value =  0, range : 0 ~ (m_macLLDNnumUplinkTS - m_macLLDNnumRetransmitTS)
+     */
+    uint8_t m_macLLDNnumSharedGroupTS;
+
     /**
      * Number of bidirectional timeslots as defined in 
      * IEEE-802.15.4e-2012 5.1.1.6.5 within superframe for bidirectional communication.
@@ -1841,7 +2110,9 @@ class LrWpanMac : public Object
     /**
      * The 8-bit identifier of the LLDN on which the
      * device is operating. If this value is 0xff, the device is not associated.
-     *? Maybe not used (?).
+     * A LLDN is identified by the PAN coordinator ID of its LL beacons, a device
+     * joins the LLDN of the first LL beacon received and ignores the LL beacons
+     * of the other LLDNs operating on the same channel.
      *? Default value =  0xff, range : 0x00 ~ 0xff
      */
     uint8_t m_macLLDNlowLatencyNWid;
@@ -1862,6 +2133,13 @@ class LrWpanMac : public Object
      */
     bool m_macLLDNcoordinator;
 
+    /**
+     * The base timeslot of the superframe assigned to this LLDN device for its
+     * uplink transmissions. Normally obtained in the Configuration state.
+     *? Default value =  0xff (no timeslot assigned), range : 0 ~ (m_macLLDNnumTimeSlots - 1)
+     */
+    uint8_t m_macLLDNassignedTimeSlot;
+
     uint8_t aMaxSIFIFrameSize;
 
     //!< LLDN beacon payload FlgsField Params
@@ -1893,18 +2171,155 @@ class LrWpanMac : public Object
     void SetMacLLDNnumUplinkTS(uint8_t numUpLinkTS);
     void SetMacLLDNnumReTransmitTS(uint8_t numRetransmitTS);    
     void SetMacLLDNnumBidirectionalTS(uint8_t numBidirectionalTS);
+    void SetMacLLDNnumSharedGroupTS(uint8_t numSharedGroupTS);
     void SetMacLLDNmgmtTSEnabled();
     void SetMacLLDNmgmtTSDisabled();     
     void SetMacLLDNdiscoveryModeTimeout(uint16_t discoveryModeTimeout);    
     void SetMacLLDNcoordinator(bool isCoordinator);
+    void SetMacLLDNassignedTimeSlot(uint8_t timeSlot);
+    void SetMacLLDNlowLatencyNWid(uint8_t lowLatencyNWid);
 
     uint8_t  GetMacLLDNNumTimeSlots() const;
     uint8_t  GetMacLLDNnumUplinkTS() const;
     uint8_t  GetMacLLDNnumReTransmitTS() const;
     uint8_t  GetMacLLDNnumBidirectionalTS() const;
+    uint8_t  GetMacLLDNnumSharedGroupTS() const;
     bool     GetMacLLDNmgmtTS() const;
     uint16_t GetMacLLDNdiscoveryModeTimeout() const;
     bool     GetMacLLDNcoordinator() const;
+    uint8_t  GetMacLLDNassignedTimeSlot() const;
+    uint8_t  GetMacLLDNlowLatencyNWid() const;
+
+    /**
+     * Assign a base timeslot to a LLDN device (PAN-C only). LL-DATA frames do not
+     * carry address fields, the PAN-C identifies their source by the timeslot used.
+     *
+     * \param timeSlot the base timeslot assigned to the device
+     * \param address the simple address of the device
+     */
+    void SetLLDNTimeslotOwner(uint8_t timeSlot, Mac8Address address);
+
+    /**
+     * Get the duration of a LLDN base timeslot, see IEEE 802.15.4e-2012 section 5.1.1.6.3.
+     * tTS = (p * sp + (m + n) * sm) / v + IFS, where n is the timeslot size (m_mlmeLLTimeslotSize).
+     *
+     * \return the base timeslot duration in symbols
+     */
+    uint64_t GetLLDNBaseTimeslotSymbols() const;
+
+    /**
+     * Get the number of symbols needed to send a LL-DATA frame and the following IFS.
+     * This is the duration of a base timeslot whose timeslot size is payloadSize.
+     *
+     * \param payloadSize the LL frame payload in octets
+     * \return the duration in symbols
+     */
+    uint64_t GetLLDNTimeslotSymbols(uint32_t payloadSize) const;
+
+    /**
+     * Get the duration of the LLDN beacon timeslot. It has the length of a base timeslot,
+     * unless the LL beacon and its group acknowledgement bitmap do not fit in it.
+     *
+     * \param baseTimeslotSymbols the duration of a base timeslot in symbols
+     * \param online true if the LL beacon is sent in the Online state
+     * \param numBaseTimeslots the number of base timeslots in the superframe
+     * \return the duration in symbols
+     */
+    uint64_t GetLLDNBeaconTimeslotSymbols(uint64_t baseTimeslotSymbols,
+                                          bool online,
+                                          uint16_t numBaseTimeslots) const;
+
+    /**
+     * Declare the traffic of a LLDN device, announced to the PAN-C in its Configuration
+     * Status. The PAN-C slot planner uses it to size the Online superframe.
+     *
+     * \param payloadSize the LL frame payload sent in each superframe, in octets
+     * \param period the longest accepted period between two frames, zero if none
+     */
+    void SetLLDNTrafficRequirements(uint8_t payloadSize, Time period);
+
+    /**
+     * Enable the slot planner of the LLDN PAN coordinator. When enabled, the base
+     * timeslots are not assigned at first contact: once the Configuration Status of the
+     * devices are collected, the planner selects the timeslot size giving the shortest
+     * Online superframe, assigns several consecutive base timeslots to the devices whose
+     * payload exceeds it, and checks the periods requested by the devices. The resulting
+     * superframe is used from the MLME-LLDN-ONLINE.request onwards.
+     *
+     * \param enabled true to enable the planner
+     */
+    void SetLLDNSlotPlannerEnabled(bool enabled);
+
+    /**
+     * Enable the duty cycle of a LLDN device in the Online state. The transceiver is
+     * switched off between the LL beacon and the timeslots of the device, and from its
+     * last timeslot to the next LL beacon, which carries the group acknowledgement.
+     * It is switched on again a guard time ahead of each of them.
+     *
+     * \param enabled true to enable the duty cycle
+     */
+    void SetLLDNSleepEnabled(bool enabled);
+
+    /**
+     * Set the guard time of the LLDN timeslots. A duty-cycled LLDN device switches its
+     * transceiver on this time ahead of the LL beacon and of its timeslots, and a LLDN
+     * device misses the timeslots it reaches with a clock error larger than this time.
+     *
+     * \param guardTime the guard time
+     */
+    void SetLLDNGuardTime(Time guardTime);
+
+    /**
+     * Get the guard time of the LLDN timeslots.
+     *
+     * \return the guard time
+     */
+    Time GetLLDNGuardTime() const;
+
+    /**
+     * Set the frequency offset of the clock of a LLDN device. The device measures the
+     * timeslots from the start of the last LL beacon it received with this clock, so
+     * its timing error grows along the superframe. A positive offset makes the clock
+     * run fast, and the timeslots start early.
+     *
+     * \param ppm the frequency offset, in parts per million
+     */
+    void SetLLDNClockDrift(double ppm);
+
+    /**
+     * Get the current frequency offset of the clock of a LLDN device.
+     *
+     * \return the frequency offset, in parts per million
+     */
+    double GetLLDNClockDrift() const;
+
+    /**
+     * Set the random walk of the frequency offset of the clock of a LLDN device. At each
+     * LL beacon received, a normally distributed step is added to the frequency offset,
+     * with a standard deviation of the given value times the square root of the time
+     * elapsed since the previous LL beacon received, in seconds.
+     *
+     * \param ppm the standard deviation of the frequency offset after one second,
+     *            in parts per million (0 to keep the frequency offset constant)
+     */
+    void SetLLDNClockDriftWalk(double ppm);
+
+    /**
+     * Get the duration of the complete LLDN superframe (beacon, management and base timeslots)
+     * described by the current LLDN parameters.
+     *
+     * \return the superframe duration in symbols
+     */
+    uint64_t GetLLDNSuperframeSymbols() const;
+
+    /**
+     * Get the type of a timeslot of the LLDN superframe.
+     *
+     * \param timeslot the timeslot number, counted after the beacon timeslot (management
+     *                 timeslots first, followed by the base timeslots)
+     * \return the type of timeslot
+     */
+    LLDNTimeslotType GetLLDNTimeslotType(uint16_t timeslot) const;
 
     /**
      * Set LLDN mode enabled.
@@ -2015,6 +2430,28 @@ class LrWpanMac : public Object
      * */
     uint64_t GetTxPacketSymbols();
 
+    /**
+     * Update the cached symbol duration from the PHY option of the PHY.
+     */
+    void UpdateSymbolDuration();
+
+    /**
+     * Get the duration of a number of symbols, as an exact multiple of the symbol
+     * duration of the current PHY option.
+     *
+     * \param symbols the number of symbols
+     * \return the duration of the symbols
+     */
+    Time GetSymbolsTime(uint64_t symbols) const;
+
+    /**
+     * Get the number of whole symbols elapsed in a duration.
+     *
+     * \param duration the duration
+     * \return the number of symbols
+     */
+    uint64_t GetTimeSymbols(Time duration) const;
+
     /**
      * Check if the packet to transmit requires acknowledgment
      *
@@ -2043,6 +2480,86 @@ class LrWpanMac : public Object
      */
     typedef void (*SentTracedCallback)(Ptr<const Packet> packet, uint8_t retries, uint8_t backoffs);
 
+    /**
+     * TracedCallback signature for the LLDN devices entering the Online state.
+     *
+     * \param [in] simpleAddress The simple address assigned to the device.
+     * \param [in] timeToOnline The time elapsed between the first Discovery or Configuration
+     *             state LL beacon received by the device and the first Online LL beacon.
+     */
+    typedef void (*LLDNTimeToOnlineTracedCallback)(Mac8Address simpleAddress, Time timeToOnline);
+
+    /**
+     * TracedCallback signature for the start of a LLDN superframe.
+     *
+     * \param [in] duration The duration of the LLDN superframe.
+     */
+    typedef void (*LLDNSuperframeTracedCallback)(Time duration);
+
+    /**
+     * TracedCallback signature for the occupancy of the uplink base timeslots,
+     * reported by the PAN-C at the end of each LLDN superframe.
+     *
+     * \param [in] baseTimeslot The base timeslot number.
+     * \param [in] occupied True if a frame was received in the base timeslot.
+     */
+    typedef void (*LLDNTimeslotOccupancyTracedCallback)(uint8_t baseTimeslot, bool occupied);
+
+    /**
+     * TracedCallback signature for the frames sent by a LLDN device in a base timeslot.
+     *
+     * \param [in] baseTimeslot The base timeslot number.
+     * \param [in] type The type of the base timeslot.
+     * \param [in] retransmission The number of previous attempts of the frame.
+     */
+    typedef void (*LLDNTimeslotTxTracedCallback)(uint8_t baseTimeslot,
+                                                 LLDNTimeslotType type,
+                                                 uint8_t retransmission);
+
+    /**
+     * TracedCallback signature for the frames not acknowledged in the group acknowledgement.
+     *
+     * \param [in] baseTimeslot The base timeslot in which the frame was sent.
+     * \param [in] retransmission The number of previous attempts of the frame.
+     */
+    typedef void (*LLDNGroupAckMissTracedCallback)(uint8_t baseTimeslot, uint8_t retransmission);
+
+    /**
+     * TracedCallback signature for the frames delivered in a LLDN timeslot.
+     *
+     * \param [in] packet The packet.
+     * \param [in] latency The time elapsed between the enqueue of the packet and the end
+     *             of its successful transmission.
+     */
+    typedef void (*LLDNDataLatencyTracedCallback)(Ptr<const Packet> packet, Time latency);
+
+    /**
+     * TracedCallback signature for the LL-DATA frames received by the PAN-C.
+     *
+     * \param [in] srcAddress The simple address of the sender.
+     * \param [in] delay The time elapsed between the start of the LL beacon and the end
+     *             of the reception of the frame.
+     */
+    typedef void (*LLDNBeaconToDataTracedCallback)(Mac8Address srcAddress, Time delay);
+
+    /**
+     * TracedCallback signature for the timeslots missed by a LLDN device.
+     *
+     * \param [in] type The type of the missed timeslot, LLDN_TS_BEACON for a LL beacon.
+     * \param [in] clockError The timing error of the device at the start of the timeslot,
+     *             positive when the device is late.
+     */
+    typedef void (*LLDNSlotMissTracedCallback)(LLDNTimeslotType type, Time clockError);
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model. Return the number of streams that have been assigned.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
     /**
      * TracedCallback signature for LrWpanMacState change events.
      *
@@ -2063,24 +2580,39 @@ class LrWpanMac : public Object
     /**
      * Helper structure for managing transmission queue elements.
      */
-    struct TxQueueElement : public SimpleRefCount<TxQueueElement>
+    struct TxQueueElement
     {
-        uint8_t txQMsduHandle; //!< MSDU Handle
-        Ptr<Packet> txQPkt;    //!< Queued packet
+        uint8_t txQMsduHandle{0}; //!< MSDU Handle
+        Ptr<Packet> txQPkt;       //!< Queued packet
+        Time txQEnqueueTime;      //!< The time at which the packet was enqueued
+        Mac8Address txQDstSimpleAddr{Mac8Address::GetBroadcast()}; //!< LL-DATA destination
     };
 
     /**
      * Helper structure for managing pending transaction list elements (Indirect transmissions).
      */
-    struct IndTxQueueElement : public SimpleRefCount<IndTxQueueElement>
+    struct IndTxQueueElement
     {
-        uint8_t seqNum;               //!< The sequence number of  the queued packet
-        Mac16Address dstShortAddress; //!< The destination short Mac Address
-        Mac64Address dstExtAddress;   //!< The destination extended Mac Address
-        Ptr<Packet> txQPkt;           //!< Queued packet.
+        uint8_t seqNum{0};                         //!< The sequence number of  the queued packet
+        LrWpanAddressMode dstAddrMode{SHORT_ADDR}; //!< The destination addressing mode
+        uint8_t txQMsduHandle{0};                  //!< MSDU Handle
+        Mac16Address dstShortAddress;              //!< The destination short Mac Address
+        Mac64Address dstExtAddress;                //!< The destination extended Mac Address
+        Ptr<Packet> txQPkt;                        //!< Queued packet.
         Time expireTime; //!< The expiration time of the packet in the indirect transmission queue.
     };
 
+    /**
+     * Helper structure for managing the guaranteed time slots (GTS) of a superframe.
+     */
+    struct GtsDescriptor
+    {
+        Mac16Address devAddress; //!< The short address of the device owning the GTS
+        uint8_t startSlot{0};    //!< The superframe slot at which the GTS begins
+        uint8_t length{0};       //!< The number of superframe slots of the GTS
+        bool direction{false};   //!< False for a transmit-only GTS, true for a receive-only GTS
+    };
+
     /**
      * Called to send a single beacon frame.
      */
@@ -2092,42 +2624,433 @@ class LrWpanMac : public Object
     void SendOneLLBeacon();
 
     /**
-     * Called to send an associate request command.
+     * Called after the transmission (PAN-C) or the reception (LLDN device) of a LL beacon
+     * to begin a LLDN superframe and arm the first timeslot of interest.
+     *
+     * \param superframeType The incoming or outgoing superframe reference
      */
-    void SendAssocRequestCommand();
+    void StartLLSuperframe(SuperframeType superframeType);
 
     /**
-     * Used to send a data request command (i.e. Request the coordinator to send the association
-     * response)
+     * Called at the beginning of a LLDN timeslot. Transmit or listen during the timeslot
+     * according to its type and the device role, and arm the next timeslot of interest.
+     *
+     * \param timeslot the timeslot number (see GetLLDNTimeslotType)
      */
-    void SendDataRequestCommand();
+    void StartLLTimeslot(uint16_t timeslot);
 
     /**
-     * Called to send an associate response command.
+     * Schedule the first timeslot of interest for this device, starting from the given
+     * timeslot, or the end of the LLDN superframe if there are no more timeslots of interest.
      *
-     * \param rxDataReqPkt The received data request pkt that instigated the Association response
-     * command.
+     * \param timeslot the first timeslot number to consider
      */
-    void SendAssocResponseCommand(Ptr<Packet> rxDataReqPkt);
+    void ArmNextLLTimeslot(uint16_t timeslot);
 
     /**
-     * Called after m_assocRespCmdWaitTime timeout while waiting for an association response
-     * command.
+     * Called at the end of the last timeslot of a LLDN superframe.
+     * The PAN-C transmits the next LL beacon, LLDN devices wait for it.
      */
-    void LostAssocRespCommand();
+    void EndLLSuperframe();
 
     /**
-     * Called to send a beacon request command.
+     * Transmit the first element of the Tx queue in the current LLDN timeslot.
+     * No CSMA-CA is used, the timeslot is owned by this device.
      */
-    void SendBeaconRequestCommand();
+    void LLTimeslotTransmit();
 
     /**
-     * Called to end a MLME-START.request after changing the page and channel number.
+     * Check if this device transmits or listens in the given LLDN timeslot.
+     *
+     * \param timeslot the timeslot number
+     * \return true if the timeslot must be armed by this device
      */
-    void EndStartRequest();
+    bool IsLLTimeslotOfInterest(uint16_t timeslot) const;
 
     /**
-     * Called at the end of the current channel scan (Active or Passive) for a given duration.
+     * Convert an offset from the start of the LLDN superframe, measured by the clock
+     * of the device, into the simulation time elapsed since the start.
+     *
+     * \param offset the offset measured by the clock of the device
+     * \return the offset in simulation time
+     */
+    Time GetLLDeviceTime(Time offset) const;
+
+    /**
+     * Check if a duty-cycled LLDN device can switch its transceiver off until its
+     * next wake up.
+     *
+     * \return true if the transceiver can be switched off
+     */
+    bool IsLLSleepAllowed() const;
+
+    /**
+     * Switch the transceiver of a duty-cycled LLDN device off until its next wake up.
+     */
+    void LLSleep();
+
+    /**
+     * Switch the transceiver of a duty-cycled LLDN device on ahead of the LL beacon
+     * or of one of its timeslots.
+     */
+    void LLWakeUp();
+
+    /**
+     * Get the number of timeslots (management and base timeslots) following the
+     * beacon timeslot in the current LLDN superframe.
+     *
+     * \return the number of timeslots
+     */
+    uint16_t GetLLDNNumTimeslots() const;
+
+    /**
+     * Get the start of a timeslot relative to the start of the LLDN superframe (i.e. the
+     * beginning of the beacon timeslot).
+     *
+     * \param timeslot the timeslot number
+     * \return the timeslot offset in symbols
+     */
+    uint64_t GetLLDNTimeslotOffset(uint16_t timeslot) const;
+
+    /**
+     * Get the number of base timeslots used by each management timeslot.
+     *
+     * \return the management timeslot length in base timeslots, 0 if the superframe has no
+     *         management timeslots
+     */
+    uint8_t GetLLDNMgmtTimeslotLength() const;
+
+    /**
+     * Check if a packet is a LLDN frame (Frame type 4 in the frame control field).
+     *
+     * \param p the packet without PHY header
+     * \return true if the packet starts with a LL MAC header
+     */
+    bool IsLLFrame(Ptr<const Packet> p) const;
+
+    /**
+     * Process the reception of a LLDN frame (fast path of PdDataIndication).
+     * Only the 1 octet LL MAC header is deserialized, and the received frame is
+     * only copied if a trace sink is connected.
+     *
+     * \param psduLength number of bytes in the PSDU
+     * \param p the received packet
+     * \param lqi the link quality indicator of the received packet
+     */
+    void LLDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi);
+
+    /**
+     * Process the end of the transmission of a LLDN beacon or of a frame
+     * transmitted in a LLDN timeslot.
+     *
+     * \param status the PHY status of the transmission
+     */
+    void LLDataConfirm(LrWpanPhyEnumeration status);
+
+    /**
+     * Build a LL-DATA frame (1 octet LL MAC header, no address fields) and
+     * push it to the transmit queue. Used by McpsDataRequest when the simple
+     * address mode is requested.
+     *
+     * \param params the request parameters
+     * \param p the packet to be transmitted
+     */
+    void LLDataRequest(McpsDataRequestParams params, Ptr<Packet> p);
+
+    /**
+     * Check if a LLDN timeslot is used by the devices to send frames to the PAN-C.
+     *
+     * \param type the timeslot type
+     * \return true for retransmission, uplink and uplink bidirectional timeslots
+     */
+    bool IsLLUplinkTimeslot(LLDNTimeslotType type) const;
+
+    /**
+     * Get the timeslot of the current LLDN superframe containing a given time.
+     *
+     * \param time the time
+     * \return the timeslot index, 0xffff for the beacon timeslot
+     */
+    uint16_t GetLLDNTimeslotAt(Time time) const;
+
+    /**
+     * Check if the end of the reception of a frame falls inside a given timeslot
+     * of the current LLDN superframe.
+     *
+     * \param timeslot the timeslot index
+     * \return true if the current time is inside the timeslot
+     */
+    bool IsInLLTimeslot(uint16_t timeslot) const;
+
+    /**
+     * Get the simple address of the LLDN device that owns a base timeslot
+     * (PAN-C only). For retransmission timeslots, the owner is the only device
+     * mapped to the retransmission timeslot that was not acknowledged in the last
+     * LL beacon.
+     *
+     * \param baseTimeslot the base timeslot
+     * \return the simple address of the owner or the broadcast simple address if unknown
+     */
+    Mac8Address GetLLDNTimeslotOwner(uint8_t baseTimeslot) const;
+
+    /**
+     * Record the successful reception of an uplink frame in a timeslot, the PAN-C
+     * reports it in the group acknowledgement bitmap of the next LL beacon.
+     *
+     * \param timeslot the timeslot in which the frame was sent
+     * \param type the type of the timeslot
+     */
+    void LLRecordGroupAck(uint16_t timeslot, LLDNTimeslotType type);
+
+    /**
+     * Process the group acknowledgement bitmap received in a LL beacon.
+     * If the frame pending in the transmit queue was not acknowledged, it is
+     * retransmitted in the next superframe (up to macMaxFrameRetries times).
+     *
+     * \param groupAckBmp the group acknowledgement bitmap (true if base timeslot n was received)
+     */
+    void LLProcessGroupAck(const std::vector<bool>& groupAckBmp);
+
+    /**
+     * Get the retransmission timeslot used by the device assigned to a base timeslot,
+     * the base timeslots are mapped in round robin to the retransmission timeslots.
+     *
+     * \param baseTimeslot the base timeslot assigned to the device
+     * \return the base timeslot used for retransmissions or 0xff if none is available
+     */
+    uint8_t GetLLDNRetransmitTimeslot(uint8_t baseTimeslot) const;
+
+    /**
+     * Check if the frame sent in the current LLDN timeslot must be acknowledged
+     * with the group acknowledgement of the next LL beacon.
+     *
+     * \return true if the frame waits for a group acknowledgement
+     */
+    bool IsLLGroupAckReq();
+
+    /**
+     * Get the number of management timeslots (0 or 2) in the current superframe.
+     *
+     * \return the number of management timeslots
+     */
+    uint16_t GetLLDNNumMgmtTimeslots() const;
+
+    /**
+     * Information kept by the LLDN PAN coordinator about each device answering
+     * in the Discovery or Configuration state.
+     */
+    struct LLDNDeviceDescriptor
+    {
+        Mac64Address fullAddr;    //!< The full MAC address of the device
+        Mac8Address simpleAddr;   //!< The simple address assigned to the device
+        uint8_t timeslotDuration; //!< The timeslot duration required by the device
+        uint8_t typeIndicator;    //!< Uplink (0) or bidirectional (1) device
+        uint8_t assignedTimeslot; //!< The base timeslot assigned, 0xff if none
+        uint8_t numTimeslots;     //!< The number of consecutive base timeslots assigned
+        Time requestedPeriod;     //!< The period requested by the device, zero if none
+        bool statusReceived;      //!< A Configuration Status was received from the device
+        bool configured;          //!< The device acknowledged its Configuration Request
+    };
+
+    /**
+     * Called at the beginning of a management timeslot in the Discovery and Configuration
+     * states. The management timeslots are divided in subslots, each long enough for a
+     * management command and its acknowledgement. The PAN-C sends the pending Configuration
+     * Requests in the successive subslots of the downlink management timeslot, devices with
+     * a pending Discover Response or Configuration Status pick a random subslot of the uplink
+     * management timeslot.
+     */
+    void LLMgmtTimeslotStart();
+
+    /**
+     * Transmit a management command in a subslot of the current management timeslot,
+     * and schedule the next subslot (PAN-C only).
+     *
+     * \param subslot the subslot number
+     */
+    void LLMgmtTransmit(uint8_t subslot);
+
+    /**
+     * Process the reception of a LL command frame (Discover Response, Configuration Status
+     * or Configuration Request).
+     *
+     * \param p the command frame without the LL MAC header and MAC trailer
+     * \param ackReq true if the command must be acknowledged
+     */
+    void LLCommandIndication(Ptr<Packet> p, bool ackReq);
+
+    /**
+     * Process the reception of the acknowledgement of a management command.
+     *
+     * \param p the acknowledgement frame without the LL MAC header and MAC trailer
+     */
+    void LLMgmtAckIndication(Ptr<Packet> p);
+
+    /**
+     * Called when the acknowledgement of the management command sent was not received.
+     */
+    void LLMgmtAckTimeout();
+
+    /**
+     * Send the acknowledgement of a management command. The acknowledged full MAC address
+     * is carried as payload, this resolves the collisions of the uplink management timeslot.
+     *
+     * \param fullAddr the full MAC address of the device that sent or received the command
+     */
+    void SendLLAck(Mac64Address fullAddr);
+
+    /**
+     * Build a LL command frame (LL MAC header, command payload and MAC trailer).
+     *
+     * \param cmdPayload the command payload
+     * \return the command frame
+     */
+    Ptr<Packet> BuildLLCommand(const CommandPayloadHeader& cmdPayload) const;
+
+    /**
+     * Prepare the uplink management command of a LLDN device (Discover Response or
+     * Configuration Status) and draw the number of superframes to wait before sending it.
+     *
+     * \param cmd the command type
+     */
+    void LLPrepareMgmtCommand(CommandPayloadHeader::MacCommand cmd);
+
+    /**
+     * Update the Discovery and Configuration state of a LLDN device after the
+     * reception of a LL beacon.
+     *
+     * \param oldState the transmission state before the LL beacon
+     */
+    void LLProcessBringUpBeacon(FlagsField::TransmissionState oldState);
+
+    /**
+     * Assign a simple address and a free base timeslot to a LLDN device (PAN-C only).
+     * When all the dedicated timeslots are used, the device gets the shared group
+     * timeslot with the fewest devices.
+     *
+     * \param device the device descriptor
+     * \return true if a base timeslot could be assigned
+     */
+    bool LLAssignTimeslot(LLDNDeviceDescriptor& device);
+
+    /**
+     * Assign the next free simple address to a LLDN device (PAN-C only).
+     *
+     * \param device the device descriptor
+     */
+    void LLAssignSimpleAddress(LLDNDeviceDescriptor& device);
+
+    /**
+     * Plan the Online superframe from the Configuration Status of the devices (PAN-C
+     * slot planner). Every candidate timeslot size is evaluated, the one giving the
+     * shortest superframe is kept. The shared group timeslots are kept after the
+     * uplink devices. The devices whose assignment changed are queued for a new
+     * Configuration Request.
+     */
+    void LLPlanSuperframe();
+
+    /**
+     * Called when no Discover Response was received during macLLDNdiscoveryModeTimeout.
+     * Issue the MLME-LLDN-DISCOVERY.confirm.
+     */
+    void LLDiscoveryTimeout();
+
+    /**
+     * Called when no Configuration Status was received during macLLDNdiscoveryModeTimeout,
+     * or when every known device is configured. Issue the MLME-LLDN-CONFIGURATION.confirm.
+     */
+    void LLConfigurationEnd();
+
+    /**
+     * Get the number of management subslots in a management timeslot.
+     *
+     * \return the number of subslots
+     */
+    uint8_t GetLLDNNumMgmtSubslots() const;
+
+    /**
+     * Get the duration of a management command exchange, i.e. the transmission
+     * of the longest management command followed by its acknowledgement.
+     *
+     * \return the duration in symbols
+     */
+    uint64_t GetLLMgmtExchangeSymbols() const;
+
+    /**
+     * Get the maximum time to wait for the acknowledgement of a management command.
+     *
+     * \return the duration in symbols
+     */
+    uint64_t GetLLMgmtAckWaitSymbols() const;
+
+    /**
+     * Called to send an associate request command.
+     */
+    void SendAssocRequestCommand();
+
+    /**
+     * Used to send a data request command (i.e. Request the coordinator to send the association
+     * response)
+     */
+    void SendDataRequestCommand();
+
+    /**
+     * Called to send the oldest pending transaction (e.g. an association response command)
+     * of the device which sent a data request command.
+     *
+     * \param rxDataReqPkt The received data request pkt that instigated the transmission.
+     */
+    void SendPendingTransaction(Ptr<Packet> rxDataReqPkt);
+
+    /**
+     * Check if the pending transaction list holds a transaction for the sender of a frame.
+     *
+     * \param rxMacHdr The MAC header of the received frame.
+     * \return true if a transaction is pending for the sender
+     */
+    bool IsIndTxPending(const LrWpanMacHeader& rxMacHdr);
+
+    /**
+     * Called after macMaxFrameTotalWaitTime when the frame announced by the
+     * coordinator in response to a poll was not received.
+     */
+    void PollWaitTimeout();
+
+    /**
+     * Check if a received data frame is the frame announced by the coordinator
+     * in response to the MLME-POLL.request in progress.
+     *
+     * \param params the MCPS-DATA.indication parameters of the frame
+     * \return true if the frame was sent by the polled coordinator to this device
+     */
+    bool IsPollResponse(const McpsDataIndicationParams& params) const;
+
+    /**
+     * Get the macMaxFrameTotalWaitTime, the maximum time to wait for a frame
+     * announced by a coordinator (See IEEE 802.15.4-2011, Section 6.4.3).
+     *
+     * \return the macMaxFrameTotalWaitTime in symbols
+     */
+    uint64_t GetMacMaxFrameTotalWaitTime() const;
+
+    /**
+     * Called after m_assocRespCmdWaitTime timeout while waiting for an association response
+     * command.
+     */
+    void LostAssocRespCommand();
+
+    /**
+     * Called to send a beacon request command.
+     */
+    void SendBeaconRequestCommand();
+
+    /**
+     * Called to end a MLME-START.request after changing the page and channel number.
+     */
+    void EndStartRequest();
+
+    /**
+     * Called at the end of the current channel scan (Active or Passive) for a given duration.
      */
     void EndChannelScan();
 
@@ -2149,6 +3072,82 @@ class LrWpanMac : public Object
      */
     void StartCFP(SuperframeType superframeType);
 
+    /**
+     * Schedule the start of the next GTS of the superframe in which this device
+     * transmits or receives.
+     *
+     * \param superframeType The incoming or outgoing superframe reference
+     * \param slot The first superframe slot to consider
+     */
+    void ScheduleNextGts(SuperframeType superframeType, uint8_t slot);
+
+    /**
+     * Called at the beginning of a GTS of this device. Serve the queue of the GTS
+     * if this device transmits in it, enable the receiver otherwise.
+     *
+     * \param superframeType The incoming or outgoing superframe reference
+     * \param gts The GTS
+     */
+    void StartGts(SuperframeType superframeType, GtsDescriptor gts);
+
+    /**
+     * Called at the end of a GTS of this device.
+     */
+    void EndGts();
+
+    /**
+     * Transmit the first element of the queue of the current GTS, without CSMA-CA.
+     * The frame is kept for the next superframe if the transaction does not fit in
+     * the rest of the GTS.
+     */
+    void GtsTransmit();
+
+    /**
+     * Get the queue of the frame being sent: the queue of the current GTS for
+     * the frames sent in a GTS, the transmit queue otherwise.
+     *
+     * \return the transmit queue
+     */
+    LrWpanRingBuffer<TxQueueElement>& GetCurrentTxQueue();
+
+    /**
+     * Allocate or deallocate a GTS following the GTS request command of a device
+     * (coordinator only). The GTSs are allocated from the end of the superframe,
+     * the CAP is never reduced below aMinCAPLength.
+     *
+     * \param devAddress The short address of the device
+     * \param gtsCharacteristics The GTS characteristics of the request
+     */
+    void ProcessGtsRequest(Mac16Address devAddress, GtsCharacteristics gtsCharacteristics);
+
+    /**
+     * Update the GTSs of this device from the GTS fields of a received beacon and
+     * confirm a pending GTS allocation.
+     *
+     * \param gtsFields The GTS fields of the beacon
+     */
+    void UpdateIncomingGts(const GtsFields& gtsFields);
+
+    /**
+     * Called when the GTS descriptor of a requested allocation was not found in
+     * the beacons received during aGTSDescPersistenceTime superframes.
+     */
+    void GtsRequestTimeout();
+
+    /**
+     * Drop the frames of the queue of a GTS and remove the queue. The higher layer
+     * is notified with an INVALID_GTS status.
+     *
+     * \param devAddress The short address of the device owning the GTS
+     * \param direction The direction of the GTS
+     */
+    void RemoveGtsTxQueue(Mac16Address devAddress, bool direction);
+
+    /**
+     * Deallocate all the GTSs of this device in the incoming superframe.
+     */
+    void ClearIncomingGts();
+
     /**
      * Called to begin the Contention Access Period (CAP) in a
      * beacon-enabled mode.
@@ -2180,15 +3179,25 @@ class LrWpanMac : public Object
      * Send an acknowledgment packet for the given sequence number.
      *
      * \param seqno the sequence number for the ACK
+     * \param framePending true if the coordinator has pending data for the recipient
      */
-    void SendAck(uint8_t seqno);
+    void SendAck(uint8_t seqno, bool framePending);
 
     /**
-     * Add an element to the transmission queue.
+     * Add an element to the transmission queue. When the queue is full, the element
+     * dropped depends on the drop policy.
      *
      * \param txQElement The element added to the Tx Queue.
      */
-    void EnqueueTxQElement(Ptr<TxQueueElement> txQElement);
+    void EnqueueTxQElement(TxQueueElement txQElement);
+
+    /**
+     * Drop a queued element, issuing its MCPS-DATA.confirm.
+     *
+     * \param i The position of the element in the Tx Queue.
+     * \param status The status of the MCPS-DATA.confirm.
+     */
+    void DropTxQElement(uint32_t i, LrWpanMcpsDataConfirmStatus status);
 
     /**
      * Remove the tip of the transmission queue, including clean up related to the
@@ -2230,23 +3239,44 @@ class LrWpanMac : public Object
      * Adds a packet to the pending transactions list (Indirect transmissions).
      *
      * \param p The packet added to pending transaction list.
+     * \param msduHandle The MSDU handle of a data packet.
      */
-    void EnqueueInd(Ptr<Packet> p);
+    void EnqueueInd(Ptr<Packet> p, uint8_t msduHandle);
 
     /**
-     * Extracts a packet from pending transactions list (Indirect transmissions).
+     * Extracts the oldest packet sent to a device from pending transactions list
+     * (Indirect transmissions).
      * \param dst The extended address used an index to obtain an element from the pending
      * transaction list.
      * \param entry The dequeued element from the pending transaction list.
      * \return The status of the dequeue
      */
-    bool DequeueInd(Mac64Address dst, Ptr<IndTxQueueElement> entry);
+    bool DequeueInd(Mac64Address dst, IndTxQueueElement& entry);
+
+    /**
+     * Extracts the oldest packet sent to a device from pending transactions list
+     * (Indirect transmissions).
+     * \param dst The short address used an index to obtain an element from the pending
+     * transaction list.
+     * \param entry The dequeued element from the pending transaction list.
+     * \return The status of the dequeue
+     */
+    bool DequeueInd(Mac16Address dst, IndTxQueueElement& entry);
 
     /**
      * Purge expired transactions from the pending transactions list.
+     * Only the expired transactions are visited.
      */
     void PurgeInd();
 
+    /**
+     * Remove a transaction from the pending transaction list and from the index
+     * of its destination.
+     *
+     * \param id The identifier of the transaction.
+     */
+    void EraseIndTxQElement(uint64_t id);
+
     /**
      * Remove an element from the pending transaction list.
      *
@@ -2279,7 +3309,8 @@ class LrWpanMac : public Object
 
     /**
      * Constructs Pending Address Fields from the local information,
-     * the Pending Address Fields are part of the beacon frame.
+     * the Pending Address Fields are part of the beacon frame. The fields list
+     * the destinations of the oldest pending transactions.
      *
      * \returns the Pending Address Fields
      */
@@ -2450,6 +3481,13 @@ class LrWpanMac : public Object
      */
     Ptr<LrWpanPhy> m_phy;
 
+    /**
+     * The duration of a symbol of the PHY option of the PHY. It is an exact integer
+     * number of time steps for all the PHY options, so the MAC timing is free
+     * of rounding errors.
+     */
+    Time m_symbolDuration;
+
     /**
      * The CSMA/CA implementation used by this MAC.
      */
@@ -2488,6 +3526,18 @@ class LrWpanMac : public Object
      */
     MlmePollConfirmCallback m_mlmePollConfirmCallback;
 
+    /**
+     * This callback is used to report the result of a GTS request.
+     * See IEEE 802.15.4-2011, section 6.2.6.2.
+     */
+    MlmeGtsConfirmCallback m_mlmeGtsConfirmCallback;
+
+    /**
+     * This callback is used to report the GTS allocated or deallocated by a coordinator.
+     * See IEEE 802.15.4-2011, section 6.2.6.3.
+     */
+    MlmeGtsIndicationCallback m_mlmeGtsIndicationCallback;
+
     /**
      * This callback is used to report the start of a new PAN or
      * the begin of a new superframe configuration.
@@ -2578,18 +3628,52 @@ class LrWpanMac : public Object
     /**
      * The transmit queue used by the MAC.
      */
-    std::deque<Ptr<TxQueueElement>> m_txQueue;
+    LrWpanRingBuffer<TxQueueElement> m_txQueue;
+
+    /**
+     * The element dropped when a MSDU is enqueued in a full transmit queue.
+     */
+    LrWpanTxQueueDropPolicy m_txQueueDropPolicy;
+
+    /**
+     * The time after which a queued MSDU can be dropped by the TX_QUEUE_STALE_FIRST policy.
+     */
+    Time m_txQueueStaleTime;
 
     /**
      * The indirect transmit queue used by the MAC pending messages (The pending transaction
-     * list).
+     * list), indexed by the identifier of the transactions. The identifiers increase
+     * in the order of the transactions.
+     */
+    std::unordered_map<uint64_t, IndTxQueueElement> m_indTxQueue;
+
+    /**
+     * The identifiers of the pending transactions sent to each extended address,
+     * oldest first.
      */
-    std::deque<Ptr<IndTxQueueElement>> m_indTxQueue;
+    std::unordered_map<uint64_t, std::deque<uint64_t>> m_indTxQueueExtIndex;
 
     /**
-     * The maximum size of the transmit queue.
+     * The identifiers of the pending transactions sent to each short address,
+     * oldest first.
      */
-    uint32_t m_maxTxQueueSize;
+    std::unordered_map<uint16_t, std::deque<uint64_t>> m_indTxQueueShortIndex;
+
+    /**
+     * The expiration times of the pending transactions and their identifiers, earliest
+     * first. The transactions dequeued before their expiration are left in the heap
+     * and skipped when they are popped.
+     */
+    std::priority_queue<std::pair<Time, uint64_t>,
+                        std::vector<std::pair<Time, uint64_t>>,
+                        std::greater<std::pair<Time, uint64_t>>>
+        m_indTxQueueExpiry;
+
+    /**
+     * The identifier of the next transaction added to the pending transaction list.
+     */
+    uint64_t m_indTxQueueNextId;
+
 
     /**
      * The maximum size of the indirect transmit queue (The pending transaction list).
@@ -2625,6 +3709,11 @@ class LrWpanMac : public Object
      */
     MlmeAssociateRequestParams m_associateParams;
 
+    /**
+     * The parameters of the MLME-POLL.request in progress.
+     */
+    MlmePollRequestParams m_pollParams;
+
     /**
      * The channel list index used to obtain the current scanned channel.
      */
@@ -2663,6 +3752,93 @@ class LrWpanMac : public Object
      */
     EventId m_assocResCmdWaitTimeout;
 
+    /**
+     * Indicates a MLME-POLL.request in progress.
+     */
+    bool m_pollPending;
+
+    /**
+     * Scheduler event for the frame announced by the coordinator in response to a poll.
+     * The receiver is kept on while it is running.
+     */
+    EventId m_pollWaitTimeout;
+
+    /**
+     * Indicates a MLME-GTS.request allocation waiting for its GTS descriptor.
+     */
+    bool m_gtsRequestPending;
+
+    /**
+     * The characteristics of the pending GTS request.
+     */
+    GtsCharacteristics m_gtsRequest;
+
+    /**
+     * Scheduler event for the GTS descriptor of a requested allocation.
+     */
+    EventId m_gtsRequestTimeout;
+
+    /**
+     * The GTSs allocated by this coordinator, applied in the next outgoing superframe.
+     */
+    std::vector<GtsDescriptor> m_gtsList;
+
+    /**
+     * The GTSs of the outgoing superframe, as announced in the last beacon.
+     */
+    std::vector<GtsDescriptor> m_outGtsList;
+
+    /**
+     * The GTS requests denied by this coordinator, announced in the next beacon.
+     */
+    std::vector<GtsDescriptor> m_gtsDenied;
+
+    /**
+     * The GTSs of this device in the incoming superframe.
+     */
+    std::vector<GtsDescriptor> m_incGtsList;
+
+    /**
+     * The transmit queue of each GTS in which this device transmits, indexed by the
+     * short address of the device owning the GTS and the GTS direction.
+     */
+    std::map<std::pair<Mac16Address, bool>, LrWpanRingBuffer<TxQueueElement>> m_gtsTxQueues;
+
+    /**
+     * The queue of the current GTS in which this device transmits, null outside of it.
+     */
+    LrWpanRingBuffer<TxQueueElement>* m_gtsTxQueue;
+
+    /**
+     * The start of the current GTS.
+     */
+    Time m_gtsStartTime;
+
+    /**
+     * The end of the current GTS.
+     */
+    Time m_gtsEndTime;
+
+    /**
+     * Indicates that the packet currently being sent is transmitted in a GTS.
+     */
+    bool m_gtsTx;
+
+    /**
+     * Indicates that the receiver is kept on for a GTS in which this device receives.
+     */
+    bool m_gtsRxOn;
+
+    /**
+     * Scheduler event for the start of the next GTS of this device.
+     */
+    EventId m_gtsEvent;
+
+    /**
+     * Scheduler event for the end of the current GTS of this device.
+     */
+    EventId m_gtsEndEvent;
+
     /**
      * Scheduler event for a deferred MAC state change.
      */
@@ -2712,6 +3888,328 @@ class LrWpanMac : public Object
      * Scheduler event for the end of a ED channel scan.
      */
     EventId m_scanEnergyEvent;
+
+    /**
+     * Scheduler event for the start of the next armed LLDN timeslot or the end of the
+     * LLDN superframe.
+     */
+    EventId m_llTimeslotEvent;
+
+    /**
+     * The start of the current LLDN superframe (beginning of the beacon timeslot).
+     */
+    Time m_llSuperframeStart;
+
+    /**
+     * The current LLDN timeslot number (see GetLLDNTimeslotType).
+     */
+    uint16_t m_llCurrentTimeslot;
+
+    /**
+     * The base timeslots of the current LLDN superframe in which the PAN-C received a frame.
+     */
+    std::vector<bool> m_llTimeslotOccupied;
+
+    /**
+     * Indicates that the LLDN device switches its transceiver off between its timeslots.
+     */
+    bool m_llSleepEnabled;
+
+    /**
+     * The guard time of the LLDN timeslots. A duty-cycled LLDN device switches its
+     * transceiver on this time ahead of the LL beacon and of its timeslots.
+     */
+    Time m_llGuardTime;
+
+    /**
+     * The frequency offset of the clock of the LLDN device, in parts per million.
+     */
+    double m_llClockDrift;
+
+    /**
+     * The standard deviation of the random walk of the clock frequency offset after one
+     * second, in parts per million.
+     */
+    double m_llClockDriftWalk;
+
+    /**
+     * The start of the last LL beacon received by the LLDN device, on which its clock was
+     * synchronized, or a negative time before the first one.
+     */
+    Time m_llSyncTime;
+
+    /**
+     * The random variable of the random walk of the clock frequency offset, created
+     * with the random walk.
+     */
+    Ptr<NormalRandomVariable> m_llDriftRandom;
+
+    /**
+     * The stream assigned to the random walk of the clock frequency offset, or -1
+     * for an automatic stream.
+     */
+    int64_t m_llDriftStream;
+
+    /**
+     * The time at which a duty-cycled LLDN device switches its transceiver on again.
+     */
+    Time m_llWakeTime;
+
+    /**
+     * Indicates that the next wake up of a duty-cycled LLDN device is for an uplink
+     * timeslot, which is skipped if there is nothing to send.
+     */
+    bool m_llWakeForUplink;
+
+    /**
+     * Scheduler event for switching the transceiver of a duty-cycled LLDN device off.
+     */
+    EventId m_llSleepEvent;
+
+    /**
+     * Scheduler event for switching the transceiver of a duty-cycled LLDN device on.
+     */
+    EventId m_llWakeEvent;
+
+    /**
+     * The end of the last successful transmission in a LLDN timeslot.
+     */
+    Time m_llTxEndTime;
+
+    /**
+     * The type of the current LLDN timeslot.
+     */
+    LLDNTimeslotType m_llCurrentTimeslotType;
+
+    /**
+     * Indicates that the packet currently being sent is transmitted in a LLDN timeslot.
+     */
+    bool m_llTimeslotTx;
+
+    /**
+     * The group acknowledgement bitmap collected by the PAN-C during the current
+     * superframe (true if a frame was received in base timeslot n).
+     */
+    std::vector<bool> m_llGroupAckBmp;
+
+    /**
+     * Indicates that the frame at the head of the transmit queue was sent and
+     * waits for the group acknowledgement of the next LL beacon.
+     */
+    bool m_llGroupAckPending;
+
+    /**
+     * The base timeslot used by the frame waiting for a group acknowledgement.
+     */
+    uint8_t m_llGroupAckTimeslot;
+
+    /**
+     * The group acknowledgement bitmap sent in the last LL beacon (PAN-C only).
+     */
+    std::vector<bool> m_llLastGroupAckBmp;
+
+    /**
+     * The simple address of the LLDN devices assigned to each base timeslot (PAN-C only).
+     */
+    std::map<uint8_t, Mac8Address> m_llTimeslotOwners;
+
+    /**
+     * The devices which answered in the Discovery or Configuration state (PAN-C only).
+     */
+    std::map<Mac64Address, LLDNDeviceDescriptor> m_llDevices;
+
+    /**
+     * The devices waiting for their Configuration Request (PAN-C only).
+     */
+    std::deque<Mac64Address> m_llConfigRequestQueue;
+
+    /**
+     * Scheduler event for the end of the Discovery state (PAN-C only).
+     */
+    EventId m_llDiscoveryTimeoutEvent;
+
+    /**
+     * Scheduler event for the end of the Configuration state (PAN-C only).
+     */
+    EventId m_llConfigurationTimeoutEvent;
+
+    /**
+     * Scheduler event for the next subslot of a management timeslot.
+     */
+    EventId m_llMgmtSubslotEvent;
+
+    /**
+     * Scheduler event for the acknowledgement timeout of a management command.
+     */
+    EventId m_llMgmtAckEvent;
+
+    /**
+     * The management command waiting to be sent (LLDN device) or sent and waiting for
+     * its acknowledgement.
+     */
+    Ptr<Packet> m_llMgmtPkt;
+
+    /**
+     * The type of the management command waiting to be sent (LLDN device).
+     */
+    CommandPayloadHeader::MacCommand m_llMgmtCmd;
+
+    /**
+     * The full MAC address expected in the acknowledgement of the management command.
+     */
+    Mac64Address m_llMgmtAckAddr;
+
+    /**
+     * Indicates that the packet currently being sent is a management command or its
+     * acknowledgement.
+     */
+    bool m_llMgmtTx;
+
+    /**
+     * The backoff exponent used to draw the number of superframes to wait before
+     * sending the management command of a LLDN device.
+     */
+    uint8_t m_llMgmtBE;
+
+    /**
+     * The number of superframes to wait before sending the management command.
+     */
+    uint32_t m_llMgmtBackoff;
+
+    /**
+     * The backoff exponent used to draw the number of shared group timeslots to skip
+     * after a frame sent in a shared group timeslot was not acknowledged.
+     */
+    uint8_t m_llSharedBE;
+
+    /**
+     * The number of shared group timeslots to skip before sending the next frame.
+     */
+    uint32_t m_llSharedBackoff;
+
+    /**
+     * Indicates that the Discover Response of the LLDN device was acknowledged.
+     */
+    bool m_llDiscovered;
+
+    /**
+     * Indicates that the Configuration Status of the LLDN device was acknowledged.
+     */
+    bool m_llConfigStatusAcked;
+
+    /**
+     * Indicates that the LLDN device received its Configuration Request.
+     */
+    bool m_llConfigured;
+
+    /**
+     * The reception time of the first Discovery or Configuration state LL beacon
+     * (negative if the device is not being brought up).
+     */
+    Time m_llBringUpStart;
+
+    /**
+     * The simple address assigned to the next configured LLDN device (PAN-C only).
+     */
+    uint8_t m_llNextSimpleAddress;
+
+    /**
+     * Indicates that the PAN-C plans the Online superframe from the Configuration
+     * Status of the devices.
+     */
+    bool m_llSlotPlanner;
+
+    /**
+     * The Online superframe computed by the slot planner (PAN-C only). The timeslot
+     * size is zero until the first plan.
+     */
+    LrWpanMlmeLLNetworkConfiguration m_llPlan;
+
+    /**
+     * Scheduler event for the slot planning, once the devices stopped sending
+     * Configuration Status frames (PAN-C only).
+     */
+    EventId m_llPlanEvent;
+
+    /**
+     * The LL frame payload announced by the LLDN device, zero to use the timeslot size.
+     */
+    uint8_t m_llReqPayloadSize;
+
+    /**
+     * The longest period between two frames announced by the LLDN device, zero if none.
+     */
+    Time m_llReqPeriod;
+
+    /**
+     * The number of consecutive base timeslots assigned to the LLDN device.
+     */
+    uint8_t m_llNumAssignedTimeslots;
+
+    /**
+     * The random variable used to select the management subslots and backoffs.
+     */
+    Ptr<UniformRandomVariable> m_llRandom;
+
+    /**
+     * The trace source fired when a LLDN device enters the Online state after its
+     * Discovery and Configuration.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<Mac8Address, Time> m_llTimeToOnlineTrace;
+
+    /**
+     * The trace source fired at the start of each LLDN superframe, reporting its duration.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<Time> m_llSuperframeTrace;
+
+    /**
+     * The trace source fired by the PAN-C at the end of each LLDN superframe for
+     * every uplink base timeslot, reporting whether a frame was received in it.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<uint8_t, bool> m_llTimeslotOccupancyTrace;
+
+    /**
+     * The trace source fired when a LLDN device sends a frame in a base timeslot.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<uint8_t, LLDNTimeslotType, uint8_t> m_llTimeslotTxTrace;
+
+    /**
+     * The trace source fired when the frame of a LLDN device is not acknowledged
+     * in the group acknowledgement.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<uint8_t, uint8_t> m_llGroupAckMissTrace;
+
+    /**
+     * The trace source fired when a frame sent in a LLDN timeslot is delivered.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<Ptr<const Packet>, Time> m_llDataLatencyTrace;
+
+    /**
+     * The trace source fired when the PAN-C receives a LL-DATA frame.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<Mac8Address, Time> m_llBeaconToDataTrace;
+
+    /**
+     * The trace source fired when a LLDN device misses a timeslot because of the
+     * error of its clock.
+     *
+     * \see class CallBackTraceSource
+     */
+    TracedCallback<LLDNTimeslotType, Time> m_llSlotMissTrace;
 };
 } // namespace ns3
 
@@ -179,8 +179,8 @@ void
 LrWpanNetDevice::SetChannel(Ptr<SpectrumChannel> channel)
 {
     NS_LOG_FUNCTION(this << channel);
-    m_phy->SetChannel(channel);
     channel->AddRx(m_phy);
+    m_phy->SetChannel(channel);
     CompleteConfig();
 }
 
@@ -403,6 +403,21 @@ LrWpanNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t protocol
 
     McpsDataRequestParams m_mcpsDataRequestParams;
 
+    // LLDN devices use LL-DATA frames with simple (8 bit) addresses.
+    if (Mac8Address::IsMatchingType(dest))
+    {
+        m_mcpsDataRequestParams.m_dstSimpleAddr = Mac8Address::ConvertFrom(dest);
+        m_mcpsDataRequestParams.m_dstAddrMode = SIMPLE_ADDR;
+        m_mcpsDataRequestParams.m_srcAddrMode = SIMPLE_ADDR;
+        if (m_useAcks)
+        {
+            m_mcpsDataRequestParams.m_txOptions = TX_OPTION_ACK;
+        }
+        m_mcpsDataRequestParams.m_msduHandle = 0;
+        m_mac->McpsDataRequest(m_mcpsDataRequestParams, packet);
+        return true;
+    }
+
     Mac16Address dst16;
     if (Mac48Address::IsMatchingType(dest))
     {
@@ -491,6 +506,10 @@ LrWpanNetDevice::McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet>
     {
         m_receiveCallback(this, pkt, 0, BuildPseudoMacAddress(params.m_srcPanId, params.m_srcAddr));
     }
+    else if (params.m_dstAddrMode == SIMPLE_ADDR)
+    {
+        m_receiveCallback(this, pkt, 0, params.m_srcSimpleAddr);
+    }
     else
     {
         m_receiveCallback(this, pkt, 0, params.m_srcExtAddr);
@@ -541,6 +560,7 @@ LrWpanNetDevice::AssignStreams(int64_t stream)
     int64_t streamIndex = stream;
     streamIndex += m_csmaca->AssignStreams(stream);
     streamIndex += m_phy->AssignStreams(stream);
+    streamIndex += m_mac->AssignStreams(streamIndex);
     NS_LOG_DEBUG("Number of assigned RV streams:  " << (streamIndex - stream));
     return (streamIndex - stream);
 }
@@ -263,6 +263,7 @@ LrWpanPhy::SetChannel(Ptr<SpectrumChannel> c)
 {
     NS_LOG_FUNCTION(this << c);
     m_channel = c;
+    UpdateRxBands();
 }
 
 Ptr<SpectrumChannel>
@@ -310,8 +311,7 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
         // Update the average receive power during ED.
         Time now = Simulator::Now();
         m_edPower.averagePower +=
-            LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                     m_phyPIBAttributes.phyCurrentChannel) *
+            m_signal->GetSignalPower() *
             (now - m_edPower.lastUpdate).GetTimeStep() / m_edPower.measurementLength.GetTimeStep();
         m_edPower.lastUpdate = now;
     }
@@ -327,9 +327,7 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
         // Update peak power if CCA is in progress.
         if (!m_ccaRequest.IsExpired())
         {
-            double power =
-                LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                         m_phyPIBAttributes.phyCurrentChannel);
+            double power = m_signal->GetSignalPower();
             if (m_ccaPeakPower < power)
             {
                 m_ccaPeakPower = power;
@@ -369,20 +367,25 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
                                  30
                           << "dBm");
         m_signal->AddSignal(lrWpanRxParams->psd);
-        Ptr<SpectrumValue> interferenceAndNoise = m_signal->GetSignalPsd();
-        *interferenceAndNoise -= *lrWpanRxParams->psd;
-        *interferenceAndNoise += *m_noise;
-        double sinr =
+        double signal =
             LrWpanSpectrumValueHelper::TotalAvgPower(lrWpanRxParams->psd,
-                                                     m_phyPIBAttributes.phyCurrentChannel) /
-            LrWpanSpectrumValueHelper::TotalAvgPower(interferenceAndNoise,
                                                      m_phyPIBAttributes.phyCurrentChannel);
+        double interferenceAndNoise =
+            m_signal->GetSignalPower() - signal +
+            LrWpanSpectrumValueHelper::TotalAvgPower(m_noise,
+                                                     m_phyPIBAttributes.phyCurrentChannel);
+        double sinr = signal / interferenceAndNoise;
 
         // Std. 802.15.4-2006, appendix E, Figure E.2
         // At SNR < -5 the BER is less than 10e-1.
         // It's useless to even *try* to decode the packet.
         if (10 * log10(sinr) > -5)
         {
+            // The packet burst is shared by all the receivers of the signal.
+            // Take a private copy, the LQI tag is updated during the reception.
+            lrWpanRxParams->packetBurst = lrWpanRxParams->packetBurst->Copy();
+            p = lrWpanRxParams->packetBurst->GetPackets().front();
+
             ChangeTrxState(IEEE_802_15_4_PHY_BUSY_RX);
             m_currentRxPacket = std::make_pair(lrWpanRxParams, false);
             m_phyRxBeginTrace(p);
@@ -421,9 +424,7 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
     // Update peak power if CCA is in progress.
     if (!m_ccaRequest.IsExpired())
     {
-        double power =
-            LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                     m_phyPIBAttributes.phyCurrentChannel);
+        double power = m_signal->GetSignalPower();
         if (m_ccaPeakPower < power)
         {
             m_ccaPeakPower = power;
@@ -440,7 +441,6 @@ void
 LrWpanPhy::CheckInterference()
 {
     // Calculate whether packet was lost.
-    LrWpanSpectrumValueHelper psdHelper;
     Ptr<LrWpanSpectrumSignalParameters> currentRxParams = m_currentRxPacket.first;
 
     // We are currently receiving a packet.
@@ -454,14 +454,14 @@ LrWpanPhy::CheckInterference()
             // How many bits did we receive since the last calculation?
             double t = (Simulator::Now() - m_rxLastUpdate).ToDouble(Time::MS);
             uint32_t chunkSize = ceil(t * (GetDataOrSymbolRate(true) / 1000));
-            Ptr<SpectrumValue> interferenceAndNoise = m_signal->GetSignalPsd();
-            *interferenceAndNoise -= *currentRxParams->psd;
-            *interferenceAndNoise += *m_noise;
-            double sinr =
+            double signal =
                 LrWpanSpectrumValueHelper::TotalAvgPower(currentRxParams->psd,
-                                                         m_phyPIBAttributes.phyCurrentChannel) /
-                LrWpanSpectrumValueHelper::TotalAvgPower(interferenceAndNoise,
                                                          m_phyPIBAttributes.phyCurrentChannel);
+            double interferenceAndNoise =
+                m_signal->GetSignalPower() - signal +
+                LrWpanSpectrumValueHelper::TotalAvgPower(m_noise,
+                                                         m_phyPIBAttributes.phyCurrentChannel);
+            double sinr = signal / interferenceAndNoise;
             double per = 1.0 - m_errorModel->GetChunkSuccessRate(sinr, chunkSize);
 
             // The LQI is the total packet success rate scaled to 0-255.
@@ -498,8 +498,7 @@ LrWpanPhy::EndRx(Ptr<SpectrumSignalParameters> par)
         // Update the average receive power during ED.
         Time now = Simulator::Now();
         m_edPower.averagePower +=
-            LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                     m_phyPIBAttributes.phyCurrentChannel) *
+            m_signal->GetSignalPower() *
             (now - m_edPower.lastUpdate).GetTimeStep() / m_edPower.measurementLength.GetTimeStep();
         m_edPower.lastUpdate = now;
     }
@@ -622,7 +621,9 @@ LrWpanPhy::PdDataRequest(const uint32_t psduLength, Ptr<Packet> p)
             Ptr<LrWpanSpectrumSignalParameters> txParams = Create<LrWpanSpectrumSignalParameters>();
             txParams->duration = CalculateTxTime(p);
             txParams->txPhy = GetObject<SpectrumPhy>();
-            txParams->psd = m_txPsd;
+            // m_txPsd is shared with the other transmitters using the same power and channel,
+            // the channel and the propagation loss models get a copy they are free to modify.
+            txParams->psd = m_txPsd->Copy();
             txParams->txAntenna = m_antenna;
             Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
             pb->AddPacket(p);
@@ -1158,14 +1159,16 @@ LrWpanPhy::PlmeSetAttributeRequest(LrWpanPibAttributeIdentifier id,
 
             m_phyPIBAttributes.phyCurrentPage = attribute->phyCurrentPage;
 
-            LrWpanSpectrumValueHelper psdHelper;
-            m_txPsd = psdHelper.CreateTxPowerSpectralDensity(
+            m_txPsd = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(
                 GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower),
                 m_phyPIBAttributes.phyCurrentChannel);
             // if the page is changed we need to also update the Noise Power Spectral Density
+            LrWpanSpectrumValueHelper psdHelper;
             m_noise =
                 psdHelper.CreateNoisePowerSpectralDensity(m_phyPIBAttributes.phyCurrentChannel);
-            m_signal = Create<LrWpanInterferenceHelper>(m_noise->GetSpectrumModel());
+            m_signal = Create<LrWpanInterferenceHelper>(m_noise->GetSpectrumModel(),
+                                                        m_phyPIBAttributes.phyCurrentChannel);
+            UpdateRxBands();
         }
         break;
     }
@@ -1208,14 +1211,16 @@ LrWpanPhy::PlmeSetAttributeRequest(LrWpanPibAttributeIdentifier id,
 
             m_phyPIBAttributes.phyCurrentChannel = attribute->phyCurrentChannel;
 
-            LrWpanSpectrumValueHelper psdHelper;
-            m_txPsd = psdHelper.CreateTxPowerSpectralDensity(
+            m_txPsd = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(
                 GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower),
                 m_phyPIBAttributes.phyCurrentChannel);
             // if the channel is changed we need to also update the Noise Power Spectral Density
+            LrWpanSpectrumValueHelper psdHelper;
             m_noise =
                 psdHelper.CreateNoisePowerSpectralDensity(m_phyPIBAttributes.phyCurrentChannel);
-            m_signal = Create<LrWpanInterferenceHelper>(m_noise->GetSpectrumModel());
+            m_signal = Create<LrWpanInterferenceHelper>(m_noise->GetSpectrumModel(),
+                                                        m_phyPIBAttributes.phyCurrentChannel);
+            UpdateRxBands();
         }
         break;
     }
@@ -1240,8 +1245,7 @@ LrWpanPhy::PlmeSetAttributeRequest(LrWpanPibAttributeIdentifier id,
         else
         {
             m_phyPIBAttributes.phyTransmitPower = attribute->phyTransmitPower;
-            LrWpanSpectrumValueHelper psdHelper;
-            m_txPsd = psdHelper.CreateTxPowerSpectralDensity(
+            m_txPsd = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(
                 GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower),
                 m_phyPIBAttributes.phyCurrentChannel);
         }
@@ -1324,7 +1328,33 @@ LrWpanPhy::ChangeTrxState(LrWpanPhyEnumeration newState)
 {
     NS_LOG_LOGIC(this << " state: " << m_trxState << " -> " << newState);
     m_trxStateLogger(Simulator::Now(), m_trxState, newState);
+    bool wasOff = (m_trxState == IEEE_802_15_4_PHY_TRX_OFF ||
+                   m_trxState == IEEE_802_15_4_PHY_FORCE_TRX_OFF);
     m_trxState = newState;
+    bool isOff = (m_trxState == IEEE_802_15_4_PHY_TRX_OFF ||
+                  m_trxState == IEEE_802_15_4_PHY_FORCE_TRX_OFF);
+    if (wasOff != isOff)
+    {
+        UpdateRxBands();
+    }
+}
+
+void
+LrWpanPhy::UpdateRxBands()
+{
+    if (!m_channel || !m_txPsd)
+    {
+        return;
+    }
+    if (m_trxState == IEEE_802_15_4_PHY_TRX_OFF || m_trxState == IEEE_802_15_4_PHY_FORCE_TRX_OFF)
+    {
+        m_channel->SetRxBands(this, 0, 0);
+    }
+    else
+    {
+        // The receiver only listens to the bands of the current channel.
+        m_channel->SetRxBands(this, m_txPsd->GetActiveBandsBegin(), m_txPsd->GetActiveBandsEnd());
+    }
 }
 
 bool
@@ -1357,8 +1387,7 @@ LrWpanPhy::EndEd()
     NS_LOG_FUNCTION(this);
 
     m_edPower.averagePower +=
-        LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                 m_phyPIBAttributes.phyCurrentChannel) *
+        m_signal->GetSignalPower() *
         (Simulator::Now() - m_edPower.lastUpdate).GetTimeStep() /
         m_edPower.measurementLength.GetTimeStep();
 
@@ -1394,8 +1423,7 @@ LrWpanPhy::EndCca()
     LrWpanPhyEnumeration sensedChannelState = IEEE_802_15_4_PHY_UNSPECIFIED;
 
     // Update peak power.
-    double power = LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                            m_phyPIBAttributes.phyCurrentChannel);
+    double power = m_signal->GetSignalPower();
     if (m_ccaPeakPower < power)
     {
         m_ccaPeakPower = power;
@@ -1559,6 +1587,18 @@ LrWpanPhy::GetCurrentChannelNum() const
     return m_phyPIBAttributes.phyCurrentChannel;
 }
 
+LrWpanPhyEnumeration
+LrWpanPhy::GetTrxState() const
+{
+    return m_trxState;
+}
+
+int8_t
+LrWpanPhy::GetNominalTxPower()
+{
+    return GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower);
+}
+
 double
 LrWpanPhy::GetDataOrSymbolRate(bool isData)
 {
@@ -1690,12 +1730,13 @@ LrWpanPhy::SetPhyOption(LrWpanPhyOption phyOption)
     // TODO: What is the RX sensibility that should be set for other frequencies?
     // default -110 dBm in W for 2.4 GHz
     m_rxSensitivity = pow(10.0, -106.58 / 10.0) / 1000.0;
-    LrWpanSpectrumValueHelper psdHelper;
-    m_txPsd = psdHelper.CreateTxPowerSpectralDensity(
+    m_txPsd = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(
         GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower),
         m_phyPIBAttributes.phyCurrentChannel);
+    LrWpanSpectrumValueHelper psdHelper;
     m_noise = psdHelper.CreateNoisePowerSpectralDensity(m_phyPIBAttributes.phyCurrentChannel);
-    m_signal = Create<LrWpanInterferenceHelper>(m_noise->GetSpectrumModel());
+    m_signal = Create<LrWpanInterferenceHelper>(m_noise->GetSpectrumModel(),
+                                                m_phyPIBAttributes.phyCurrentChannel);
     m_rxLastUpdate = Seconds(0);
     Ptr<Packet> none_packet = nullptr;
     Ptr<LrWpanSpectrumSignalParameters> none_params = nullptr;
@@ -1773,9 +1814,7 @@ LrWpanPhy::GetPhySymbolsPerOctet() const
 double
 LrWpanPhy::GetCurrentSignalPsd()
 {
-    double powerWatts =
-        LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                 m_phyPIBAttributes.phyCurrentChannel);
+    double powerWatts = m_signal->GetSignalPower();
     return WToDbm(powerWatts);
 }
 
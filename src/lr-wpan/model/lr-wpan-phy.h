@@ -460,6 +460,20 @@ class LrWpanPhy : public SpectrumPhy
      */
     uint8_t GetCurrentChannelNum() const;
 
+    /**
+     * Get the current state of the transceiver.
+     *
+     * \return The current TRX state
+     */
+    LrWpanPhyEnumeration GetTrxState() const;
+
+    /**
+     * Get the nominal transmit power in use in this PHY from the PIB attributes.
+     *
+     * \return The nominal transmit power in dBm
+     */
+    int8_t GetNominalTxPower();
+
     /**
      * implement PLME SetAttribute confirm SAP
      * bit rate is in bit/s.  Symbol rate is in symbol/s.
@@ -574,6 +588,12 @@ class LrWpanPhy : public SpectrumPhy
      */
     void ChangeTrxState(LrWpanPhyEnumeration newState);
 
+    /**
+     * Tell the channel which signals are delivered to the PHY: none when the
+     * transceiver is off, only the ones on the current channel otherwise.
+     */
+    void UpdateRxBands();
+
     /**
      * Get the currently configured PHY option.
      * See IEEE 802.15.4-2006, section 6.1.2, Table 2.
@@ -789,7 +809,7 @@ class LrWpanPhy : public SpectrumPhy
     /**
      * The transmit power spectral density.
      */
-    Ptr<SpectrumValue> m_txPsd;
+    Ptr<const SpectrumValue> m_txPsd;
 
     /**
      * The spectral density for for the noise.
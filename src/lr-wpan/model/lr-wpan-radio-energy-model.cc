@@ -0,0 +1,334 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "lr-wpan-radio-energy-model.h"
+
+#include <ns3/double.h>
+#include <ns3/energy-source.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LrWpanRadioEnergyModel");
+
+NS_OBJECT_ENSURE_REGISTERED(LrWpanRadioEnergyModel);
+
+TypeId
+LrWpanRadioEnergyModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LrWpanRadioEnergyModel")
+            .SetParent<DeviceEnergyModel>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<LrWpanRadioEnergyModel>()
+            .AddAttribute("TxCurrentA",
+                          "The transmit current in Ampere, used when no current is set for "
+                          "the transmit power.",
+                          DoubleValue(0.0174), // CC2420 at 0 dBm
+                          MakeDoubleAccessor(&LrWpanRadioEnergyModel::m_txCurrentA),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("RxCurrentA",
+                          "The receive current in Ampere (RX_ON, BUSY_RX and TX_ON states).",
+                          DoubleValue(0.0188),
+                          MakeDoubleAccessor(&LrWpanRadioEnergyModel::m_rxCurrentA),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("TrxOffCurrentA",
+                          "The current in Ampere in the TRX_OFF state.",
+                          DoubleValue(0.000426),
+                          MakeDoubleAccessor(&LrWpanRadioEnergyModel::m_trxOffCurrentA),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("SleepCurrentA",
+                          "The current in Ampere when the transceiver sleeps.",
+                          DoubleValue(0.00002),
+                          MakeDoubleAccessor(&LrWpanRadioEnergyModel::m_sleepCurrentA),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("SleepDelay",
+                          "The time spent in the TRX_OFF state before the transceiver sleeps. "
+                          "By default, the transceiver never sleeps.",
+                          TimeValue(Time::Max()),
+                          MakeTimeAccessor(&LrWpanRadioEnergyModel::m_sleepDelay),
+                          MakeTimeChecker())
+            .AddTraceSource(
+                "TotalEnergyConsumption",
+                "Total energy consumption of the radio device.",
+                MakeTraceSourceAccessor(&LrWpanRadioEnergyModel::m_totalEnergyConsumption),
+                "ns3::TracedValueCallback::Double");
+    return tid;
+}
+
+LrWpanRadioEnergyModel::LrWpanRadioEnergyModel()
+    : m_currentState(IEEE_802_15_4_PHY_TRX_OFF),
+      m_sleeping(false),
+      m_currentA(0),
+      m_lastUpdateTime(Seconds(0))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LrWpanRadioEnergyModel::~LrWpanRadioEnergyModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LrWpanRadioEnergyModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_sleepEvent.Cancel();
+    m_source = nullptr;
+    m_phy = nullptr;
+    m_energyDepletionCallback.Nullify();
+    m_energyRechargedCallback.Nullify();
+}
+
+void
+LrWpanRadioEnergyModel::SetEnergySource(Ptr<EnergySource> source)
+{
+    NS_LOG_FUNCTION(this << source);
+    NS_ASSERT(source);
+    m_source = source;
+    m_lastUpdateTime = Simulator::Now();
+}
+
+double
+LrWpanRadioEnergyModel::GetTotalEnergyConsumption() const
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_source)
+    {
+        return m_totalEnergyConsumption;
+    }
+    Time duration = Simulator::Now() - m_lastUpdateTime;
+    return m_totalEnergyConsumption +
+           duration.GetSeconds() * m_currentA * m_source->GetSupplyVoltage();
+}
+
+void
+LrWpanRadioEnergyModel::AttachPhy(Ptr<LrWpanPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    m_phy = phy;
+    m_phy->TraceConnectWithoutContext(
+        "TrxStateValue",
+        MakeCallback(&LrWpanRadioEnergyModel::TrxStateChanged, this));
+
+    // The PHY may have left the TRX_OFF state before being attached.
+    ChangeState(m_phy->GetTrxState());
+}
+
+double
+LrWpanRadioEnergyModel::GetTxCurrentA() const
+{
+    return m_txCurrentA;
+}
+
+void
+LrWpanRadioEnergyModel::SetTxCurrentA(double txCurrentA)
+{
+    NS_LOG_FUNCTION(this << txCurrentA);
+    m_txCurrentA = txCurrentA;
+}
+
+void
+LrWpanRadioEnergyModel::SetTxCurrentA(int8_t txPower, double txCurrentA)
+{
+    NS_LOG_FUNCTION(this << +txPower << txCurrentA);
+    m_txCurrentsA[txPower] = txCurrentA;
+}
+
+double
+LrWpanRadioEnergyModel::GetRxCurrentA() const
+{
+    return m_rxCurrentA;
+}
+
+void
+LrWpanRadioEnergyModel::SetRxCurrentA(double rxCurrentA)
+{
+    NS_LOG_FUNCTION(this << rxCurrentA);
+    m_rxCurrentA = rxCurrentA;
+}
+
+double
+LrWpanRadioEnergyModel::GetTrxOffCurrentA() const
+{
+    return m_trxOffCurrentA;
+}
+
+void
+LrWpanRadioEnergyModel::SetTrxOffCurrentA(double trxOffCurrentA)
+{
+    NS_LOG_FUNCTION(this << trxOffCurrentA);
+    m_trxOffCurrentA = trxOffCurrentA;
+}
+
+double
+LrWpanRadioEnergyModel::GetSleepCurrentA() const
+{
+    return m_sleepCurrentA;
+}
+
+void
+LrWpanRadioEnergyModel::SetSleepCurrentA(double sleepCurrentA)
+{
+    NS_LOG_FUNCTION(this << sleepCurrentA);
+    m_sleepCurrentA = sleepCurrentA;
+}
+
+LrWpanPhyEnumeration
+LrWpanRadioEnergyModel::GetCurrentState() const
+{
+    return m_currentState;
+}
+
+bool
+LrWpanRadioEnergyModel::IsSleeping() const
+{
+    return m_sleeping;
+}
+
+void
+LrWpanRadioEnergyModel::SetEnergyDepletionCallback(LrWpanRadioEnergyDepletionCallback callback)
+{
+    m_energyDepletionCallback = callback;
+}
+
+void
+LrWpanRadioEnergyModel::SetEnergyRechargedCallback(LrWpanRadioEnergyRechargedCallback callback)
+{
+    m_energyRechargedCallback = callback;
+}
+
+void
+LrWpanRadioEnergyModel::ChangeState(int newState)
+{
+    NS_LOG_FUNCTION(this << newState);
+
+    UpdateEnergyConsumption();
+
+    m_sleepEvent.Cancel();
+    m_currentState = static_cast<LrWpanPhyEnumeration>(newState);
+    m_sleeping = false;
+    if (m_currentState == IEEE_802_15_4_PHY_TRX_OFF ||
+        m_currentState == IEEE_802_15_4_PHY_FORCE_TRX_OFF)
+    {
+        if (m_sleepDelay.IsZero())
+        {
+            m_sleeping = true;
+        }
+        else if (m_sleepDelay != Time::Max())
+        {
+            m_sleepEvent = Simulator::Schedule(m_sleepDelay, &LrWpanRadioEnergyModel::Sleep, this);
+        }
+    }
+    m_currentA = GetStateCurrentA();
+}
+
+void
+LrWpanRadioEnergyModel::HandleEnergyDepletion()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_DEBUG("LrWpanRadioEnergyModel: energy is depleted");
+    if (!m_energyDepletionCallback.IsNull())
+    {
+        m_energyDepletionCallback();
+    }
+}
+
+void
+LrWpanRadioEnergyModel::HandleEnergyRecharged()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_DEBUG("LrWpanRadioEnergyModel: energy is recharged");
+    if (!m_energyRechargedCallback.IsNull())
+    {
+        m_energyRechargedCallback();
+    }
+}
+
+void
+LrWpanRadioEnergyModel::HandleEnergyChanged()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+double
+LrWpanRadioEnergyModel::DoGetCurrentA() const
+{
+    return m_currentA;
+}
+
+void
+LrWpanRadioEnergyModel::TrxStateChanged(LrWpanPhyEnumeration oldState,
+                                        LrWpanPhyEnumeration newState)
+{
+    ChangeState(newState);
+}
+
+void
+LrWpanRadioEnergyModel::UpdateEnergyConsumption()
+{
+    if (!m_source)
+    {
+        m_lastUpdateTime = Simulator::Now();
+        return;
+    }
+
+    Time duration = Simulator::Now() - m_lastUpdateTime;
+    NS_ASSERT(!duration.IsStrictlyNegative());
+    m_totalEnergyConsumption += duration.GetSeconds() * m_currentA * m_source->GetSupplyVoltage();
+    m_lastUpdateTime = Simulator::Now();
+
+    // The energy source draws the current of the previous state up to now.
+    m_source->UpdateEnergySource();
+}
+
+void
+LrWpanRadioEnergyModel::Sleep()
+{
+    NS_LOG_FUNCTION(this);
+    UpdateEnergyConsumption();
+    m_sleeping = true;
+    m_currentA = GetStateCurrentA();
+}
+
+double
+LrWpanRadioEnergyModel::GetStateCurrentA()
+{
+    switch (m_currentState)
+    {
+    case IEEE_802_15_4_PHY_BUSY_TX: {
+        if (m_txCurrentsA.empty() || !m_phy)
+        {
+            return m_txCurrentA;
+        }
+        auto it = m_txCurrentsA.lower_bound(m_phy->GetNominalTxPower());
+        return (it != m_txCurrentsA.end()) ? it->second : m_txCurrentsA.rbegin()->second;
+    }
+    case IEEE_802_15_4_PHY_RX_ON:
+    case IEEE_802_15_4_PHY_BUSY_RX:
+    case IEEE_802_15_4_PHY_TX_ON:
+        return m_rxCurrentA;
+    case IEEE_802_15_4_PHY_TRX_OFF:
+    case IEEE_802_15_4_PHY_FORCE_TRX_OFF:
+        return m_sleeping ? m_sleepCurrentA : m_trxOffCurrentA;
+    default:
+        // Transient states (e.g. BUSY while switching) keep the receive current.
+        return m_rxCurrentA;
+    }
+}
+
+} // namespace ns3
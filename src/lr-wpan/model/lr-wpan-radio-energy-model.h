@@ -0,0 +1,203 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LR_WPAN_RADIO_ENERGY_MODEL_H
+#define LR_WPAN_RADIO_ENERGY_MODEL_H
+
+#include <ns3/device-energy-model.h>
+#include <ns3/event-id.h>
+#include <ns3/lr-wpan-phy.h>
+#include <ns3/nstime.h>
+#include <ns3/traced-value.h>
+
+#include <map>
+
+namespace ns3
+{
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief Energy model of a IEEE 802.15.4 transceiver.
+ *
+ * The model follows the TrxStateValue trace of a LrWpanPhy, the energy is
+ * only integrated when the transceiver state changes. The current drawn in
+ * each state is:
+ *
+ * - BUSY_TX: the transmit current, which depends on the nominal transmit
+ *   power of the PHY (see SetTxCurrentA).
+ * - RX_ON, BUSY_RX and TX_ON (the synthesizer is running): the receive current.
+ * - TRX_OFF: the TRX_OFF current (crystal oscillator running), then the sleep
+ *   current once the transceiver stayed in TRX_OFF for the SleepDelay.
+ *
+ * The default values are those of a CC2420 transceiver.
+ */
+class LrWpanRadioEnergyModel : public DeviceEnergyModel
+{
+  public:
+    /** Callback type for energy depletion handling. */
+    typedef Callback<void> LrWpanRadioEnergyDepletionCallback;
+
+    /** Callback type for energy recharged handling. */
+    typedef Callback<void> LrWpanRadioEnergyRechargedCallback;
+
+    /**
+     * Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LrWpanRadioEnergyModel();
+    ~LrWpanRadioEnergyModel() override;
+
+    // Inherited methods.
+    void SetEnergySource(Ptr<EnergySource> source) override;
+    double GetTotalEnergyConsumption() const override;
+
+    /**
+     * Follow the transceiver state of a PHY, starting from its current state.
+     * \param phy the PHY
+     */
+    void AttachPhy(Ptr<LrWpanPhy> phy);
+
+    /**
+     * \return the transmit current used when no current is set for the transmit power, in A
+     */
+    double GetTxCurrentA() const;
+
+    /**
+     * \param txCurrentA the transmit current used when no current is set for the
+     * transmit power, in A
+     */
+    void SetTxCurrentA(double txCurrentA);
+
+    /**
+     * Set the transmit current at a transmit power. The current used for a
+     * transmit power is the one set for the closest transmit power not lower
+     * than it, or the one set for the highest transmit power.
+     *
+     * \param txPower the nominal transmit power, in dBm
+     * \param txCurrentA the transmit current, in A
+     */
+    void SetTxCurrentA(int8_t txPower, double txCurrentA);
+
+    /**
+     * \return the receive current, in A
+     */
+    double GetRxCurrentA() const;
+
+    /**
+     * \param rxCurrentA the receive current, in A
+     */
+    void SetRxCurrentA(double rxCurrentA);
+
+    /**
+     * \return the TRX_OFF current, in A
+     */
+    double GetTrxOffCurrentA() const;
+
+    /**
+     * \param trxOffCurrentA the TRX_OFF current, in A
+     */
+    void SetTrxOffCurrentA(double trxOffCurrentA);
+
+    /**
+     * \return the sleep current, in A
+     */
+    double GetSleepCurrentA() const;
+
+    /**
+     * \param sleepCurrentA the sleep current, in A
+     */
+    void SetSleepCurrentA(double sleepCurrentA);
+
+    /**
+     * \return the transceiver state followed by the model
+     */
+    LrWpanPhyEnumeration GetCurrentState() const;
+
+    /**
+     * \return true if the transceiver sleeps
+     */
+    bool IsSleeping() const;
+
+    /**
+     * \param callback the callback invoked when the energy source is depleted
+     */
+    void SetEnergyDepletionCallback(LrWpanRadioEnergyDepletionCallback callback);
+
+    /**
+     * \param callback the callback invoked when the energy source is recharged
+     */
+    void SetEnergyRechargedCallback(LrWpanRadioEnergyRechargedCallback callback);
+
+    /**
+     * Change the transceiver state followed by the model.
+     * \param newState the new LrWpanPhyEnumeration state
+     */
+    void ChangeState(int newState) override;
+
+    void HandleEnergyDepletion() override;
+    void HandleEnergyRecharged() override;
+    void HandleEnergyChanged() override;
+
+  private:
+    void DoDispose() override;
+
+    double DoGetCurrentA() const override;
+
+    /**
+     * Trace sink of the transceiver state of the PHY.
+     * \param oldState the previous state
+     * \param newState the new state
+     */
+    void TrxStateChanged(LrWpanPhyEnumeration oldState, LrWpanPhyEnumeration newState);
+
+    /**
+     * Add the energy consumed since the last update and notify the energy source.
+     */
+    void UpdateEnergyConsumption();
+
+    /**
+     * Switch from the TRX_OFF state to the sleep state.
+     */
+    void Sleep();
+
+    /**
+     * Get the current drawn in the current state.
+     * \return the current, in A
+     */
+    double GetStateCurrentA();
+
+    Ptr<EnergySource> m_source;               //!< The energy source
+    Ptr<LrWpanPhy> m_phy;                     //!< The PHY whose state is followed
+    double m_txCurrentA;                      //!< The default transmit current
+    std::map<int8_t, double> m_txCurrentsA;   //!< The transmit current by transmit power
+    double m_rxCurrentA;                      //!< The receive current
+    double m_trxOffCurrentA;                  //!< The TRX_OFF current
+    double m_sleepCurrentA;                   //!< The sleep current
+    Time m_sleepDelay;                        //!< The time in TRX_OFF before sleeping
+    LrWpanPhyEnumeration m_currentState;      //!< The transceiver state
+    bool m_sleeping;                          //!< Whether the transceiver sleeps
+    double m_currentA;                        //!< The current drawn in the current state
+    Time m_lastUpdateTime;                    //!< The time of the last energy update
+    EventId m_sleepEvent;                     //!< The switch to the sleep state
+    TracedValue<double> m_totalEnergyConsumption; //!< The energy consumed, in J
+    LrWpanRadioEnergyDepletionCallback m_energyDepletionCallback; //!< Depletion callback
+    LrWpanRadioEnergyRechargedCallback m_energyRechargedCallback; //!< Recharged callback
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_RADIO_ENERGY_MODEL_H */
@@ -0,0 +1,228 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LR_WPAN_RING_BUFFER_H
+#define LR_WPAN_RING_BUFFER_H
+
+#include <ns3/assert.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief A FIFO queue of elements stored by value, bounded by a maximum size.
+ *
+ * The storage doubles when it is full, up to the maximum size, and is reused
+ * afterwards: once the queue reached its peak size, enqueuing and dequeuing
+ * elements does not allocate memory. The elements removed from the queue are
+ * reset to their default value, releasing the resources they hold.
+ */
+template <typename T>
+class LrWpanRingBuffer
+{
+  public:
+    /**
+     * Create a ring buffer.
+     * \param maxSize the maximum number of elements (not limited by default)
+     */
+    explicit LrWpanRingBuffer(uint32_t maxSize = std::numeric_limits<uint32_t>::max())
+        : m_maxSize(maxSize),
+          m_head(0),
+          m_size(0)
+    {
+    }
+
+    /**
+     * Change the maximum size of the ring buffer, keeping its elements. If the ring
+     * buffer holds more elements, no element can be added until enough are removed.
+     * \param maxSize the maximum number of elements
+     */
+    void SetMaxSize(uint32_t maxSize)
+    {
+        m_maxSize = maxSize;
+        if (m_elements.size() > maxSize && m_size <= maxSize)
+        {
+            Reallocate(maxSize);
+        }
+    }
+
+    /**
+     * \return the maximum number of elements
+     */
+    uint32_t GetMaxSize() const
+    {
+        return m_maxSize;
+    }
+
+    /**
+     * \return the number of elements
+     */
+    uint32_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * \return true if the ring buffer has no elements
+     */
+    bool IsEmpty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * \return true if the ring buffer has no room for another element
+     */
+    bool IsFull() const
+    {
+        return m_size >= m_maxSize;
+    }
+
+    /**
+     * \param i the position of the element, 0 being the oldest one
+     * \return the element
+     */
+    T& operator[](uint32_t i)
+    {
+        NS_ASSERT_MSG(i < m_size, "Ring buffer index out of range");
+        return m_elements[(m_head + i) % m_elements.size()];
+    }
+
+    /**
+     * \param i the position of the element, 0 being the oldest one
+     * \return the element
+     */
+    const T& operator[](uint32_t i) const
+    {
+        NS_ASSERT_MSG(i < m_size, "Ring buffer index out of range");
+        return m_elements[(m_head + i) % m_elements.size()];
+    }
+
+    /**
+     * \return the oldest element
+     */
+    T& Front()
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * \return the oldest element
+     */
+    const T& Front() const
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * Add an element after the newest one. The ring buffer must not be full.
+     * \param element the element
+     */
+    void PushBack(T element)
+    {
+        NS_ASSERT_MSG(!IsFull(), "The ring buffer is full");
+        if (m_size == m_elements.size())
+        {
+            Reallocate(std::min<uint64_t>(std::max<uint64_t>(2 * m_elements.size(), 4), m_maxSize));
+        }
+        m_elements[(m_head + m_size) % m_elements.size()] = std::move(element);
+        m_size++;
+    }
+
+    /**
+     * Remove the oldest element.
+     */
+    void PopFront()
+    {
+        NS_ASSERT_MSG(!IsEmpty(), "The ring buffer is empty");
+        m_elements[m_head] = T();
+        m_head = (m_head + 1) % m_elements.size();
+        m_size--;
+    }
+
+    /**
+     * Remove an element, the newer elements move one position towards the front.
+     * \param i the position of the element, 0 being the oldest one
+     */
+    void Erase(uint32_t i)
+    {
+        NS_ASSERT_MSG(i < m_size, "Ring buffer index out of range");
+        for (; i + 1 < m_size; i++)
+        {
+            (*this)[i] = std::move((*this)[i + 1]);
+        }
+        (*this)[m_size - 1] = T();
+        m_size--;
+    }
+
+    /**
+     * Move an element to the front, the older elements move one position towards the back.
+     * \param i the position of the element, 0 being the oldest one
+     */
+    void MoveToFront(uint32_t i)
+    {
+        NS_ASSERT_MSG(i < m_size, "Ring buffer index out of range");
+        T element = std::move((*this)[i]);
+        for (; i > 0; i--)
+        {
+            (*this)[i] = std::move((*this)[i - 1]);
+        }
+        (*this)[0] = std::move(element);
+    }
+
+    /**
+     * Remove all the elements.
+     */
+    void Clear()
+    {
+        while (!IsEmpty())
+        {
+            PopFront();
+        }
+        m_head = 0;
+    }
+
+  private:
+    /**
+     * Move the elements to a new storage, the oldest element first.
+     * \param capacity the number of elements of the new storage
+     */
+    void Reallocate(uint32_t capacity)
+    {
+        std::vector<T> elements(capacity);
+        for (uint32_t i = 0; i < m_size; i++)
+        {
+            elements[i] = std::move((*this)[i]);
+        }
+        m_elements.swap(elements);
+        m_head = 0;
+    }
+
+    std::vector<T> m_elements; //!< The storage of the elements
+    uint32_t m_maxSize;        //!< The maximum number of elements
+    uint32_t m_head;           //!< The position of the oldest element in the storage
+    uint32_t m_size;           //!< The number of elements
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_RING_BUFFER_H */
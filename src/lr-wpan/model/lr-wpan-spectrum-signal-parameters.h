@@ -43,6 +43,10 @@ struct LrWpanSpectrumSignalParameters : public SpectrumSignalParameters
 
     /**
      * copy constructor
+     *
+     * The packet burst is shared with the original object, a receiver
+     * has to copy it before modifying the packets.
+     *
      * \param p the object to copy from.
      */
     LrWpanSpectrumSignalParameters(const LrWpanSpectrumSignalParameters& p);
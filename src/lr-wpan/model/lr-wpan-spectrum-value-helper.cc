@@ -21,7 +21,9 @@
 #include <ns3/log.h>
 #include <ns3/spectrum-value.h>
 
+#include <algorithm>
 #include <cmath>
+#include <map>
 
 namespace ns3
 {
@@ -103,6 +105,25 @@ LrWpanSpectrumValueHelper::CreateTxPowerSpectralDensity(double txPower, uint32_t
     return txPsd;
 }
 
+Ptr<const SpectrumValue>
+LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(double txPower, uint32_t channel)
+{
+    NS_LOG_FUNCTION(txPower << channel);
+
+    // The transmit power is set from the PIB in steps of 1 dB, so only a few
+    // PSDs are ever created.
+    static std::map<std::pair<double, uint32_t>, Ptr<const SpectrumValue>> txPsdCache;
+
+    auto it = txPsdCache.find(std::make_pair(txPower, channel));
+    if (it == txPsdCache.end())
+    {
+        LrWpanSpectrumValueHelper psdHelper;
+        Ptr<const SpectrumValue> txPsd = psdHelper.CreateTxPowerSpectralDensity(txPower, channel);
+        it = txPsdCache.emplace(std::make_pair(txPower, channel), txPsd).first;
+    }
+    return it->second;
+}
+
 Ptr<SpectrumValue>
 LrWpanSpectrumValueHelper::CreateNoisePowerSpectralDensity(uint32_t channel)
 {
@@ -134,13 +155,15 @@ LrWpanSpectrumValueHelper::TotalAvgPower(Ptr<const SpectrumValue> psd, uint32_t
 
     NS_ASSERT(psd->GetSpectrumModel() == g_LrWpanSpectrumModel);
 
-    // numerically integrate to get area under psd using 1 MHz resolution
-
-    totalAvgPower += (*psd)[2405 + 5 * (channel - 11) - 2400 - 2];
-    totalAvgPower += (*psd)[2405 + 5 * (channel - 11) - 2400 - 1];
-    totalAvgPower += (*psd)[2405 + 5 * (channel - 11) - 2400];
-    totalAvgPower += (*psd)[2405 + 5 * (channel - 11) - 2400 + 1];
-    totalAvgPower += (*psd)[2405 + 5 * (channel - 11) - 2400 + 2];
+    // numerically integrate to get area under psd using 1 MHz resolution.
+    // Only the bands of the channel which are active in the psd can hold power.
+    size_t center = 2405 + 5 * (channel - 11) - 2400;
+    size_t begin = std::max<size_t>(center - 2, psd->GetActiveBandsBegin());
+    size_t end = std::min<size_t>(center + 3, psd->GetActiveBandsEnd());
+    for (size_t i = begin; i < end; i++)
+    {
+        totalAvgPower += (*psd)[i];
+    }
     totalAvgPower *= 1.0e6;
 
     return totalAvgPower;
@@ -39,12 +39,31 @@ class LrWpanSpectrumValueHelper
 
     /**
      * \brief create spectrum value
+     *
+     * Only the 5 bands around the center frequency of the channel are active
+     * in the returned SpectrumValue, so that the spectrum arithmetic on it
+     * does not process the rest of the 2.4 GHz band.
+     *
      * \param txPower the power transmission in dBm
      * \param channel the channel number per IEEE802.15.4
      * \return a Ptr to a newly created SpectrumValue instance
      */
     Ptr<SpectrumValue> CreateTxPowerSpectralDensity(double txPower, uint32_t channel);
 
+    /**
+     * \brief get a shared transmit power spectral density
+     *
+     * The PSDs are created once for each transmit power and channel, and
+     * the same instance is returned to all the callers using these values.
+     * The returned instance must not be modified.
+     *
+     * \param txPower the power transmission in dBm
+     * \param channel the channel number per IEEE802.15.4
+     * \return a Ptr to the shared SpectrumValue instance
+     */
+    static Ptr<const SpectrumValue> GetSharedTxPowerSpectralDensity(double txPower,
+                                                                   uint32_t channel);
+
     /**
      * \brief create spectrum value for noise
      * \param channel the channel number per IEEE802.15.4
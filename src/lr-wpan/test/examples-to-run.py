@@ -11,6 +11,7 @@ cpp_examples = [
     ("lr-wpan-data", "True", "True"),
     ("lr-wpan-error-distance-plot", "True", "True"),
     ("lr-wpan-error-model-plot", "True", "True"),
+    ("lr-wpan-fcs-benchmark --frames=1000", "True", "True"),
     ("lr-wpan-packet-print", "True", "True"),
     ("lr-wpan-phy-test", "True", "True"),
 ]
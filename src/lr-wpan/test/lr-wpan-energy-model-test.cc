@@ -0,0 +1,258 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <ns3/basic-energy-source.h>
+#include <ns3/basic-energy-source-helper.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/node-container.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-energy-model-test");
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the energy consumed in the transceiver states
+ */
+class LrWpanEnergyModelStatesTestCase : public TestCase
+{
+  public:
+    LrWpanEnergyModelStatesTestCase();
+    ~LrWpanEnergyModelStatesTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record whether the transceiver sleeps.
+     * \param index the index of the record
+     */
+    void RecordSleeping(uint32_t index);
+
+    /**
+     * Record the current drawn by the transceiver.
+     */
+    void RecordTxCurrent();
+
+    Ptr<LrWpanRadioEnergyModel> m_model; //!< The energy model under test
+    bool m_sleeping[2];                  //!< The recorded sleep states
+    double m_txCurrentA;                 //!< The recorded current during BUSY_TX
+};
+
+LrWpanEnergyModelStatesTestCase::LrWpanEnergyModelStatesTestCase()
+    : TestCase("Energy consumed in the transceiver states"),
+      m_sleeping{true, false},
+      m_txCurrentA(0)
+{
+}
+
+LrWpanEnergyModelStatesTestCase::~LrWpanEnergyModelStatesTestCase()
+{
+}
+
+void
+LrWpanEnergyModelStatesTestCase::RecordSleeping(uint32_t index)
+{
+    m_sleeping[index] = m_model->IsSleeping();
+}
+
+void
+LrWpanEnergyModelStatesTestCase::RecordTxCurrent()
+{
+    m_txCurrentA = m_model->GetCurrentA();
+}
+
+void
+LrWpanEnergyModelStatesTestCase::DoRun()
+{
+    // Test Setup:
+    //
+    // A single PHY, driven through the PLME, follows the state sequence
+    //
+    //  0 s      1 s      2 s      3 s
+    //  |TRX_OFF |RX_ON   |TRX_OFF |
+    //
+    // The transceiver sleeps after 0.5 s in TRX_OFF. At 3.5 s, a frame is
+    // sent at -7 dBm.
+
+    Ptr<LrWpanPhy> phy = CreateObject<LrWpanPhy>();
+    phy->SetChannel(CreateObject<SingleModelSpectrumChannel>());
+    phy->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+
+    Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource>();
+    source->SetSupplyVoltage(3.0);
+
+    m_model = CreateObject<LrWpanRadioEnergyModel>();
+    m_model->SetAttribute("SleepDelay", TimeValue(Seconds(0.5)));
+    m_model->SetTxCurrentA(0, 0.0174);
+    m_model->SetTxCurrentA(-5, 0.0139);
+    m_model->SetTxCurrentA(-10, 0.0112);
+    source->AppendDeviceEnergyModel(m_model);
+    m_model->SetEnergySource(source);
+    m_model->AttachPhy(phy);
+
+    Simulator::Schedule(Seconds(1.0),
+                        &LrWpanPhy::PlmeSetTRXStateRequest,
+                        phy,
+                        IEEE_802_15_4_PHY_RX_ON);
+    Simulator::Schedule(Seconds(2.0),
+                        &LrWpanPhy::PlmeSetTRXStateRequest,
+                        phy,
+                        IEEE_802_15_4_PHY_TRX_OFF);
+    Simulator::Schedule(Seconds(2.25), &LrWpanEnergyModelStatesTestCase::RecordSleeping, this, 0);
+    Simulator::Schedule(Seconds(2.75), &LrWpanEnergyModelStatesTestCase::RecordSleeping, this, 1);
+    Simulator::Stop(Seconds(3.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_sleeping[0], false, "The transceiver sleeps before the sleep delay");
+    NS_TEST_EXPECT_MSG_EQ(m_sleeping[1], true, "The transceiver does not sleep");
+
+    // 1 s in TRX_OFF, half of it asleep, twice, and 1 s in RX_ON (within the
+    // 192 us turnaround time).
+    double expected = 3.0 * (2 * (0.5 * 0.000426 + 0.5 * 0.00002) + 0.0188);
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_model->GetTotalEnergyConsumption(),
+                              expected,
+                              2e-5,
+                              "Wrong energy consumption");
+    NS_TEST_EXPECT_MSG_EQ_TOL(source->GetInitialEnergy() - source->GetRemainingEnergy(),
+                              expected,
+                              2e-5,
+                              "Wrong energy drawn from the energy source");
+
+    // Transmit at -7 dBm (6-bit two's complement), the current of the closest
+    // higher tabulated power (-5 dBm) is used.
+    LrWpanPhyPibAttributes pib;
+    pib.phyTransmitPower = static_cast<uint8_t>(-7) & 0x3F;
+    phy->PlmeSetAttributeRequest(phyTransmitPower, &pib);
+    phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+    Simulator::Schedule(Seconds(0.5), &LrWpanPhy::PdDataRequest, phy, 20, Create<Packet>(20));
+    Simulator::Schedule(Seconds(0.5) + MicroSeconds(100),
+                        &LrWpanEnergyModelStatesTestCase::RecordTxCurrent,
+                        this);
+    Simulator::Stop(Seconds(1.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_txCurrentA, 0.0139, 1e-9, "Wrong transmit current");
+
+    // A model attached to a PHY which is already on starts in the state of the PHY.
+    Ptr<LrWpanRadioEnergyModel> model = CreateObject<LrWpanRadioEnergyModel>();
+    model->AttachPhy(phy);
+    NS_TEST_EXPECT_MSG_EQ(model->GetCurrentState(),
+                          IEEE_802_15_4_PHY_TX_ON,
+                          "The energy model does not start in the state of the PHY");
+
+    m_model = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the installation of the energy model on a network
+ */
+class LrWpanEnergyModelHelperTestCase : public TestCase
+{
+  public:
+    LrWpanEnergyModelHelperTestCase();
+    ~LrWpanEnergyModelHelperTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+LrWpanEnergyModelHelperTestCase::LrWpanEnergyModelHelperTestCase()
+    : TestCase("Install the energy model on a network")
+{
+}
+
+LrWpanEnergyModelHelperTestCase::~LrWpanEnergyModelHelperTestCase()
+{
+}
+
+void
+LrWpanEnergyModelHelperTestCase::DoRun()
+{
+    // Test Setup:
+    //
+    // Three idle devices, each with an energy source. The MAC switches the
+    // transceiver to RX_ON when the devices are initialized.
+
+    NodeContainer nodes;
+    nodes.Create(3);
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer devices = lrWpanHelper.Install(nodes);
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        nodes.Get(i)->AggregateObject(CreateObject<ConstantPositionMobilityModel>());
+    }
+
+    BasicEnergySourceHelper sourceHelper;
+    sourceHelper.Set("BasicEnergySupplyVoltageV", DoubleValue(3.0));
+    EnergySourceContainer sources = sourceHelper.Install(nodes);
+
+    LrWpanRadioEnergyModelHelper radioHelper;
+    radioHelper.Set("RxCurrentA", DoubleValue(0.02));
+    DeviceEnergyModelContainer models = radioHelper.Install(devices, sources);
+    NS_TEST_ASSERT_MSG_EQ(models.GetN(), 3, "Wrong number of energy models");
+
+    Simulator::Stop(Seconds(1.0));
+    Simulator::Run();
+
+    for (uint32_t i = 0; i < models.GetN(); i++)
+    {
+        Ptr<LrWpanRadioEnergyModel> model = DynamicCast<LrWpanRadioEnergyModel>(models.Get(i));
+        NS_TEST_ASSERT_MSG_NE(model, nullptr, "Wrong energy model type");
+        NS_TEST_EXPECT_MSG_EQ(model->GetCurrentState(),
+                              IEEE_802_15_4_PHY_RX_ON,
+                              "The energy model does not follow the PHY");
+        NS_TEST_EXPECT_MSG_EQ_TOL(model->GetTotalEnergyConsumption(),
+                                  3.0 * 0.02,
+                                  2e-5,
+                                  "Wrong energy consumption");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan radio energy model TestSuite
+ */
+class LrWpanEnergyModelTestSuite : public TestSuite
+{
+  public:
+    LrWpanEnergyModelTestSuite();
+};
+
+LrWpanEnergyModelTestSuite::LrWpanEnergyModelTestSuite()
+    : TestSuite("lr-wpan-energy-model", UNIT)
+{
+    AddTestCase(new LrWpanEnergyModelStatesTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanEnergyModelHelperTestCase, TestCase::QUICK);
+}
+
+static LrWpanEnergyModelTestSuite
+    g_lrWpanEnergyModelTestSuite; //!< Static variable for test initialization
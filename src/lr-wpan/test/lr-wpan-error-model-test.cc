@@ -17,6 +17,7 @@
  * Author: Tom Henderson <thomas.r.henderson@boeing.com>
  */
 #include "ns3/rng-seed-manager.h"
+#include <ns3/boolean.h>
 #include <ns3/callback.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/log.h>
@@ -85,6 +86,22 @@ class LrWpanErrorModelTestCase : public TestCase
     void DoRun() override;
 };
 
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan Tabulated Error model Test
+ */
+class LrWpanTabulatedErrorModelTestCase : public TestCase
+{
+  public:
+    LrWpanTabulatedErrorModelTestCase();
+    ~LrWpanTabulatedErrorModelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
 LrWpanErrorDistanceTestCase::LrWpanErrorDistanceTestCase()
     : TestCase("Test the 802.15.4 error model vs distance"),
       m_received(0)
@@ -194,6 +211,51 @@ LrWpanErrorModelTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ_TOL(ber, 0.175, 0.001, "Model fails for SNR = " << snr);
 }
 
+// ==============================================================================
+LrWpanTabulatedErrorModelTestCase::LrWpanTabulatedErrorModelTestCase()
+    : TestCase("Test the 802.15.4 tabulated error model against the closed form")
+{
+}
+
+LrWpanTabulatedErrorModelTestCase::~LrWpanTabulatedErrorModelTestCase()
+{
+}
+
+void
+LrWpanTabulatedErrorModelTestCase::DoRun()
+{
+    Ptr<LrWpanErrorModel> model = CreateObject<LrWpanErrorModel>();
+    Ptr<LrWpanErrorModel> tabModel = CreateObject<LrWpanErrorModel>();
+    tabModel->SetAttribute("Tabulated", BooleanValue(true));
+
+    // Sweep the SNR with a step that does not fall on the table grid, both inside
+    // and outside the tabulated range. The BER must stay within 1% of the closed form.
+    for (double snr = -15.0; snr <= 9.0; snr += 0.037)
+    {
+        double snrRatio = pow(10.0, snr / 10.0);
+        double ber = 1.0 - model->GetChunkSuccessRate(snrRatio, 1);
+        double tabBer = 1.0 - tabModel->GetChunkSuccessRate(snrRatio, 1);
+        if (ber > 1e-12)
+        {
+            NS_TEST_ASSERT_MSG_EQ_TOL(tabBer / ber, 1.0, 0.01, "BER fails for SNR = " << snr);
+        }
+        else
+        {
+            // 1.0 - (1.0 - ber) loses the relative precision, compare the absolute values.
+            NS_TEST_ASSERT_MSG_EQ_TOL(tabBer, ber, 1e-14, "BER fails for SNR = " << snr);
+        }
+
+        double psr = model->GetChunkSuccessRate(snrRatio, 8 * 127);
+        double tabPsr = tabModel->GetChunkSuccessRate(snrRatio, 8 * 127);
+        NS_TEST_ASSERT_MSG_EQ_TOL(tabPsr, psr, 0.01 * psr + 1e-12, "PSR fails for SNR = " << snr);
+    }
+
+    // Above the table the BER is negligible.
+    NS_TEST_ASSERT_MSG_EQ(tabModel->GetChunkSuccessRate(pow(10.0, 1.2), 8 * 127),
+                          1.0,
+                          "PSR fails above the tabulated range");
+}
+
 /**
  * \ingroup lr-wpan-test
  * \ingroup tests
@@ -210,6 +272,7 @@ LrWpanErrorModelTestSuite::LrWpanErrorModelTestSuite()
     : TestSuite("lr-wpan-error-model", UNIT)
 {
     AddTestCase(new LrWpanErrorModelTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanTabulatedErrorModelTestCase, TestCase::QUICK);
     AddTestCase(new LrWpanErrorDistanceTestCase, TestCase::QUICK);
 }
 
@@ -0,0 +1,2591 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-lldn-test");
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the transmission of uplink frames in the LLDN Online state timeslots.
+ */
+class TestLldnOnlineTimeslots : public TestCase
+{
+  public:
+    TestLldnOnlineTimeslots();
+    ~TestLldnOnlineTimeslots() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+    /**
+     * Function called when a LL beacon is transmitted by the PAN-C.
+     * \param p packet
+     */
+    void PanCTx(Ptr<const Packet> p);
+    /**
+     * Function called when a LLDN device enters the Online state.
+     * \param params MLME-LLDN-ONLINE.indication parameters
+     */
+    void OnlineIndication(MlmeLLDNOnlineIndicationParams params);
+    /**
+     * Function called when the MAC state of a LLDN device changes.
+     * \param oldValue the previous MAC state
+     * \param newValue the new MAC state
+     */
+    void DeviceMacState(LrWpanMacState oldValue, LrWpanMacState newValue);
+
+    void DoRun() override;
+
+    std::map<uint16_t, Time> m_rxTime; //!< Reception time of each uplink frame (by source)
+    Time m_firstBeaconTxTime;          //!< Start of the first LL beacon transmission
+    uint32_t m_onlineIndications;      //!< Number of MLME-LLDN-ONLINE.indications
+    bool m_csmaUsed;                   //!< True if any LLDN device entered the CSMA state
+};
+
+TestLldnOnlineTimeslots::TestLldnOnlineTimeslots()
+    : TestCase("Test the LLDN Online state superframe timeslots"),
+      m_onlineIndications(0),
+      m_csmaUsed(false)
+{
+}
+
+TestLldnOnlineTimeslots::~TestLldnOnlineTimeslots()
+{
+}
+
+void
+TestLldnOnlineTimeslots::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    NS_LOG_DEBUG(Simulator::Now().As(Time::S) << " PAN-C received packet of size " << p->GetSize()
+                                              << " from " << params.m_srcAddr);
+    uint8_t buf[2];
+    params.m_srcAddr.CopyTo(buf);
+    uint16_t src = (buf[0] << 8) | buf[1];
+    if (m_rxTime.find(src) == m_rxTime.end())
+    {
+        m_rxTime[src] = Simulator::Now();
+    }
+}
+
+void
+TestLldnOnlineTimeslots::PanCTx(Ptr<const Packet> p)
+{
+    if (m_firstBeaconTxTime.IsZero())
+    {
+        m_firstBeaconTxTime = Simulator::Now();
+    }
+}
+
+void
+TestLldnOnlineTimeslots::OnlineIndication(MlmeLLDNOnlineIndicationParams params)
+{
+    m_onlineIndications++;
+}
+
+void
+TestLldnOnlineTimeslots::DeviceMacState(LrWpanMacState oldValue, LrWpanMacState newValue)
+{
+    if (newValue == MAC_CSMA)
+    {
+        m_csmaUsed = true;
+    }
+}
+
+void
+TestLldnOnlineTimeslots::DoRun()
+{
+    //  [00:01]                [00:02]         [00:03]
+    //   PAN-C <---------------- Dev1            Dev2
+    //     ^------------------------------------|
+    //
+    // Test Setup:
+    //
+    // Both LLDN devices enqueue a data frame before the PAN-C switches to the
+    // Online state. Dev1 is assigned to the base timeslot 0 and Dev2 to the base
+    // timeslot 3. After the first LL beacon, each device must transmit its frame in
+    // its own timeslot without using CSMA-CA. The test checks that the frames are
+    // received inside their timeslots, which are exactly 3 base timeslots apart.
+
+    // Create 3 nodes, and a NetDevice for each one
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<Node> n1 = CreateObject<Node>();
+    Ptr<Node> n2 = CreateObject<Node>();
+
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> dev1 = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> dev2 = CreateObject<LrWpanNetDevice>();
+
+    panC->SetAddress(Mac16Address("00:01"));
+    dev1->SetAddress(Mac16Address("00:02"));
+    dev2->SetAddress(Mac16Address("00:03"));
+    panC->SetAddress(Mac8Address(1));
+    dev1->SetAddress(Mac8Address(2));
+    dev2->SetAddress(Mac8Address(3));
+
+    // Each device must be attached to the same channel
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    panC->SetChannel(channel);
+    dev1->SetChannel(channel);
+    dev2->SetChannel(channel);
+
+    panCNode->AddDevice(panC);
+    n1->AddDevice(dev1);
+    n2->AddDevice(dev2);
+
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    Ptr<ConstantPositionMobilityModel> dev1Mobility = CreateObject<ConstantPositionMobilityModel>();
+    dev1Mobility->SetPosition(Vector(5, 0, 0));
+    dev1->GetPhy()->SetMobility(dev1Mobility);
+
+    Ptr<ConstantPositionMobilityModel> dev2Mobility = CreateObject<ConstantPositionMobilityModel>();
+    dev2Mobility->SetPosition(Vector(0, 5, 0));
+    dev2->GetPhy()->SetMobility(dev2Mobility);
+
+    // MAC layer Callbacks hooks
+    McpsDataIndicationCallback cb0;
+    cb0 = MakeCallback(&TestLldnOnlineTimeslots::DataIndicationPanC, this);
+    panC->GetMac()->SetMcpsDataIndicationCallback(cb0);
+
+    MlmeLLDNOnlineIndicationCallback cb1;
+    cb1 = MakeCallback(&TestLldnOnlineTimeslots::OnlineIndication, this);
+    dev1->GetMac()->SetMlmeLLDNOnlineIndicationCallback(cb1);
+    dev2->GetMac()->SetMlmeLLDNOnlineIndicationCallback(cb1);
+
+    panC->GetMac()->TraceConnectWithoutContext(
+        "MacTx",
+        MakeCallback(&TestLldnOnlineTimeslots::PanCTx, this));
+    dev1->GetMac()->TraceConnectWithoutContext(
+        "MacStateValue",
+        MakeCallback(&TestLldnOnlineTimeslots::DeviceMacState, this));
+    dev2->GetMac()->TraceConnectWithoutContext(
+        "MacStateValue",
+        MakeCallback(&TestLldnOnlineTimeslots::DeviceMacState, this));
+
+    // LLDN PAN-C: 10 uplink base timeslots, no management timeslots.
+    Ptr<LrWpanMac> panCMac = panC->GetMac();
+    panCMac->SetPanId(5);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetAssociatedCoor(Mac8Address(1));
+    panCMac->SetMacLLDNNumTimeSlots(10);
+    panCMac->SetMacLLDNnumUplinkTS(10);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+    panCMac->SetMlmeLLDNTimeslotSize(40);
+
+    dev1->GetMac()->SetPanId(5);
+    dev1->GetMac()->SetLLDNModeEnabled();
+    dev1->GetMac()->SetMacLLDNnumUplinkTS(10);
+    dev1->GetMac()->SetMacLLDNassignedTimeSlot(0);
+
+    dev2->GetMac()->SetPanId(5);
+    dev2->GetMac()->SetLLDNModeEnabled();
+    dev2->GetMac()->SetMacLLDNnumUplinkTS(10);
+    dev2->GetMac()->SetMacLLDNassignedTimeSlot(3);
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = 5;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = 0;
+
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   dev1->GetMac(),
+                                   params,
+                                   Create<Packet>(20));
+    Simulator::ScheduleWithContext(2,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   dev2->GetMac(),
+                                   params,
+                                   Create<Packet>(20));
+
+    MlmeLLDNOnlineRequestParams onlineParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeLLDNOnlineRequest,
+                                   panCMac,
+                                   onlineParams);
+
+    Simulator::Stop(Seconds(2.0));
+    NS_LOG_DEBUG("----------- Start of TestLldnOnlineTimeslots -------------------");
+    Simulator::Run();
+
+    double symbolRate = panC->GetPhy()->GetDataOrSymbolRate(false);
+    Time timeslot =
+        Seconds(static_cast<double>(panCMac->GetLLDNBaseTimeslotSymbols()) / symbolRate);
+
+    NS_TEST_EXPECT_MSG_EQ(m_onlineIndications, 2, "Error, devices did not enter the Online state");
+    NS_TEST_EXPECT_MSG_EQ(m_csmaUsed, false, "Error, LLDN devices must not use CSMA-CA");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTime.size(), 2, "Error, uplink frames not received by the PAN-C");
+
+    // Base timeslot 0 starts after the beacon timeslot
+    NS_TEST_EXPECT_MSG_GT(m_rxTime[2],
+                          m_firstBeaconTxTime + timeslot,
+                          "Error, Dev1 frame too early");
+    NS_TEST_EXPECT_MSG_LT(m_rxTime[2],
+                          m_firstBeaconTxTime + 2 * timeslot,
+                          "Error, Dev1 frame received outside of its timeslot");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTime[3] - m_rxTime[2],
+                          3 * timeslot,
+                          "Error, Dev2 frame not received 3 timeslots after Dev1 frame");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the group acknowledgement of the LLDN uplink frames and the use of
+ * the retransmission timeslots.
+ */
+class TestLldnGroupAck : public TestCase
+{
+  public:
+    TestLldnGroupAck();
+    ~TestLldnGroupAck() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+    /**
+     * Function called when a Data confirm is invoked in the LLDN device.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirmDev(McpsDataConfirmParams params);
+    /**
+     * Function called when a frame is transmitted by the PAN-C.
+     * \param p packet
+     */
+    void PanCTx(Ptr<const Packet> p);
+    /**
+     * Function called when the LLDN device enters the Online state.
+     * \param params MLME-LLDN-ONLINE.indication parameters
+     */
+    void OnlineIndication(MlmeLLDNOnlineIndicationParams params);
+
+    void DoRun() override;
+
+    Ptr<LrWpanNetDevice> m_dev;      //!< The LLDN device
+    Time m_timeslot;                 //!< The duration of a base timeslot
+    Time m_lastBeaconTxTime;         //!< Start of the last LL beacon transmission
+    uint32_t m_panCTxCount;          //!< Number of frames sent by the PAN-C
+    std::vector<Time> m_rxOffset;    //!< Reception time of the uplink frames (from the beacon)
+    std::vector<LrWpanMcpsDataConfirmStatus> m_confirmStatus; //!< Data confirm status
+};
+
+TestLldnGroupAck::TestLldnGroupAck()
+    : TestCase("Test the LLDN group acknowledgement and retransmission timeslots"),
+      m_panCTxCount(0)
+{
+}
+
+TestLldnGroupAck::~TestLldnGroupAck()
+{
+}
+
+void
+TestLldnGroupAck::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_rxOffset.push_back(Simulator::Now() - m_lastBeaconTxTime);
+}
+
+void
+TestLldnGroupAck::DataConfirmDev(McpsDataConfirmParams params)
+{
+    NS_LOG_DEBUG(Simulator::Now().As(Time::S) << " Dev data confirm status " << params.m_status);
+    m_confirmStatus.push_back(params.m_status);
+}
+
+void
+TestLldnGroupAck::PanCTx(Ptr<const Packet> p)
+{
+    m_panCTxCount++;
+    m_lastBeaconTxTime = Simulator::Now();
+}
+
+void
+TestLldnGroupAck::OnlineIndication(MlmeLLDNOnlineIndicationParams params)
+{
+    // Move the device out of range during its first uplink timeslot, the
+    // PAN-C does not receive the frame and does not acknowledge it.
+    Ptr<MobilityModel> mobility = m_dev->GetPhy()->GetMobility();
+    mobility->SetPosition(Vector(1e6, 0, 0));
+    Simulator::Schedule(8 * m_timeslot, &MobilityModel::SetPosition, mobility, Vector(5, 0, 0));
+}
+
+void
+TestLldnGroupAck::DoRun()
+{
+    //  [00:01]                [00:02]
+    //   PAN-C <---------------- Dev
+    //
+    // Test Setup:
+    //
+    // The superframe has 10 base timeslots, the first 2 of them are retransmission
+    // timeslots. The device is assigned to the base timeslot 3 (its retransmission
+    // timeslot is the base timeslot 1) and sends a frame with the ACK request bit set.
+    // The device is out of range during its first uplink timeslot. The next LL beacon
+    // does not acknowledge the frame and the device retransmits it in its retransmission
+    // timeslot. The following LL beacon acknowledges the frame. No ACK frames are sent.
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<Node> devNode = CreateObject<Node>();
+
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    m_dev = CreateObject<LrWpanNetDevice>();
+
+    panC->SetAddress(Mac16Address("00:01"));
+    m_dev->SetAddress(Mac16Address("00:02"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    panC->SetChannel(channel);
+    m_dev->SetChannel(channel);
+
+    panCNode->AddDevice(panC);
+    devNode->AddDevice(m_dev);
+
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    Ptr<ConstantPositionMobilityModel> devMobility = CreateObject<ConstantPositionMobilityModel>();
+    devMobility->SetPosition(Vector(5, 0, 0));
+    m_dev->GetPhy()->SetMobility(devMobility);
+
+    McpsDataIndicationCallback cb0;
+    cb0 = MakeCallback(&TestLldnGroupAck::DataIndicationPanC, this);
+    panC->GetMac()->SetMcpsDataIndicationCallback(cb0);
+
+    McpsDataConfirmCallback cb1;
+    cb1 = MakeCallback(&TestLldnGroupAck::DataConfirmDev, this);
+    m_dev->GetMac()->SetMcpsDataConfirmCallback(cb1);
+
+    MlmeLLDNOnlineIndicationCallback cb2;
+    cb2 = MakeCallback(&TestLldnGroupAck::OnlineIndication, this);
+    m_dev->GetMac()->SetMlmeLLDNOnlineIndicationCallback(cb2);
+
+    panC->GetMac()->TraceConnectWithoutContext("MacTx",
+                                               MakeCallback(&TestLldnGroupAck::PanCTx, this));
+
+    Ptr<LrWpanMac> panCMac = panC->GetMac();
+    panCMac->SetPanId(5);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetMacLLDNNumTimeSlots(10);
+    panCMac->SetMacLLDNnumReTransmitTS(2);
+    panCMac->SetMacLLDNnumUplinkTS(10);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+
+    Ptr<LrWpanMac> devMac = m_dev->GetMac();
+    devMac->SetPanId(5);
+    devMac->SetLLDNModeEnabled();
+    devMac->SetMacLLDNnumReTransmitTS(2);
+    devMac->SetMacLLDNnumUplinkTS(10);
+    devMac->SetMacLLDNassignedTimeSlot(3);
+
+    double symbolRate = panC->GetPhy()->GetDataOrSymbolRate(false);
+    m_timeslot = Seconds(static_cast<double>(panCMac->GetLLDNBaseTimeslotSymbols()) / symbolRate);
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = 5;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = 0;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   devMac,
+                                   params,
+                                   Create<Packet>(20));
+
+    MlmeLLDNOnlineRequestParams onlineParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeLLDNOnlineRequest,
+                                   panCMac,
+                                   onlineParams);
+
+    // Stop after the 3rd LL beacon
+    Simulator::Stop(Seconds(1.0) + 25 * m_timeslot);
+    NS_LOG_DEBUG("----------- Start of TestLldnGroupAck -------------------");
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxOffset.size(), 1, "Error, the frame must be received once");
+    // The retransmission timeslot 1 starts 2 timeslots after the beacon (beacon + base timeslot 0)
+    NS_TEST_EXPECT_MSG_GT(m_rxOffset[0],
+                          2 * m_timeslot,
+                          "Error, frame not received in the retransmission timeslot");
+    NS_TEST_EXPECT_MSG_LT(m_rxOffset[0],
+                          3 * m_timeslot,
+                          "Error, frame not received in the retransmission timeslot");
+    NS_TEST_ASSERT_MSG_EQ(m_confirmStatus.size(), 1, "Error, missing data confirm");
+    NS_TEST_EXPECT_MSG_EQ(m_confirmStatus[0],
+                          IEEE_802_15_4_SUCCESS,
+                          "Error, frame not acknowledged in the group acknowledgement");
+    NS_TEST_EXPECT_MSG_EQ(m_panCTxCount, 3, "Error, the PAN-C must only send LL beacons");
+
+    m_dev = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the group acknowledgement of a frame sent after the 16th base timeslot.
+ */
+class TestLldnLongGroupAck : public TestCase
+{
+  public:
+    TestLldnLongGroupAck();
+    ~TestLldnLongGroupAck() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+    /**
+     * Function called when a Data confirm is invoked in the LLDN device.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirmDev(McpsDataConfirmParams params);
+    /**
+     * Function called when the LLDN device enters the Online state.
+     * \param params MLME-LLDN-ONLINE.indication parameters
+     */
+    void OnlineIndication(MlmeLLDNOnlineIndicationParams params);
+
+    void DoRun() override;
+
+    Ptr<LrWpanNetDevice> m_dev;   //!< The LLDN device
+    Time m_timeslot;              //!< The duration of a base timeslot
+    std::vector<Time> m_rxTime;   //!< Reception time of the uplink frames in the PAN-C
+    std::vector<Time> m_confirmTime; //!< Time of the data confirms in the LLDN device
+    std::vector<LrWpanMcpsDataConfirmStatus> m_confirmStatus; //!< Data confirm status
+};
+
+TestLldnLongGroupAck::TestLldnLongGroupAck()
+    : TestCase("Test the LLDN group acknowledgement of a frame sent after the 16th timeslot")
+{
+}
+
+TestLldnLongGroupAck::~TestLldnLongGroupAck()
+{
+}
+
+void
+TestLldnLongGroupAck::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_rxTime.push_back(Simulator::Now());
+}
+
+void
+TestLldnLongGroupAck::DataConfirmDev(McpsDataConfirmParams params)
+{
+    NS_LOG_DEBUG(Simulator::Now().As(Time::S) << " Dev data confirm status " << params.m_status);
+    m_confirmTime.push_back(Simulator::Now());
+    m_confirmStatus.push_back(params.m_status);
+}
+
+void
+TestLldnLongGroupAck::OnlineIndication(MlmeLLDNOnlineIndicationParams params)
+{
+    // Move the device out of range during its first uplink timeslot.
+    Ptr<MobilityModel> mobility = m_dev->GetPhy()->GetMobility();
+    mobility->SetPosition(Vector(1e6, 0, 0));
+    Simulator::Schedule(23 * m_timeslot, &MobilityModel::SetPosition, mobility, Vector(5, 0, 0));
+}
+
+void
+TestLldnLongGroupAck::DoRun()
+{
+    //  [00:01]                [00:02]
+    //   PAN-C <---------------- Dev
+    //
+    // Test Setup:
+    //
+    // The superframe has 24 base timeslots and no retransmission timeslots. The device
+    // is assigned to the base timeslot 20 and sends a frame with the ACK request bit set.
+    // The device is out of range during its first uplink timeslot: the frame is not
+    // acknowledged in the next LL beacon and the device sends it again in its timeslot.
+    // The device confirms the frame only after the PAN-C received it.
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<Node> devNode = CreateObject<Node>();
+
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    m_dev = CreateObject<LrWpanNetDevice>();
+
+    panC->SetAddress(Mac16Address("00:01"));
+    m_dev->SetAddress(Mac16Address("00:02"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    panC->SetChannel(channel);
+    m_dev->SetChannel(channel);
+
+    panCNode->AddDevice(panC);
+    devNode->AddDevice(m_dev);
+
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    Ptr<ConstantPositionMobilityModel> devMobility = CreateObject<ConstantPositionMobilityModel>();
+    devMobility->SetPosition(Vector(5, 0, 0));
+    m_dev->GetPhy()->SetMobility(devMobility);
+
+    McpsDataIndicationCallback cb0;
+    cb0 = MakeCallback(&TestLldnLongGroupAck::DataIndicationPanC, this);
+    panC->GetMac()->SetMcpsDataIndicationCallback(cb0);
+
+    McpsDataConfirmCallback cb1;
+    cb1 = MakeCallback(&TestLldnLongGroupAck::DataConfirmDev, this);
+    m_dev->GetMac()->SetMcpsDataConfirmCallback(cb1);
+
+    MlmeLLDNOnlineIndicationCallback cb2;
+    cb2 = MakeCallback(&TestLldnLongGroupAck::OnlineIndication, this);
+    m_dev->GetMac()->SetMlmeLLDNOnlineIndicationCallback(cb2);
+
+    Ptr<LrWpanMac> panCMac = panC->GetMac();
+    panCMac->SetPanId(5);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetMacLLDNNumTimeSlots(24);
+    panCMac->SetMacLLDNnumUplinkTS(24);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+
+    Ptr<LrWpanMac> devMac = m_dev->GetMac();
+    devMac->SetPanId(5);
+    devMac->SetLLDNModeEnabled();
+    devMac->SetMacLLDNnumUplinkTS(24);
+    devMac->SetMacLLDNassignedTimeSlot(20);
+
+    double symbolRate = panC->GetPhy()->GetDataOrSymbolRate(false);
+    m_timeslot = Seconds(static_cast<double>(panCMac->GetLLDNBaseTimeslotSymbols()) / symbolRate);
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = 5;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = 0;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   devMac,
+                                   params,
+                                   Create<Packet>(20));
+
+    MlmeLLDNOnlineRequestParams onlineParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeLLDNOnlineRequest,
+                                   panCMac,
+                                   onlineParams);
+
+    // Stop after the 4th LL beacon
+    Simulator::Stop(Seconds(1.0) + 80 * m_timeslot);
+    NS_LOG_DEBUG("----------- Start of TestLldnLongGroupAck -------------------");
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTime.size(), 1, "Error, the frame must be received once");
+    NS_TEST_ASSERT_MSG_EQ(m_confirmStatus.size(), 1, "Error, missing data confirm");
+    NS_TEST_EXPECT_MSG_EQ(m_confirmStatus[0],
+                          IEEE_802_15_4_SUCCESS,
+                          "Error, frame not acknowledged in the group acknowledgement");
+    NS_TEST_EXPECT_MSG_GT(m_confirmTime[0],
+                          m_rxTime[0],
+                          "Error, frame confirmed before its reception by the PAN-C");
+
+    m_dev = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the LLDN trace sources through the LLDN statistics helper.
+ */
+class TestLldnStats : public TestCase
+{
+  public:
+    TestLldnStats();
+    ~TestLldnStats() override;
+
+  private:
+    /**
+     * Function called when the LLDN device enters the Online state.
+     * \param params MLME-LLDN-ONLINE.indication parameters
+     */
+    void OnlineIndication(MlmeLLDNOnlineIndicationParams params);
+
+    void DoRun() override;
+
+    Ptr<LrWpanNetDevice> m_dev; //!< The LLDN device
+    Time m_timeslot;            //!< The duration of a base timeslot
+};
+
+TestLldnStats::TestLldnStats()
+    : TestCase("Test the LLDN trace sources and statistics helper")
+{
+}
+
+TestLldnStats::~TestLldnStats()
+{
+}
+
+void
+TestLldnStats::OnlineIndication(MlmeLLDNOnlineIndicationParams params)
+{
+    // Move the device out of range during its first uplink timeslot.
+    Ptr<MobilityModel> mobility = m_dev->GetPhy()->GetMobility();
+    mobility->SetPosition(Vector(1e6, 0, 0));
+    Simulator::Schedule(8 * m_timeslot, &MobilityModel::SetPosition, mobility, Vector(5, 0, 0));
+}
+
+void
+TestLldnStats::DoRun()
+{
+    //  [00:01]                [00:02]
+    //   PAN-C <---------------- Dev
+    //
+    // Test Setup:
+    //
+    // Same as TestLldnGroupAck: the superframe has 10 base timeslots, the first 2 of them
+    // are retransmission timeslots. The device, assigned to the base timeslot 3, loses its
+    // first transmission and retransmits the frame in the base timeslot 1.
+    // The statistics helper must report 2 frames sent, 1 retransmission, 1 group
+    // acknowledgement miss, 1 delivered frame and 1 occupied timeslot out of the 20
+    // uplink timeslots of the 2 complete superframes.
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<Node> devNode = CreateObject<Node>();
+
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    m_dev = CreateObject<LrWpanNetDevice>();
+
+    panC->SetAddress(Mac16Address("00:01"));
+    m_dev->SetAddress(Mac16Address("00:02"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    panC->SetChannel(channel);
+    m_dev->SetChannel(channel);
+
+    panCNode->AddDevice(panC);
+    devNode->AddDevice(m_dev);
+
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    Ptr<ConstantPositionMobilityModel> devMobility = CreateObject<ConstantPositionMobilityModel>();
+    devMobility->SetPosition(Vector(5, 0, 0));
+    m_dev->GetPhy()->SetMobility(devMobility);
+
+    MlmeLLDNOnlineIndicationCallback cb0;
+    cb0 = MakeCallback(&TestLldnStats::OnlineIndication, this);
+    m_dev->GetMac()->SetMlmeLLDNOnlineIndicationCallback(cb0);
+
+    LrWpanLldnStatsHelper stats;
+    stats.Install(panC);
+    stats.Install(m_dev);
+
+    Ptr<LrWpanMac> panCMac = panC->GetMac();
+    panCMac->SetPanId(5);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetMacLLDNNumTimeSlots(10);
+    panCMac->SetMacLLDNnumReTransmitTS(2);
+    panCMac->SetMacLLDNnumUplinkTS(10);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+
+    Ptr<LrWpanMac> devMac = m_dev->GetMac();
+    devMac->SetPanId(5);
+    devMac->SetLLDNModeEnabled();
+    devMac->SetMacLLDNnumReTransmitTS(2);
+    devMac->SetMacLLDNnumUplinkTS(10);
+    devMac->SetMacLLDNassignedTimeSlot(3);
+
+    double symbolRate = panC->GetPhy()->GetDataOrSymbolRate(false);
+    m_timeslot = Seconds(static_cast<double>(panCMac->GetLLDNBaseTimeslotSymbols()) / symbolRate);
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = 5;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = 0;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   devMac,
+                                   params,
+                                   Create<Packet>(20));
+
+    MlmeLLDNOnlineRequestParams onlineParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeLLDNOnlineRequest,
+                                   panCMac,
+                                   onlineParams);
+
+    // Stop after the 3rd LL beacon
+    Simulator::Stop(Seconds(1.0) + 25 * m_timeslot);
+    NS_LOG_DEBUG("----------- Start of TestLldnStats -------------------");
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.GetRetransmissionRatio(),
+                              0.5,
+                              1e-9,
+                              "Error, 1 of the 2 frames sent must be a retransmission");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetGroupAckMisses(), 1, "Error, wrong group ack misses");
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.GetTimeslotUtilization(),
+                              0.05,
+                              1e-9,
+                              "Error, 1 of the 20 uplink timeslots must be occupied");
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.GetTimeslotUtilization(1),
+                              0.5,
+                              1e-9,
+                              "Error, the retransmission timeslot must be occupied once");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetTimeslotUtilization(3),
+                          0,
+                          "Error, the timeslot of the device must be empty");
+
+    Histogram latency = stats.GetLatencyHistogram(devNode->GetId());
+    uint32_t delivered = 0;
+    for (uint32_t i = 0; i < latency.GetNBins(); i++)
+    {
+        delivered += latency.GetBinCount(i);
+        if (latency.GetBinCount(i) > 0)
+        {
+            // The frame is enqueued at 0.5 s and delivered in the second superframe.
+            NS_TEST_EXPECT_MSG_GT(latency.GetBinEnd(i), 0.5, "Error, latency too short");
+            NS_TEST_EXPECT_MSG_LT(latency.GetBinStart(i),
+                                  0.5 + 25 * m_timeslot.GetSeconds(),
+                                  "Error, latency too long");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(delivered, 1, "Error, the frame must be delivered once");
+
+    NS_TEST_EXPECT_MSG_EQ(stats.GetNumSuperframes(panCNode->GetId()),
+                          3,
+                          "Error, the PAN-C must start 3 superframes");
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.GetMeanSuperframeDuration(panCNode->GetId()).GetSeconds(),
+                              11 * m_timeslot.GetSeconds(),
+                              1e-8,
+                              "Error, wrong superframe duration");
+
+    std::ostringstream os;
+    stats.Print(os);
+    NS_TEST_EXPECT_MSG_NE(os.str().find("Node " + std::to_string(devNode->GetId())),
+                          std::string::npos,
+                          "Error, the device statistics must be printed");
+
+    m_dev = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the contention of several LLDN devices in a shared group timeslot.
+ */
+class TestLldnSharedTimeslot : public TestCase
+{
+  public:
+    TestLldnSharedTimeslot();
+    ~TestLldnSharedTimeslot() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+    /**
+     * Function called when a Data confirm is invoked in a LLDN device.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirmDev(McpsDataConfirmParams params);
+
+    void DoRun() override;
+
+    std::map<Mac16Address, uint32_t> m_rxCount; //!< Frames received by the PAN-C per source
+    std::vector<LrWpanMcpsDataConfirmStatus> m_confirmStatus; //!< Data confirm status
+};
+
+TestLldnSharedTimeslot::TestLldnSharedTimeslot()
+    : TestCase("Test the LLDN shared group timeslots")
+{
+}
+
+TestLldnSharedTimeslot::~TestLldnSharedTimeslot()
+{
+}
+
+void
+TestLldnSharedTimeslot::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_rxCount[params.m_srcAddr]++;
+}
+
+void
+TestLldnSharedTimeslot::DataConfirmDev(McpsDataConfirmParams params)
+{
+    m_confirmStatus.push_back(params.m_status);
+}
+
+void
+TestLldnSharedTimeslot::DoRun()
+{
+    //                  [00:02]
+    //                     |
+    //   [00:01] PAN-C <-- [00:03]
+    //                     |
+    //                  [00:04]
+    //
+    // Test Setup:
+    //
+    // The superframe has 10 uplink base timeslots, the last one is a shared group
+    // timeslot. The 3 devices are assigned to the shared group timeslot and send a
+    // frame in the same superframe: their first transmissions collide. Each device
+    // then skips a random number of shared group timeslots before trying again,
+    // until the 3 frames are acknowledged.
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    panC->SetAddress(Mac16Address("00:01"));
+    panC->SetChannel(channel);
+    panCNode->AddDevice(panC);
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    Ptr<LrWpanMac> panCMac = panC->GetMac();
+    panCMac->SetPanId(5);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetMacLLDNNumTimeSlots(10);
+    panCMac->SetMacLLDNnumUplinkTS(10);
+    panCMac->SetMacLLDNnumSharedGroupTS(1);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+    panCMac->SetMcpsDataIndicationCallback(
+        MakeCallback(&TestLldnSharedTimeslot::DataIndicationPanC, this));
+
+    LrWpanLldnStatsHelper stats;
+    stats.Install(panC);
+
+    std::vector<Vector> positions = {Vector(0, 5, 0), Vector(5, 0, 0), Vector(0, -5, 0)};
+    std::vector<Ptr<LrWpanNetDevice>> devs;
+    for (uint32_t i = 0; i < positions.size(); i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<LrWpanNetDevice> dev = CreateObject<LrWpanNetDevice>();
+        std::ostringstream addr;
+        addr << "00:0" << i + 2;
+        dev->SetAddress(Mac16Address(addr.str().c_str()));
+        dev->SetChannel(channel);
+        node->AddDevice(dev);
+        Ptr<ConstantPositionMobilityModel> mobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(positions[i]);
+        dev->GetPhy()->SetMobility(mobility);
+        dev->AssignStreams(10 * i);
+
+        Ptr<LrWpanMac> devMac = dev->GetMac();
+        devMac->SetPanId(5);
+        devMac->SetLLDNModeEnabled();
+        devMac->SetMacLLDNnumUplinkTS(10);
+        devMac->SetMacLLDNnumSharedGroupTS(1);
+        devMac->SetMacLLDNassignedTimeSlot(9);
+        devMac->SetMacMaxFrameRetries(7);
+        devMac->SetMcpsDataConfirmCallback(
+            MakeCallback(&TestLldnSharedTimeslot::DataConfirmDev, this));
+        stats.Install(dev);
+        devs.push_back(dev);
+
+        McpsDataRequestParams params;
+        params.m_dstPanId = 5;
+        params.m_srcAddrMode = SHORT_ADDR;
+        params.m_dstAddrMode = SHORT_ADDR;
+        params.m_dstAddr = Mac16Address("00:01");
+        params.m_msduHandle = i;
+        params.m_txOptions = TX_OPTION_ACK;
+        Simulator::ScheduleWithContext(node->GetId(),
+                                       Seconds(0.5),
+                                       &LrWpanMac::McpsDataRequest,
+                                       devMac,
+                                       params,
+                                       Create<Packet>(20));
+    }
+
+    double symbolRate = panC->GetPhy()->GetDataOrSymbolRate(false);
+    Time timeslot =
+        Seconds(static_cast<double>(panCMac->GetLLDNBaseTimeslotSymbols()) / symbolRate);
+
+    MlmeLLDNOnlineRequestParams onlineParams;
+    Simulator::ScheduleWithContext(panCNode->GetId(),
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeLLDNOnlineRequest,
+                                   panCMac,
+                                   onlineParams);
+
+    Simulator::Stop(Seconds(1.0) + 100 * 11 * timeslot);
+    NS_LOG_DEBUG("----------- Start of TestLldnSharedTimeslot -------------------");
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxCount.size(), 3, "Error, the 3 frames must be received");
+    for (const auto& rx : m_rxCount)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rx.second, 1, "Error, frame from " << rx.first << " received twice");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_confirmStatus.size(), 3, "Error, missing data confirms");
+    for (const auto& status : m_confirmStatus)
+    {
+        NS_TEST_EXPECT_MSG_EQ(status,
+                              IEEE_802_15_4_SUCCESS,
+                              "Error, frame not acknowledged in the shared group timeslot");
+    }
+
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(stats.GetSharedTimeslotCollisions(9),
+                                3,
+                                "Error, the first transmissions must collide");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetSharedTimeslotAttempts(9),
+                          stats.GetSharedTimeslotCollisions(9) + 3,
+                          "Error, every frame sent must be acknowledged or collide");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetTimeslotUtilization(0),
+                          0,
+                          "Error, the devices must only use the shared group timeslot");
+
+    devs.clear();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the transmission of LL-DATA frames with simple (8 bit) addresses.
+ */
+class TestLldnSimpleAddrData : public TestCase
+{
+  public:
+    TestLldnSimpleAddrData();
+    ~TestLldnSimpleAddrData() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+    /**
+     * Function called when a Data confirm is invoked in the LLDN device.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirmDev(McpsDataConfirmParams params);
+    /**
+     * Function called when a frame is received by the PAN-C MAC.
+     * \param p packet
+     */
+    void PanCRx(Ptr<const Packet> p);
+
+    void DoRun() override;
+
+    std::vector<McpsDataIndicationParams> m_indications;        //!< PAN-C data indications
+    std::vector<uint32_t> m_indicationSize;                      //!< Size of the received MSDUs
+    uint32_t m_rxMpduSize;                                       //!< Size of the received MPDU
+    std::vector<LrWpanMcpsDataConfirmStatus> m_confirmStatus;    //!< Data confirm status
+};
+
+TestLldnSimpleAddrData::TestLldnSimpleAddrData()
+    : TestCase("Test the LLDN LL-DATA frames with simple addresses"),
+      m_rxMpduSize(0)
+{
+}
+
+TestLldnSimpleAddrData::~TestLldnSimpleAddrData()
+{
+}
+
+void
+TestLldnSimpleAddrData::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_indications.push_back(params);
+    m_indicationSize.push_back(p->GetSize());
+}
+
+void
+TestLldnSimpleAddrData::DataConfirmDev(McpsDataConfirmParams params)
+{
+    m_confirmStatus.push_back(params.m_status);
+}
+
+void
+TestLldnSimpleAddrData::PanCRx(Ptr<const Packet> p)
+{
+    m_rxMpduSize = p->GetSize();
+}
+
+void
+TestLldnSimpleAddrData::DoRun()
+{
+    // Test Setup:
+    //
+    // A LLDN device (simple address 7) assigned to the base timeslot 2 sends a
+    // LL-DATA frame to the PAN-C (simple address 1). The frame only carries the
+    // 1 octet LL MAC header, the PAN-C identifies the source by its timeslot.
+    // A second request mixing a simple and a short address is rejected.
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<Node> devNode = CreateObject<Node>();
+
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> dev = CreateObject<LrWpanNetDevice>();
+
+    panC->SetAddress(Mac16Address("00:01"));
+    dev->SetAddress(Mac16Address("00:02"));
+    panC->SetAddress(Mac8Address(1));
+    dev->SetAddress(Mac8Address(7));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    panC->SetChannel(channel);
+    dev->SetChannel(channel);
+
+    panCNode->AddDevice(panC);
+    devNode->AddDevice(dev);
+
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    Ptr<ConstantPositionMobilityModel> devMobility = CreateObject<ConstantPositionMobilityModel>();
+    devMobility->SetPosition(Vector(5, 0, 0));
+    dev->GetPhy()->SetMobility(devMobility);
+
+    McpsDataIndicationCallback cb0;
+    cb0 = MakeCallback(&TestLldnSimpleAddrData::DataIndicationPanC, this);
+    panC->GetMac()->SetMcpsDataIndicationCallback(cb0);
+
+    McpsDataConfirmCallback cb1;
+    cb1 = MakeCallback(&TestLldnSimpleAddrData::DataConfirmDev, this);
+    dev->GetMac()->SetMcpsDataConfirmCallback(cb1);
+
+    panC->GetMac()->TraceConnectWithoutContext(
+        "MacRx",
+        MakeCallback(&TestLldnSimpleAddrData::PanCRx, this));
+
+    Ptr<LrWpanMac> panCMac = panC->GetMac();
+    panCMac->SetPanId(5);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetAssociatedCoor(Mac8Address(1));
+    panCMac->SetMacLLDNNumTimeSlots(10);
+    panCMac->SetMacLLDNnumUplinkTS(10);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+    panCMac->SetLLDNTimeslotOwner(2, Mac8Address(7));
+
+    Ptr<LrWpanMac> devMac = dev->GetMac();
+    devMac->SetPanId(5);
+    devMac->SetLLDNModeEnabled();
+    devMac->SetMacLLDNnumUplinkTS(10);
+    devMac->SetMacLLDNassignedTimeSlot(2);
+
+    McpsDataRequestParams params;
+    params.m_srcAddrMode = SIMPLE_ADDR;
+    params.m_dstAddrMode = SIMPLE_ADDR;
+    params.m_dstSimpleAddr = Mac8Address(1);
+    params.m_msduHandle = 0;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   devMac,
+                                   params,
+                                   Create<Packet>(20));
+
+    McpsDataRequestParams invalidParams = params;
+    invalidParams.m_srcAddrMode = SHORT_ADDR;
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(0.6),
+                                   &LrWpanMac::McpsDataRequest,
+                                   devMac,
+                                   invalidParams,
+                                   Create<Packet>(20));
+
+    MlmeLLDNOnlineRequestParams onlineParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeLLDNOnlineRequest,
+                                   panCMac,
+                                   onlineParams);
+
+    Simulator::Stop(Seconds(1.1));
+    NS_LOG_DEBUG("----------- Start of TestLldnSimpleAddrData -------------------");
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_indications.size(), 1, "Error, LL-DATA frame not received");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(m_indications[0].m_srcAddrMode),
+                          SIMPLE_ADDR,
+                          "Error, wrong source address mode");
+    NS_TEST_EXPECT_MSG_EQ(m_indications[0].m_srcSimpleAddr,
+                          Mac8Address(7),
+                          "Error, wrong source simple address");
+    NS_TEST_EXPECT_MSG_EQ(m_indications[0].m_dstSimpleAddr,
+                          Mac8Address(1),
+                          "Error, wrong destination simple address");
+    NS_TEST_EXPECT_MSG_EQ(m_indicationSize[0], 20, "Error, wrong MSDU size");
+    // LL MAC header (1) + MSDU (20) + FCS (2)
+    NS_TEST_EXPECT_MSG_EQ(m_rxMpduSize, 23, "Error, wrong LL-DATA frame size");
+
+    NS_TEST_ASSERT_MSG_EQ(m_confirmStatus.size(), 2, "Error, missing data confirms");
+    NS_TEST_EXPECT_MSG_EQ(m_confirmStatus[0],
+                          IEEE_802_15_4_INVALID_ADDRESS,
+                          "Error, mixed address modes must be rejected");
+    NS_TEST_EXPECT_MSG_EQ(m_confirmStatus[1],
+                          IEEE_802_15_4_SUCCESS,
+                          "Error, LL-DATA frame not acknowledged");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the downlink LL-DATA frames sent in the bidirectional timeslots.
+ */
+class TestLldnDownlink : public TestCase
+{
+  public:
+    TestLldnDownlink();
+    ~TestLldnDownlink() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in a LLDN device.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationDev(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    void DoRun() override;
+
+    std::map<uint8_t, std::vector<uint32_t>> m_rxSizes; //!< MSDU sizes received by each device
+};
+
+TestLldnDownlink::TestLldnDownlink()
+    : TestCase("Test the LLDN downlink frames in the bidirectional timeslots")
+{
+}
+
+TestLldnDownlink::~TestLldnDownlink()
+{
+}
+
+void
+TestLldnDownlink::DataIndicationDev(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    uint8_t dst;
+    params.m_dstSimpleAddr.CopyTo(&dst);
+    m_rxSizes[dst].push_back(p->GetSize());
+}
+
+void
+TestLldnDownlink::DoRun()
+{
+    // Test Setup:
+    //
+    // The PAN-C (simple address 1) announces 2 bidirectional timeslots in the
+    // downlink direction: the base timeslot 0 of Dev1 (simple address 2) and the
+    // base timeslot 1 of Dev2 (simple address 3). The PAN-C first enqueues a
+    // 30 octets MSDU for Dev2, then a 20 octets MSDU for Dev1. Each MSDU must be
+    // sent in the timeslot of its destination, so each device only receives its own.
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<Node> n1 = CreateObject<Node>();
+    Ptr<Node> n2 = CreateObject<Node>();
+
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> dev1 = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> dev2 = CreateObject<LrWpanNetDevice>();
+
+    panC->SetAddress(Mac16Address("00:01"));
+    dev1->SetAddress(Mac16Address("00:02"));
+    dev2->SetAddress(Mac16Address("00:03"));
+    panC->SetAddress(Mac8Address(1));
+    dev1->SetAddress(Mac8Address(2));
+    dev2->SetAddress(Mac8Address(3));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    panC->SetChannel(channel);
+    dev1->SetChannel(channel);
+    dev2->SetChannel(channel);
+
+    panCNode->AddDevice(panC);
+    n1->AddDevice(dev1);
+    n2->AddDevice(dev2);
+
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    Ptr<ConstantPositionMobilityModel> dev1Mobility = CreateObject<ConstantPositionMobilityModel>();
+    dev1Mobility->SetPosition(Vector(5, 0, 0));
+    dev1->GetPhy()->SetMobility(dev1Mobility);
+
+    Ptr<ConstantPositionMobilityModel> dev2Mobility = CreateObject<ConstantPositionMobilityModel>();
+    dev2Mobility->SetPosition(Vector(0, 5, 0));
+    dev2->GetPhy()->SetMobility(dev2Mobility);
+
+    McpsDataIndicationCallback cb0;
+    cb0 = MakeCallback(&TestLldnDownlink::DataIndicationDev, this);
+    dev1->GetMac()->SetMcpsDataIndicationCallback(cb0);
+    dev2->GetMac()->SetMcpsDataIndicationCallback(cb0);
+
+    // LLDN PAN-C: 2 bidirectional base timeslots in the downlink direction.
+    Ptr<LrWpanMac> panCMac = panC->GetMac();
+    panCMac->SetPanId(5);
+    panCMac->SetLLDNModeEnabled();
+    panCMac->SetMacLLDNcoordinator(true);
+    panCMac->SetAssociatedCoor(Mac8Address(1));
+    panCMac->SetMacLLDNNumTimeSlots(2);
+    panCMac->SetMacLLDNnumUplinkTS(0);
+    panCMac->SetMacLLDNnumBidirectionalTS(2);
+    panCMac->SetMacLLDNmgmtTSDisabled();
+    panCMac->SetMlmeLLDNTimeslotSize(40);
+    panCMac->SetMlmeLLDNTransmissionDirection(FlagsField::DOWNLINK);
+    panCMac->SetLLDNTimeslotOwner(0, Mac8Address(2));
+    panCMac->SetLLDNTimeslotOwner(1, Mac8Address(3));
+
+    Ptr<LrWpanNetDevice> devs[2] = {dev1, dev2};
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        devs[i]->GetMac()->SetPanId(5);
+        devs[i]->GetMac()->SetLLDNModeEnabled();
+        devs[i]->GetMac()->SetMacLLDNnumUplinkTS(0);
+        devs[i]->GetMac()->SetMacLLDNnumBidirectionalTS(2);
+        devs[i]->GetMac()->SetMacLLDNassignedTimeSlot(i);
+    }
+
+    McpsDataRequestParams params;
+    params.m_srcAddrMode = SIMPLE_ADDR;
+    params.m_dstAddrMode = SIMPLE_ADDR;
+    params.m_msduHandle = 0;
+
+    params.m_dstSimpleAddr = Mac8Address(3);
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   panCMac,
+                                   params,
+                                   Create<Packet>(30));
+    params.m_dstSimpleAddr = Mac8Address(2);
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(0.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   panCMac,
+                                   params,
+                                   Create<Packet>(20));
+
+    MlmeLLDNOnlineRequestParams onlineParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeLLDNOnlineRequest,
+                                   panCMac,
+                                   onlineParams);
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes[2].size(), 1, "Error, Dev1 did not receive one frame");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[2][0], 20, "Error, Dev1 received the frame of Dev2");
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes[3].size(), 1, "Error, Dev2 did not receive one frame");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[3][0], 30, "Error, Dev2 received the frame of Dev1");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the LLDN bring-up: Discovery, Configuration and Online states.
+ */
+class TestLldnBringUp : public TestCase
+{
+  public:
+    TestLldnBringUp();
+    ~TestLldnBringUp() override;
+
+  private:
+    /**
+     * Function called when the MLME-LLDN-DISCOVERY.confirm is invoked in the PAN-C.
+     * \param params MLME-LLDN-DISCOVERY.confirm parameters
+     */
+    void DiscoveryConfirm(MlmeLLDNDiscoveryConfirmsParams params);
+    /**
+     * Function called when the MLME-LLDN-CONFIGURATION.confirm is invoked in the PAN-C.
+     * \param params MLME-LLDN-CONFIGURATION.confirm parameters
+     */
+    void ConfigurationConfirm(MlmeLLDNConfigurationConfirmParams params);
+    /**
+     * Function called when a LLDN device reaches the Online state.
+     * \param addr the simple address of the device
+     * \param duration the time elapsed since the device started its bring-up
+     */
+    void TimeToOnline(Mac8Address addr, Time duration);
+
+    void DoRun() override;
+
+    Ptr<LrWpanMac> m_panCMac; //!< The PAN-C MAC
+    std::vector<MlmeLLDNDiscoveryConfirmsParams> m_discoveryConfirms; //!< Discovery confirms
+    std::vector<MlmeLLDNConfigurationConfirmParams>
+        m_configurationConfirms;          //!< Configuration confirms
+    std::vector<Mac8Address> m_onlineAddr; //!< Simple addresses of the online devices
+    std::vector<Time> m_onlineTime;        //!< Time to online of the devices
+};
+
+TestLldnBringUp::TestLldnBringUp()
+    : TestCase("Test the LLDN Discovery and Configuration states")
+{
+}
+
+TestLldnBringUp::~TestLldnBringUp()
+{
+}
+
+void
+TestLldnBringUp::DiscoveryConfirm(MlmeLLDNDiscoveryConfirmsParams params)
+{
+    m_discoveryConfirms.push_back(params);
+    MlmeLLDNConfigurationRequestParams configParams;
+    m_panCMac->MlmeLLDNConfigurationRequest(configParams);
+}
+
+void
+TestLldnBringUp::ConfigurationConfirm(MlmeLLDNConfigurationConfirmParams params)
+{
+    m_configurationConfirms.push_back(params);
+    MlmeLLDNOnlineRequestParams onlineParams;
+    m_panCMac->MlmeLLDNOnlineRequest(onlineParams);
+}
+
+void
+TestLldnBringUp::TimeToOnline(Mac8Address addr, Time duration)
+{
+    m_onlineAddr.push_back(addr);
+    m_onlineTime.push_back(duration);
+}
+
+void
+TestLldnBringUp::DoRun()
+{
+    // Test Setup:
+    //
+    // A PAN-C and 5 LLDN devices without any preassigned address or timeslot.
+    // The PAN-C starts the Discovery state, the devices answer with a Discover
+    // Response in the management timeslots. When the discovery timeout expires,
+    // the PAN-C enters the Configuration state, collects the Configuration Status
+    // of the devices and assigns them a simple address and a base timeslot with
+    // a Configuration Request. Once all the devices are configured, the PAN-C
+    // switches to the Online state.
+
+    const uint32_t numDevices = 5;
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    panC->SetAddress(Mac16Address("00:01"));
+    panC->SetAddress(Mac8Address(1));
+    panC->SetChannel(channel);
+    panCNode->AddDevice(panC);
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    m_panCMac = panC->GetMac();
+    m_panCMac->SetPanId(5);
+    m_panCMac->SetLLDNModeEnabled();
+    m_panCMac->SetMacLLDNcoordinator(true);
+    m_panCMac->SetAssociatedCoor(Mac8Address(1));
+    m_panCMac->SetMacLLDNdiscoveryModeTimeout(1);
+    m_panCMac->SetMlmeLLDNTimeSlotPerMgmtTS(2);
+    m_panCMac->SetMlmeLLDNTimeslotSize(40);
+
+    m_panCMac->SetMlmeLLDNDiscoveryConfirmCallback(
+        MakeCallback(&TestLldnBringUp::DiscoveryConfirm, this));
+    m_panCMac->SetMlmeLLDNConfigurationConfirmCallback(
+        MakeCallback(&TestLldnBringUp::ConfigurationConfirm, this));
+
+    std::vector<Ptr<LrWpanNetDevice>> devices;
+    for (uint32_t i = 0; i < numDevices; i++)
+    {
+        Ptr<Node> devNode = CreateObject<Node>();
+        Ptr<LrWpanNetDevice> dev = CreateObject<LrWpanNetDevice>();
+        dev->SetAddress(Mac16Address::Allocate());
+        dev->SetChannel(channel);
+        devNode->AddDevice(dev);
+
+        Ptr<ConstantPositionMobilityModel> devMobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        devMobility->SetPosition(Vector(5 + i, 0, 0));
+        dev->GetPhy()->SetMobility(devMobility);
+
+        dev->GetMac()->SetPanId(5);
+        dev->GetMac()->SetLLDNModeEnabled();
+        dev->GetMac()->TraceConnectWithoutContext(
+            "LLDNTimeToOnline",
+            MakeCallback(&TestLldnBringUp::TimeToOnline, this));
+        devices.push_back(dev);
+    }
+
+    MlmeLLDNDiscoveryRequstParams discoveryParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(0.1),
+                                   &LrWpanMac::MlmeLLDNDiscoveryRequest,
+                                   m_panCMac,
+                                   discoveryParams);
+
+    Simulator::Stop(Seconds(5));
+    NS_LOG_DEBUG("----------- Start of TestLldnBringUp -------------------");
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_discoveryConfirms.size(), 1, "Error, missing discovery confirm");
+    NS_TEST_EXPECT_MSG_EQ(m_discoveryConfirms[0].m_status,
+                          MLME_LLDN_DISCOVERY_SUCCESS,
+                          "Error, the discovery failed");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(m_discoveryConfirms[0].m_discoveredDevices),
+                          numDevices,
+                          "Error, wrong number of discovered devices");
+
+    NS_TEST_ASSERT_MSG_EQ(m_configurationConfirms.size(),
+                          1,
+                          "Error, missing configuration confirm");
+    NS_TEST_EXPECT_MSG_EQ(m_configurationConfirms[0].m_status,
+                          MLME_LLDN_CONFIGURATION_SUCCESS,
+                          "Error, the configuration failed");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(m_configurationConfirms[0].m_configuredDevices),
+                          numDevices,
+                          "Error, wrong number of configured devices");
+
+    NS_TEST_ASSERT_MSG_EQ(m_onlineAddr.size(), numDevices, "Error, devices not online");
+    std::set<Mac8Address> addresses(m_onlineAddr.begin(), m_onlineAddr.end());
+    NS_TEST_EXPECT_MSG_EQ(addresses.size(), numDevices, "Error, duplicated simple addresses");
+    NS_TEST_EXPECT_MSG_EQ(addresses.count(Mac8Address(1)), 0, "Error, PAN-C address reused");
+    for (const auto& duration : m_onlineTime)
+    {
+        NS_TEST_EXPECT_MSG_GT(duration, Seconds(0), "Error, wrong time to online");
+    }
+
+    std::set<uint8_t> timeslots;
+    for (const auto& dev : devices)
+    {
+        timeslots.insert(dev->GetMac()->GetMacLLDNassignedTimeSlot());
+    }
+    NS_TEST_EXPECT_MSG_EQ(timeslots.size(), numDevices, "Error, duplicated timeslots");
+
+    m_panCMac = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the LLDN slot planner of the PAN-C.
+ */
+class TestLldnSlotPlanner : public TestCase
+{
+  public:
+    TestLldnSlotPlanner();
+    ~TestLldnSlotPlanner() override;
+
+  private:
+    /**
+     * Function called when the MLME-LLDN-DISCOVERY.confirm is invoked in the PAN-C.
+     * \param params MLME-LLDN-DISCOVERY.confirm parameters
+     */
+    void DiscoveryConfirm(MlmeLLDNDiscoveryConfirmsParams params);
+    /**
+     * Function called when the MLME-LLDN-CONFIGURATION.confirm is invoked in the PAN-C.
+     * \param params MLME-LLDN-CONFIGURATION.confirm parameters
+     */
+    void ConfigurationConfirm(MlmeLLDNConfigurationConfirmParams params);
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+    /**
+     * Function called when a Data confirm is invoked in a LLDN device.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirmDev(McpsDataConfirmParams params);
+
+    void DoRun() override;
+
+    Ptr<LrWpanMac> m_panCMac;                       //!< The PAN-C MAC
+    std::vector<Ptr<LrWpanMac>> m_devMacs;          //!< The LLDN devices MAC
+    std::vector<uint8_t> m_payloadSizes;            //!< The payload size of each device
+    std::vector<MlmeLLDNConfigurationConfirmParams> m_configurationConfirms; //!< Confirms
+    std::map<Mac8Address, uint32_t> m_indicationSize; //!< Received MSDU size per device
+    std::vector<LrWpanMcpsDataConfirmStatus> m_confirmStatus; //!< Data confirm status
+};
+
+TestLldnSlotPlanner::TestLldnSlotPlanner()
+    : TestCase("Test the LLDN slot planner")
+{
+}
+
+TestLldnSlotPlanner::~TestLldnSlotPlanner()
+{
+}
+
+void
+TestLldnSlotPlanner::DiscoveryConfirm(MlmeLLDNDiscoveryConfirmsParams params)
+{
+    MlmeLLDNConfigurationRequestParams configParams;
+    m_panCMac->MlmeLLDNConfigurationRequest(configParams);
+}
+
+void
+TestLldnSlotPlanner::ConfigurationConfirm(MlmeLLDNConfigurationConfirmParams params)
+{
+    m_configurationConfirms.push_back(params);
+    MlmeLLDNOnlineRequestParams onlineParams;
+    m_panCMac->MlmeLLDNOnlineRequest(onlineParams);
+
+    // Each device sends a frame of the announced size once online.
+    for (uint32_t i = 0; i < m_devMacs.size(); i++)
+    {
+        McpsDataRequestParams dataParams;
+        dataParams.m_srcAddrMode = SIMPLE_ADDR;
+        dataParams.m_dstAddrMode = SIMPLE_ADDR;
+        dataParams.m_dstSimpleAddr = Mac8Address(1);
+        dataParams.m_msduHandle = i;
+        dataParams.m_txOptions = TX_OPTION_ACK;
+        Simulator::ScheduleWithContext(i + 1,
+                                       MilliSeconds(100),
+                                       &LrWpanMac::McpsDataRequest,
+                                       m_devMacs[i],
+                                       dataParams,
+                                       Create<Packet>(m_payloadSizes[i]));
+    }
+}
+
+void
+TestLldnSlotPlanner::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_indicationSize[params.m_srcSimpleAddr] = p->GetSize();
+}
+
+void
+TestLldnSlotPlanner::DataConfirmDev(McpsDataConfirmParams params)
+{
+    m_confirmStatus.push_back(params.m_status);
+}
+
+void
+TestLldnSlotPlanner::DoRun()
+{
+    // Test Setup:
+    //
+    // A PAN-C with its slot planner enabled and 4 LLDN devices: 3 devices send
+    // 10 octets frames, one of them every 10 ms at most, and one device sends
+    // 60 octets frames. The shortest Online superframe uses 10 octets base
+    // timeslots (50 symbols) and assigns 4 consecutive base timeslots to the
+    // device sending 60 octets (178 symbols), i.e. (1 + 3 + 4) * 50 symbols = 6.4 ms.
+    // The default configuration (40 octets timeslots) would need 8.5 ms.
+
+    m_payloadSizes = {10, 60, 10, 10};
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LogDistancePropagationLossModel> propModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<ConstantSpeedPropagationDelayModel> delayModel =
+        CreateObject<ConstantSpeedPropagationDelayModel>();
+    channel->AddPropagationLossModel(propModel);
+    channel->SetPropagationDelayModel(delayModel);
+
+    Ptr<Node> panCNode = CreateObject<Node>();
+    Ptr<LrWpanNetDevice> panC = CreateObject<LrWpanNetDevice>();
+    panC->SetAddress(Mac16Address("00:01"));
+    panC->SetAddress(Mac8Address(1));
+    panC->SetChannel(channel);
+    panCNode->AddDevice(panC);
+    Ptr<ConstantPositionMobilityModel> panCMobility = CreateObject<ConstantPositionMobilityModel>();
+    panCMobility->SetPosition(Vector(0, 0, 0));
+    panC->GetPhy()->SetMobility(panCMobility);
+
+    m_panCMac = panC->GetMac();
+    m_panCMac->SetPanId(5);
+    m_panCMac->SetLLDNModeEnabled();
+    m_panCMac->SetMacLLDNcoordinator(true);
+    m_panCMac->SetAssociatedCoor(Mac8Address(1));
+    m_panCMac->SetMacLLDNdiscoveryModeTimeout(1);
+    m_panCMac->SetMlmeLLDNTimeSlotPerMgmtTS(2);
+    m_panCMac->SetMlmeLLDNTimeslotSize(40);
+    m_panCMac->SetLLDNSlotPlannerEnabled(true);
+
+    m_panCMac->SetMlmeLLDNDiscoveryConfirmCallback(
+        MakeCallback(&TestLldnSlotPlanner::DiscoveryConfirm, this));
+    m_panCMac->SetMlmeLLDNConfigurationConfirmCallback(
+        MakeCallback(&TestLldnSlotPlanner::ConfigurationConfirm, this));
+    m_panCMac->SetMcpsDataIndicationCallback(
+        MakeCallback(&TestLldnSlotPlanner::DataIndicationPanC, this));
+
+    for (uint32_t i = 0; i < m_payloadSizes.size(); i++)
+    {
+        Ptr<Node> devNode = CreateObject<Node>();
+        Ptr<LrWpanNetDevice> dev = CreateObject<LrWpanNetDevice>();
+        dev->SetAddress(Mac16Address::Allocate());
+        dev->SetChannel(channel);
+        devNode->AddDevice(dev);
+
+        Ptr<ConstantPositionMobilityModel> devMobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        devMobility->SetPosition(Vector(5 + i, 0, 0));
+        dev->GetPhy()->SetMobility(devMobility);
+
+        Ptr<LrWpanMac> devMac = dev->GetMac();
+        devMac->SetPanId(5);
+        devMac->SetLLDNModeEnabled();
+        devMac->SetLLDNTrafficRequirements(m_payloadSizes[i],
+                                           (i == 2) ? MilliSeconds(10) : Seconds(0));
+        devMac->SetMcpsDataConfirmCallback(
+            MakeCallback(&TestLldnSlotPlanner::DataConfirmDev, this));
+        m_devMacs.push_back(devMac);
+    }
+
+    MlmeLLDNDiscoveryRequstParams discoveryParams;
+    Simulator::ScheduleWithContext(0,
+                                   Seconds(0.1),
+                                   &LrWpanMac::MlmeLLDNDiscoveryRequest,
+                                   m_panCMac,
+                                   discoveryParams);
+
+    Simulator::Stop(Seconds(5));
+    NS_LOG_DEBUG("----------- Start of TestLldnSlotPlanner -------------------");
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_configurationConfirms.size(),
+                          1,
+                          "Error, missing configuration confirm");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(m_configurationConfirms[0].m_configuredDevices),
+                          m_payloadSizes.size(),
+                          "Error, wrong number of configured devices");
+
+    const LrWpanMlmeLLNetworkConfiguration& plan =
+        m_configurationConfirms[0].m_LLNetworkConfiguration;
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(plan.m_timeslotSize),
+                          10,
+                          "Error, wrong planned timeslot size");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(plan.m_numTimeSlots),
+                          7,
+                          "Error, wrong planned number of base timeslots");
+    NS_TEST_EXPECT_MSG_EQ(plan.m_superframeDuration,
+                          MicroSeconds(6400),
+                          "Error, wrong planned superframe duration");
+    NS_TEST_EXPECT_MSG_EQ(plan.m_periodsMet, true, "Error, the requested period is not met");
+
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(m_panCMac->GetMacLLDNNumTimeSlots()),
+                          7,
+                          "Error, the planned superframe is not used in the Online state");
+
+    NS_TEST_ASSERT_MSG_EQ(m_indicationSize.size(),
+                          m_payloadSizes.size(),
+                          "Error, missing LL-DATA frames");
+    for (uint32_t i = 0; i < m_devMacs.size(); i++)
+    {
+        auto it = m_indicationSize.find(m_devMacs[i]->GetSimpleAddress());
+        NS_TEST_ASSERT_MSG_EQ((it != m_indicationSize.end()), true, "Error, unknown source");
+        NS_TEST_EXPECT_MSG_EQ(it->second,
+                              static_cast<uint32_t>(m_payloadSizes[i]),
+                              "Error, wrong MSDU size");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(m_confirmStatus.size(),
+                          m_payloadSizes.size(),
+                          "Error, missing data confirms");
+    for (const auto& status : m_confirmStatus)
+    {
+        NS_TEST_EXPECT_MSG_EQ(status,
+                              IEEE_802_15_4_SUCCESS,
+                              "Error, LL-DATA frame not acknowledged");
+    }
+
+    m_panCMac = nullptr;
+    m_devMacs.clear();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test a LLDN star built with the LrWpanLldnStarHelper.
+ */
+class TestLldnStarHelper : public TestCase
+{
+  public:
+    TestLldnStarHelper();
+    ~TestLldnStarHelper() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+    /**
+     * Function called when a Data confirm is invoked in a LLDN device.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirmDev(McpsDataConfirmParams params);
+
+    void DoRun() override;
+
+    std::set<Mac8Address> m_sources;                         //!< Source of the received frames
+    std::vector<LrWpanMcpsDataConfirmStatus> m_confirmStatus; //!< Data confirm status
+};
+
+TestLldnStarHelper::TestLldnStarHelper()
+    : TestCase("Test the LLDN star network builder")
+{
+}
+
+TestLldnStarHelper::~TestLldnStarHelper()
+{
+}
+
+void
+TestLldnStarHelper::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_sources.insert(params.m_srcSimpleAddr);
+}
+
+void
+TestLldnStarHelper::DataConfirmDev(McpsDataConfirmParams params)
+{
+    m_confirmStatus.push_back(params.m_status);
+}
+
+void
+TestLldnStarHelper::DoRun()
+{
+    // Test Setup:
+    //
+    //              dev 4
+    //       dev 5         dev 3
+    //   dev 6     PAN-C (1)     dev 2
+    //       dev 7         dev 9
+    //              dev 8
+    //
+    // The helper builds a star of 8 LLDN devices on a 10 m ring around the
+    // PAN-C, with 2 retransmission timeslots ahead of the dedicated timeslots.
+    // Each device sends a LL-DATA frame, which must be received by the PAN-C
+    // in its own timeslot and acknowledged.
+
+    const uint32_t numDevices = 8;
+
+    LrWpanLldnStarHelper starHelper;
+    starHelper.SetPlacement(LrWpanLldnStarHelper::RING, 10);
+    starHelper.SetNumRetransmitTimeslots(2);
+    starHelper.SetPanCDataIndicationCallback(
+        MakeCallback(&TestLldnStarHelper::DataIndicationPanC, this));
+    starHelper.SetDeviceDataConfirmCallback(
+        MakeCallback(&TestLldnStarHelper::DataConfirmDev, this));
+
+    NetDeviceContainer devices = starHelper.Install(numDevices);
+    starHelper.AssignStreams(0);
+
+    NS_TEST_ASSERT_MSG_EQ(devices.GetN(), numDevices + 1, "Error, wrong number of devices");
+    NS_TEST_ASSERT_MSG_EQ(starHelper.GetPanCs().GetN(), 1, "Error, wrong number of PAN-Cs");
+    NS_TEST_ASSERT_MSG_EQ(starHelper.GetPanCs().Get(0), devices.Get(0), "Error, wrong PAN-C");
+
+    for (uint32_t i = 0; i < numDevices; i++)
+    {
+        Ptr<LrWpanNetDevice> dev = DynamicCast<LrWpanNetDevice>(devices.Get(i + 1));
+        NS_TEST_EXPECT_MSG_EQ(dev->GetMac()->GetSimpleAddress(),
+                              Mac8Address(i + 2),
+                              "Error, wrong simple address");
+
+        Vector position = dev->GetPhy()->GetMobility()->GetPosition();
+        NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(position, Vector(0, 0, 0)),
+                                  10,
+                                  1e-9,
+                                  "Error, device not on the ring");
+
+        McpsDataRequestParams params;
+        params.m_srcAddrMode = SIMPLE_ADDR;
+        params.m_dstAddrMode = SIMPLE_ADDR;
+        params.m_dstSimpleAddr = Mac8Address(1);
+        params.m_msduHandle = 0;
+        params.m_txOptions = TX_OPTION_ACK;
+        Simulator::ScheduleWithContext(dev->GetNode()->GetId(),
+                                       Seconds(0.5),
+                                       &LrWpanMac::McpsDataRequest,
+                                       dev->GetMac(),
+                                       params,
+                                       Create<Packet>(20));
+    }
+
+    starHelper.Start(Seconds(1.0));
+
+    Simulator::Stop(Seconds(1.2));
+    NS_LOG_DEBUG("----------- Start of TestLldnStarHelper -------------------");
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_sources.size(), numDevices, "Error, LL-DATA frames not received");
+    NS_TEST_ASSERT_MSG_EQ(m_confirmStatus.size(), numDevices, "Error, missing data confirms");
+    for (const auto& status : m_confirmStatus)
+    {
+        NS_TEST_EXPECT_MSG_EQ(status,
+                              IEEE_802_15_4_SUCCESS,
+                              "Error, LL-DATA frame not acknowledged");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test neighbouring LLDN stars with a channel plan and the inter-cell collisions.
+ */
+class TestLldnMultiCell : public TestCase
+{
+  public:
+    TestLldnMultiCell();
+    ~TestLldnMultiCell() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in a PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * Run two neighbouring stars of 4 LLDN devices, each device sending 10 LL-DATA frames.
+     * \param channels the channel plan
+     * \param starHelper the helper building the stars
+     */
+    void RunStars(const std::vector<uint8_t>& channels, LrWpanLldnStarHelper& starHelper);
+
+    void DoRun() override;
+
+    uint32_t m_indications; //!< Number of data indications in the PAN-Cs
+};
+
+TestLldnMultiCell::TestLldnMultiCell()
+    : TestCase("Test the LLDN channel plan and inter-cell collisions"),
+      m_indications(0)
+{
+}
+
+TestLldnMultiCell::~TestLldnMultiCell()
+{
+}
+
+void
+TestLldnMultiCell::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_indications++;
+}
+
+void
+TestLldnMultiCell::RunStars(const std::vector<uint8_t>& channels,
+                            LrWpanLldnStarHelper& starHelper)
+{
+    m_indications = 0;
+    starHelper.SetChannelPlan(channels, 100);
+    starHelper.SetPanCDataIndicationCallback(
+        MakeCallback(&TestLldnMultiCell::DataIndicationPanC, this));
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        starHelper.SetNetworkId(i + 1);
+        starHelper.SetCenter(Vector(i * 8.0, 0, 0));
+        starHelper.SetPlacement(LrWpanLldnStarHelper::RING, (i == 0) ? 10 : 3);
+        NetDeviceContainer devices = starHelper.Install(4);
+        for (uint32_t j = 1; j < devices.GetN(); j++)
+        {
+            Ptr<LrWpanNetDevice> dev = DynamicCast<LrWpanNetDevice>(devices.Get(j));
+            McpsDataRequestParams params;
+            params.m_srcAddrMode = SIMPLE_ADDR;
+            params.m_dstAddrMode = SIMPLE_ADDR;
+            params.m_dstSimpleAddr = Mac8Address(i + 1);
+            params.m_msduHandle = 0;
+            for (uint32_t k = 0; k < 10; k++)
+            {
+                Simulator::ScheduleWithContext(dev->GetNode()->GetId(),
+                                               Seconds(1.001 + k * 0.1),
+                                               &LrWpanMac::McpsDataRequest,
+                                               dev->GetMac(),
+                                               params,
+                                               Create<Packet>(20));
+            }
+        }
+    }
+    starHelper.AssignStreams(0);
+    starHelper.EnableInterCellStats();
+    starHelper.Start(Seconds(1.0));
+
+    Simulator::Stop(Seconds(2.1));
+    Simulator::Run();
+}
+
+void
+TestLldnMultiCell::DoRun()
+{
+    // Test Setup:
+    //
+    //   Star 1 (LLDN 1)          Star 2 (LLDN 2)
+    //   PAN-C at (0,0)           PAN-C at (8,0)
+    //   devices on a 10 m ring   devices on a 3 m ring
+    //
+    // Two stars of 4 LLDN devices, whose PAN-Cs start their superframes at the same
+    // time. Each device sends 10 LL-DATA frames.
+    // On a single channel, the devices only follow the LL beacons of their own LLDN
+    // but the frames sent in the same timeslot of both stars collide: the devices of
+    // star 2 reach the PAN-C of star 1 before its own devices.
+    // With two channels in the plan, the stars get different channels and all the
+    // frames are received without inter-cell collisions.
+
+    {
+        LrWpanLldnStarHelper starHelper;
+        RunStars({11}, starHelper);
+
+        NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(starHelper.GetChannelNumber(0)),
+                              11,
+                              "Error, wrong channel");
+        NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(starHelper.GetChannelNumber(1)),
+                              11,
+                              "Error, wrong channel");
+        NodeContainer nodes = starHelper.GetNodes();
+        for (uint32_t i = 0; i < nodes.GetN(); i++)
+        {
+            Ptr<LrWpanNetDevice> dev = DynamicCast<LrWpanNetDevice>(nodes.Get(i)->GetDevice(0));
+            uint32_t expected = (i < 5) ? 1 : 2;
+            NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(dev->GetMac()->GetMacLLDNlowLatencyNWid()),
+                                  expected,
+                                  "Error, device in the wrong LLDN");
+        }
+        NS_TEST_EXPECT_MSG_GT(starHelper.GetUplinkFrames(0), 0, "Error, no uplink frames");
+        NS_TEST_EXPECT_MSG_GT(starHelper.GetInterCellCollisions(0),
+                              0,
+                              "Error, co-channel stars must collide");
+        NS_TEST_EXPECT_MSG_GT(starHelper.GetInterCellCollisionRate(),
+                              0,
+                              "Error, co-channel stars must collide");
+        Simulator::Destroy();
+    }
+
+    {
+        LrWpanLldnStarHelper starHelper;
+        RunStars({11, 12}, starHelper);
+
+        NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(starHelper.GetChannelNumber(0)),
+                              11,
+                              "Error, wrong channel");
+        NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(starHelper.GetChannelNumber(1)),
+                              12,
+                              "Error, wrong channel");
+        NS_TEST_EXPECT_MSG_EQ(m_indications, 80, "Error, LL-DATA frames lost");
+        NS_TEST_EXPECT_MSG_EQ(starHelper.GetInterCellCollisions(0),
+                              0,
+                              "Error, unexpected inter-cell collisions");
+        NS_TEST_EXPECT_MSG_EQ(starHelper.GetInterCellCollisions(1),
+                              0,
+                              "Error, unexpected inter-cell collisions");
+        NS_TEST_EXPECT_MSG_EQ(starHelper.GetInterCellCollisionRate(),
+                              0,
+                              "Error, unexpected inter-cell collisions");
+        Simulator::Destroy();
+    }
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the duty cycle of the transceiver of LLDN devices between their timeslots.
+ */
+class TestLldnDutyCycle : public TestCase
+{
+  public:
+    TestLldnDutyCycle();
+    ~TestLldnDutyCycle() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * Function called when the transceiver state of the observed LLDN device changes.
+     * \param oldState the previous state
+     * \param newState the new state
+     */
+    void TrxStateChanged(LrWpanPhyEnumeration oldState, LrWpanPhyEnumeration newState);
+
+    /**
+     * Run a star of 4 LLDN devices, each device sending 10 LL-DATA frames.
+     * \param sleep true to duty-cycle the transceiver of the devices
+     */
+    void RunStar(bool sleep);
+
+    void DoRun() override;
+
+    uint32_t m_indications; //!< Number of data indications in the PAN-C
+    Time m_onTime;          //!< Time spent with the transceiver on by the observed device
+    Time m_lastChange;      //!< Time of the last transceiver state change
+    bool m_on;              //!< Whether the transceiver of the observed device is on
+    double m_onFraction;    //!< Fraction of the Online time with the transceiver on
+};
+
+TestLldnDutyCycle::TestLldnDutyCycle()
+    : TestCase("Test the duty cycle of the LLDN devices"),
+      m_indications(0),
+      m_on(false),
+      m_onFraction(0)
+{
+}
+
+TestLldnDutyCycle::~TestLldnDutyCycle()
+{
+}
+
+void
+TestLldnDutyCycle::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_indications++;
+}
+
+void
+TestLldnDutyCycle::TrxStateChanged(LrWpanPhyEnumeration oldState,
+                                   LrWpanPhyEnumeration newState)
+{
+    // Only the Online state is observed.
+    Time start = Max(m_lastChange, Seconds(1.1));
+    if (m_on && Simulator::Now() > start)
+    {
+        m_onTime += Simulator::Now() - start;
+    }
+    m_on = (newState != IEEE_802_15_4_PHY_TRX_OFF);
+    m_lastChange = Simulator::Now();
+}
+
+void
+TestLldnDutyCycle::RunStar(bool sleep)
+{
+    m_indications = 0;
+    m_onTime = Seconds(0);
+    m_lastChange = Seconds(0);
+    m_on = false;
+
+    LrWpanLldnStarHelper starHelper;
+    starHelper.SetTimeslotSize(10);
+    starHelper.SetNumRetransmitTimeslots(1);
+    starHelper.SetPanCDataIndicationCallback(
+        MakeCallback(&TestLldnDutyCycle::DataIndicationPanC, this));
+    if (sleep)
+    {
+        starHelper.EnableDeviceSleep(MicroSeconds(500));
+    }
+
+    NetDeviceContainer devices = starHelper.Install(4);
+    for (uint32_t i = 1; i < devices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> dev = DynamicCast<LrWpanNetDevice>(devices.Get(i));
+        McpsDataRequestParams params;
+        params.m_srcAddrMode = SIMPLE_ADDR;
+        params.m_dstAddrMode = SIMPLE_ADDR;
+        params.m_dstSimpleAddr = Mac8Address(1);
+        params.m_msduHandle = 0;
+        params.m_txOptions = TX_OPTION_ACK;
+        for (uint32_t k = 0; k < 10; k++)
+        {
+            Simulator::ScheduleWithContext(dev->GetNode()->GetId(),
+                                           Seconds(1.001 + k * 0.1),
+                                           &LrWpanMac::McpsDataRequest,
+                                           dev->GetMac(),
+                                           params,
+                                           Create<Packet>(10));
+        }
+    }
+    DynamicCast<LrWpanNetDevice>(devices.Get(1))
+        ->GetPhy()
+        ->TraceConnectWithoutContext("TrxStateValue",
+                                     MakeCallback(&TestLldnDutyCycle::TrxStateChanged, this));
+    starHelper.AssignStreams(0);
+    starHelper.Start(Seconds(1.0));
+
+    Simulator::Stop(Seconds(2.1));
+    Simulator::Run();
+
+    if (m_on)
+    {
+        m_onTime += Simulator::Now() - Max(m_lastChange, Seconds(1.1));
+    }
+    m_onFraction = m_onTime.GetSeconds(); // Observed during 1 s
+    Simulator::Destroy();
+}
+
+void
+TestLldnDutyCycle::DoRun()
+{
+    // Test Setup:
+    //
+    // A star of 4 LLDN devices, with a retransmission timeslot. Each device sends
+    // 10 LL-DATA frames, one every 100 ms.
+    // Without the duty cycle, the transceiver of the devices is always on. With
+    // the duty cycle, it is only switched on around the LL beacons and the
+    // timeslots of the device, and all the frames are still received.
+
+    RunStar(false);
+    NS_TEST_EXPECT_MSG_EQ(m_indications, 40, "Error, LL-DATA frames lost");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_onFraction, 1, 1e-9, "Error, the transceiver was switched off");
+
+    RunStar(true);
+    NS_TEST_EXPECT_MSG_EQ(m_indications, 40, "Error, LL-DATA frames lost with the duty cycle");
+    NS_LOG_DEBUG("Transceiver on " << m_onFraction * 100 << "% of the time");
+    NS_TEST_EXPECT_MSG_LT(m_onFraction, 0.5, "Error, the transceiver was not duty-cycled");
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test that the LLDN superframes are aligned on an exact number of symbols
+ * during a long run.
+ */
+class TestLldnSymbolTime : public TestCase
+{
+  public:
+    TestLldnSymbolTime();
+    ~TestLldnSymbolTime() override;
+
+  private:
+    /**
+     * Function called at the start of each LLDN superframe of the PAN-C.
+     * \param duration the duration of the LLDN superframe
+     */
+    void SuperframeStart(Time duration);
+
+    void DoRun() override;
+
+    std::vector<Time> m_starts;    //!< The start of the LLDN superframes of the PAN-C
+    std::vector<Time> m_durations; //!< The duration of the LLDN superframes of the PAN-C
+};
+
+TestLldnSymbolTime::TestLldnSymbolTime()
+    : TestCase("Test the symbol alignment of the LLDN superframes")
+{
+}
+
+TestLldnSymbolTime::~TestLldnSymbolTime()
+{
+}
+
+void
+TestLldnSymbolTime::SuperframeStart(Time duration)
+{
+    // Only the Online superframes are observed.
+    if (Simulator::Now() < Seconds(2.0))
+    {
+        return;
+    }
+    m_starts.push_back(Simulator::Now());
+    m_durations.push_back(duration);
+}
+
+void
+TestLldnSymbolTime::DoRun()
+{
+    // Test Setup:
+    //
+    // A star of 2 LLDN devices runs for 10 minutes in the Online state.
+    // The superframe duration is an exact number of 16 us symbols (2.4 GHz O-QPSK).
+    // The superframes of the PAN-C (the superframe and the turnaround time before
+    // the next LL beacon) start with a constant period of an exact number of
+    // symbols, without any rounding drift.
+
+    LrWpanLldnStarHelper starHelper;
+    NetDeviceContainer devices = starHelper.Install(2);
+    Ptr<LrWpanNetDevice> panC = DynamicCast<LrWpanNetDevice>(devices.Get(0));
+    starHelper.AssignStreams(0);
+    starHelper.Start(Seconds(1.0));
+
+    panC->GetMac()->TraceConnectWithoutContext(
+        "LLDNSuperframe",
+        MakeCallback(&TestLldnSymbolTime::SuperframeStart, this));
+
+    Simulator::Stop(Seconds(602.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_GT(m_starts.size(), 1000, "Error, LLDN superframes not started");
+    Time duration = m_durations.front();
+    uint64_t symbols = panC->GetMac()->GetLLDNSuperframeSymbols();
+    NS_TEST_EXPECT_MSG_EQ(duration,
+                          MicroSeconds(16) * static_cast<int64_t>(symbols),
+                          "Error, the superframe duration is not an exact number of symbols");
+
+    Time period = m_starts[1] - m_starts[0];
+    NS_TEST_EXPECT_MSG_EQ(Rem(period, MicroSeconds(16)),
+                          Seconds(0),
+                          "Error, the superframe period is not an exact number of symbols");
+
+    uint32_t misaligned = 0;
+    for (size_t i = 0; i < m_starts.size(); i++)
+    {
+        if (m_durations[i] != duration ||
+            m_starts[i] - m_starts.front() != period * static_cast<int64_t>(i))
+        {
+            misaligned++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(misaligned, 0, "Error, the LLDN superframes drifted");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the timeslots missed by LLDN devices with a drifting clock.
+ */
+class TestLldnClockDrift : public TestCase
+{
+  public:
+    TestLldnClockDrift();
+    ~TestLldnClockDrift() override;
+
+  private:
+    /**
+     * Function called when a Data indication is invoked in the PAN-C.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * Function called when a LLDN device misses a timeslot.
+     * \param type the type of the missed timeslot
+     * \param clockError the timing error of the device
+     */
+    void SlotMiss(LLDNTimeslotType type, Time clockError);
+
+    /**
+     * Run a star of 4 LLDN devices, each device sending 10 LL-DATA frames.
+     * \param drift the clock frequency offset of the devices, in ppm
+     * \param walk the random walk of the clock frequency offset, in ppm
+     * \param guardTime the guard time of the timeslots
+     * \param sleep true to duty-cycle the transceiver of the devices
+     */
+    void RunStar(double drift, double walk, Time guardTime, bool sleep);
+
+    void DoRun() override;
+
+    uint32_t m_indications;     //!< Number of data indications in the PAN-C
+    uint32_t m_uplinkMisses;    //!< Number of uplink timeslots missed by the devices
+    uint32_t m_beaconMisses;    //!< Number of LL beacons missed by the devices
+    double m_minMissError;      //!< Smallest clock error of a missed timeslot, in us
+    double m_finalDrift;        //!< Clock frequency offset of the first device at the end
+};
+
+TestLldnClockDrift::TestLldnClockDrift()
+    : TestCase("Test the timeslots missed by LLDN devices with a drifting clock"),
+      m_indications(0),
+      m_uplinkMisses(0),
+      m_beaconMisses(0),
+      m_minMissError(0),
+      m_finalDrift(0)
+{
+}
+
+TestLldnClockDrift::~TestLldnClockDrift()
+{
+}
+
+void
+TestLldnClockDrift::DataIndicationPanC(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_indications++;
+}
+
+void
+TestLldnClockDrift::SlotMiss(LLDNTimeslotType type, Time clockError)
+{
+    if (type == LLDN_TS_BEACON)
+    {
+        m_beaconMisses++;
+    }
+    else
+    {
+        m_uplinkMisses++;
+    }
+    double error = std::abs(clockError.ToDouble(Time::US));
+    if (m_uplinkMisses + m_beaconMisses == 1 || error < m_minMissError)
+    {
+        m_minMissError = error;
+    }
+}
+
+void
+TestLldnClockDrift::RunStar(double drift, double walk, Time guardTime, bool sleep)
+{
+    m_indications = 0;
+    m_uplinkMisses = 0;
+    m_beaconMisses = 0;
+    m_minMissError = 0;
+
+    LrWpanLldnStarHelper starHelper;
+    starHelper.SetTimeslotSize(10);
+    starHelper.SetNumRetransmitTimeslots(1);
+    starHelper.SetPanCDataIndicationCallback(
+        MakeCallback(&TestLldnClockDrift::DataIndicationPanC, this));
+    starHelper.SetGuardTime(guardTime);
+    if (sleep)
+    {
+        starHelper.EnableDeviceSleep(guardTime);
+    }
+    Ptr<ConstantRandomVariable> driftVariable = CreateObject<ConstantRandomVariable>();
+    driftVariable->SetAttribute("Constant", DoubleValue(drift));
+    starHelper.SetClockDrift(driftVariable, walk);
+
+    NetDeviceContainer devices = starHelper.Install(4);
+    for (uint32_t i = 1; i < devices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> dev = DynamicCast<LrWpanNetDevice>(devices.Get(i));
+        dev->GetMac()->TraceConnectWithoutContext(
+            "LLDNSlotMiss",
+            MakeCallback(&TestLldnClockDrift::SlotMiss, this));
+        McpsDataRequestParams params;
+        params.m_srcAddrMode = SIMPLE_ADDR;
+        params.m_dstAddrMode = SIMPLE_ADDR;
+        params.m_dstSimpleAddr = Mac8Address(1);
+        params.m_msduHandle = 0;
+        params.m_txOptions = TX_OPTION_ACK;
+        for (uint32_t k = 0; k < 10; k++)
+        {
+            Simulator::ScheduleWithContext(dev->GetNode()->GetId(),
+                                           Seconds(1.001 + k * 0.1),
+                                           &LrWpanMac::McpsDataRequest,
+                                           dev->GetMac(),
+                                           params,
+                                           Create<Packet>(10));
+        }
+    }
+    starHelper.AssignStreams(0);
+    starHelper.Start(Seconds(1.0));
+
+    Simulator::Stop(Seconds(2.1));
+    Simulator::Run();
+
+    m_finalDrift = DynamicCast<LrWpanNetDevice>(devices.Get(1))->GetMac()->GetLLDNClockDrift();
+    Simulator::Destroy();
+}
+
+void
+TestLldnClockDrift::DoRun()
+{
+    // Test Setup:
+    //
+    // A star of 4 LLDN devices, with a retransmission timeslot. Each device sends
+    // 10 LL-DATA frames, one every 100 ms. The base timeslots last 800 us, the
+    // timeslots of the devices start from 1.6 ms to 4 ms after the LL beacon and
+    // the superframe lasts 4.8 ms.
+    //
+    // - 40 ppm and a 500 us guard time: no timeslot is missed.
+    // - 500 ppm and a 1 us guard time: the error of the first device (0.8 us) stays
+    //   in the guard time, the other devices (1.2 us to 2 us) miss all their timeslots.
+    // - -500 ppm, 1 us guard time and duty cycle: the devices wake up 1.4 us after
+    //   the start of the LL beacon and miss it, they only get the next one. The first
+    //   device, missing the group acknowledgements, retransmits its frames.
+    // - A random walk of 1 ppm from a perfect clock: the frequency offset drifts
+    //   without reaching the guard time.
+
+    RunStar(40, 0, MicroSeconds(500), false);
+    NS_TEST_EXPECT_MSG_EQ(m_indications, 40, "Error, LL-DATA frames lost");
+    NS_TEST_EXPECT_MSG_EQ(m_uplinkMisses + m_beaconMisses, 0, "Error, timeslots missed");
+
+    RunStar(500, 0, MicroSeconds(1), false);
+    NS_TEST_EXPECT_MSG_EQ(m_indications, 10, "Error, only the first device should transmit");
+    NS_TEST_EXPECT_MSG_GT(m_uplinkMisses, 0, "Error, no timeslot missed");
+    NS_TEST_EXPECT_MSG_EQ(m_beaconMisses, 0, "Error, LL beacon missed without duty cycle");
+    NS_TEST_EXPECT_MSG_GT(m_minMissError, 1, "Error, timeslot missed within the guard time");
+
+    RunStar(-500, 0, MicroSeconds(1), true);
+    NS_TEST_EXPECT_MSG_GT(m_beaconMisses, 0, "Error, no LL beacon missed");
+    NS_TEST_EXPECT_MSG_GT(m_uplinkMisses, 0, "Error, no timeslot missed");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_indications,
+                                10,
+                                "Error, LL-DATA frames of the first device lost");
+
+    RunStar(0, 1, MicroSeconds(500), false);
+    NS_TEST_EXPECT_MSG_EQ(m_indications, 40, "Error, LL-DATA frames lost");
+    NS_TEST_EXPECT_MSG_EQ(m_uplinkMisses, 0, "Error, timeslots missed");
+    NS_TEST_EXPECT_MSG_NE(m_finalDrift, 0, "Error, the clock frequency offset did not drift");
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan LLDN TestSuite
+ */
+class LrWpanLldnTestSuite : public TestSuite
+{
+  public:
+    LrWpanLldnTestSuite();
+};
+
+LrWpanLldnTestSuite::LrWpanLldnTestSuite()
+    : TestSuite("lr-wpan-lldn-test", UNIT)
+{
+    AddTestCase(new TestLldnOnlineTimeslots, TestCase::QUICK);
+    AddTestCase(new TestLldnGroupAck, TestCase::QUICK);
+    AddTestCase(new TestLldnLongGroupAck, TestCase::QUICK);
+    AddTestCase(new TestLldnStats, TestCase::QUICK);
+    AddTestCase(new TestLldnSimpleAddrData, TestCase::QUICK);
+    AddTestCase(new TestLldnDownlink, TestCase::QUICK);
+    AddTestCase(new TestLldnBringUp, TestCase::QUICK);
+    AddTestCase(new TestLldnSlotPlanner, TestCase::QUICK);
+    AddTestCase(new TestLldnSharedTimeslot, TestCase::QUICK);
+    AddTestCase(new TestLldnStarHelper, TestCase::QUICK);
+    AddTestCase(new TestLldnMultiCell, TestCase::QUICK);
+    AddTestCase(new TestLldnDutyCycle, TestCase::QUICK);
+    AddTestCase(new TestLldnClockDrift, TestCase::QUICK);
+    AddTestCase(new TestLldnSymbolTime, TestCase::QUICK);
+}
+
+static LrWpanLldnTestSuite g_lrWpanLldnTestSuite; //!< Static variable for test initialization
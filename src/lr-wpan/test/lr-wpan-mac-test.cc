@@ -28,6 +28,10 @@
 #include <ns3/single-model-spectrum-channel.h>
 
 #include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -485,6 +489,997 @@ TestActiveScanPanDescriptors::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the MSDUs dropped by each policy of the MAC transmit queue when it is full.
+ */
+class TestTxQueueDropPolicy : public TestCase
+{
+  public:
+    TestTxQueueDropPolicy();
+    ~TestTxQueueDropPolicy() override;
+
+  private:
+    /**
+     * Function called when a Data confirm is invoked
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirm(McpsDataConfirmParams params);
+
+    /**
+     * Send MSDUs to a MAC, all but the first 2 of them after a delay, and record
+     * their confirm status.
+     * \param policy the drop policy of the transmit queue
+     * \param delay the delay between the first 2 and the other MSDUs
+     * \param queueSize the max size of the transmit queue (0 for no limit), the default
+     *                  size if not set
+     * \param numMsdus the number of MSDUs
+     */
+    void RunPolicy(LrWpanTxQueueDropPolicy policy,
+                   Time delay,
+                   std::optional<uint32_t> queueSize = 2,
+                   uint8_t numMsdus = 4);
+
+    void DoRun() override;
+
+    std::map<uint8_t, LrWpanMcpsDataConfirmStatus> m_status; //!< Confirm status of each handle
+};
+
+TestTxQueueDropPolicy::TestTxQueueDropPolicy()
+    : TestCase("Test the drop policies of the MAC transmit queue")
+{
+}
+
+TestTxQueueDropPolicy::~TestTxQueueDropPolicy()
+{
+}
+
+void
+TestTxQueueDropPolicy::DataConfirm(McpsDataConfirmParams params)
+{
+    NS_LOG_DEBUG("MSDU handle " << static_cast<uint32_t>(params.m_msduHandle) << " status "
+                                << params.m_status);
+    m_status[params.m_msduHandle] = params.m_status;
+}
+
+void
+TestTxQueueDropPolicy::RunPolicy(LrWpanTxQueueDropPolicy policy,
+                                 Time delay,
+                                 std::optional<uint32_t> queueSize,
+                                 uint8_t numMsdus)
+{
+    m_status.clear();
+
+    Ptr<Node> n0 = CreateObject<Node>();
+    Ptr<Node> n1 = CreateObject<Node>();
+    Ptr<LrWpanNetDevice> dev0 = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> dev1 = CreateObject<LrWpanNetDevice>();
+    dev0->SetAddress(Mac16Address("00:01"));
+    dev1->SetAddress(Mac16Address("00:02"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    dev0->SetChannel(channel);
+    dev1->SetChannel(channel);
+    n0->AddDevice(dev0);
+    n1->AddDevice(dev1);
+
+    Ptr<ConstantPositionMobilityModel> mobility0 = CreateObject<ConstantPositionMobilityModel>();
+    mobility0->SetPosition(Vector(0, 0, 0));
+    dev0->GetPhy()->SetMobility(mobility0);
+    Ptr<ConstantPositionMobilityModel> mobility1 = CreateObject<ConstantPositionMobilityModel>();
+    mobility1->SetPosition(Vector(0, 10, 0));
+    dev1->GetPhy()->SetMobility(mobility1);
+
+    dev0->GetMac()->SetMcpsDataConfirmCallback(
+        MakeCallback(&TestTxQueueDropPolicy::DataConfirm, this));
+    if (queueSize)
+    {
+        dev0->GetMac()->SetTxQMaxSize(*queueSize);
+    }
+    dev0->GetMac()->SetTxQDropPolicy(policy);
+    dev0->GetMac()->SetTxQStaleTime(MicroSeconds(500));
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = 0;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:02");
+
+    // The first MSDU is still being sent when the last ones are requested.
+    for (uint8_t i = 0; i < numMsdus; i++)
+    {
+        params.m_msduHandle = i;
+        Simulator::ScheduleWithContext(1,
+                                       Seconds(1) + ((i < 2) ? Time(0) : delay),
+                                       &LrWpanMac::McpsDataRequest,
+                                       dev0->GetMac(),
+                                       params,
+                                       Create<Packet>(100));
+    }
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+TestTxQueueDropPolicy::DoRun()
+{
+    // Node 0 [00:01] sends 4 MSDUs to Node 1 [00:02] without acknowledgment.
+    // The transmit queue of Node 0 holds 2 MSDUs, the first one being sent
+    // when the others are requested.
+
+    LogComponentEnable("lr-wpan-mac-test", LOG_LEVEL_DEBUG);
+
+    // Tail drop: the new MSDUs are rejected.
+    RunPolicy(TX_QUEUE_TAIL_DROP, Time(0));
+    NS_TEST_ASSERT_MSG_EQ(m_status.size(), 4, "All the MSDUs must be confirmed");
+    NS_TEST_EXPECT_MSG_EQ(m_status[0], IEEE_802_15_4_SUCCESS, "MSDU 0 must be sent");
+    NS_TEST_EXPECT_MSG_EQ(m_status[1], IEEE_802_15_4_SUCCESS, "MSDU 1 must be sent");
+    NS_TEST_EXPECT_MSG_EQ(m_status[2],
+                          IEEE_802_15_4_TRANSACTION_OVERFLOW,
+                          "MSDU 2 must be rejected");
+    NS_TEST_EXPECT_MSG_EQ(m_status[3],
+                          IEEE_802_15_4_TRANSACTION_OVERFLOW,
+                          "MSDU 3 must be rejected");
+
+    // Head drop: the oldest queued MSDUs are dropped, except the one being sent.
+    RunPolicy(TX_QUEUE_HEAD_DROP, Time(0));
+    NS_TEST_ASSERT_MSG_EQ(m_status.size(), 4, "All the MSDUs must be confirmed");
+    NS_TEST_EXPECT_MSG_EQ(m_status[0], IEEE_802_15_4_SUCCESS, "MSDU 0 must be sent");
+    NS_TEST_EXPECT_MSG_EQ(m_status[1],
+                          IEEE_802_15_4_TRANSACTION_OVERFLOW,
+                          "MSDU 1 must be dropped");
+    NS_TEST_EXPECT_MSG_EQ(m_status[2],
+                          IEEE_802_15_4_TRANSACTION_OVERFLOW,
+                          "MSDU 2 must be dropped");
+    NS_TEST_EXPECT_MSG_EQ(m_status[3], IEEE_802_15_4_SUCCESS, "MSDU 3 must be sent");
+
+    // Stale first: the MSDU queued for more than 500 us makes room for MSDU 2,
+    // MSDU 2 is fresh and MSDU 3 is rejected.
+    RunPolicy(TX_QUEUE_STALE_FIRST, MilliSeconds(1));
+    NS_TEST_ASSERT_MSG_EQ(m_status.size(), 4, "All the MSDUs must be confirmed");
+    NS_TEST_EXPECT_MSG_EQ(m_status[0], IEEE_802_15_4_SUCCESS, "MSDU 0 must be sent");
+    NS_TEST_EXPECT_MSG_EQ(m_status[1],
+                          IEEE_802_15_4_TRANSACTION_EXPIRED,
+                          "MSDU 1 must expire");
+    NS_TEST_EXPECT_MSG_EQ(m_status[2], IEEE_802_15_4_SUCCESS, "MSDU 2 must be sent");
+    NS_TEST_EXPECT_MSG_EQ(m_status[3],
+                          IEEE_802_15_4_TRANSACTION_OVERFLOW,
+                          "MSDU 3 must be rejected");
+
+    // The transmit queue holds 32 MSDUs by default.
+    RunPolicy(TX_QUEUE_TAIL_DROP, Time(0), std::nullopt, 40);
+    NS_TEST_ASSERT_MSG_EQ(m_status.size(), 40, "All the MSDUs must be confirmed");
+    for (const auto& status : m_status)
+    {
+        LrWpanMcpsDataConfirmStatus expected =
+            (status.first < 32) ? IEEE_802_15_4_SUCCESS : IEEE_802_15_4_TRANSACTION_OVERFLOW;
+        NS_TEST_EXPECT_MSG_EQ(status.second, expected, "Only the first 32 MSDUs must be sent");
+    }
+
+    // The transmit queue is not limited if its size is set to 0.
+    RunPolicy(TX_QUEUE_TAIL_DROP, Time(0), 0, 100);
+    NS_TEST_ASSERT_MSG_EQ(m_status.size(), 100, "All the MSDUs must be confirmed");
+    for (const auto& status : m_status)
+    {
+        NS_TEST_EXPECT_MSG_EQ(status.second, IEEE_802_15_4_SUCCESS, "All the MSDUs must be sent");
+    }
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the association responses delivered through the pending transaction list
+ * (indirect transmissions) to several devices.
+ */
+class TestIndirectTxAssociation : public TestCase
+{
+  public:
+    TestIndirectTxAssociation();
+    ~TestIndirectTxAssociation() override;
+
+  private:
+    /**
+     * Function called by the coordinator when a device requests the association.
+     * \param params MLME associate indication parameters
+     */
+    void AssociateIndication(MlmeAssociateIndicationParams params);
+
+    /**
+     * Function called by a device at the end of its association.
+     * \param device the device
+     * \param params MLME associate confirm parameters
+     */
+    void AssociateConfirm(Ptr<LrWpanNetDevice> device, MlmeAssociateConfirmParams params);
+
+    /**
+     * Function called when a transaction is dequeued from the pending transaction list.
+     * \param p the packet
+     */
+    void IndTxDequeue(Ptr<const Packet> p);
+
+    /**
+     * Function called when a transaction is dropped from the pending transaction list.
+     * \param p the packet
+     */
+    void IndTxDrop(Ptr<const Packet> p);
+
+    void DoRun() override;
+
+    Ptr<LrWpanNetDevice> m_coord;                                //!< The PAN coordinator
+    std::map<Mac64Address, MlmeAssociateConfirmParams> m_confirm; //!< Confirm of each device
+    uint32_t m_dequeued;                                         //!< Dequeued transactions
+    uint32_t m_dropped;                                          //!< Dropped transactions
+};
+
+TestIndirectTxAssociation::TestIndirectTxAssociation()
+    : TestCase("Test the association of several devices through indirect transmissions"),
+      m_dequeued(0),
+      m_dropped(0)
+{
+}
+
+TestIndirectTxAssociation::~TestIndirectTxAssociation()
+{
+}
+
+void
+TestIndirectTxAssociation::AssociateIndication(MlmeAssociateIndicationParams params)
+{
+    // The short address allocated is made of the last bytes of the extended address.
+    uint8_t buffer64MacAddr[8];
+    uint8_t buffer16MacAddr[2];
+    params.m_extDevAddr.CopyTo(buffer64MacAddr);
+    buffer16MacAddr[0] = buffer64MacAddr[6];
+    buffer16MacAddr[1] = buffer64MacAddr[7];
+
+    MlmeAssociateResponseParams assocRespParams;
+    assocRespParams.m_extDevAddr = params.m_extDevAddr;
+    assocRespParams.m_status = LrWpanAssociationStatus::ASSOCIATED;
+    assocRespParams.m_assocShortAddr.CopyFrom(buffer16MacAddr);
+    Simulator::ScheduleNow(&LrWpanMac::MlmeAssociateResponse, m_coord->GetMac(), assocRespParams);
+}
+
+void
+TestIndirectTxAssociation::AssociateConfirm(Ptr<LrWpanNetDevice> device,
+                                            MlmeAssociateConfirmParams params)
+{
+    NS_LOG_DEBUG(device->GetMac()->GetExtendedAddress()
+                 << " associated with status " << params.m_status << " and short address "
+                 << device->GetMac()->GetShortAddress());
+    m_confirm[device->GetMac()->GetExtendedAddress()] = params;
+}
+
+void
+TestIndirectTxAssociation::IndTxDequeue(Ptr<const Packet> p)
+{
+    m_dequeued++;
+}
+
+void
+TestIndirectTxAssociation::IndTxDrop(Ptr<const Packet> p)
+{
+    m_dropped++;
+}
+
+void
+TestIndirectTxAssociation::DoRun()
+{
+    // A PAN coordinator in non-beacon mode and 3 end devices requesting the association
+    // at the same time. The association responses wait in the pending transaction list
+    // of the coordinator until each device requests its data. The test checks that each
+    // device receives its own response.
+
+    LogComponentEnable("lr-wpan-mac-test", LOG_LEVEL_DEBUG);
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    std::vector<Ptr<LrWpanNetDevice>> devices;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<LrWpanNetDevice> device = CreateObject<LrWpanNetDevice>();
+        std::ostringstream extAddress;
+        extAddress << "00:00:00:00:00:00:00:0" << i + 1;
+        device->GetMac()->SetExtendedAddress(Mac64Address(extAddress.str().c_str()));
+        device->SetChannel(channel);
+        node->AddDevice(device);
+
+        Ptr<ConstantPositionMobilityModel> mobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(10 * i, 0, 0));
+        device->GetPhy()->SetMobility(mobility);
+        devices.push_back(device);
+    }
+
+    m_coord = devices[0];
+    m_coord->SetAddress(Mac16Address("00:01"));
+    m_coord->GetMac()->SetMlmeAssociateIndicationCallback(
+        MakeCallback(&TestIndirectTxAssociation::AssociateIndication, this));
+    m_coord->GetMac()->TraceConnectWithoutContext(
+        "MacIndTxDequeue",
+        MakeCallback(&TestIndirectTxAssociation::IndTxDequeue, this));
+    m_coord->GetMac()->TraceConnectWithoutContext(
+        "MacIndTxDrop",
+        MakeCallback(&TestIndirectTxAssociation::IndTxDrop, this));
+
+    MlmeStartRequestParams params;
+    params.m_panCoor = true;
+    params.m_PanId = 5;
+    params.m_bcnOrd = 15;
+    params.m_sfrmOrd = 15;
+    params.m_logCh = 11;
+    Simulator::ScheduleWithContext(m_coord->GetNode()->GetId(),
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeStartRequest,
+                                   m_coord->GetMac(),
+                                   params);
+
+    for (uint32_t i = 1; i < devices.size(); i++)
+    {
+        devices[i]->GetMac()->SetMlmeAssociateConfirmCallback(
+            MakeCallback(&TestIndirectTxAssociation::AssociateConfirm, this).Bind(devices[i]));
+
+        MlmeAssociateRequestParams assocParams;
+        assocParams.m_chNum = 11;
+        assocParams.m_chPage = 0;
+        assocParams.m_coordPanId = 5;
+        assocParams.m_coordAddrMode = SHORT_ADDR;
+        assocParams.m_coordShortAddr = Mac16Address("00:01");
+        assocParams.m_capabilityInfo.SetShortAddrAllocOn(true);
+        Simulator::ScheduleWithContext(devices[i]->GetNode()->GetId(),
+                                       Seconds(2.0) + MilliSeconds(i),
+                                       &LrWpanMac::MlmeAssociateRequest,
+                                       devices[i]->GetMac(),
+                                       assocParams);
+    }
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_dequeued, 3, "All the association responses must be dequeued");
+    NS_TEST_EXPECT_MSG_EQ(m_dropped, 0, "No association response must expire");
+    NS_TEST_ASSERT_MSG_EQ(m_confirm.size(), 3, "All the devices must confirm the association");
+    for (uint32_t i = 1; i < devices.size(); i++)
+    {
+        const MlmeAssociateConfirmParams& confirm =
+            m_confirm[devices[i]->GetMac()->GetExtendedAddress()];
+        std::ostringstream shortAddress;
+        shortAddress << "00:0" << i + 1;
+        NS_TEST_EXPECT_MSG_EQ(confirm.m_status,
+                              MLMEASSOC_SUCCESS,
+                              "The association of device " << i << " must succeed");
+        NS_TEST_EXPECT_MSG_EQ(devices[i]->GetMac()->GetShortAddress(),
+                              Mac16Address(shortAddress.str().c_str()),
+                              "Device " << i << " must receive its own response");
+    }
+
+    m_coord = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the extraction of indirect data with MLME-POLL and the pending address fields
+ * of the beacons.
+ */
+class TestPollIndirectData : public TestCase
+{
+  public:
+    TestPollIndirectData();
+    ~TestPollIndirectData() override;
+
+  private:
+    /**
+     * Function called by the end device at the end of a poll.
+     * \param params MLME poll confirm parameters
+     */
+    void PollConfirm(MlmePollConfirmParams params);
+
+    /**
+     * Function called when the end device receives a data frame.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndication(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * Function called when the coordinator ends the transmission of an MSDU.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirm(McpsDataConfirmParams params);
+
+    void DoRun() override;
+
+    std::vector<LrWpanMlmePollConfirmStatus> m_pollStatus; //!< The status of the polls
+    std::vector<Time> m_pollTime;                          //!< The end time of the polls
+    uint32_t m_rxPackets;                                  //!< The packets received by the device
+    std::vector<McpsDataConfirmParams> m_dataConfirm;      //!< The MSDUs sent by the coordinator
+};
+
+TestPollIndirectData::TestPollIndirectData()
+    : TestCase("Test the extraction of indirect data with polls"),
+      m_rxPackets(0)
+{
+}
+
+TestPollIndirectData::~TestPollIndirectData()
+{
+}
+
+void
+TestPollIndirectData::PollConfirm(MlmePollConfirmParams params)
+{
+    NS_LOG_DEBUG("Poll confirm with status " << params.m_status);
+    m_pollStatus.push_back(params.m_status);
+    m_pollTime.push_back(Simulator::Now());
+}
+
+void
+TestPollIndirectData::DataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    NS_LOG_DEBUG("Received packet of size " << p->GetSize());
+    m_rxPackets++;
+}
+
+void
+TestPollIndirectData::DataConfirm(McpsDataConfirmParams params)
+{
+    NS_LOG_DEBUG("MSDU handle " << static_cast<uint32_t>(params.m_msduHandle) << " status "
+                                << params.m_status);
+    m_dataConfirm.push_back(params);
+}
+
+void
+TestPollIndirectData::DoRun()
+{
+    // [00:01] PAN coordinator sending beacons every 0.98304 s (BO = SO = 6)
+    // [00:02] End device tracking the beacons
+    //
+    // At 2.2 s, the end device polls the coordinator, which has no data for it.
+    // At 2.5 s, the coordinator keeps a data frame for the end device in its pending
+    // transaction list. The next beacon lists the address of the end device in its pending
+    // address fields, the end device polls the coordinator and receives the frame.
+
+    LogComponentEnable("lr-wpan-mac-test", LOG_LEVEL_DEBUG);
+
+    Ptr<Node> coordNode = CreateObject<Node>();
+    Ptr<Node> endNode = CreateObject<Node>();
+    Ptr<LrWpanNetDevice> coordNetDevice = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> endNodeNetDevice = CreateObject<LrWpanNetDevice>();
+    coordNetDevice->SetAddress(Mac16Address("00:01"));
+    endNodeNetDevice->SetAddress(Mac16Address("00:02"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    coordNetDevice->SetChannel(channel);
+    endNodeNetDevice->SetChannel(channel);
+    coordNode->AddDevice(coordNetDevice);
+    endNode->AddDevice(endNodeNetDevice);
+
+    Ptr<ConstantPositionMobilityModel> coordMobility =
+        CreateObject<ConstantPositionMobilityModel>();
+    coordMobility->SetPosition(Vector(0, 0, 0));
+    coordNetDevice->GetPhy()->SetMobility(coordMobility);
+    Ptr<ConstantPositionMobilityModel> endNodeMobility =
+        CreateObject<ConstantPositionMobilityModel>();
+    endNodeMobility->SetPosition(Vector(10, 0, 0));
+    endNodeNetDevice->GetPhy()->SetMobility(endNodeMobility);
+
+    coordNetDevice->GetMac()->SetMcpsDataConfirmCallback(
+        MakeCallback(&TestPollIndirectData::DataConfirm, this));
+    endNodeNetDevice->GetMac()->SetMlmePollConfirmCallback(
+        MakeCallback(&TestPollIndirectData::PollConfirm, this));
+    endNodeNetDevice->GetMac()->SetMcpsDataIndicationCallback(
+        MakeCallback(&TestPollIndirectData::DataIndication, this));
+
+    // Manual association of the end device
+    endNodeNetDevice->GetMac()->SetPanId(5);
+    endNodeNetDevice->GetMac()->SetAssociatedCoor(Mac16Address("00:01"));
+
+    MlmeStartRequestParams startParams;
+    startParams.m_panCoor = true;
+    startParams.m_PanId = 5;
+    startParams.m_bcnOrd = 6;
+    startParams.m_sfrmOrd = 6;
+    startParams.m_logCh = 11;
+    Simulator::ScheduleWithContext(coordNode->GetId(),
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeStartRequest,
+                                   coordNetDevice->GetMac(),
+                                   startParams);
+
+    MlmeSyncRequestParams syncParams;
+    syncParams.m_logCh = 11;
+    syncParams.m_trackBcn = true;
+    Simulator::ScheduleWithContext(endNode->GetId(),
+                                   Seconds(1.5),
+                                   &LrWpanMac::MlmeSyncRequest,
+                                   endNodeNetDevice->GetMac(),
+                                   syncParams);
+
+    MlmePollRequestParams pollParams;
+    pollParams.m_coorAddrMode = SHORT_ADDR;
+    pollParams.m_coorPanId = 5;
+    pollParams.m_coorShortAddr = Mac16Address("00:01");
+    Simulator::ScheduleWithContext(endNode->GetId(),
+                                   Seconds(2.2),
+                                   &LrWpanMac::MlmePollRequest,
+                                   endNodeNetDevice->GetMac(),
+                                   pollParams);
+
+    McpsDataRequestParams dataParams;
+    dataParams.m_dstPanId = 5;
+    dataParams.m_srcAddrMode = SHORT_ADDR;
+    dataParams.m_dstAddrMode = SHORT_ADDR;
+    dataParams.m_dstAddr = Mac16Address("00:02");
+    dataParams.m_msduHandle = 9;
+    dataParams.m_txOptions = TX_OPTION_ACK | TX_OPTION_INDIRECT;
+    Simulator::ScheduleWithContext(coordNode->GetId(),
+                                   Seconds(2.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   coordNetDevice->GetMac(),
+                                   dataParams,
+                                   Create<Packet>(20));
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_pollStatus.size(), 2, "Two polls must be confirmed");
+    NS_TEST_EXPECT_MSG_EQ(m_pollStatus[0],
+                          MLMEPOLL_NO_DATA,
+                          "The first poll must not find any data");
+    NS_TEST_EXPECT_MSG_EQ(m_pollStatus[1], MLMEPOLL_SUCCESS, "The second poll must get the data");
+    NS_TEST_EXPECT_MSG_GT(m_pollTime[1],
+                          Seconds(2.5),
+                          "The second poll must follow the beacon after the data request");
+    NS_TEST_EXPECT_MSG_EQ(m_rxPackets, 1, "The end device must receive the packet");
+    NS_TEST_ASSERT_MSG_EQ(m_dataConfirm.size(), 1, "The coordinator must confirm the MSDU");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(m_dataConfirm[0].m_msduHandle),
+                          9,
+                          "Unexpected MSDU handle");
+    NS_TEST_EXPECT_MSG_EQ(m_dataConfirm[0].m_status,
+                          IEEE_802_15_4_SUCCESS,
+                          "The indirect transmission must succeed");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test that the beacons advertise every destination of the pending transaction list
+ * in turn when it holds more destinations than the pending address fields can list.
+ */
+class TestPendingAddrRotation : public TestCase
+{
+  public:
+    TestPendingAddrRotation();
+    ~TestPendingAddrRotation() override;
+
+  private:
+    /**
+     * Get the short address of an end device.
+     * \param index the index of the end device
+     * \return the short address 00:02 for the first end device, 00:03 for the second one, ...
+     */
+    static Mac16Address GetDeviceAddress(uint8_t index);
+
+    /**
+     * Keep a data frame for an end device in the pending transaction list of the coordinator.
+     * \param index the index of the end device
+     */
+    void SendIndirect(uint8_t index);
+
+    /**
+     * Function called when an end device receives a data frame.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndication(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * Function called when the coordinator ends the transmission of an MSDU.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirm(McpsDataConfirmParams params);
+
+    void DoRun() override;
+
+    static const uint8_t NUM_DEVICES = 10; //!< The number of end devices
+
+    Ptr<LrWpanNetDevice> m_coord;                 //!< The PAN coordinator
+    std::map<Mac16Address, uint32_t> m_rxPackets; //!< The packets received by each end device
+};
+
+TestPendingAddrRotation::TestPendingAddrRotation()
+    : TestCase("Test the rotation of the pending addresses of the beacons")
+{
+}
+
+TestPendingAddrRotation::~TestPendingAddrRotation()
+{
+}
+
+Mac16Address
+TestPendingAddrRotation::GetDeviceAddress(uint8_t index)
+{
+    uint8_t buffer[2] = {0, static_cast<uint8_t>(index + 2)};
+    Mac16Address address;
+    address.CopyFrom(buffer);
+    return address;
+}
+
+void
+TestPendingAddrRotation::SendIndirect(uint8_t index)
+{
+    McpsDataRequestParams dataParams;
+    dataParams.m_dstPanId = 5;
+    dataParams.m_srcAddrMode = SHORT_ADDR;
+    dataParams.m_dstAddrMode = SHORT_ADDR;
+    dataParams.m_dstAddr = GetDeviceAddress(index);
+    dataParams.m_msduHandle = index;
+    dataParams.m_txOptions = TX_OPTION_ACK | TX_OPTION_INDIRECT;
+    m_coord->GetMac()->McpsDataRequest(dataParams, Create<Packet>(20));
+}
+
+void
+TestPendingAddrRotation::DataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    NS_LOG_DEBUG("Device " << params.m_dstAddr << " received packet of size " << p->GetSize());
+    m_rxPackets[params.m_dstAddr]++;
+}
+
+void
+TestPendingAddrRotation::DataConfirm(McpsDataConfirmParams params)
+{
+    // The coordinator always has a pending transaction for every end device.
+    SendIndirect(params.m_msduHandle);
+}
+
+void
+TestPendingAddrRotation::DoRun()
+{
+    // [00:01] PAN coordinator sending beacons every 0.98304 s (BO = SO = 6)
+    // [00:02 - 00:0b] 10 end devices tracking the beacons
+    //
+    // At 2.5 s, the coordinator keeps a data frame for every end device in its pending
+    // transaction list, and keeps another one each time a frame is sent. The pending address
+    // fields list at most 7 addresses, the addresses of the oldest transactions must be listed
+    // so that every end device eventually polls the coordinator.
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    Ptr<Node> coordNode = CreateObject<Node>();
+    m_coord = CreateObject<LrWpanNetDevice>();
+    m_coord->SetAddress(Mac16Address("00:01"));
+    m_coord->SetChannel(channel);
+    coordNode->AddDevice(m_coord);
+    Ptr<ConstantPositionMobilityModel> coordMobility =
+        CreateObject<ConstantPositionMobilityModel>();
+    coordMobility->SetPosition(Vector(0, 0, 0));
+    m_coord->GetPhy()->SetMobility(coordMobility);
+    m_coord->GetMac()->SetMcpsDataConfirmCallback(
+        MakeCallback(&TestPendingAddrRotation::DataConfirm, this));
+
+    MlmeSyncRequestParams syncParams;
+    syncParams.m_logCh = 11;
+    syncParams.m_trackBcn = true;
+    for (uint8_t i = 0; i < NUM_DEVICES; i++)
+    {
+        Ptr<Node> endNode = CreateObject<Node>();
+        Ptr<LrWpanNetDevice> endNodeNetDevice = CreateObject<LrWpanNetDevice>();
+        endNodeNetDevice->SetAddress(GetDeviceAddress(i));
+        endNodeNetDevice->SetChannel(channel);
+        endNode->AddDevice(endNodeNetDevice);
+        Ptr<ConstantPositionMobilityModel> endNodeMobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        endNodeMobility->SetPosition(Vector(10, i, 0));
+        endNodeNetDevice->GetPhy()->SetMobility(endNodeMobility);
+        endNodeNetDevice->GetMac()->SetMcpsDataIndicationCallback(
+            MakeCallback(&TestPendingAddrRotation::DataIndication, this));
+
+        // Manual association of the end device
+        endNodeNetDevice->GetMac()->SetPanId(5);
+        endNodeNetDevice->GetMac()->SetAssociatedCoor(Mac16Address("00:01"));
+        Simulator::ScheduleWithContext(endNode->GetId(),
+                                       Seconds(1.5),
+                                       &LrWpanMac::MlmeSyncRequest,
+                                       endNodeNetDevice->GetMac(),
+                                       syncParams);
+
+        Simulator::ScheduleWithContext(coordNode->GetId(),
+                                       Seconds(2.5),
+                                       &TestPendingAddrRotation::SendIndirect,
+                                       this,
+                                       i);
+    }
+
+    MlmeStartRequestParams startParams;
+    startParams.m_panCoor = true;
+    startParams.m_PanId = 5;
+    startParams.m_bcnOrd = 6;
+    startParams.m_sfrmOrd = 6;
+    startParams.m_logCh = 11;
+    Simulator::ScheduleWithContext(coordNode->GetId(),
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeStartRequest,
+                                   m_coord->GetMac(),
+                                   startParams);
+
+    Simulator::Stop(Seconds(8));
+    Simulator::Run();
+
+    for (uint8_t i = 0; i < NUM_DEVICES; i++)
+    {
+        Mac16Address address = GetDeviceAddress(i);
+        NS_TEST_EXPECT_MSG_GT(m_rxPackets[address],
+                              0,
+                              "End device " << address << " never advertised in the beacons");
+    }
+
+    m_coord = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the allocation and deallocation of a GTS and the transmission of a data frame
+ * in the CFP.
+ */
+class TestGtsCfpTransmission : public TestCase
+{
+  public:
+    TestGtsCfpTransmission();
+    ~TestGtsCfpTransmission() override;
+
+  private:
+    /**
+     * Function called by the end device at the end of a GTS request.
+     * \param params MLME GTS confirm parameters
+     */
+    void GtsConfirm(MlmeGtsConfirmParams params);
+
+    /**
+     * Function called when the coordinator allocates or deallocates a GTS.
+     * \param params MLME GTS indication parameters
+     */
+    void GtsIndication(MlmeGtsIndicationParams params);
+
+    /**
+     * Function called when the coordinator receives a data frame.
+     * \param params MCPS data indication parameters
+     * \param p packet
+     */
+    void DataIndication(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * Function called when the end device ends the transmission of an MSDU.
+     * \param params MCPS data confirm parameters
+     */
+    void DataConfirm(McpsDataConfirmParams params);
+
+    /**
+     * Function called when the period of the outgoing superframe of the coordinator changes.
+     * \param oldValue the previous period
+     * \param newValue the current period
+     */
+    void CoordSuperframeStatus(SuperframeStatus oldValue, SuperframeStatus newValue);
+
+    void DoRun() override;
+
+    std::vector<LrWpanMlmeGtsConfirmStatus> m_gtsStatus; //!< The status of the GTS requests
+    std::vector<MlmeGtsIndicationParams> m_gtsIndication; //!< The GTS changes of the coordinator
+    std::vector<SuperframeStatus> m_rxPeriod;  //!< The coordinator period of the received frames
+    std::vector<McpsDataConfirmParams> m_dataConfirm; //!< The MSDUs sent by the end device
+    SuperframeStatus m_coordStatus;                   //!< The coordinator superframe period
+};
+
+TestGtsCfpTransmission::TestGtsCfpTransmission()
+    : TestCase("Test the GTS allocation and the transmissions in the CFP"),
+      m_coordStatus(INACTIVE)
+{
+}
+
+TestGtsCfpTransmission::~TestGtsCfpTransmission()
+{
+}
+
+void
+TestGtsCfpTransmission::GtsConfirm(MlmeGtsConfirmParams params)
+{
+    NS_LOG_DEBUG("GTS confirm with status " << params.m_status);
+    m_gtsStatus.push_back(params.m_status);
+}
+
+void
+TestGtsCfpTransmission::GtsIndication(MlmeGtsIndicationParams params)
+{
+    NS_LOG_DEBUG("GTS indication for " << params.m_devAddress);
+    m_gtsIndication.push_back(params);
+}
+
+void
+TestGtsCfpTransmission::DataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    NS_LOG_DEBUG("Received packet of size " << p->GetSize());
+    m_rxPeriod.push_back(m_coordStatus);
+}
+
+void
+TestGtsCfpTransmission::DataConfirm(McpsDataConfirmParams params)
+{
+    NS_LOG_DEBUG("MSDU handle " << static_cast<uint32_t>(params.m_msduHandle) << " status "
+                                << params.m_status);
+    m_dataConfirm.push_back(params);
+}
+
+void
+TestGtsCfpTransmission::CoordSuperframeStatus(SuperframeStatus oldValue, SuperframeStatus newValue)
+{
+    m_coordStatus = newValue;
+}
+
+void
+TestGtsCfpTransmission::DoRun()
+{
+    // [00:01] PAN coordinator sending beacons every 0.98304 s (BO = SO = 6)
+    // [00:02] End device tracking the beacons
+    //
+    // At 2.2 s, the end device requests a transmit GTS of 2 slots, described in the next beacon.
+    // At 3.2 s, the end device sends a data frame in its GTS, received by the coordinator
+    // during the CFP.
+    // At 4.2 s, the end device deallocates the GTS, a data frame sent in a GTS at 4.5 s is
+    // rejected.
+
+    LogComponentEnable("lr-wpan-mac-test", LOG_LEVEL_DEBUG);
+
+    Ptr<Node> coordNode = CreateObject<Node>();
+    Ptr<Node> endNode = CreateObject<Node>();
+    Ptr<LrWpanNetDevice> coordNetDevice = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> endNodeNetDevice = CreateObject<LrWpanNetDevice>();
+    coordNetDevice->SetAddress(Mac16Address("00:01"));
+    endNodeNetDevice->SetAddress(Mac16Address("00:02"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    coordNetDevice->SetChannel(channel);
+    endNodeNetDevice->SetChannel(channel);
+    coordNode->AddDevice(coordNetDevice);
+    endNode->AddDevice(endNodeNetDevice);
+
+    Ptr<ConstantPositionMobilityModel> coordMobility =
+        CreateObject<ConstantPositionMobilityModel>();
+    coordMobility->SetPosition(Vector(0, 0, 0));
+    coordNetDevice->GetPhy()->SetMobility(coordMobility);
+    Ptr<ConstantPositionMobilityModel> endNodeMobility =
+        CreateObject<ConstantPositionMobilityModel>();
+    endNodeMobility->SetPosition(Vector(10, 0, 0));
+    endNodeNetDevice->GetPhy()->SetMobility(endNodeMobility);
+
+    coordNetDevice->GetMac()->SetMlmeGtsIndicationCallback(
+        MakeCallback(&TestGtsCfpTransmission::GtsIndication, this));
+    coordNetDevice->GetMac()->SetMcpsDataIndicationCallback(
+        MakeCallback(&TestGtsCfpTransmission::DataIndication, this));
+    coordNetDevice->GetMac()->TraceConnectWithoutContext(
+        "MacOutSuperframeStatus",
+        MakeCallback(&TestGtsCfpTransmission::CoordSuperframeStatus, this));
+    endNodeNetDevice->GetMac()->SetMlmeGtsConfirmCallback(
+        MakeCallback(&TestGtsCfpTransmission::GtsConfirm, this));
+    endNodeNetDevice->GetMac()->SetMcpsDataConfirmCallback(
+        MakeCallback(&TestGtsCfpTransmission::DataConfirm, this));
+
+    // Manual association of the end device
+    endNodeNetDevice->GetMac()->SetPanId(5);
+    endNodeNetDevice->GetMac()->SetAssociatedCoor(Mac16Address("00:01"));
+
+    MlmeStartRequestParams startParams;
+    startParams.m_panCoor = true;
+    startParams.m_PanId = 5;
+    startParams.m_bcnOrd = 6;
+    startParams.m_sfrmOrd = 6;
+    startParams.m_logCh = 11;
+    Simulator::ScheduleWithContext(coordNode->GetId(),
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeStartRequest,
+                                   coordNetDevice->GetMac(),
+                                   startParams);
+
+    MlmeSyncRequestParams syncParams;
+    syncParams.m_logCh = 11;
+    syncParams.m_trackBcn = true;
+    Simulator::ScheduleWithContext(endNode->GetId(),
+                                   Seconds(1.5),
+                                   &LrWpanMac::MlmeSyncRequest,
+                                   endNodeNetDevice->GetMac(),
+                                   syncParams);
+
+    MlmeGtsRequestParams gtsParams;
+    gtsParams.m_gtsCharacteristics.m_gtsLength = 2;
+    gtsParams.m_gtsCharacteristics.m_gtsDirection = false;
+    gtsParams.m_gtsCharacteristics.m_allocation = true;
+    Simulator::ScheduleWithContext(endNode->GetId(),
+                                   Seconds(2.2),
+                                   &LrWpanMac::MlmeGtsRequest,
+                                   endNodeNetDevice->GetMac(),
+                                   gtsParams);
+
+    McpsDataRequestParams dataParams;
+    dataParams.m_dstPanId = 5;
+    dataParams.m_srcAddrMode = SHORT_ADDR;
+    dataParams.m_dstAddrMode = SHORT_ADDR;
+    dataParams.m_dstAddr = Mac16Address("00:01");
+    dataParams.m_msduHandle = 1;
+    dataParams.m_txOptions = TX_OPTION_ACK | TX_OPTION_GTS;
+    Simulator::ScheduleWithContext(endNode->GetId(),
+                                   Seconds(3.2),
+                                   &LrWpanMac::McpsDataRequest,
+                                   endNodeNetDevice->GetMac(),
+                                   dataParams,
+                                   Create<Packet>(20));
+
+    gtsParams.m_gtsCharacteristics.m_allocation = false;
+    Simulator::ScheduleWithContext(endNode->GetId(),
+                                   Seconds(4.2),
+                                   &LrWpanMac::MlmeGtsRequest,
+                                   endNodeNetDevice->GetMac(),
+                                   gtsParams);
+
+    dataParams.m_msduHandle = 2;
+    Simulator::ScheduleWithContext(endNode->GetId(),
+                                   Seconds(4.5),
+                                   &LrWpanMac::McpsDataRequest,
+                                   endNodeNetDevice->GetMac(),
+                                   dataParams,
+                                   Create<Packet>(20));
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_gtsStatus.size(), 2, "Two GTS requests must be confirmed");
+    NS_TEST_EXPECT_MSG_EQ(m_gtsStatus[0], MLMEGTS_SUCCESS, "The GTS must be allocated");
+    NS_TEST_EXPECT_MSG_EQ(m_gtsStatus[1], MLMEGTS_SUCCESS, "The GTS must be deallocated");
+    NS_TEST_ASSERT_MSG_EQ(m_gtsIndication.size(), 2, "The coordinator must indicate both changes");
+    NS_TEST_EXPECT_MSG_EQ(m_gtsIndication[0].m_devAddress,
+                          Mac16Address("00:02"),
+                          "Unexpected GTS owner");
+    NS_TEST_EXPECT_MSG_EQ(m_gtsIndication[0].m_gtsCharacteristics.m_allocation,
+                          true,
+                          "The first indication must be an allocation");
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxPeriod.size(), 1, "The coordinator must receive one frame");
+    NS_TEST_EXPECT_MSG_EQ(m_rxPeriod[0], CFP, "The frame must be received in the CFP");
+
+    NS_TEST_ASSERT_MSG_EQ(m_dataConfirm.size(), 2, "The end device must confirm both MSDUs");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(m_dataConfirm[0].m_msduHandle),
+                          1,
+                          "Unexpected MSDU handle");
+    NS_TEST_EXPECT_MSG_EQ(m_dataConfirm[0].m_status,
+                          IEEE_802_15_4_SUCCESS,
+                          "The transmission in the GTS must succeed");
+    NS_TEST_EXPECT_MSG_EQ(m_dataConfirm[1].m_status,
+                          IEEE_802_15_4_INVALID_GTS,
+                          "A deallocated GTS cannot be used");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup lr-wpan-test
  * \ingroup tests
@@ -502,6 +1497,11 @@ LrWpanMacTestSuite::LrWpanMacTestSuite()
 {
     AddTestCase(new TestRxOffWhenIdleAfterCsmaFailure, TestCase::QUICK);
     AddTestCase(new TestActiveScanPanDescriptors, TestCase::QUICK);
+    AddTestCase(new TestTxQueueDropPolicy, TestCase::QUICK);
+    AddTestCase(new TestIndirectTxAssociation, TestCase::QUICK);
+    AddTestCase(new TestPollIndirectData, TestCase::QUICK);
+    AddTestCase(new TestPendingAddrRotation, TestCase::QUICK);
+    AddTestCase(new TestGtsCfpTransmission, TestCase::QUICK);
 }
 
 static LrWpanMacTestSuite g_lrWpanMacTestSuite; //!< Static variable for test initialization
@@ -107,6 +107,57 @@ LrWpanPacketTestCase::DoRun()
     // Compare macHdr with receivedMacHdr, macTrailer with receivedMacTrailer,...
 }
 
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan MAC trailer FCS Test
+ */
+class LrWpanFcsTestCase : public TestCase
+{
+  public:
+    LrWpanFcsTestCase();
+    ~LrWpanFcsTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+LrWpanFcsTestCase::LrWpanFcsTestCase()
+    : TestCase("Test the 802.15.4 MAC trailer FCS calculation")
+{
+}
+
+LrWpanFcsTestCase::~LrWpanFcsTestCase()
+{
+}
+
+void
+LrWpanFcsTestCase::DoRun()
+{
+    // CRC-16 check value of the ITU-T polynomial, LSB first, initial value 0x0000
+    const uint8_t checkData[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    Ptr<Packet> p = Create<Packet>(checkData, sizeof(checkData));
+
+    LrWpanMacTrailer macTrailer;
+    macTrailer.EnableFcs(true);
+    macTrailer.SetFcs(p);
+    NS_TEST_EXPECT_MSG_EQ(macTrailer.GetFcs(), 0x2189, "Wrong FCS value");
+    NS_TEST_EXPECT_MSG_EQ(macTrailer.CheckFcs(p), true, "FCS check failed");
+
+    // Any modification of the frame must be detected
+    const uint8_t corruptedData[] = {'1', '2', '3', '4', '5', '6', '7', '8', '8'};
+    Ptr<Packet> corrupted = Create<Packet>(corruptedData, sizeof(corruptedData));
+    NS_TEST_EXPECT_MSG_EQ(macTrailer.CheckFcs(corrupted), false, "FCS error not detected");
+
+    // Frames larger than aMaxPhyPacketSize
+    std::vector<uint8_t> largeData(300, 0x5a);
+    Ptr<Packet> large = Create<Packet>(largeData.data(), largeData.size());
+    macTrailer.SetFcs(large);
+    NS_TEST_EXPECT_MSG_EQ(macTrailer.CheckFcs(large), true, "FCS check of a large frame failed");
+    NS_TEST_EXPECT_MSG_EQ(macTrailer.CheckFcs(p), false, "FCS error not detected");
+}
+
 /**
  * \ingroup lr-wpan-test
  * \ingroup tests
@@ -123,6 +174,7 @@ LrWpanPacketTestSuite::LrWpanPacketTestSuite()
     : TestSuite("lr-wpan-packet", UNIT)
 {
     AddTestCase(new LrWpanPacketTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanFcsTestCase, TestCase::QUICK);
 }
 
 static LrWpanPacketTestSuite g_lrWpanPacketTestSuite; //!< Static variable for test initialization
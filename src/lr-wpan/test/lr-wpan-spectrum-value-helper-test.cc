@@ -16,12 +16,23 @@
  *
  * Author:  Tom Henderson <thomas.r.henderson@boeing.com>
  */
+#include <ns3/constant-position-mobility-model.h>
 #include <ns3/log.h>
+#include <ns3/lr-wpan-interference-helper.h>
+#include <ns3/lr-wpan-mac.h>
+#include <ns3/lr-wpan-net-device.h>
 #include <ns3/lr-wpan-spectrum-value-helper.h>
+#include <ns3/node.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/spectrum-signal-parameters.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/test.h>
 
 #include <cmath>
+#include <vector>
 
 using namespace ns3;
 
@@ -68,8 +79,205 @@ LrWpanSpectrumValueHelperTestCase::DoRun()
                                       pwrWatts,
                                       pwrWatts / 4.0,
                                       "Not equal for channel " << chan << " pwrdBm " << pwrdBm);
+
+            // The shared PSD must match the created one, and be reused.
+            Ptr<const SpectrumValue> shared =
+                LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(pwrdBm, chan);
+            NS_TEST_ASSERT_MSG_EQ_TOL(helper.TotalAvgPower(shared, chan),
+                                      helper.TotalAvgPower(value, chan),
+                                      1e-12 * pwrWatts,
+                                      "Shared PSD differs for channel " << chan << " pwrdBm "
+                                                                        << pwrdBm);
+            NS_TEST_ASSERT_MSG_EQ(
+                LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(pwrdBm, chan),
+                shared,
+                "Shared PSD not reused for channel " << chan << " pwrdBm " << pwrdBm);
         }
     }
+    NS_TEST_ASSERT_MSG_NE(LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(0, 11),
+                          LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(0, 12),
+                          "Different channels must not share the PSD");
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan interference helper in-band power Test
+ */
+class LrWpanInterferenceHelperTestCase : public TestCase
+{
+  public:
+    LrWpanInterferenceHelperTestCase();
+    ~LrWpanInterferenceHelperTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+LrWpanInterferenceHelperTestCase::LrWpanInterferenceHelperTestCase()
+    : TestCase("Test the in-band power accumulated by the 802.15.4 interference helper")
+{
+}
+
+LrWpanInterferenceHelperTestCase::~LrWpanInterferenceHelperTestCase()
+{
+}
+
+void
+LrWpanInterferenceHelperTestCase::DoRun()
+{
+    LrWpanSpectrumValueHelper helper;
+    uint32_t channel = 11;
+    Ptr<SpectrumValue> noise = helper.CreateNoisePowerSpectralDensity(channel);
+    Ptr<LrWpanInterferenceHelper> interference =
+        Create<LrWpanInterferenceHelper>(noise->GetSpectrumModel(), channel);
+
+    // Signals in the channel and in the adjacent channel
+    Ptr<SpectrumValue> signal1 = helper.CreateTxPowerSpectralDensity(0, channel);
+    Ptr<SpectrumValue> signal2 = helper.CreateTxPowerSpectralDensity(-10, channel);
+    Ptr<SpectrumValue> signal3 = helper.CreateTxPowerSpectralDensity(0, channel + 1);
+
+    NS_TEST_EXPECT_MSG_EQ(interference->AddSignal(signal1), true, "Signal not added");
+    NS_TEST_EXPECT_MSG_EQ(interference->AddSignal(signal2), true, "Signal not added");
+    NS_TEST_EXPECT_MSG_EQ(interference->AddSignal(signal3), true, "Signal not added");
+    NS_TEST_EXPECT_MSG_EQ(interference->AddSignal(signal1), false, "Signal added twice");
+
+    // The incremental in-band power matches the power of the accumulated PSD
+    double expected = helper.TotalAvgPower(interference->GetSignalPsd(), channel);
+    NS_TEST_EXPECT_MSG_EQ_TOL(interference->GetSignalPower(),
+                              expected,
+                              expected * 1e-9,
+                              "Wrong in-band power");
+
+    NS_TEST_EXPECT_MSG_EQ(interference->RemoveSignal(signal1), true, "Signal not removed");
+    NS_TEST_EXPECT_MSG_EQ(interference->RemoveSignal(signal1), false, "Signal removed twice");
+    expected = helper.TotalAvgPower(interference->GetSignalPsd(), channel);
+    NS_TEST_EXPECT_MSG_EQ_TOL(interference->GetSignalPower(),
+                              expected,
+                              expected * 1e-9,
+                              "Wrong in-band power after removing a signal");
+
+    interference->RemoveSignal(signal2);
+    interference->RemoveSignal(signal3);
+    NS_TEST_EXPECT_MSG_EQ(interference->GetSignalPower(),
+                          0.0,
+                          "Wrong in-band power without signals");
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Spectrum propagation loss model applying a constant loss to the PSD it receives,
+ * in place.
+ */
+class InPlaceSpectrumPropagationLossModel : public SpectrumPropagationLossModel
+{
+  public:
+    /**
+     * \return the number of PSDs the loss was applied to
+     */
+    uint32_t GetNumCalls() const
+    {
+        return m_numCalls;
+    }
+
+  private:
+    Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParameters> params,
+                                                    Ptr<const MobilityModel> a,
+                                                    Ptr<const MobilityModel> b) const override
+    {
+        m_numCalls++;
+        *(params->psd) *= 1e-3;
+        return params->psd;
+    }
+
+    mutable uint32_t m_numCalls{0}; //!< The number of PSDs the loss was applied to
+};
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test that the transmissions leave the shared transmit PSD unchanged
+ */
+class LrWpanSharedTxPsdTestCase : public TestCase
+{
+  public:
+    LrWpanSharedTxPsdTestCase();
+    ~LrWpanSharedTxPsdTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+LrWpanSharedTxPsdTestCase::LrWpanSharedTxPsdTestCase()
+    : TestCase("Test the shared transmit PSD after a transmission through a spectrum loss model")
+{
+}
+
+LrWpanSharedTxPsdTestCase::~LrWpanSharedTxPsdTestCase()
+{
+}
+
+void
+LrWpanSharedTxPsdTestCase::DoRun()
+{
+    // Test Setup:
+    // Two devices on channel 11 with a transmit power of 0 dBm, the default one. The
+    // spectrum propagation loss model of the channel applies the loss to the PSD it
+    // receives. Device 0 sends a frame to device 1, the transmit PSD shared by the
+    // devices with the same power and channel must not be modified.
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<InPlaceSpectrumPropagationLossModel> loss =
+        CreateObject<InPlaceSpectrumPropagationLossModel>();
+    channel->AddSpectrumPropagationLossModel(loss);
+
+    std::vector<Ptr<LrWpanNetDevice>> devices;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<LrWpanNetDevice> device = CreateObject<LrWpanNetDevice>();
+        device->SetAddress(Mac16Address(i == 0 ? "00:01" : "00:02"));
+        device->SetChannel(channel);
+        node->AddDevice(device);
+        Ptr<ConstantPositionMobilityModel> mobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(10 * i, 0, 0));
+        device->GetPhy()->SetMobility(mobility);
+        devices.push_back(device);
+    }
+
+    McpsDataRequestParams params;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstPanId = 0;
+    params.m_dstAddr = Mac16Address("00:02");
+    params.m_msduHandle = 0;
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(1),
+                                   &LrWpanMac::McpsDataRequest,
+                                   devices[0]->GetMac(),
+                                   params,
+                                   Create<Packet>(20));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(loss->GetNumCalls(), 0, "The loss model must be applied");
+    LrWpanSpectrumValueHelper helper;
+    Ptr<SpectrumValue> expected = helper.CreateTxPowerSpectralDensity(0, 11);
+    Ptr<const SpectrumValue> shared =
+        LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(0, 11);
+    for (size_t i = 0; i < expected->GetValuesN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((*shared)[i],
+                              (*expected)[i],
+                              "The shared transmit PSD changed in band " << i);
+    }
+
+    devices.clear();
+    Simulator::Destroy();
 }
 
 /**
@@ -88,6 +296,8 @@ LrWpanSpectrumValueHelperTestSuite::LrWpanSpectrumValueHelperTestSuite()
     : TestSuite("lr-wpan-spectrum-value-helper", UNIT)
 {
     AddTestCase(new LrWpanSpectrumValueHelperTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanInterferenceHelperTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanSharedTxPsdTestCase, TestCase::QUICK);
 }
 
 static LrWpanSpectrumValueHelperTestSuite
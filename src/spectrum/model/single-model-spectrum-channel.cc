@@ -21,6 +21,7 @@
 
 #include <ns3/angles.h>
 #include <ns3/antenna-model.h>
+#include <ns3/constant-position-mobility-model.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
@@ -36,6 +37,7 @@
 #include <ns3/spectrum-propagation-loss-model.h>
 
 #include <algorithm>
+#include <cmath>
 
 namespace ns3
 {
@@ -45,6 +47,9 @@ NS_LOG_COMPONENT_DEFINE("SingleModelSpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED(SingleModelSpectrumChannel);
 
 SingleModelSpectrumChannel::SingleModelSpectrumChannel()
+    : m_maxInterferenceRange(0.0),
+      m_gridDirty(true),
+      m_gridCellSize(0.0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -53,7 +58,20 @@ void
 SingleModelSpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    for (const auto& mobility : m_trackedMobility)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SingleModelSpectrumChannel::CourseChanged, this));
+    }
+    m_trackedMobility.clear();
+    m_grid.clear();
+    m_unlocatedPhys.clear();
+    m_movingPhys.clear();
     m_phyList.clear();
+    m_rxBands.clear();
+    m_phyIndex.clear();
+    m_skippedSignals.clear();
     m_spectrumModel = nullptr;
     SpectrumChannel::DoDispose();
 }
@@ -65,7 +83,16 @@ SingleModelSpectrumChannel::GetTypeId()
     static TypeId tid = TypeId("ns3::SingleModelSpectrumChannel")
                             .SetParent<SpectrumChannel>()
                             .SetGroupName("Spectrum")
-                            .AddConstructor<SingleModelSpectrumChannel>();
+                            .AddConstructor<SingleModelSpectrumChannel>()
+                            .AddAttribute("MaxInterferenceRange",
+                                          "If positive, the maximum distance in meters between "
+                                          "a transmitter and a receiver. Receivers farther away "
+                                          "are skipped without computing the propagation loss. "
+                                          "Zero disables this feature.",
+                                          DoubleValue(0.0),
+                                          MakeDoubleAccessor(
+                                              &SingleModelSpectrumChannel::m_maxInterferenceRange),
+                                          MakeDoubleChecker<double>(0.0));
     return tid;
 }
 
@@ -76,7 +103,32 @@ SingleModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     auto it = std::find(begin(m_phyList), end(m_phyList), phy);
     if (it != std::end(m_phyList))
     {
+        m_rxBands.erase(m_rxBands.begin() + (it - m_phyList.begin()));
         m_phyList.erase(it);
+        m_gridDirty = true;
+
+        m_phyIndex.clear();
+        for (std::size_t i = 0; i < m_phyList.size(); ++i)
+        {
+            m_phyIndex[m_phyList[i]] = i;
+        }
+        for (auto& signal : m_skippedSignals)
+        {
+            signal.receivers.erase(phy);
+        }
+
+        // Stop tracking the mobility model if no other PHY uses it.
+        Ptr<MobilityModel> mobility = phy->GetMobility();
+        if (mobility && m_trackedMobility.count(mobility) > 0 &&
+            std::none_of(m_phyList.begin(), m_phyList.end(), [&mobility](Ptr<SpectrumPhy> p) {
+                return p->GetMobility() == mobility;
+            }))
+        {
+            mobility->TraceDisconnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&SingleModelSpectrumChannel::CourseChanged, this));
+            m_trackedMobility.erase(mobility);
+        }
     }
 }
 
@@ -84,7 +136,151 @@ void
 SingleModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
+    m_phyIndex[phy] = m_phyList.size();
     m_phyList.push_back(phy);
+    m_rxBands.push_back({false, 0, 0});
+    m_gridDirty = true;
+}
+
+void
+SingleModelSpectrumChannel::SetRxBands(Ptr<SpectrumPhy> phy, size_t begin, size_t end)
+{
+    NS_LOG_FUNCTION(this << phy << begin << end);
+    auto it = m_phyIndex.find(phy);
+    if (it == m_phyIndex.end())
+    {
+        return;
+    }
+    RxBands& rxBands = m_rxBands[it->second];
+    rxBands = {true, begin, std::max(begin, end)};
+
+    // Deliver the rest of the ongoing signals which the receiver missed and
+    // which are now in its range. The beginning of the signal is lost, the
+    // receiver only sees it as interference.
+    PurgeSkippedSignals();
+    for (auto& signal : m_skippedSignals)
+    {
+        if (!IsInRxBands(rxBands, signal.params->psd) || signal.receivers.erase(phy) == 0)
+        {
+            continue;
+        }
+        NS_LOG_LOGIC("delivering the rest of signal " << signal.params << " to " << phy);
+        Ptr<SpectrumSignalParameters> rest = Create<SpectrumSignalParameters>(*signal.params);
+        rest->duration = signal.end - Simulator::Now();
+        StartTxToRx(rest, signal.senderMobility, phy);
+    }
+}
+
+bool
+SingleModelSpectrumChannel::IsInRxBands(const RxBands& rxBands, Ptr<const SpectrumValue> psd)
+{
+    return !rxBands.restricted ||
+           (rxBands.begin < psd->GetActiveBandsEnd() && psd->GetActiveBandsBegin() < rxBands.end);
+}
+
+void
+SingleModelSpectrumChannel::PurgeSkippedSignals()
+{
+    Time now = Simulator::Now();
+    m_skippedSignals.remove_if([now](const SkippedSignal& signal) {
+        return signal.end <= now || signal.receivers.empty();
+    });
+}
+
+void
+SingleModelSpectrumChannel::CourseChanged(Ptr<const MobilityModel>)
+{
+    m_gridDirty = true;
+}
+
+SingleModelSpectrumChannel::GridCell
+SingleModelSpectrumChannel::GetGridCell(const Vector& position) const
+{
+    return GridCell(static_cast<int64_t>(std::floor(position.x / m_gridCellSize)),
+                    static_cast<int64_t>(std::floor(position.y / m_gridCellSize)),
+                    static_cast<int64_t>(std::floor(position.z / m_gridCellSize)));
+}
+
+void
+SingleModelSpectrumChannel::UpdateGrid()
+{
+    if (!m_gridDirty && m_gridCellSize == m_maxInterferenceRange)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+
+    m_gridCellSize = m_maxInterferenceRange;
+    m_grid.clear();
+    m_unlocatedPhys.clear();
+    m_movingPhys.clear();
+    for (std::size_t i = 0; i < m_phyList.size(); ++i)
+    {
+        Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility();
+        if (!mobility)
+        {
+            m_unlocatedPhys.push_back(i);
+            continue;
+        }
+        if (!DynamicCast<ConstantPositionMobilityModel>(mobility))
+        {
+            m_movingPhys.push_back(i);
+            continue;
+        }
+        if (m_trackedMobility.insert(mobility).second)
+        {
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&SingleModelSpectrumChannel::CourseChanged, this));
+        }
+        Vector position = mobility->GetPosition();
+        m_grid[GetGridCell(position)].push_back({i, position});
+    }
+    m_gridDirty = false;
+}
+
+std::vector<std::size_t>
+SingleModelSpectrumChannel::GetRxCandidates(const Vector& senderPosition)
+{
+    UpdateGrid();
+
+    std::vector<std::size_t> candidates = m_unlocatedPhys;
+    for (std::size_t i : m_movingPhys)
+    {
+        if (CalculateDistance(m_phyList[i]->GetMobility()->GetPosition(), senderPosition) <=
+            m_maxInterferenceRange)
+        {
+            candidates.push_back(i);
+        }
+    }
+    GridCell center = GetGridCell(senderPosition);
+    for (int64_t dx = -1; dx <= 1; ++dx)
+    {
+        for (int64_t dy = -1; dy <= 1; ++dy)
+        {
+            for (int64_t dz = -1; dz <= 1; ++dz)
+            {
+                auto cell = m_grid.find(GridCell(std::get<0>(center) + dx,
+                                                 std::get<1>(center) + dy,
+                                                 std::get<2>(center) + dz));
+                if (cell == m_grid.end())
+                {
+                    continue;
+                }
+                for (const auto& entry : cell->second)
+                {
+                    if (CalculateDistance(entry.position, senderPosition) <=
+                        m_maxInterferenceRange)
+                    {
+                        candidates.push_back(entry.index);
+                    }
+                }
+            }
+        }
+    }
+    // Keep the order of m_phyList, as without the grid.
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
 }
 
 void
@@ -114,107 +310,145 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
 
-    for (PhyList::const_iterator rxPhyIterator = m_phyList.begin();
-         rxPhyIterator != m_phyList.end();
-         ++rxPhyIterator)
-    {
-        Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
-        Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+    SkippedSignal skipped;
+    auto startTxToRx = [&](std::size_t i) {
+        if (IsInRxBands(m_rxBands[i], txParams->psd))
+        {
+            StartTxToRx(txParams, senderMobility, m_phyList[i]);
+        }
+        else if (m_phyList[i] != txParams->txPhy)
+        {
+            skipped.receivers.insert(m_phyList[i]);
+        }
+    };
 
-        if (rxNetDevice && txNetDevice)
+    if (m_maxInterferenceRange > 0 && senderMobility)
+    {
+        for (std::size_t i : GetRxCandidates(senderMobility->GetPosition()))
         {
-            // we assume that devices are attached to a node
-            if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
-            {
-                NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
-                             "same node, not supported yet by any pathloss model in ns-3.");
-                continue;
-            }
+            startTxToRx(i);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < m_phyList.size(); ++i)
+        {
+            startTxToRx(i);
         }
+    }
 
-        if ((*rxPhyIterator) != txParams->txPhy)
+    if (!skipped.receivers.empty())
+    {
+        PurgeSkippedSignals();
+        skipped.params = txParams->Copy();
+        skipped.senderMobility = senderMobility;
+        skipped.end = Simulator::Now() + txParams->duration;
+        m_skippedSignals.push_back(std::move(skipped));
+    }
+}
+
+void
+SingleModelSpectrumChannel::StartTxToRx(Ptr<SpectrumSignalParameters> txParams,
+                                        Ptr<MobilityModel> senderMobility,
+                                        Ptr<SpectrumPhy> rxPhy)
+{
+    Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
+    Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+
+    if (rxNetDevice && txNetDevice)
+    {
+        // we assume that devices are attached to a node
+        if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
         {
-            Time delay = MicroSeconds(0);
+            NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                         "same node, not supported yet by any pathloss model in ns-3.");
+            return;
+        }
+    }
 
-            Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
-            NS_LOG_LOGIC("copying signal parameters " << txParams);
-            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    if (rxPhy == txParams->txPhy)
+    {
+        return;
+    }
 
-            if (senderMobility && receiverMobility)
-            {
-                double txAntennaGain = 0;
-                double rxAntennaGain = 0;
-                double propagationGainDb = 0;
-                double pathLossDb = 0;
-                if (rxParams->txAntenna)
-                {
-                    Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
-                    txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                    NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    pathLossDb -= txAntennaGain;
-                }
-                Ptr<AntennaModel> rxAntenna =
-                    DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
-                if (rxAntenna)
-                {
-                    Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
-                    rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
-                    NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
-                    pathLossDb -= rxAntennaGain;
-                }
-                if (m_propagationLoss)
-                {
-                    propagationGainDb =
-                        m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
-                    NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
-                    pathLossDb -= propagationGainDb;
-                }
-                NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
-                // Gain trace
-                m_gainTrace(senderMobility,
-                            receiverMobility,
-                            txAntennaGain,
-                            rxAntennaGain,
-                            propagationGainDb,
-                            pathLossDb);
-                // Pathloss trace
-                m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                if (pathLossDb > m_maxLossDb)
-                {
-                    // beyond range
-                    continue;
-                }
-                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                *(rxParams->psd) *= pathGainLinear;
+    Time delay = MicroSeconds(0);
+    double pathGainLinear = 1.0;
 
-                if (m_propagationDelay)
-                {
-                    delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
-                }
-            }
+    Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
 
-            if (rxNetDevice)
-            {
-                // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
-            }
-            else
-            {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
-            }
+    if (senderMobility && receiverMobility)
+    {
+        double txAntennaGain = 0;
+        double rxAntennaGain = 0;
+        double propagationGainDb = 0;
+        double pathLossDb = 0;
+        if (txParams->txAntenna)
+        {
+            Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
+            txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
+            NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+            pathLossDb -= txAntennaGain;
+        }
+        Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
+        if (rxAntenna)
+        {
+            Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
+            rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+            NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
+            pathLossDb -= rxAntennaGain;
         }
+        if (m_propagationLoss)
+        {
+            propagationGainDb = m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
+            NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
+            pathLossDb -= propagationGainDb;
+        }
+        NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
+        // Gain trace
+        m_gainTrace(senderMobility,
+                    receiverMobility,
+                    txAntennaGain,
+                    rxAntennaGain,
+                    propagationGainDb,
+                    pathLossDb);
+        // Pathloss trace
+        m_pathLossTrace(txParams->txPhy, rxPhy, pathLossDb);
+        if (pathLossDb > m_maxLossDb)
+        {
+            // beyond range, do not even copy the signal parameters
+            return;
+        }
+        pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+
+        if (m_propagationDelay)
+        {
+            delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
+        }
+    }
+
+    NS_LOG_LOGIC("copying signal parameters " << txParams);
+    Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    if (senderMobility && receiverMobility)
+    {
+        *(rxParams->psd) *= pathGainLinear;
+    }
+
+    if (rxNetDevice)
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &SingleModelSpectrumChannel::StartRx,
+                                       this,
+                                       rxParams,
+                                       rxPhy);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is
+        // attached to a node
+        Simulator::Schedule(delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, rxPhy);
     }
 }
 
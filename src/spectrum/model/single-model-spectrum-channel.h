@@ -23,6 +23,12 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-model.h>
 #include <ns3/traced-callback.h>
+#include <ns3/vector.h>
+
+#include <list>
+#include <map>
+#include <set>
+#include <tuple>
 
 namespace ns3
 {
@@ -33,6 +39,23 @@ namespace ns3
  * \brief SpectrumChannel implementation which handles a single spectrum model
  *
  * All SpectrumPhy layers attached to this SpectrumChannel
+ *
+ * If the MaxInterferenceRange attribute is set, the receivers are looked up
+ * in a grid of the positions of the attached PHYs, with cells as large as the
+ * range. The receivers farther than the range from the transmitter are skipped
+ * without computing the propagation loss, so the cost of a transmission depends
+ * on the number of receivers in range rather than on the total number of PHYs.
+ * Only the PHYs with a ConstantPositionMobilityModel are stored in the grid, which
+ * is rebuilt at the next transmission when a PHY is added or removed, or when one
+ * of these mobility models reports a course change. The distance to the other PHYs
+ * is computed from their current position at each transmission, as their mobility
+ * models do not report the course changes along their trajectory.
+ *
+ * The receivers which restricted their bands with SetRxBands are skipped as
+ * well when the active bands of a signal do not overlap their range. The
+ * channel keeps track of the ongoing signals which skipped some receivers, and
+ * delivers the remaining part of the signal to a receiver extending its range
+ * over the signal before the end of the signal.
  */
 class SingleModelSpectrumChannel : public SpectrumChannel
 {
@@ -49,6 +72,7 @@ class SingleModelSpectrumChannel : public SpectrumChannel
     void RemoveRx(Ptr<SpectrumPhy> phy) override;
     void AddRx(Ptr<SpectrumPhy> phy) override;
     void StartTx(Ptr<SpectrumSignalParameters> params) override;
+    void SetRxBands(Ptr<SpectrumPhy> phy, size_t begin, size_t end) override;
 
     // inherited from Channel
     std::size_t GetNDevices() const override;
@@ -60,6 +84,85 @@ class SingleModelSpectrumChannel : public SpectrumChannel
   private:
     void DoDispose() override;
 
+    /// Grid cell coordinates
+    typedef std::tuple<int64_t, int64_t, int64_t> GridCell;
+
+    /// A PHY stored in the grid
+    struct GridEntry
+    {
+        std::size_t index; //!< Index of the PHY in m_phyList
+        Vector position;   //!< Position of the PHY, constant while the grid is valid
+    };
+
+    /// Range of bands delivered to a receiver
+    struct RxBands
+    {
+        bool restricted; //!< False if all the signals are delivered
+        size_t begin;    //!< Index of the first band of the range
+        size_t end;      //!< Index following the last band of the range
+    };
+
+    /// An ongoing signal which was not delivered to some receivers
+    struct SkippedSignal
+    {
+        Ptr<SpectrumSignalParameters> params;   //!< Copy of the transmitted signal
+        Ptr<MobilityModel> senderMobility;      //!< Mobility model of the transmitter
+        Time end;                               //!< End of the transmission
+        std::set<Ptr<SpectrumPhy>> receivers;   //!< Receivers which did not get the signal
+    };
+
+    /**
+     * Check if a signal must be delivered to a receiver.
+     *
+     * \param rxBands the bands of the receiver
+     * \param psd the power spectral density of the signal
+     * \return true if the signal is delivered
+     */
+    static bool IsInRxBands(const RxBands& rxBands, Ptr<const SpectrumValue> psd);
+
+    /**
+     * Forget the skipped signals which are over.
+     */
+    void PurgeSkippedSignals();
+
+    /**
+     * Propagate a transmitted signal to a receiver, computing the propagation
+     * loss and scheduling the reception.
+     *
+     * \param txParams the parameters of the transmitted signal
+     * \param senderMobility the mobility model of the transmitter
+     * \param rxPhy the receiver
+     */
+    void StartTxToRx(Ptr<SpectrumSignalParameters> txParams,
+                     Ptr<MobilityModel> senderMobility,
+                     Ptr<SpectrumPhy> rxPhy);
+
+    /**
+     * Rebuild the grid of the PHY positions, if needed.
+     */
+    void UpdateGrid();
+
+    /**
+     * Get the cell of the grid containing a position.
+     *
+     * \param position the position
+     * \return the grid cell
+     */
+    GridCell GetGridCell(const Vector& position) const;
+
+    /**
+     * Get the receivers which may be in range of a transmitter.
+     *
+     * \param senderPosition the position of the transmitter
+     * \return the indexes in m_phyList of the receivers, in increasing order
+     */
+    std::vector<std::size_t> GetRxCandidates(const Vector& senderPosition);
+
+    /**
+     * Invalidate the grid when a PHY stored in the grid moves.
+     */
+    void CourseChanged(Ptr<const MobilityModel>);
+
     /**
      * Used internally to reschedule transmission after the propagation delay.
      *
@@ -77,6 +180,36 @@ class SingleModelSpectrumChannel : public SpectrumChannel
      * SpectrumModel that this channel instance is supporting.
      */
     Ptr<const SpectrumModel> m_spectrumModel;
+
+    /**
+     * Maximum distance between a transmitter and a receiver, in meters, or zero
+     * if the receivers are not culled by distance.
+     */
+    double m_maxInterferenceRange;
+
+    bool m_gridDirty;      //!< True if the grid must be rebuilt
+    double m_gridCellSize; //!< Size of the grid cells, in meters
+
+    /// Grid of the PHYs which have a ConstantPositionMobilityModel
+    std::map<GridCell, std::vector<GridEntry>> m_grid;
+
+    /// Indexes in m_phyList of the PHYs without a mobility model
+    std::vector<std::size_t> m_unlocatedPhys;
+
+    /// Indexes in m_phyList of the PHYs with another mobility model
+    std::vector<std::size_t> m_movingPhys;
+
+    /// Mobility models which notify the channel of their course changes
+    std::set<Ptr<MobilityModel>> m_trackedMobility;
+
+    /// Bands delivered to the PHYs, in the order of m_phyList
+    std::vector<RxBands> m_rxBands;
+
+    /// Index in m_phyList of the PHYs
+    std::map<Ptr<SpectrumPhy>, std::size_t> m_phyIndex;
+
+    /// Ongoing signals which were not delivered to some receivers
+    std::list<SkippedSignal> m_skippedSignals;
 };
 
 } // namespace ns3
@@ -173,4 +173,10 @@ SpectrumChannel::GetPropagationLossModel()
     return m_propagationLoss;
 }
 
+void
+SpectrumChannel::SetRxBands(Ptr<SpectrumPhy> phy, size_t begin, size_t end)
+{
+    NS_LOG_FUNCTION(this << phy << begin << end);
+}
+
 } // namespace ns3
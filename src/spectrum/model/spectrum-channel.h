@@ -153,6 +153,25 @@ class SpectrumChannel : public Channel
      */
     virtual void AddRx(Ptr<SpectrumPhy> phy) = 0;
 
+    /**
+     * \brief Restrict the signals delivered to a receiver to a range of bands
+     *
+     * A receiver which is switched off or tuned to a part of the spectrum can
+     * use this method so that the channel does not deliver the signals which
+     * are entirely outside of the range. An empty range stops the delivery of
+     * all the signals. When the range is extended, a channel implementation
+     * may deliver the remaining part of the signals which are still ongoing,
+     * as signals without any specific parameters.
+     *
+     * The default implementation ignores the range and delivers all the
+     * signals to the receiver.
+     *
+     * \param phy the SpectrumPhy instance, added to the channel as a receiver
+     * \param begin index of the first band of the range
+     * \param end index following the last band of the range
+     */
+    virtual void SetRxBands(Ptr<SpectrumPhy> phy, size_t begin, size_t end);
+
     /**
      * TracedCallback signature for path loss calculation events.
      *
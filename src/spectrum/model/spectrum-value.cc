@@ -22,25 +22,33 @@
 #include <ns3/math.h>
 #include <ns3/spectrum-value.h>
 
+#include <algorithm>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("SpectrumValue");
 
 SpectrumValue::SpectrumValue()
+    : m_activeBegin(0),
+      m_activeEnd(0)
 {
 }
 
 SpectrumValue::SpectrumValue(Ptr<const SpectrumModel> sof)
     : m_spectrumModel(sof),
-      m_values(sof->GetNumBands())
+      m_values(sof->GetNumBands()),
+      m_activeBegin(0),
+      m_activeEnd(0)
 {
 }
 
 double&
 SpectrumValue::operator[](size_t index)
 {
-    return m_values.at(index);
+    double& value = m_values.at(index);
+    ExtendActiveBands(index, index + 1);
+    return value;
 }
 
 const double&
@@ -76,15 +84,55 @@ SpectrumValue::ConstValuesEnd() const
 Values::iterator
 SpectrumValue::ValuesBegin()
 {
+    SetAllBandsActive();
     return m_values.begin();
 }
 
 Values::iterator
 SpectrumValue::ValuesEnd()
 {
+    SetAllBandsActive();
     return m_values.end();
 }
 
+size_t
+SpectrumValue::GetActiveBandsBegin() const
+{
+    return m_activeBegin;
+}
+
+size_t
+SpectrumValue::GetActiveBandsEnd() const
+{
+    return m_activeEnd;
+}
+
+void
+SpectrumValue::ExtendActiveBands(size_t begin, size_t end)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+    if (m_activeBegin == m_activeEnd)
+    {
+        m_activeBegin = begin;
+        m_activeEnd = end;
+    }
+    else
+    {
+        m_activeBegin = std::min(m_activeBegin, begin);
+        m_activeEnd = std::max(m_activeEnd, end);
+    }
+}
+
+void
+SpectrumValue::SetAllBandsActive()
+{
+    m_activeBegin = 0;
+    m_activeEnd = m_values.size();
+}
+
 Bands::const_iterator
 SpectrumValue::ConstBandsBegin() const
 {
@@ -100,18 +148,21 @@ SpectrumValue::ConstBandsEnd() const
 void
 SpectrumValue::Add(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    // only the active bands of x can change the values
+    Values::iterator it1 = m_values.begin() + x.m_activeBegin;
+    Values::const_iterator it2 = x.m_values.begin() + x.m_activeBegin;
+    Values::const_iterator end2 = x.m_values.begin() + x.m_activeEnd;
+
+    while (it2 != end2)
     {
         *it1 += *it2;
         ++it1;
         ++it2;
     }
+    ExtendActiveBands(x.m_activeBegin, x.m_activeEnd);
 }
 
 void
@@ -124,23 +175,27 @@ SpectrumValue::Add(double s)
         *it1 += s;
         ++it1;
     }
+    SetAllBandsActive();
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    // only the active bands of x can change the values
+    Values::iterator it1 = m_values.begin() + x.m_activeBegin;
+    Values::const_iterator it2 = x.m_values.begin() + x.m_activeBegin;
+    Values::const_iterator end2 = x.m_values.begin() + x.m_activeEnd;
+
+    while (it2 != end2)
     {
         *it1 -= *it2;
         ++it1;
         ++it2;
     }
+    ExtendActiveBands(x.m_activeBegin, x.m_activeEnd);
 }
 
 void
@@ -152,13 +207,15 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    // the values outside the active bands stay zero
+    Values::iterator it1 = m_values.begin() + m_activeBegin;
+    Values::iterator end1 = m_values.begin() + m_activeEnd;
+    Values::const_iterator it2 = x.m_values.begin() + m_activeBegin;
+
+    while (it1 != end1)
     {
         *it1 *= *it2;
         ++it1;
@@ -169,9 +226,11 @@ SpectrumValue::Multiply(const SpectrumValue& x)
 void
 SpectrumValue::Multiply(double s)
 {
-    Values::iterator it1 = m_values.begin();
+    // the values outside the active bands stay zero
+    Values::iterator it1 = m_values.begin() + m_activeBegin;
+    Values::iterator end1 = m_values.begin() + m_activeEnd;
 
-    while (it1 != m_values.end())
+    while (it1 != end1)
     {
         *it1 *= s;
         ++it1;
@@ -193,15 +252,22 @@ SpectrumValue::Divide(const SpectrumValue& x)
         ++it1;
         ++it2;
     }
+    SetAllBandsActive();
 }
 
 void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    Values::iterator it1 = m_values.begin();
+    if (s == 0)
+    {
+        // 0 / 0 is not a number, process all the bands
+        SetAllBandsActive();
+    }
+    Values::iterator it1 = m_values.begin() + m_activeBegin;
+    Values::iterator end1 = m_values.begin() + m_activeEnd;
 
-    while (it1 != m_values.end())
+    while (it1 != end1)
     {
         *it1 /= s;
         ++it1;
@@ -211,9 +277,10 @@ SpectrumValue::Divide(double s)
 void
 SpectrumValue::ChangeSign()
 {
-    Values::iterator it1 = m_values.begin();
+    Values::iterator it1 = m_values.begin() + m_activeBegin;
+    Values::iterator end1 = m_values.begin() + m_activeEnd;
 
-    while (it1 != m_values.end())
+    while (it1 != end1)
     {
         *it1 = -(*it1);
         ++it1;
@@ -234,6 +301,7 @@ SpectrumValue::ShiftLeft(int n)
         m_values.at(i) = 0;
         i++;
     }
+    SetAllBandsActive();
 }
 
 void
@@ -250,6 +318,7 @@ SpectrumValue::ShiftRight(int n)
         m_values.at(i) = 0;
         --i;
     }
+    SetAllBandsActive();
 }
 
 void
@@ -263,6 +332,7 @@ SpectrumValue::Pow(double exp)
         *it1 = std::pow(*it1, exp);
         ++it1;
     }
+    SetAllBandsActive();
 }
 
 void
@@ -276,6 +346,7 @@ SpectrumValue::Exp(double base)
         *it1 = std::pow(base, *it1);
         ++it1;
     }
+    SetAllBandsActive();
 }
 
 void
@@ -289,6 +360,7 @@ SpectrumValue::Log10()
         *it1 = std::log10(*it1);
         ++it1;
     }
+    SetAllBandsActive();
 }
 
 void
@@ -302,6 +374,7 @@ SpectrumValue::Log2()
         *it1 = log2(*it1);
         ++it1;
     }
+    SetAllBandsActive();
 }
 
 void
@@ -315,14 +388,16 @@ SpectrumValue::Log()
         *it1 = std::log(*it1);
         ++it1;
     }
+    SetAllBandsActive();
 }
 
 double
 Norm(const SpectrumValue& x)
 {
     double s = 0;
-    Values::const_iterator it1 = x.ConstValuesBegin();
-    while (it1 != x.ConstValuesEnd())
+    Values::const_iterator it1 = x.ConstValuesBegin() + x.m_activeBegin;
+    Values::const_iterator end1 = x.ConstValuesBegin() + x.m_activeEnd;
+    while (it1 != end1)
     {
         s += (*it1) * (*it1);
         ++it1;
@@ -334,8 +409,9 @@ double
 Sum(const SpectrumValue& x)
 {
     double s = 0;
-    Values::const_iterator it1 = x.ConstValuesBegin();
-    while (it1 != x.ConstValuesEnd())
+    Values::const_iterator it1 = x.ConstValuesBegin() + x.m_activeBegin;
+    Values::const_iterator end1 = x.ConstValuesBegin() + x.m_activeEnd;
+    while (it1 != end1)
     {
         s += (*it1);
         ++it1;
@@ -360,24 +436,23 @@ double
 Integral(const SpectrumValue& arg)
 {
     double i = 0;
-    Values::const_iterator vit = arg.ConstValuesBegin();
-    Bands::const_iterator bit = arg.ConstBandsBegin();
-    while (vit != arg.ConstValuesEnd())
+    NS_ASSERT(arg.GetValuesN() == arg.GetSpectrumModel()->GetNumBands());
+    Values::const_iterator vit = arg.ConstValuesBegin() + arg.m_activeBegin;
+    Values::const_iterator vend = arg.ConstValuesBegin() + arg.m_activeEnd;
+    Bands::const_iterator bit = arg.ConstBandsBegin() + arg.m_activeBegin;
+    while (vit != vend)
     {
-        NS_ASSERT(bit != arg.ConstBandsEnd());
         i += (*vit) * (bit->fh - bit->fl);
         ++vit;
         ++bit;
     }
-    NS_ASSERT(bit == arg.ConstBandsEnd());
     return i;
 }
 
 Ptr<SpectrumValue>
 SpectrumValue::Copy() const
 {
-    Ptr<SpectrumValue> p = Create<SpectrumValue>(m_spectrumModel);
-    *p = *this;
+    Ptr<SpectrumValue> p = Create<SpectrumValue>(*this);
     return p;
 
     //  return Copy<SpectrumValue> (*this)
@@ -619,6 +694,15 @@ SpectrumValue::operator=(double rhs)
         *it1 = rhs;
         ++it1;
     }
+    if (rhs == 0)
+    {
+        m_activeBegin = 0;
+        m_activeEnd = 0;
+    }
+    else
+    {
+        SetAllBandsActive();
+    }
     return *this;
 }
 
@@ -55,6 +55,18 @@ typedef std::vector<double> Values;
  * The intended use of this class is to represent frequency-dependent
  * things, such as power spectral densities, frequency-dependent
  * propagation losses, spectral masks, etc.
+ *
+ * Each instance keeps track of the range of bands which may hold a
+ * non-zero value (the active bands), all the values outside this range
+ * being zero. A newly created SpectrumValue has no active bands, and
+ * writing a value through operator[] extends the active bands to include
+ * it. The addition, subtraction and multiplication operators, as well as
+ * Norm, Sum and Integral, only process the active bands. This makes
+ * band-limited signals, e.g., a narrowband PSD defined over a wideband
+ * SpectrumModel, much cheaper to handle. Any operation which can make the
+ * values outside the active bands non-zero (e.g., adding a flat value,
+ * the division by a SpectrumValue, the access through ValuesBegin ())
+ * marks all the bands as active.
  */
 class SpectrumValue : public SimpleRefCount<SpectrumValue>
 {
@@ -81,7 +93,8 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
     SpectrumValue();
 
     /**
-     * Access value at given frequency index
+     * Access value at given frequency index. The active bands are
+     * extended to include the index.
      *
      * @param index the given frequency index
      *
@@ -139,19 +152,34 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
     Values::const_iterator ConstValuesEnd() const;
 
     /**
-     *
+     * All the bands are marked as active, since the values can be modified
+     * through the returned iterator.
      *
      * @return an iterator pointing to the beginning of the embedded Values
      */
     Values::iterator ValuesBegin();
 
     /**
-     *
+     * All the bands are marked as active, since the values can be modified
+     * through the returned iterator.
      *
      * @return an iterator pointing to the end of the embedded Values
      */
     Values::iterator ValuesEnd();
 
+    /**
+     * \brief Get the index of the first active band
+     * \return the index of the first band which may hold a non-zero value
+     */
+    size_t GetActiveBandsBegin() const;
+
+    /**
+     * \brief Get the index following the last active band
+     * \return the index following the last band which may hold a non-zero value,
+     * equal to GetActiveBandsBegin () if all the values are zero
+     */
+    size_t GetActiveBandsEnd() const;
+
     /**
      * \brief Get the number of values stored in the array
      * \return the values array size
@@ -586,6 +614,16 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      * Applies a Log to each the elements
      */
     void Log();
+    /**
+     * Extend the active bands to include the given range
+     * \param begin index of the first band of the range
+     * \param end index following the last band of the range
+     */
+    void ExtendActiveBands(size_t begin, size_t end);
+    /**
+     * Mark all the bands as active
+     */
+    void SetAllBandsActive();
 
     Ptr<const SpectrumModel> m_spectrumModel; //!< The spectrum model
 
@@ -597,6 +635,9 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      */
     Values m_values;
+
+    size_t m_activeBegin; //!< Index of the first active band
+    size_t m_activeEnd;   //!< Index following the last active band
 };
 
 std::ostream& operator<<(std::ostream& os, const SpectrumValue& pvf);
@@ -0,0 +1,382 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/net-device.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("SingleModelSpectrumChannelTest");
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumPhy counting the received signals
+ */
+class CountingSpectrumPhy : public SpectrumPhy
+{
+  public:
+    CountingSpectrumPhy();
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    uint32_t m_rxCount;               //!< Number of received signals
+    Time m_rxDuration;                //!< Duration of the last received signal
+    Ptr<MobilityModel> m_mobility;    //!< Mobility model
+    Ptr<const SpectrumModel> m_model; //!< Spectrum model
+};
+
+CountingSpectrumPhy::CountingSpectrumPhy()
+    : m_rxCount(0)
+{
+}
+
+TypeId
+CountingSpectrumPhy::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::CountingSpectrumPhy")
+                            .SetParent<SpectrumPhy>()
+                            .SetGroupName("Spectrum")
+                            .AddConstructor<CountingSpectrumPhy>();
+    return tid;
+}
+
+void
+CountingSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+CountingSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+CountingSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+CountingSpectrumPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+CountingSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+CountingSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_model;
+}
+
+Ptr<Object>
+CountingSpectrumPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+CountingSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_rxCount++;
+    m_rxDuration = params->duration;
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the receiver culling by distance of SingleModelSpectrumChannel
+ */
+class SingleModelSpectrumChannelRangeTestCase : public TestCase
+{
+  public:
+    SingleModelSpectrumChannelRangeTestCase();
+    ~SingleModelSpectrumChannelRangeTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Transmit a signal from the first PHY and count the receptions.
+     * \return the number of PHYs which received the signal
+     */
+    uint32_t Transmit();
+
+    Ptr<SingleModelSpectrumChannel> m_channel;    //!< The channel
+    std::vector<Ptr<CountingSpectrumPhy>> m_phys; //!< The PHYs, the first one transmits
+    Ptr<SpectrumValue> m_psd;                     //!< The transmitted PSD
+};
+
+SingleModelSpectrumChannelRangeTestCase::SingleModelSpectrumChannelRangeTestCase()
+    : TestCase("Check the receivers culled by the MaxInterferenceRange attribute")
+{
+}
+
+SingleModelSpectrumChannelRangeTestCase::~SingleModelSpectrumChannelRangeTestCase()
+{
+}
+
+uint32_t
+SingleModelSpectrumChannelRangeTestCase::Transmit()
+{
+    for (const auto& phy : m_phys)
+    {
+        phy->m_rxCount = 0;
+    }
+
+    Ptr<SpectrumSignalParameters> txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = m_psd;
+    txParams->duration = MilliSeconds(1);
+    txParams->txPhy = m_phys[0];
+    m_channel->StartTx(txParams);
+    Simulator::Run();
+
+    uint32_t received = 0;
+    for (const auto& phy : m_phys)
+    {
+        received += phy->m_rxCount;
+    }
+    return received;
+}
+
+void
+SingleModelSpectrumChannelRangeTestCase::DoRun()
+{
+    std::vector<double> freqs = {1e9, 2e9};
+    Ptr<SpectrumModel> model = Create<SpectrumModel>(freqs);
+    m_psd = Create<SpectrumValue>(model);
+    (*m_psd)[0] = 1.0;
+
+    m_channel = CreateObject<SingleModelSpectrumChannel>();
+    m_channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+
+    // The transmitter, 4 receivers at increasing distances and one without mobility.
+    std::vector<Vector> positions = {Vector(0, 0, 0),
+                                     Vector(10, 0, 0),
+                                     Vector(0, -50, 0),
+                                     Vector(150, 0, 0),
+                                     Vector(300, 300, 0)};
+    for (const auto& position : positions)
+    {
+        Ptr<CountingSpectrumPhy> phy = CreateObject<CountingSpectrumPhy>();
+        Ptr<ConstantPositionMobilityModel> mobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(position);
+        phy->SetMobility(mobility);
+        phy->m_model = model;
+        m_channel->AddRx(phy);
+        m_phys.push_back(phy);
+    }
+    Ptr<CountingSpectrumPhy> unlocated = CreateObject<CountingSpectrumPhy>();
+    unlocated->m_model = model;
+    m_channel->AddRx(unlocated);
+    m_phys.push_back(unlocated);
+
+    NS_TEST_ASSERT_MSG_EQ(Transmit(), 5U, "All the receivers must get the signal by default");
+
+    m_channel->SetAttribute("MaxInterferenceRange", DoubleValue(100));
+    NS_TEST_ASSERT_MSG_EQ(Transmit(), 3U, "Only the receivers in range must get the signal");
+    NS_TEST_ASSERT_MSG_EQ(m_phys[3]->m_rxCount, 0U, "The receiver at 150 m must be skipped");
+    NS_TEST_ASSERT_MSG_EQ(unlocated->m_rxCount,
+                          1U,
+                          "A receiver without mobility is never skipped");
+
+    // Moving a receiver must update the grid.
+    m_phys[3]->GetMobility()->SetPosition(Vector(60, 60, 0));
+    NS_TEST_ASSERT_MSG_EQ(Transmit(), 4U, "The receiver moved in range must get the signal");
+    m_phys[1]->GetMobility()->SetPosition(Vector(0, 0, 250));
+    NS_TEST_ASSERT_MSG_EQ(Transmit(), 3U, "The receiver moved out of range must be skipped");
+
+    // A receiver moving along a trajectory does not report its course changes,
+    // its current position must be used.
+    Ptr<CountingSpectrumPhy> moving = CreateObject<CountingSpectrumPhy>();
+    Ptr<ConstantVelocityMobilityModel> velocity = CreateObject<ConstantVelocityMobilityModel>();
+    velocity->SetPosition(Vector(400, 0, 0));
+    velocity->SetVelocity(Vector(-100, 0, 0));
+    moving->SetMobility(velocity);
+    moving->m_model = model;
+    m_channel->AddRx(moving);
+    m_phys.push_back(moving);
+    NS_TEST_ASSERT_MSG_EQ(Transmit(), 3U, "The moving receiver is out of range");
+    Simulator::Stop(Seconds(3.5));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(Transmit(), 4U, "The moving receiver is now in range");
+    NS_TEST_ASSERT_MSG_EQ(moving->m_rxCount, 1U, "The moving receiver must get the signal");
+    m_channel->RemoveRx(moving);
+    m_phys.pop_back();
+
+    m_channel->SetAttribute("MaxInterferenceRange", DoubleValue(1000));
+    NS_TEST_ASSERT_MSG_EQ(Transmit(), 5U, "All the receivers are in range");
+
+    m_phys.clear();
+    m_channel->Dispose();
+    m_channel = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the receivers restricted to a range of bands with SetRxBands
+ */
+class SingleModelSpectrumChannelRxBandsTestCase : public TestCase
+{
+  public:
+    SingleModelSpectrumChannelRxBandsTestCase();
+    ~SingleModelSpectrumChannelRxBandsTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+SingleModelSpectrumChannelRxBandsTestCase::SingleModelSpectrumChannelRxBandsTestCase()
+    : TestCase("Check the receivers skipped and caught up by SetRxBands")
+{
+}
+
+SingleModelSpectrumChannelRxBandsTestCase::~SingleModelSpectrumChannelRxBandsTestCase()
+{
+}
+
+void
+SingleModelSpectrumChannelRxBandsTestCase::DoRun()
+{
+    // Test Setup:
+    // A signal on the band 0 lasting 1 ms is transmitted at time 0.
+    //
+    // - inBand listens to the bands 0-1, switches off at 0.5 ms and on again at 0.6 ms.
+    // - outOfBand listens to the bands 2-3, and to all the bands after the signal.
+    // - off listens to no band, and to all the bands from 0.4 ms.
+    // - unrestricted never calls SetRxBands.
+
+    std::vector<double> freqs = {1e9, 2e9, 3e9, 4e9};
+    Ptr<SpectrumModel> model = Create<SpectrumModel>(freqs);
+    Ptr<SpectrumValue> psd = Create<SpectrumValue>(model);
+    (*psd)[0] = 1.0;
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    std::vector<Ptr<CountingSpectrumPhy>> phys;
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        Ptr<CountingSpectrumPhy> phy = CreateObject<CountingSpectrumPhy>();
+        phy->m_model = model;
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+    Ptr<CountingSpectrumPhy> tx = phys[0];
+    Ptr<CountingSpectrumPhy> inBand = phys[1];
+    Ptr<CountingSpectrumPhy> outOfBand = phys[2];
+    Ptr<CountingSpectrumPhy> off = phys[3];
+    Ptr<CountingSpectrumPhy> unrestricted = phys[4];
+
+    channel->SetRxBands(inBand, 0, 2);
+    channel->SetRxBands(outOfBand, 2, 4);
+    channel->SetRxBands(off, 0, 0);
+
+    Ptr<SpectrumSignalParameters> txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = psd;
+    txParams->duration = MilliSeconds(1);
+    txParams->txPhy = tx;
+    channel->StartTx(txParams);
+
+    Simulator::Schedule(MicroSeconds(400),
+                        &SingleModelSpectrumChannel::SetRxBands,
+                        channel,
+                        off,
+                        0,
+                        4);
+    Simulator::Schedule(MicroSeconds(500),
+                        &SingleModelSpectrumChannel::SetRxBands,
+                        channel,
+                        inBand,
+                        0,
+                        0);
+    Simulator::Schedule(MicroSeconds(600),
+                        &SingleModelSpectrumChannel::SetRxBands,
+                        channel,
+                        inBand,
+                        0,
+                        2);
+    Simulator::Schedule(MilliSeconds(2),
+                        &SingleModelSpectrumChannel::SetRxBands,
+                        channel,
+                        outOfBand,
+                        0,
+                        4);
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(inBand->m_rxCount, 1U, "The signal must be delivered once in band");
+    NS_TEST_EXPECT_MSG_EQ(outOfBand->m_rxCount, 0U, "The signal must not be delivered out of band");
+    NS_TEST_EXPECT_MSG_EQ(unrestricted->m_rxCount, 1U, "The signal must always be delivered");
+    NS_TEST_EXPECT_MSG_EQ(off->m_rxCount, 1U, "The rest of the signal must be delivered");
+    NS_TEST_EXPECT_MSG_EQ(off->m_rxDuration,
+                          MicroSeconds(600),
+                          "Only the rest of the signal must be delivered");
+    NS_TEST_EXPECT_MSG_EQ(tx->m_rxCount, 0U, "The transmitter must not get its own signal");
+
+    phys.clear();
+    channel->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SingleModelSpectrumChannel TestSuite
+ */
+class SingleModelSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    SingleModelSpectrumChannelTestSuite();
+};
+
+SingleModelSpectrumChannelTestSuite::SingleModelSpectrumChannelTestSuite()
+    : TestSuite("single-model-spectrum-channel", UNIT)
+{
+    AddTestCase(new SingleModelSpectrumChannelRangeTestCase, TestCase::QUICK);
+    AddTestCase(new SingleModelSpectrumChannelRxBandsTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SingleModelSpectrumChannelTestSuite g_singleModelSpectrumChannelTestSuite;
@@ -93,6 +93,105 @@ SpectrumValueTestCase::DoRun()
     NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(m_a, m_b, TOLERANCE, "");
 }
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Spectrum Value active bands Test
+ *
+ * Check that the operations on a band-limited SpectrumValue give the same
+ * results as on a SpectrumValue with all the bands active.
+ */
+class SpectrumValueActiveBandsTestCase : public TestCase
+{
+  public:
+    SpectrumValueActiveBandsTestCase();
+    ~SpectrumValueActiveBandsTestCase() override;
+    void DoRun() override;
+};
+
+SpectrumValueActiveBandsTestCase::SpectrumValueActiveBandsTestCase()
+    : TestCase("SpectrumValue active bands")
+{
+}
+
+SpectrumValueActiveBandsTestCase::~SpectrumValueActiveBandsTestCase()
+{
+}
+
+void
+SpectrumValueActiveBandsTestCase::DoRun()
+{
+    std::vector<double> freqs;
+    for (int i = 1; i <= 20; i++)
+    {
+        freqs.push_back(i);
+    }
+    Ptr<SpectrumModel> f = Create<SpectrumModel>(freqs);
+
+    SpectrumValue a(f);
+    NS_TEST_ASSERT_MSG_EQ(a.GetActiveBandsBegin(),
+                          a.GetActiveBandsEnd(),
+                          "A new SpectrumValue must have no active bands");
+
+    a[4] = 1.5;
+    a[6] = 2.5;
+    NS_TEST_ASSERT_MSG_EQ(a.GetActiveBandsBegin(), 4U, "Wrong first active band");
+    NS_TEST_ASSERT_MSG_EQ(a.GetActiveBandsEnd(), 7U, "Wrong last active band");
+
+    SpectrumValue b(f);
+    b[10] = -3.0;
+    b[12] = 0.5;
+
+    // The same values, with all the bands active.
+    SpectrumValue fullA = a;
+    SpectrumValue fullB = b;
+    fullA.ValuesBegin();
+    fullB.ValuesBegin();
+    NS_TEST_ASSERT_MSG_EQ(fullA.GetActiveBandsEnd() - fullA.GetActiveBandsBegin(),
+                          20U,
+                          "ValuesBegin must activate all the bands");
+
+    SpectrumValue sum = a + b;
+    NS_TEST_ASSERT_MSG_EQ(sum.GetActiveBandsBegin(), 4U, "Wrong first active band of the sum");
+    NS_TEST_ASSERT_MSG_EQ(sum.GetActiveBandsEnd(), 13U, "Wrong last active band of the sum");
+
+    // The test macro evaluates its arguments several times, use named values.
+    SpectrumValue y = fullA + fullB;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(sum, y, TOLERANCE, "a + b");
+    SpectrumValue x = a - b;
+    y = fullA - fullB;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(x, y, TOLERANCE, "a - b");
+    x = a * b;
+    y = fullA * fullB;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(x, y, TOLERANCE, "a * b");
+    x = a * 3.0;
+    y = fullA * 3.0;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(x, y, TOLERANCE, "a * 3");
+    x = -a;
+    y = -fullA;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(x, y, TOLERANCE, "-a");
+    x = a + 1.0;
+    y = fullA + 1.0;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(x, y, TOLERANCE, "a + 1");
+    NS_TEST_ASSERT_MSG_EQ(x.GetActiveBandsEnd() - x.GetActiveBandsBegin(),
+                          20U,
+                          "Adding a flat value must activate all the bands");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Sum(a + b), Sum(fullA + fullB), TOLERANCE, "Sum");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Norm(a + b), Norm(fullA + fullB), TOLERANCE, "Norm");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Integral(a + b), Integral(fullA + fullB), TOLERANCE, "Integral");
+
+    a += b;
+    a -= b;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(a, fullA, TOLERANCE, "a + b - b");
+
+    SpectrumValue zero(f);
+    zero = 0.0;
+    NS_TEST_ASSERT_MSG_EQ(zero.GetActiveBandsBegin(),
+                          zero.GetActiveBandsEnd(),
+                          "Assigning zero must deactivate all the bands");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Integral(zero), 0.0, TOLERANCE, "Integral of zero");
+}
+
 /**
  * \ingroup spectrum-tests
  *
@@ -268,6 +367,8 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     v1rs3[4] = v1[1];
     tv1rs3 = v1 >> 3;
     AddTestCase(new SpectrumValueTestCase(tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
+
+    AddTestCase(new SpectrumValueActiveBandsTestCase, TestCase::QUICK);
 }
 
 /**